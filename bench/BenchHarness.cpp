@@ -0,0 +1,223 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Benchmark Harness
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/BenchHarness.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: Timing, statistics and result output for ims_bench
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		// Aim for at least this many samples from a microbenchmark within the minimum run time
+		const int TARGET_BATCHES = 50;
+
+		std::string JSONString(const std::string& s)
+		{
+			std::ostringstream oss;
+			oss << '"';
+			for (char c : s) {
+				switch (c) {
+				case '"': oss << "\\\""; break;
+				case '\\': oss << "\\\\"; break;
+				case '\n': oss << "\\n"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+					}
+					else {
+						oss << c;
+					}
+				}
+			}
+			oss << '"';
+			return oss.str();
+		}
+
+		std::string HumanTime(double ns)
+		{
+			std::ostringstream oss;
+			oss << std::fixed << std::setprecision(2);
+			if (ns < 1e3) oss << ns << " ns";
+			else if (ns < 1e6) oss << ns / 1e3 << " us";
+			else if (ns < 1e9) oss << ns / 1e6 << " ms";
+			else oss << ns / 1e9 << " s";
+			return oss.str();
+		}
+
+		std::string HumanRate(double perSecond, const char* unit)
+		{
+			if (perSecond <= 0.0) return "";
+			std::ostringstream oss;
+			oss << std::fixed << std::setprecision(2);
+			if (perSecond < 1e3) oss << perSecond << " " << unit << "/s";
+			else if (perSecond < 1e6) oss << perSecond / 1e3 << " k" << unit << "/s";
+			else if (perSecond < 1e9) oss << perSecond / 1e6 << " M" << unit << "/s";
+			else oss << perSecond / 1e9 << " G" << unit << "/s";
+			return oss.str();
+		}
+
+	}
+
+	Measure::Measure(std::chrono::milliseconds minTime, std::size_t minSamples)
+		: m_minTime(minTime), m_minSamples(minSamples) {}
+
+	void Measure::Run(const std::function<void()>& body)
+	{
+		// Calibrate: grow the batch until it lasts a useful fraction of the minimum run time
+		const Clock::duration target = std::max<Clock::duration>(m_minTime / TARGET_BATCHES, std::chrono::microseconds(100));
+		std::uint64_t batch = 1;
+		for (;;) {
+			const auto t0 = Clock::now();
+			for (std::uint64_t i = 0; i < batch; i++) body();
+			const auto elapsed = Clock::now() - t0;
+			if ((elapsed >= target) || (batch >= (1ull << 30))) {
+				Sample(elapsed, batch);
+				break;
+			}
+			batch *= 2;
+		}
+
+		while (More()) {
+			const auto t0 = Clock::now();
+			for (std::uint64_t i = 0; i < batch; i++) body();
+			Sample(Clock::now() - t0, batch);
+		}
+	}
+
+	void Measure::Sample(Clock::duration elapsed, std::uint64_t iterations)
+	{
+		if (!m_started) {
+			m_start = Clock::now() - elapsed;
+			m_started = true;
+		}
+		m_elapsed += elapsed;
+		m_iterations += iterations;
+		m_samplesNs.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations));
+	}
+
+	bool Measure::More() const
+	{
+		if (m_skipped) return false;
+		if (m_samplesNs.size() < m_minSamples) return true;
+		return !m_started || ((Clock::now() - m_start) < m_minTime);
+	}
+
+	void Measure::Skip(const std::string& why)
+	{
+		m_skipped = true;
+		m_note = why;
+	}
+
+	Result Measure::Summarise(const std::string& name) const
+	{
+		Result r;
+		r.name = name;
+		r.skipped = m_skipped || m_samplesNs.empty();
+		r.note = m_note;
+		if (r.skipped) return r;
+
+		std::vector<double> sorted(m_samplesNs);
+		std::sort(sorted.begin(), sorted.end());
+		r.iterations = m_iterations;
+		r.samples = sorted.size();
+		r.minNs = sorted.front();
+		r.maxNs = sorted.back();
+		const std::size_t mid = sorted.size() / 2;
+		r.medianNs = (sorted.size() % 2) ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+		r.meanNs = std::chrono::duration<double, std::nano>(m_elapsed).count() / static_cast<double>(m_iterations);
+
+		// Throughput is quoted at the median, which is less sensitive to scheduling noise than the mean
+		if (r.medianNs > 0.0) {
+			r.itemsPerSecond = m_items * 1e9 / r.medianNs;
+			r.bytesPerSecond = m_bytes * 1e9 / r.medianNs;
+		}
+		return r;
+	}
+
+	void Registry::Add(const std::string& name, std::function<void(Context&, Measure&)> fn)
+	{
+		m_cases.push_back(Case{ name, false, std::move(fn) });
+	}
+
+	void Registry::AddDevice(const std::string& name, std::function<void(Context&, Measure&)> fn)
+	{
+		m_cases.push_back(Case{ name, true, std::move(fn) });
+	}
+
+	void WriteTableHeader(std::ostream& os, std::size_t nameWidth)
+	{
+		os << std::left << std::setw(static_cast<int>(nameWidth) + 2) << "benchmark"
+			<< std::right << std::setw(12) << "median" << std::setw(12) << "min"
+			<< std::setw(12) << "iterations" << "  throughput" << std::endl;
+	}
+
+	void WriteTableRow(std::ostream& os, std::size_t nameWidth, const Result& r)
+	{
+		os << std::left << std::setw(static_cast<int>(nameWidth) + 2) << r.name << std::right;
+		if (r.skipped) {
+			os << "  skipped: " << r.note << std::endl;
+			return;
+		}
+		os << std::setw(12) << HumanTime(r.medianNs) << std::setw(12) << HumanTime(r.minNs)
+			<< std::setw(12) << r.iterations;
+		const std::string items = HumanRate(r.itemsPerSecond, "items");
+		const std::string bytes = HumanRate(r.bytesPerSecond, "B");
+		if (!items.empty()) os << "  " << items;
+		if (!bytes.empty()) os << "  " << bytes;
+		os << std::endl;
+	}
+
+	void WriteJSON(std::ostream& os, const RunInfo& info, const std::vector<Result>& results)
+	{
+		os << std::setprecision(6);
+		os << "{\n";
+		os << "  \"suite\": \"ims_bench\",\n";
+		os << "  \"library\": " << JSONString(info.library) << ",\n";
+		os << "  \"timestamp\": " << JSONString(info.timestamp) << ",\n";
+		os << "  \"target\": " << JSONString(info.target) << ",\n";
+		os << "  \"latency_us\": " << info.latencyUs << ",\n";
+		os << "  \"jitter_us\": " << info.jitterUs << ",\n";
+		os << "  \"min_time_ms\": " << info.minTimeMs << ",\n";
+		os << "  \"results\": [";
+		for (std::size_t i = 0; i < results.size(); i++) {
+			const Result& r = results[i];
+			os << (i ? ",\n" : "\n") << "    { \"name\": " << JSONString(r.name);
+			if (r.skipped) {
+				os << ", \"skipped\": true, \"note\": " << JSONString(r.note) << " }";
+				continue;
+			}
+			os << ", \"iterations\": " << r.iterations << ", \"samples\": " << r.samples
+				<< ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs
+				<< ", \"mean_ns\": " << r.meanNs << ", \"max_ns\": " << r.maxNs
+				<< ", \"items_per_second\": " << r.itemsPerSecond
+				<< ", \"bytes_per_second\": " << r.bytesPerSecond << " }";
+		}
+		os << "\n  ]\n}\n";
+	}
+
+}
+}
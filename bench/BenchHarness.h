@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Benchmark Harness Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/BenchHarness.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: Minimal timing harness used by ims_bench.  Each benchmark case
+/              is a function that is handed a Measure object; microbenchmarks
+/              pass it a body to be timed in calibrated batches, end-to-end
+/              cases time one operation at a time and add samples directly.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_BENCH_HARNESS_H__
+#define IMS_BENCH_HARNESS_H__
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace iMS
+{
+	class IMSSystem;
+
+namespace bench {
+
+	using Clock = std::chrono::steady_clock;
+
+	// Prevents the compiler from discarding a value computed in a benchmark body
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	// Shared state handed to every benchmark case
+	struct Context
+	{
+		// Connected system (simulator or hardware), or null if none is available
+		std::shared_ptr<IMSSystem> ims;
+		// Scratch directory for file based benchmarks
+		std::string workDir;
+	};
+
+	struct Result
+	{
+		std::string name;
+		std::uint64_t iterations{ 0 };
+		std::size_t samples{ 0 };
+		double minNs{ 0.0 };
+		double medianNs{ 0.0 };
+		double meanNs{ 0.0 };
+		double maxNs{ 0.0 };
+		double itemsPerSecond{ 0.0 };
+		double bytesPerSecond{ 0.0 };
+		bool skipped{ false };
+		std::string note;
+	};
+
+	class Measure
+	{
+	public:
+		Measure(std::chrono::milliseconds minTime, std::size_t minSamples);
+
+		// Times 'body' in batches large enough for the clock resolution to be insignificant.  Each
+		// batch contributes one sample of the mean time per call.
+		void Run(const std::function<void()>& body);
+
+		// Adds the time taken by one operation.  Used by cases which time their own operations.
+		void Sample(Clock::duration elapsed, std::uint64_t iterations = 1);
+
+		// True until both the minimum run time and the minimum number of samples have been reached
+		bool More() const;
+
+		// Work done by one iteration, used to report throughput
+		void Items(double perIteration) { m_items = perIteration; }
+		void Bytes(double perIteration) { m_bytes = perIteration; }
+
+		// Marks the case as not run
+		void Skip(const std::string& why);
+		bool Skipped() const { return m_skipped; }
+
+		Result Summarise(const std::string& name) const;
+
+	private:
+		const Clock::duration m_minTime;
+		const std::size_t m_minSamples;
+		Clock::time_point m_start;
+		bool m_started{ false };
+		Clock::duration m_elapsed{};
+		std::vector<double> m_samplesNs;
+		std::uint64_t m_iterations{ 0 };
+		double m_items{ 0.0 };
+		double m_bytes{ 0.0 };
+		bool m_skipped{ false };
+		std::string m_note;
+	};
+
+	struct Case
+	{
+		std::string name;
+		// Case needs a connected iMS system and is skipped without one
+		bool device;
+		std::function<void(Context&, Measure&)> fn;
+	};
+
+	class Registry
+	{
+	public:
+		void Add(const std::string& name, std::function<void(Context&, Measure&)> fn);
+		void AddDevice(const std::string& name, std::function<void(Context&, Measure&)> fn);
+
+		const std::vector<Case>& Cases() const { return m_cases; }
+
+	private:
+		std::vector<Case> m_cases;
+	};
+
+	// Run metadata written alongside the results
+	struct RunInfo
+	{
+		std::string library;
+		std::string timestamp;
+		std::string target;
+		std::uint32_t latencyUs{ 0 };
+		std::uint32_t jitterUs{ 0 };
+		long minTimeMs{ 0 };
+	};
+
+	// Human readable table, written a row at a time as benchmarks complete
+	void WriteTableHeader(std::ostream& os, std::size_t nameWidth);
+	void WriteTableRow(std::ostream& os, std::size_t nameWidth, const Result& r);
+
+	void WriteJSON(std::ostream& os, const RunInfo& info, const std::vector<Result>& results);
+
+	// Benchmark groups, one per source file
+	void RegisterProtocolBenchmarks(Registry& reg);
+	void RegisterImageBenchmarks(Registry& reg);
+	void RegisterCompensationBenchmarks(Registry& reg);
+	void RegisterProjectBenchmarks(Registry& reg);
+	void RegisterDownloadBenchmarks(Registry& reg);
+
+}
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Compensation Table Benchmarks
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/bench_compensation.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: Generation of CompensationTable contents from a
+/              CompensationFunction with each of the interpolation styles.
+/              Tables are sized offline so no system is required.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+
+#include "AcoustoOptics.h"
+#include "Compensation.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		// Default depth of an iMS4 Synthesiser look up table (4096 entries)
+		const int LUT_DEPTH = 12;
+		const int SPEC_POINTS = 16;
+
+		CompensationFunction TestFunction(CompensationFunction::InterpolationStyle style)
+		{
+			CompensationFunction func;
+			for (int i = 0; i < SPEC_POINTS; i++) {
+				const double f = 50.0 + 100.0 * i / (SPEC_POINTS - 1);
+				const double a = 60.0 + 40.0 * std::sin(i * 0.4);
+				const double p = 10.0 * i;
+				func.push_back(CompensationPointSpecification(CompensationPoint(Percent(a), Degrees(p), static_cast<unsigned int>(i & 0xF), i / 16.0), MHz(f)));
+			}
+			for (auto feat : { CompensationFeature::AMPLITUDE, CompensationFeature::PHASE, CompensationFeature::SYNC_DIG, CompensationFeature::SYNC_ANLG }) {
+				func.SetStyle(feat, style);
+			}
+			return func;
+		}
+
+		void Apply(Measure& m, CompensationFunction::InterpolationStyle style)
+		{
+			CompensationTable tbl(LUT_DEPTH, MHz(40.0), MHz(160.0));
+			const CompensationFunction func = TestFunction(style);
+
+			m.Items(static_cast<double>(tbl.size()));
+			m.Run([&] {
+				DoNotOptimize(tbl.ApplyFunction(func, CompensationModifier::REPLACE));
+			});
+		}
+
+		void ApplyFeature(Measure& m, CompensationFunction::InterpolationStyle style, CompensationFeature feat)
+		{
+			CompensationTable tbl(LUT_DEPTH, MHz(40.0), MHz(160.0));
+			const CompensationFunction func = TestFunction(style);
+
+			m.Items(static_cast<double>(tbl.size()));
+			m.Run([&] {
+				DoNotOptimize(tbl.ApplyFunction(func, feat));
+			});
+		}
+
+		// Job change on a multi-laser system: the device is looked up by model and functions generated for each laser
+		void AODeviceFunctions(Measure& m)
+		{
+			const auto& models = AODeviceList::getList();
+			if (models.begin() == models.end()) {
+				m.Skip("no AO devices in database");
+				return;
+			}
+			const std::string model = *models.begin();
+			const std::vector<micrometre> lasers{ micrometre(0.355), micrometre(0.532), micrometre(1.064) };
+
+			m.Items(static_cast<double>(lasers.size()));
+			m.Run([&] {
+				AODevice aod(model);
+				DoNotOptimize(aod.GetCompensationFunctions(lasers).size());
+			});
+		}
+
+		// Four channel iMS_LUT file, written once then imported table by table
+		void ExportChannels(Context& ctx, Measure& m)
+		{
+			const std::string file = (std::filesystem::path(ctx.workDir) / "bench_export.lut").string();
+			CompensationTableExporter ex(4);
+			for (int chan = RFChannel::min; chan <= RFChannel::max; chan++) {
+				CompensationTable tbl(LUT_DEPTH, MHz(40.0), MHz(160.0));
+				tbl.ApplyFunction(TestFunction(CompensationFunction::InterpolationStyle::LINEAR), CompensationModifier::REPLACE);
+				ex.ProvideChannelTable(RFChannel(chan), tbl);
+			}
+
+			m.Items(4.0 * (1 << LUT_DEPTH));
+			m.Run([&] {
+				DoNotOptimize(ex.ExportChannelLUT(file));
+			});
+			std::remove(file.c_str());
+		}
+
+		void ImportChannels(Context& ctx, Measure& m)
+		{
+			const std::string file = (std::filesystem::path(ctx.workDir) / "bench_import.lut").string();
+			CompensationTableExporter ex(4);
+			for (int chan = RFChannel::min; chan <= RFChannel::max; chan++) {
+				ex.ProvideChannelTable(RFChannel(chan), CompensationTable(LUT_DEPTH, MHz(40.0), MHz(160.0)));
+			}
+			if (!ex.ExportChannelLUT(file)) {
+				m.Skip("unable to write " + file);
+				return;
+			}
+
+			CompensationTableImporter im(file);
+			m.Items(4.0 * (1 << LUT_DEPTH));
+			m.Run([&] {
+				for (int chan = RFChannel::min; chan <= RFChannel::max; chan++) {
+					RFChannel ch(chan);
+					DoNotOptimize(im.RetrieveChannelLUT(ch).Size());
+				}
+			});
+			std::remove(file.c_str());
+		}
+
+	}
+
+	void RegisterCompensationBenchmarks(Registry& reg)
+	{
+		using Style = CompensationFunction::InterpolationStyle;
+
+		reg.Add("compensation/ApplyFunction/spot", [](Context&, Measure& m) { Apply(m, Style::SPOT); });
+		reg.Add("compensation/ApplyFunction/step", [](Context&, Measure& m) { Apply(m, Style::STEP); });
+		reg.Add("compensation/Interpolate/linear", [](Context&, Measure& m) { Apply(m, Style::LINEAR); });
+		reg.Add("compensation/Interpolate/linextend", [](Context&, Measure& m) { Apply(m, Style::LINEXTEND); });
+		reg.Add("compensation/Interpolate/bspline", [](Context&, Measure& m) { Apply(m, Style::BSPLINE); });
+		reg.Add("compensation/Interpolate/bspline_amplitude_only", [](Context&, Measure& m) { ApplyFeature(m, Style::BSPLINE, CompensationFeature::AMPLITUDE); });
+		reg.Add("compensation/AODevice/GetCompensationFunctions_3_lasers", [](Context&, Measure& m) { AODeviceFunctions(m); });
+		reg.Add("compensation/CompensationTableExporter/4_channels", [](Context& ctx, Measure& m) { ExportChannels(ctx, m); });
+		reg.Add("compensation/CompensationTableImporter/4_channels", [](Context& ctx, Measure& m) { ImportChannels(ctx, m); });
+	}
+
+}
+}
@@ -0,0 +1,575 @@
+/*-----------------------------------------------------------------------------
+/ Title      : End-to-end Download Benchmarks
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/bench_download.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: Image, compensation table (LUT) and sequence downloads timed
+/              from StartDownload() to the DOWNLOAD_FINISHED event, against
+/              the stand-in device started by ims_bench or real hardware.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+
+#include "Compensation.h"
+#include "IEventHandler.h"
+#include "ImageOps.h"
+#include "IMSSystem.h"
+#include "PrivateUtil.h"
+#include "SignalPath.h"
+#include "ToneBuffer.h"
+
+#include <atomic>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		const std::chrono::milliseconds DOWNLOAD_TIMEOUT(30000);
+
+		// Waits for the finished or error event of one download
+		class DownloadWaiter : public IEventHandler
+		{
+		public:
+			DownloadWaiter(int finished, int error) : m_finished(finished), m_error(error) {}
+
+			void EventAction(void* /*sender*/, const int message, const int param) override
+			{
+				if (message == m_finished) {
+					m_param = param;
+					m_done.set();
+				}
+				else if (message == m_error) {
+					m_failed = true;
+					m_done.set();
+				}
+			}
+
+			void Reset()
+			{
+				m_failed = false;
+				m_param = 0;
+				m_done.reset();
+			}
+
+			// Returns false on error or timeout
+			bool Wait() const { return m_done.wait_for(DOWNLOAD_TIMEOUT) && !m_failed; }
+			int Param() const { return m_param; }
+
+		private:
+			const int m_finished;
+			const int m_error;
+			CompletionSignal m_done;
+			std::atomic<bool> m_failed{ false };
+			std::atomic<int> m_param{ 0 };
+		};
+
+		Image DownloadImage(std::size_t npts)
+		{
+			Image img("bench");
+			for (std::size_t i = 0; i < npts; i++) {
+				const double f = 50.0 + 100.0 * static_cast<double>(i) / npts;
+				img.AddPoint(ImagePoint(FAP(f, 100.0, 0.0), FAP(f, 90.0, 0.0), FAP(f, 80.0, 0.0), FAP(f, 70.0, 0.0)));
+			}
+			return img;
+		}
+
+		void ClearImageTable(std::shared_ptr<IMSSystem> ims)
+		{
+			ImageTableViewer itv(ims);
+			for (int n = itv.Entries(); n > 0; n--) {
+				if (!itv.Erase(0)) break;
+			}
+		}
+
+		// Downloads an Image, returning the number of bytes transferred or -1 on failure
+		int ImageDownloadOnce(std::shared_ptr<IMSSystem> ims, const Image& img, Clock::duration& elapsed)
+		{
+			ImageDownload dl(ims, img);
+			DownloadWaiter waiter(DownloadEvents::DOWNLOAD_FINISHED, DownloadEvents::DOWNLOAD_ERROR);
+			dl.ImageDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.ImageDownloadEventSubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+
+			const auto t0 = Clock::now();
+			const bool ok = dl.StartDownload() && waiter.Wait();
+			elapsed = Clock::now() - t0;
+
+			dl.ImageDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.ImageDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+			return ok ? waiter.Param() : -1;
+		}
+
+		void Images(Context& ctx, Measure& m, std::size_t npts)
+		{
+			const Image img = DownloadImage(npts);
+			ClearImageTable(ctx.ims);
+
+			m.Items(static_cast<double>(npts));
+			while (m.More()) {
+				Clock::duration elapsed;
+				const int bytes = ImageDownloadOnce(ctx.ims, img, elapsed);
+				if (bytes < 0) {
+					m.Skip("image download failed");
+					break;
+				}
+				m.Bytes(static_cast<double>(bytes));
+				m.Sample(elapsed);
+				ClearImageTable(ctx.ims);
+			}
+		}
+
+		// Loads a group of Images, either one ImageDownload after another or as one ImageGroupDownload
+		void Group(Context& ctx, Measure& m, std::size_t nimages, std::size_t npts, bool grouped)
+		{
+			ImageGroup grp("bench");
+			for (std::size_t i = 0; i < nimages; i++) grp.AddImage(DownloadImage(npts));
+			ClearImageTable(ctx.ims);
+
+			m.Items(static_cast<double>(nimages));
+			while (m.More()) {
+				Clock::duration elapsed{ 0 };
+				double bytes = 0.0;
+				bool ok = true;
+				if (grouped) {
+					ImageGroupDownload dl(ctx.ims, grp);
+					DownloadWaiter waiter(DownloadEvents::DOWNLOAD_FINISHED, DownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL);
+					dl.ImageGroupDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+					dl.ImageGroupDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL, &waiter);
+
+					const auto t0 = Clock::now();
+					ok = dl.StartDownload() && waiter.Wait();
+					elapsed = Clock::now() - t0;
+					bytes = static_cast<double>(dl.GetProgress().BytesTransferred);
+
+					dl.ImageGroupDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+					dl.ImageGroupDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL, &waiter);
+				}
+				else {
+					for (auto it = grp.cbegin(); ok && (it != grp.cend()); ++it) {
+						Clock::duration one;
+						const int n = ImageDownloadOnce(ctx.ims, *it, one);
+						ok = (n >= 0);
+						bytes += n;
+						elapsed += one;
+					}
+				}
+				if (!ok) {
+					m.Skip("image group download failed");
+					break;
+				}
+				m.Bytes(bytes);
+				m.Sample(elapsed);
+				ClearImageTable(ctx.ims);
+			}
+		}
+
+		// Reads an Image back once it is on the Controller, checking it in the given mode
+		void ImageVerify(Context& ctx, Measure& m, std::size_t npts, ImageDownload::VerifyMode mode)
+		{
+			const Image img = DownloadImage(npts);
+			ClearImageTable(ctx.ims);
+
+			ImageDownload dl(ctx.ims, img);
+			DownloadWaiter loaded(DownloadEvents::DOWNLOAD_FINISHED, DownloadEvents::DOWNLOAD_ERROR);
+			dl.ImageDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &loaded);
+			const bool ok = dl.StartDownload() && loaded.Wait();
+			dl.ImageDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &loaded);
+			if (!ok) {
+				m.Skip("image download failed");
+				return;
+			}
+
+			DownloadWaiter waiter(DownloadEvents::VERIFY_SUCCESS, DownloadEvents::VERIFY_FAIL);
+			dl.ImageDownloadEventSubscribe(DownloadEvents::VERIFY_SUCCESS, &waiter);
+			dl.ImageDownloadEventSubscribe(DownloadEvents::VERIFY_FAIL, &waiter);
+
+			m.Items(static_cast<double>(npts));
+			while (m.More()) {
+				waiter.Reset();
+				const auto t0 = Clock::now();
+				if (!dl.StartVerify(mode) || !waiter.Wait()) {
+					m.Skip("image verify failed");
+					break;
+				}
+				m.Sample(Clock::now() - t0);
+			}
+
+			dl.ImageDownloadEventUnsubscribe(DownloadEvents::VERIFY_SUCCESS, &waiter);
+			dl.ImageDownloadEventUnsubscribe(DownloadEvents::VERIFY_FAIL, &waiter);
+			ClearImageTable(ctx.ims);
+		}
+
+		// Downloads a CompensationTable, returning false on failure
+		bool LUTDownloadOnce(CompensationTableDownload& dl, bool incremental, Clock::duration& elapsed)
+		{
+			DownloadWaiter waiter(CompensationEvents::DOWNLOAD_FINISHED, CompensationEvents::DOWNLOAD_ERROR);
+			dl.CompensationTableDownloadEventSubscribe(CompensationEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.CompensationTableDownloadEventSubscribe(CompensationEvents::DOWNLOAD_ERROR, &waiter);
+
+			const auto t0 = Clock::now();
+			const bool ok = dl.StartDownload(incremental) && waiter.Wait();
+			elapsed = Clock::now() - t0;
+
+			dl.CompensationTableDownloadEventUnsubscribe(CompensationEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.CompensationTableDownloadEventUnsubscribe(CompensationEvents::DOWNLOAD_ERROR, &waiter);
+			return ok;
+		}
+
+		void LUT(Context& ctx, Measure& m)
+		{
+			const CompensationTable tbl(ctx.ims, CompensationPoint(Percent(80.0), Degrees(45.0), 1, 0.5));
+
+			m.Items(static_cast<double>(tbl.size()));
+			while (m.More()) {
+				CompensationTableDownload dl(ctx.ims, tbl);
+				Clock::duration elapsed;
+				if (!LUTDownloadOnce(dl, false, elapsed)) {
+					m.Skip("compensation table download failed");
+					break;
+				}
+				m.Sample(elapsed);
+			}
+		}
+
+		// Channel scoped tables, either one channel at a time or all channels in one download
+		void LUTChannels(Context& ctx, Measure& m, bool together)
+		{
+			const auto& cap = ctx.ims->Synth().GetCap();
+			std::vector<CompensationTable> tbls;
+			for (int chan = 0; chan < cap.channels; chan++) {
+				tbls.emplace_back(cap.LUTDepth - 2, cap.lowerFrequency, cap.upperFrequency,
+					CompensationPoint(Percent(80.0 - chan), Degrees(45.0 * chan), 1, 0.5));
+			}
+
+			m.Items(static_cast<double>(tbls.size() * tbls.front().Size()));
+			while (m.More()) {
+				Clock::duration total{};
+				bool ok = true;
+				if (together) {
+					CompensationTableDownload dl(ctx.ims, tbls);
+					ok = LUTDownloadOnce(dl, false, total);
+				}
+				else {
+					for (int chan = 0; ok && (chan < cap.channels); chan++) {
+						CompensationTableDownload dl(ctx.ims, tbls[chan], RFChannel(chan + 1));
+						Clock::duration elapsed;
+						ok = LUTDownloadOnce(dl, false, elapsed);
+						total += elapsed;
+					}
+				}
+				if (!ok) {
+					m.Skip("channel compensation table download failed");
+					break;
+				}
+				m.Sample(total);
+			}
+		}
+
+		// Closed loop correction: a few points nudged between each download
+		void LUTIncremental(Context& ctx, Measure& m, int points)
+		{
+			CompensationTable tbl(ctx.ims, CompensationPoint(Percent(80.0), Degrees(45.0), 1, 0.5));
+			CompensationTableDownload dl(ctx.ims, tbl);
+			Clock::duration elapsed;
+			if (!LUTDownloadOnce(dl, false, elapsed)) {
+				m.Skip("compensation table download failed");
+				return;
+			}
+
+			const int stride = static_cast<int>(tbl.Size()) / points;
+			double ampl = 80.0;
+			m.Items(static_cast<double>(points));
+			while (m.More()) {
+				ampl = (ampl < 90.0) ? ampl + 0.5 : 70.0;
+				for (int i = 0; i < points; i++) tbl[i * stride].Amplitude(Percent(ampl));
+
+				if (!LUTDownloadOnce(dl, true, elapsed)) {
+					m.Skip("incremental compensation table download failed");
+					break;
+				}
+				m.Sample(elapsed);
+			}
+		}
+
+		// Downloads a ToneBuffer, in full or only the entries changed since the last download
+		bool TBDownloadOnce(ToneBufferDownload& dl, bool incremental, Clock::duration& elapsed)
+		{
+			DownloadWaiter waiter(ToneBufferEvents::DOWNLOAD_FINISHED, ToneBufferEvents::DOWNLOAD_ERROR);
+			dl.ToneBufferDownloadEventSubscribe(ToneBufferEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.ToneBufferDownloadEventSubscribe(ToneBufferEvents::DOWNLOAD_ERROR, &waiter);
+
+			const auto t0 = Clock::now();
+			const bool ok = (incremental ? dl.StartIncrementalDownload() : dl.StartDownload()) && waiter.Wait();
+			elapsed = Clock::now() - t0;
+
+			dl.ToneBufferDownloadEventUnsubscribe(ToneBufferEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.ToneBufferDownloadEventUnsubscribe(ToneBufferEvents::DOWNLOAD_ERROR, &waiter);
+			return ok;
+		}
+
+		// 'entries' tones retuned between each download, or the whole buffer if zero
+		void TB(Context& ctx, Measure& m, int entries)
+		{
+			ToneBuffer tb(TBEntry(FAP(100.0, 80.0, 0.0), FAP(100.0, 80.0, 90.0), FAP(100.0, 80.0, 180.0), FAP(100.0, 80.0, 270.0)));
+			ToneBufferDownload dl(ctx.ims, tb);
+			Clock::duration elapsed;
+			if (entries && !TBDownloadOnce(dl, false, elapsed)) {
+				m.Skip("tone buffer download failed");
+				return;
+			}
+
+			const int stride = entries ? static_cast<int>(tb.Size()) / entries : 1;
+			double freq = 100.0;
+			m.Items(static_cast<double>(entries ? entries : tb.Size()));
+			while (m.More()) {
+				freq = (freq < 120.0) ? freq + 0.5 : 80.0;
+				for (int i = 0; i < entries; i++) tb[i * stride] = TBEntry(FAP(freq, 80.0, 0.0), FAP(freq, 80.0, 90.0), FAP(freq, 80.0, 180.0), FAP(freq, 80.0, 270.0));
+
+				if (!TBDownloadOnce(dl, entries != 0, elapsed)) {
+					m.Skip("tone buffer download failed");
+					break;
+				}
+				m.Sample(elapsed);
+			}
+		}
+
+		// Host stepped LTB index, one register round trip pair at a time
+		void LTBIndex(Context& ctx, Measure& m)
+		{
+			SignalPath sp(ctx.ims);
+			if (!sp.UpdateLocalToneBuffer(SignalPath::ToneBufferControl::HOST, 0)) {
+				m.Skip("tone buffer control update failed");
+				return;
+			}
+
+			unsigned int index = 0;
+			m.Items(1);
+			while (m.More()) {
+				index = (index + 1) & 0xFF;
+				const auto t0 = Clock::now();
+				if (!sp.UpdateLocalToneBuffer(index)) {
+					m.Skip("tone buffer index update failed");
+					break;
+				}
+				m.Sample(Clock::now() - t0);
+			}
+		}
+
+		// The same steps streamed back to back, timed until every update is acknowledged
+		void LTBIndexStream(Context& ctx, Measure& m, std::size_t count)
+		{
+			SignalPath sp(ctx.ims);
+			if (!sp.UpdateLocalToneBuffer(SignalPath::ToneBufferControl::HOST, 0)) {
+				m.Skip("tone buffer control update failed");
+				return;
+			}
+
+			std::vector<unsigned int> indices(count);
+			for (std::size_t i = 0; i < count; i++) indices[i] = static_cast<unsigned int>((i + 1) & 0xFF);
+
+			ToneIndexStream stream(ctx.ims);
+			DownloadWaiter waiter(ToneIndexStreamEvents::STREAM_IDLE, ToneIndexStreamEvents::WRITE_ERROR);
+			stream.ToneIndexStreamEventSubscribe(ToneIndexStreamEvents::STREAM_IDLE, &waiter);
+			stream.ToneIndexStreamEventSubscribe(ToneIndexStreamEvents::WRITE_ERROR, &waiter);
+
+			m.Items(static_cast<double>(count));
+			while (m.More()) {
+				waiter.Reset();
+				const auto t0 = Clock::now();
+				if (!stream.Push(indices, std::chrono::microseconds(0)) || !waiter.Wait()) {
+					m.Skip("tone index stream failed");
+					break;
+				}
+				m.Sample(Clock::now() - t0);
+			}
+
+			stream.ToneIndexStreamEventUnsubscribe(ToneIndexStreamEvents::STREAM_IDLE, &waiter);
+			stream.ToneIndexStreamEventUnsubscribe(ToneIndexStreamEvents::WRITE_ERROR, &waiter);
+		}
+
+		// Switching to a job of four Images, either downloading them on demand or with the cache having prefetched them while
+		// the previous job played
+		void CacheJobSwitch(Context& ctx, Measure& m, bool prefetch)
+		{
+			std::vector<Image> imgs;
+			for (int i = 0; i < 4; i++) imgs.push_back(DownloadImage(4096 + i));
+
+			ImageSequence job;
+			for (const auto& img : imgs) job.push_back(std::make_shared<ImageSequenceEntry>(img));
+
+			ImageCache cache(ctx.ims);
+			for (const auto& img : imgs) cache.Add(img);
+			DownloadWaiter waiter(ImageCacheEvents::PREFETCH_IDLE, -1);
+			cache.ImageCacheEventSubscribe(ImageCacheEvents::PREFETCH_IDLE, &waiter);
+
+			m.Items(static_cast<double>(imgs.size()));
+			while (m.More()) {
+				ClearImageTable(ctx.ims);
+				if (prefetch) {
+					waiter.Reset();
+					cache.Prefetch(job);
+					if (!waiter.Wait()) {
+						m.Skip("prefetch timed out");
+						break;
+					}
+				}
+
+				const auto t0 = Clock::now();
+				const bool ok = cache.Require(job);
+				const auto elapsed = Clock::now() - t0;
+				if (!ok) {
+					m.Skip("image cache load failed");
+					break;
+				}
+				m.Sample(elapsed);
+				cache.Unpin(job);
+			}
+
+			cache.ImageCacheEventUnsubscribe(ImageCacheEvents::PREFETCH_IDLE, &waiter);
+			ClearImageTable(ctx.ims);
+		}
+
+		void Sequences(Context& ctx, Measure& m, std::size_t entries)
+		{
+			// Sequence entries refer to an Image that is already present in Controller memory
+			const Image img = DownloadImage(1024);
+			ClearImageTable(ctx.ims);
+			Clock::duration unused;
+			if (ImageDownloadOnce(ctx.ims, img, unused) < 0) {
+				m.Skip("image download failed");
+				return;
+			}
+
+			ImageSequence seq;
+			for (std::size_t i = 0; i < entries; i++) {
+				seq.push_back(std::make_shared<ImageSequenceEntry>(img));
+			}
+
+			SequenceManager sm(ctx.ims);
+			sm.QueueClear();
+
+			m.Items(static_cast<double>(entries));
+			while (m.More()) {
+				SequenceDownload dl(ctx.ims, seq);
+				DownloadWaiter waiter(DownloadEvents::DOWNLOAD_FINISHED, DownloadEvents::DOWNLOAD_ERROR);
+				dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+				dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+
+				const auto t0 = Clock::now();
+				const bool ok = dl.StartDownload() && waiter.Wait();
+				const auto elapsed = Clock::now() - t0;
+
+				dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+				dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+				if (!ok) {
+					m.Skip("sequence download failed");
+					break;
+				}
+				m.Bytes(static_cast<double>(waiter.Param()));
+				m.Sample(elapsed);
+				sm.QueueClear();
+			}
+			ClearImageTable(ctx.ims);
+		}
+
+		void SequenceRedownload(Context& ctx, Measure& m, std::size_t entries, std::size_t appended, bool reuse)
+		{
+			const Image img = DownloadImage(1024);
+			ClearImageTable(ctx.ims);
+			Clock::duration unused;
+			if (ImageDownloadOnce(ctx.ims, img, unused) < 0) {
+				m.Skip("image download failed");
+				return;
+			}
+
+			ImageSequence seq;
+			for (std::size_t i = 0; i < entries; i++) {
+				seq.push_back(std::make_shared<ImageSequenceEntry>(img));
+			}
+
+			SequenceManager sm(ctx.ims);
+			sm.QueueClear();
+
+			// The first download formats every entry; each sample then appends a few entries and downloads the
+			// sequence again, either reusing the earlier format or formatting in full for comparison.  Both
+			// transfer the whole sequence
+			SequenceDownload dl(ctx.ims, seq);
+			if (!dl.Download()) {
+				m.Skip("sequence download failed");
+				return;
+			}
+			sm.QueueClear();
+
+			DownloadWaiter waiter(DownloadEvents::DOWNLOAD_FINISHED, DownloadEvents::DOWNLOAD_ERROR);
+			dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+
+			m.Items(static_cast<double>(appended));
+			while (m.More()) {
+				for (std::size_t i = 0; i < appended; i++) {
+					seq.push_back(std::make_shared<ImageSequenceEntry>(img));
+				}
+				waiter.Reset();
+
+				const auto t0 = Clock::now();
+				const bool ok = (reuse ? dl.Redownload(true) : dl.StartDownload()) && waiter.Wait();
+				const auto elapsed = Clock::now() - t0;
+
+				if (!ok) {
+					m.Skip("sequence download failed");
+					break;
+				}
+				m.Bytes(static_cast<double>(waiter.Param()));
+				m.Sample(elapsed);
+				sm.QueueClear();
+			}
+
+			dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+			ClearImageTable(ctx.ims);
+		}
+
+	}
+
+	void RegisterDownloadBenchmarks(Registry& reg)
+	{
+		reg.AddDevice("download/ImageDownload/1k_points", [](Context& ctx, Measure& m) { Images(ctx, m, 1024); });
+		reg.AddDevice("download/ImageDownload/64k_points", [](Context& ctx, Measure& m) { Images(ctx, m, 65536); });
+		reg.AddDevice("download/ImageDownload/32_images_1k_points_each", [](Context& ctx, Measure& m) { Group(ctx, m, 32, 1024, false); });
+		reg.AddDevice("download/ImageGroupDownload/32_images_1k_points_each", [](Context& ctx, Measure& m) { Group(ctx, m, 32, 1024, true); });
+		reg.AddDevice("download/ImageDownload/verify_compare_64k_points", [](Context& ctx, Measure& m) { ImageVerify(ctx, m, 65536, ImageDownload::VerifyMode::COMPARE); });
+		reg.AddDevice("download/ImageDownload/verify_digest_64k_points", [](Context& ctx, Measure& m) { ImageVerify(ctx, m, 65536, ImageDownload::VerifyMode::DIGEST); });
+		reg.AddDevice("download/CompensationTableDownload/full_table", [](Context& ctx, Measure& m) { LUT(ctx, m); });
+		reg.AddDevice("download/CompensationTableDownload/incremental_4_points", [](Context& ctx, Measure& m) { LUTIncremental(ctx, m, 4); });
+		reg.AddDevice("download/CompensationTableDownload/per_channel", [](Context& ctx, Measure& m) { LUTChannels(ctx, m, false); });
+		reg.AddDevice("download/CompensationTableDownload/all_channels", [](Context& ctx, Measure& m) { LUTChannels(ctx, m, true); });
+		reg.AddDevice("download/ToneBufferDownload/full_buffer", [](Context& ctx, Measure& m) { TB(ctx, m, 0); });
+		reg.AddDevice("download/ToneBufferDownload/incremental_4_entries", [](Context& ctx, Measure& m) { TB(ctx, m, 4); });
+		reg.AddDevice("download/SignalPath/UpdateLocalToneBuffer_index", [](Context& ctx, Measure& m) { LTBIndex(ctx, m); });
+		reg.AddDevice("download/ToneIndexStream/256_indices", [](Context& ctx, Measure& m) { LTBIndexStream(ctx, m, 256); });
+		reg.AddDevice("download/ImageCache/job_switch_on_demand", [](Context& ctx, Measure& m) { CacheJobSwitch(ctx, m, false); });
+		reg.AddDevice("download/ImageCache/job_switch_prefetched", [](Context& ctx, Measure& m) { CacheJobSwitch(ctx, m, true); });
+		reg.AddDevice("download/SequenceDownload/16_entries", [](Context& ctx, Measure& m) { Sequences(ctx, m, 16); });
+		reg.AddDevice("download/SequenceDownload/1024_entries", [](Context& ctx, Measure& m) { Sequences(ctx, m, 1024); });
+		reg.AddDevice("download/SequenceDownload/16k_entries", [](Context& ctx, Measure& m) { Sequences(ctx, m, 16384); });
+		reg.AddDevice("download/SequenceDownload/append_4_to_16k_download", [](Context& ctx, Measure& m) { SequenceRedownload(ctx, m, 16384, 4, false); });
+		reg.AddDevice("download/SequenceDownload/append_4_to_16k_redownload", [](Context& ctx, Measure& m) { SequenceRedownload(ctx, m, 16384, 4, true); });
+	}
+
+}
+}
@@ -0,0 +1,188 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Image Formatting Benchmarks
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/bench_image.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: FormatImage, FormatSequenceBuffer and the Frequency / Amplitude /
+/              Phase renderers.  All depend on the capabilities of the attached
+/              Synthesiser so require a connected system.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+
+#include "Image.h"
+#include "Image_p.h"
+#include "IMSSystem.h"
+#include "IMSTypeDefs_p.h"
+
+#include <vector>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		const std::size_t IMAGE_POINTS = 16384;
+		const std::size_t RENDER_VALUES = 4096;
+
+		Image TestImage(std::size_t npts)
+		{
+			Image img("bench");
+			for (std::size_t i = 0; i < npts; i++) {
+				const double f = 50.0 + 100.0 * static_cast<double>(i) / npts;
+				const double a = 100.0 * static_cast<double>(i % 101) / 100.0;
+				const double p = 360.0 * static_cast<double>(i % 97) / 97.0;
+				img.AddPoint(ImagePoint(FAP(f, a, p), FAP(f + 1.0, a, p), FAP(f + 2.0, a, p), FAP(f + 3.0, a, p), 0.5f, 0.25f, static_cast<unsigned int>(i & 0xFFF)));
+			}
+			return img;
+		}
+
+		void Format(Context& ctx, Measure& m, const ImageFormat& fmt, int msbFirst)
+		{
+			const Image img = TestImage(IMAGE_POINTS);
+			boost::container::deque<std::uint8_t> data;
+			FormatImage(img, ctx.ims, data, fmt, msbFirst);
+
+			m.Items(static_cast<double>(IMAGE_POINTS));
+			m.Bytes(static_cast<double>(data.size()));
+			m.Run([&] {
+				data.clear();
+				DoNotOptimize(FormatImage(img, ctx.ims, data, fmt, msbFirst));
+			});
+		}
+
+		void SequenceBuffer(Context& ctx, Measure& m, std::size_t entries)
+		{
+			const Image img = TestImage(64);
+			ImageSequence seq;
+			for (std::size_t i = 0; i < entries; i++) {
+				seq.push_back(std::make_shared<ImageSequenceEntry>(img, ImageRepeats::PROGRAM, static_cast<int>(i % 4)));
+			}
+			boost::container::deque<std::uint8_t> data;
+			if (!FormatSequenceBuffer(seq, ctx.ims, data)) {
+				m.Skip("sequence could not be formatted for this system");
+				return;
+			}
+
+			m.Items(static_cast<double>(entries));
+			m.Bytes(static_cast<double>(data.size()));
+			m.Run([&] {
+				DoNotOptimize(FormatSequenceBuffer(seq, ctx.ims, data));
+			});
+		}
+
+		void CompactSequenceBuffer(Context& ctx, Measure& m, std::size_t entries)
+		{
+			// The same four distinct entries as SequenceBuffer, played in the same order
+			const Image img = TestImage(64);
+			CompactSequence seq;
+			for (int i = 0; i < 4; i++) {
+				seq.AddEntry(std::make_shared<ImageSequenceEntry>(img, ImageRepeats::PROGRAM, i));
+			}
+			seq.reserve(entries);
+			for (std::size_t i = 0; i < entries; i++) seq.push_back(i % 4);
+
+			boost::container::deque<std::uint8_t> data;
+			if (!FormatSequenceBuffer(seq, ctx.ims, data)) {
+				m.Skip("sequence could not be formatted for this system");
+				return;
+			}
+
+			m.Items(static_cast<double>(entries));
+			m.Bytes(static_cast<double>(data.size()));
+			m.Run([&] {
+				DoNotOptimize(FormatSequenceBuffer(seq, ctx.ims, data));
+			});
+		}
+
+		template <typename T, typename Render>
+		void Renderer(Context& ctx, Measure& m, double lo, double hi, Render render)
+		{
+			std::vector<T> values;
+			values.reserve(RENDER_VALUES);
+			for (std::size_t i = 0; i < RENDER_VALUES; i++) {
+				values.push_back(T(lo + (hi - lo) * static_cast<double>(i) / RENDER_VALUES));
+			}
+
+			m.Items(static_cast<double>(RENDER_VALUES));
+			m.Run([&] {
+				unsigned int acc = 0;
+				for (const auto& v : values) acc += render(ctx.ims, v);
+				DoNotOptimize(acc);
+			});
+		}
+
+	}
+
+	void RegisterImageBenchmarks(Registry& reg)
+	{
+		reg.AddDevice("image/FormatImage/system_default", [](Context& ctx, Measure& m) {
+			Format(ctx, m, ImageFormat(ctx.ims), 1);
+		});
+		reg.AddDevice("image/FormatImage/lsb_first_legacy", [](Context& ctx, Measure& m) {
+			Format(ctx, m, ImageFormat(ctx.ims), 0);
+		});
+		reg.AddDevice("image/FormatImage/1ch_freq_only", [](Context& ctx, Measure& m) {
+			ImageFormat fmt(ctx.ims);
+			fmt.Channels(1);
+			fmt.EnableAmpl(false);
+			fmt.EnablePhase(false);
+			fmt.SyncAnlgChannels(0);
+			fmt.EnableSyncDig(false);
+			Format(ctx, m, fmt, 1);
+		});
+		reg.AddDevice("image/FormatImage/4ch_combined_sync", [](Context& ctx, Measure& m) {
+			ImageFormat fmt(ctx.ims);
+			fmt.Channels(4);
+			fmt.CombineAllChannels(true);
+			fmt.SyncAnlgChannels(2);
+			fmt.EnableSyncDig(true);
+			Format(ctx, m, fmt, 1);
+		});
+		reg.AddDevice("image/FormatSequenceBuffer/1024_entries", [](Context& ctx, Measure& m) {
+			SequenceBuffer(ctx, m, 1024);
+		});
+		reg.AddDevice("image/FormatSequenceBuffer/1M_entries", [](Context& ctx, Measure& m) {
+			SequenceBuffer(ctx, m, 1 << 20);
+		});
+		reg.AddDevice("image/FormatSequenceBuffer/compact_1M_entries", [](Context& ctx, Measure& m) {
+			CompactSequenceBuffer(ctx, m, 1 << 20);
+		});
+
+		reg.AddDevice("render/Frequency/ImagePoint", [](Context& ctx, Measure& m) {
+			Renderer<MHz>(ctx, m, 40.0, 160.0, [](std::shared_ptr<IMSSystem> ims, const MHz& v) { return FrequencyRenderer::RenderAsImagePoint(ims, v); });
+		});
+		reg.AddDevice("render/Frequency/DDSValue", [](Context& ctx, Measure& m) {
+			Renderer<MHz>(ctx, m, 40.0, 160.0, [](std::shared_ptr<IMSSystem> ims, const MHz& v) { return FrequencyRenderer::RenderAsDDSValue(ims, v); });
+		});
+		reg.AddDevice("render/Amplitude/ImagePoint", [](Context& ctx, Measure& m) {
+			Renderer<Percent>(ctx, m, 0.0, 100.0, [](std::shared_ptr<IMSSystem> ims, const Percent& v) { return AmplitudeRenderer::RenderAsImagePoint(ims, v); });
+		});
+		reg.AddDevice("render/Amplitude/CompensationPoint", [](Context& ctx, Measure& m) {
+			Renderer<Percent>(ctx, m, 0.0, 100.0, [](std::shared_ptr<IMSSystem> ims, const Percent& v) { return AmplitudeRenderer::RenderAsCompensationPoint(ims, v); });
+		});
+		reg.AddDevice("render/Phase/ImagePoint", [](Context& ctx, Measure& m) {
+			Renderer<Degrees>(ctx, m, 0.0, 360.0, [](std::shared_ptr<IMSSystem> ims, const Degrees& v) { return PhaseRenderer::RenderAsImagePoint(ims, v); });
+		});
+		reg.AddDevice("render/Phase/CompensationPoint", [](Context& ctx, Measure& m) {
+			Renderer<Degrees>(ctx, m, 0.0, 360.0, [](std::shared_ptr<IMSSystem> ims, const Degrees& v) { return PhaseRenderer::RenderAsCompensationPoint(ims, v); });
+		});
+	}
+
+}
+}
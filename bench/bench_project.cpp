@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Image Project Benchmarks
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/bench_project.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: ImageProject Save / Load of a large project in both the
+/              compressed (.iip) and uncompressed (.xml) file formats.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+
+#include "ImageProject.h"
+
+#include <filesystem>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		Image ProjectImage(std::size_t npts, int seed)
+		{
+			Image img("image " + std::to_string(seed));
+			for (std::size_t i = 0; i < npts; i++) {
+				const double f = 50.0 + 100.0 * static_cast<double>((i * 7 + seed) % npts) / npts;
+				img.AddPoint(ImagePoint(FAP(f, 80.0, static_cast<double>(i % 360)), FAP(f + 1.0, 70.0, 0.0), FAP(f + 2.0, 60.0, 0.0), FAP(f + 3.0, 50.0, 0.0)));
+			}
+			return img;
+		}
+
+		// A project of the size produced by a typical raster scanning application: 8 free images and
+		// 4 groups of 4 images (192k points in total), plus compensation functions and tone buffers
+		void BuildLargeProject(ImageProject& prj)
+		{
+			for (int i = 0; i < 8; i++) {
+				prj.FreeImageContainer().AddImage(ProjectImage(16384, i));
+			}
+			for (int g = 0; g < 4; g++) {
+				ImageGroup grp("group " + std::to_string(g));
+				for (int i = 0; i < 4; i++) grp.AddImage(ProjectImage(4096, g * 4 + i));
+				prj.ImageGroupContainer().push_back(grp);
+			}
+			for (int c = 0; c < 8; c++) {
+				CompensationFunction func;
+				for (int i = 0; i < 32; i++) {
+					func.push_back(CompensationPointSpecification(CompensationPoint(Percent(50.0 + i), Degrees(i * c)), MHz(50.0 + 3.0 * i)));
+				}
+				prj.CompensationFunctionContainer().push_back(func);
+			}
+			for (int t = 0; t < 4; t++) {
+				prj.ToneBufferContainer().push_back(ToneBuffer(TBEntry(FAP(50.0 + t, 75.0, 0.0)), "tones " + std::to_string(t)));
+			}
+		}
+
+		const std::size_t LARGE_PROJECT_POINTS = 8 * 16384 + 16 * 4096;
+
+		void Save(Context& ctx, Measure& m, const std::string& ext)
+		{
+			ImageProject prj;
+			BuildLargeProject(prj);
+			const std::string file = (std::filesystem::path(ctx.workDir) / ("bench_save" + ext)).string();
+
+			m.Items(static_cast<double>(LARGE_PROJECT_POINTS));
+			bool ok = true;
+			m.Run([&] { ok &= prj.Save(file); });
+			if (!ok) {
+				m.Skip("ImageProject::Save failed");
+				return;
+			}
+			m.Bytes(static_cast<double>(std::filesystem::file_size(file)));
+			std::filesystem::remove(file);
+		}
+
+		void Load(Context& ctx, Measure& m, const std::string& ext)
+		{
+			const std::string file = (std::filesystem::path(ctx.workDir) / ("bench_load" + ext)).string();
+			ImageProject prj;
+			BuildLargeProject(prj);
+			if (!prj.Save(file)) {
+				m.Skip("ImageProject::Save failed");
+				return;
+			}
+
+			prj.Clear();
+			m.Items(static_cast<double>(LARGE_PROJECT_POINTS));
+			m.Bytes(static_cast<double>(std::filesystem::file_size(file)));
+			bool ok = true;
+			m.Run([&] { ok &= prj.Load(file); });
+			std::filesystem::remove(file);
+			if (!ok) m.Skip("ImageProject::Load failed");
+		}
+
+	}
+
+	void RegisterProjectBenchmarks(Registry& reg)
+	{
+		reg.Add("project/Save/iip", [](Context& ctx, Measure& m) { Save(ctx, m, ".iip"); });
+		reg.Add("project/Load/iip", [](Context& ctx, Measure& m) { Load(ctx, m, ".iip"); });
+		reg.Add("project/Save/xml", [](Context& ctx, Measure& m) { Save(ctx, m, ".xml"); });
+		reg.Add("project/Load/xml", [](Context& ctx, Measure& m) { Load(ctx, m, ".xml"); });
+	}
+
+}
+}
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Report Protocol Benchmarks
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/bench_protocol.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: CRCGenerator, ReportSerializer and ReportParser, the per message
+/              costs paid by every transfer to and from an iMS system.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+#include "SimDevice.h"
+
+#include "DeviceReport.h"
+#include "HostReport.h"
+#include "ReportManipulation.h"
+
+#include <queue>
+#include <vector>
+
+namespace iMS {
+namespace bench {
+
+	namespace {
+
+		std::vector<std::uint8_t> TestPayload(std::size_t len)
+		{
+			std::vector<std::uint8_t> p(len);
+			for (std::size_t i = 0; i < len; i++) p[i] = static_cast<std::uint8_t>(i * 37 + 11);
+			return p;
+		}
+
+		void CRC(Measure& m, std::size_t len)
+		{
+			std::queue<std::uint8_t> data;
+			for (auto b : TestPayload(len)) data.push(b);
+
+			// The generator consumes its input queue, so each call works on a copy, as ReportSerializer does
+			m.Items(1);
+			m.Bytes(static_cast<double>(len));
+			m.Run([&] {
+				std::queue<std::uint8_t> q(data);
+				CRCGenerator gen(q);
+				DoNotOptimize(gen.CRC());
+			});
+		}
+
+		void Serialize(Measure& m, std::size_t len)
+		{
+			HostReport rpt(HostReport::Actions::CTRLR_IMAGE, HostReport::Dir::WRITE, 0);
+			rpt.Payload<std::vector<std::uint8_t>>(TestPayload(len));
+
+			ReportSerializer ser;
+			ser.Serialize(&rpt);
+			m.Items(1);
+			m.Bytes(static_cast<double>(ser.Stream().size()));
+			m.Run([&] {
+				ser.Serialize(&rpt);
+				DoNotOptimize(ser.Stream().data());
+			});
+		}
+
+		void Parse(Measure& m, std::size_t len)
+		{
+			// Controller response carrying 'len' bytes of read data
+			const std::vector<std::uint8_t> frame = sim::SimDevice::EncodeReport(
+				static_cast<std::uint8_t>(ReportTypes::DEVICE_REPORT_ID_CTRLR), 0x40, 0, 0, TestPayload(len));
+
+			ReportParser parser;
+			DeviceReport rpt;
+			for (auto c : frame) parser.Parse(&rpt, c);
+			if (parser.ParserState() != ReportParserState::COMPLETE) {
+				m.Skip("reference frame did not parse");
+				return;
+			}
+
+			m.Items(1);
+			m.Bytes(static_cast<double>(frame.size()));
+			m.Run([&] {
+				parser.ResetParser();
+				for (auto c : frame) parser.Parse(&rpt, c);
+				DoNotOptimize(parser.ParserState());
+			});
+		}
+
+	}
+
+	void RegisterProtocolBenchmarks(Registry& reg)
+	{
+		reg.Add("protocol/CRCGenerator/8B", [](Context&, Measure& m) { CRC(m, 8); });
+		reg.Add("protocol/CRCGenerator/73B", [](Context&, Measure& m) { CRC(m, IOReport::PAYLOAD_MAX_LENGTH + IOReport::OVERHEAD_MAX_LENGTH); });
+		reg.Add("protocol/ReportSerializer/0B", [](Context&, Measure& m) { Serialize(m, 0); });
+		reg.Add("protocol/ReportSerializer/64B", [](Context&, Measure& m) { Serialize(m, IOReport::PAYLOAD_MAX_LENGTH); });
+		reg.Add("protocol/ReportParser/0B", [](Context&, Measure& m) { Parse(m, 0); });
+		reg.Add("protocol/ReportParser/64B", [](Context&, Measure& m) { Parse(m, IOReport::PAYLOAD_MAX_LENGTH); });
+	}
+
+}
+}
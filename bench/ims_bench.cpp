@@ -0,0 +1,242 @@
+/*-----------------------------------------------------------------------------
+/ Title      : iMS Library Benchmark Suite
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/ims_bench.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 604 $
+/------------------------------------------------------------------------------
+/ Description: Runs the library hot path microbenchmarks and the end-to-end
+/              download benchmarks.  By default an in-process device simulator
+/              is started and connected to over Ethernet; --hardware uses the
+/              first iMS system found by a normal scan instead.  Results are
+/              printed as a table and optionally written as JSON for tracking
+/              between releases.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "BenchHarness.h"
+#include "SimDevice.h"
+#include "SimServer.h"
+
+#include "ConnectionList.h"
+#include "IMSSystem.h"
+#include "LibVersion.h"
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+using namespace iMS;
+using namespace iMS::bench;
+
+namespace {
+
+	struct Options
+	{
+		std::string filter;
+		std::string jsonFile;
+		std::string workDir;
+		long minTimeMs{ 1000 };
+		bool list{ false };
+		bool hardware{ false };
+		bool noDevice{ false };
+		std::uint32_t latencyUs{ 0 };
+		std::uint32_t jitterUs{ 0 };
+	};
+
+	void Usage()
+	{
+		std::cout <<
+			"Usage: ims_bench [options]\n"
+			"  --filter <str>       only run benchmarks whose name contains <str>\n"
+			"  --json <file>        write results to <file> as JSON\n"
+			"  --min-time-ms <ms>   minimum time spent in each benchmark (default 1000)\n"
+			"  --list               list benchmark names and exit\n"
+			"  --hardware           benchmark the first iMS system found by a scan instead of the simulator\n"
+			"  --no-device          run only the benchmarks that do not need an iMS system\n"
+			"  --latency-us <us>    simulator one way response latency (default 0)\n"
+			"  --jitter-us <us>     simulator latency jitter (default 0)\n"
+			"  --work-dir <dir>     directory for temporary files (default system temp directory)\n";
+	}
+
+	std::string Timestamp()
+	{
+		const std::time_t now = std::time(nullptr);
+		char buf[32];
+		std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+		return buf;
+	}
+
+	std::shared_ptr<IMSSystem> FindSystem(bool ethernetOnly)
+	{
+		ConnectionList connList(500);
+		if (ethernetOnly) {
+			for (const auto& module : connList.Modules()) {
+				connList.Config(module).IncludeInScan = (module == "CM_ETH");
+			}
+		}
+		auto systems = connList.Scan();
+		if (systems.empty()) return nullptr;
+
+		auto ims = systems.front();
+		ims->Connect();
+		return ims->Open() ? ims : nullptr;
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	Options opt;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg == "--help" || arg == "-h") {
+			Usage();
+			return 0;
+		}
+		if (arg == "--list") { opt.list = true; continue; }
+		if (arg == "--hardware") { opt.hardware = true; continue; }
+		if (arg == "--no-device") { opt.noDevice = true; continue; }
+		if (i + 1 >= argc) {
+			std::cerr << "ims_bench: missing value for " << arg << std::endl;
+			return 1;
+		}
+		const std::string val = argv[++i];
+		try {
+			if (arg == "--filter") opt.filter = val;
+			else if (arg == "--json") opt.jsonFile = val;
+			else if (arg == "--work-dir") opt.workDir = val;
+			else if (arg == "--min-time-ms") opt.minTimeMs = std::stol(val);
+			else if (arg == "--latency-us") opt.latencyUs = static_cast<std::uint32_t>(std::stoul(val));
+			else if (arg == "--jitter-us") opt.jitterUs = static_cast<std::uint32_t>(std::stoul(val));
+			else {
+				std::cerr << "ims_bench: unknown option " << arg << std::endl;
+				Usage();
+				return 1;
+			}
+		}
+		catch (const std::exception&) {
+			std::cerr << "ims_bench: bad value for " << arg << ": " << val << std::endl;
+			return 1;
+		}
+	}
+
+	Registry reg;
+	RegisterProtocolBenchmarks(reg);
+	RegisterImageBenchmarks(reg);
+	RegisterCompensationBenchmarks(reg);
+	RegisterProjectBenchmarks(reg);
+	RegisterDownloadBenchmarks(reg);
+
+	std::vector<const Case*> selected;
+	bool needDevice = false;
+	for (const auto& c : reg.Cases()) {
+		if (!opt.filter.empty() && (c.name.find(opt.filter) == std::string::npos)) continue;
+		if (c.device && opt.noDevice) continue;
+		selected.push_back(&c);
+		needDevice |= c.device;
+	}
+
+	if (opt.list) {
+		for (const auto* c : selected) std::cout << c->name << (c->device ? "  [device]" : "") << std::endl;
+		return 0;
+	}
+
+	Context ctx;
+	ctx.workDir = opt.workDir.empty() ? std::filesystem::temp_directory_path().string() : opt.workDir;
+
+	RunInfo info;
+	info.library = LibVersion::GetVersion();
+	info.timestamp = Timestamp();
+	info.target = "none";
+	info.minTimeMs = opt.minTimeMs;
+
+	// The stand-in device.  CM_ENET does not discover systems on the loopback interface, so the
+	// simulator answers on the host's own network interfaces and must be able to bind TFTP port 69.
+	sim::SimConfig simCfg;
+	simCfg.latencyUs = opt.latencyUs;
+	simCfg.jitterUs = opt.jitterUs;
+	std::unique_ptr<sim::SimDevice> simDevice;
+	std::unique_ptr<sim::SimServer> simServer;
+	std::thread simThread;
+
+	if (needDevice) {
+		if (opt.hardware) {
+			ctx.ims = FindSystem(false);
+			info.target = "hardware";
+		}
+		else {
+			simDevice = std::make_unique<sim::SimDevice>(simCfg);
+			simServer = std::make_unique<sim::SimServer>(simCfg, *simDevice);
+			simThread = std::thread([&] {
+				if (!simServer->Run()) std::cerr << "ims_bench: simulator could not open its sockets" << std::endl;
+			});
+			ctx.ims = FindSystem(true);
+			info.target = "simulator";
+			info.latencyUs = opt.latencyUs;
+			info.jitterUs = opt.jitterUs;
+		}
+		if (ctx.ims) {
+			std::cout << "ims_bench: connected to " << ctx.ims->Ctlr().Model() << " / " << ctx.ims->Synth().Model()
+				<< " on " << ctx.ims->ConnPort() << std::endl;
+		}
+		else {
+			std::cout << "ims_bench: no iMS system found, device benchmarks will be skipped" << std::endl;
+		}
+	}
+
+	std::size_t nameWidth = 10;
+	for (const auto* c : selected) nameWidth = std::max(nameWidth, c->name.size());
+	WriteTableHeader(std::cout, nameWidth);
+
+	std::vector<Result> results;
+	for (const auto* c : selected) {
+		Measure m(std::chrono::milliseconds(opt.minTimeMs), 3);
+		if (c->device && !ctx.ims) {
+			m.Skip("no iMS system");
+		}
+		else {
+			try {
+				c->fn(ctx, m);
+			}
+			catch (const std::exception& e) {
+				m.Skip(std::string("exception: ") + e.what());
+			}
+		}
+		results.push_back(m.Summarise(c->name));
+		WriteTableRow(std::cout, nameWidth, results.back());
+	}
+
+	if (ctx.ims) ctx.ims->Disconnect();
+	ctx.ims.reset();
+	if (simServer) {
+		simServer->Stop();
+		simThread.join();
+	}
+
+	if (!opt.jsonFile.empty()) {
+		std::ofstream ofs(opt.jsonFile);
+		if (!ofs) {
+			std::cerr << "ims_bench: unable to write " << opt.jsonFile << std::endl;
+			return 1;
+		}
+		WriteJSON(ofs, info, results);
+	}
+	return 0;
+}
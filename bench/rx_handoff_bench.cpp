@@ -0,0 +1,211 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Receive Handoff Microbenchmark
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/bench/rx_handoff_bench.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 602 $
+/------------------------------------------------------------------------------
+/ Description: Compares the receiver -> parser character handoff used by the
+/              Connection Managers (SPSCByteRing + RxWakeup) with the previous
+/              mutex / condition variable / std::deque implementation.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "RxHandoff.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace iMS;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	// The handoff as implemented before the SPSC ring: receiver appends to a deque under a
+	// mutex and notifies; parser wakes, swaps the deque out and copies it into its own buffer.
+	class MutexHandoff
+	{
+	public:
+		void Push(const char* data, std::size_t len)
+		{
+			{
+				std::scoped_lock<std::mutex> lck{ m_mutex };
+				m_queue.insert(m_queue.end(), data, data + len);
+			}
+			m_cond.notify_one();
+		}
+
+		template <typename Done>
+		void Pull(std::deque<std::uint8_t>& out, Done done)
+		{
+			std::deque<char> localCopy;
+			{
+				std::unique_lock<std::mutex> lck{ m_mutex };
+				m_cond.wait_for(lck, std::chrono::milliseconds(10), [&] { return !m_queue.empty() || done(); });
+				if (!m_queue.empty()) std::swap(localCopy, m_queue);
+			}
+			out.insert(out.end(), std::make_move_iterator(localCopy.begin()), std::make_move_iterator(localCopy.end()));
+		}
+
+	private:
+		std::deque<char> m_queue;
+		std::mutex m_mutex;
+		std::condition_variable m_cond;
+	};
+
+	class RingHandoff
+	{
+	public:
+		void Push(const char* data, std::size_t len)
+		{
+			auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+			std::size_t written = m_ring.Write(bytes, len);
+			while (written < len) {
+				m_wake.Signal();
+				std::this_thread::yield();
+				written += m_ring.Write(bytes + written, len - written);
+			}
+			m_wake.Notify();
+		}
+
+		template <typename Done>
+		void Pull(std::deque<std::uint8_t>& out, Done done)
+		{
+			m_wake.WaitUntil(Clock::now() + std::chrono::milliseconds(250), [&] { return !m_ring.Empty() || done(); });
+			m_ring.Read(out);
+		}
+
+	private:
+		SPSCByteRing m_ring;
+		RxWakeup m_wake;
+	};
+
+	struct ThroughputResult { double mbps; };
+
+	template <typename Handoff>
+	ThroughputResult Throughput(std::size_t chunk, std::size_t total)
+	{
+		Handoff h;
+		std::atomic<bool> finished{ false };
+		std::size_t received = 0;
+
+		std::thread parser([&] {
+			std::deque<std::uint8_t> glblRx;
+			while (true) {
+				h.Pull(glblRx, [&] { return finished.load(); });
+				received += glblRx.size();
+				glblRx.clear();  // stands in for the report parser consuming the characters
+				if (received >= total) break;
+			}
+		});
+
+		std::vector<char> buf(chunk, 0x55);
+		auto t0 = Clock::now();
+		for (std::size_t sent = 0; sent < total; sent += chunk) {
+			h.Push(buf.data(), std::min(chunk, total - sent));
+		}
+		finished = true;
+		parser.join();
+		double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+		return { (double)total / (secs * 1024 * 1024) };
+	}
+
+	struct LatencyResult { double median_us; double p99_us; double max_us; };
+
+	// One-way latency from Push() to the parser seeing the bytes.  The producer pauses between
+	// messages so the parser is asleep each time, as it is for request / response traffic.
+	template <typename Handoff>
+	LatencyResult Latency(std::size_t chunk, int iterations)
+	{
+		Handoff h;
+		std::atomic<bool> finished{ false };
+		std::atomic<int> acked{ 0 };
+		std::vector<double> samples;
+		samples.reserve(iterations);
+
+		std::thread parser([&] {
+			std::deque<std::uint8_t> glblRx;
+			while (acked.load() < iterations) {
+				h.Pull(glblRx, [&] { return finished.load(); });
+				while (glblRx.size() >= chunk) {
+					auto now = Clock::now().time_since_epoch().count();
+					Clock::rep sent;
+					std::uint8_t raw[sizeof(sent)];
+					std::copy(glblRx.begin(), glblRx.begin() + sizeof(sent), raw);
+					std::memcpy(&sent, raw, sizeof(sent));
+					glblRx.erase(glblRx.begin(), glblRx.begin() + chunk);
+					samples.push_back(std::chrono::duration<double, std::micro>(Clock::duration(now - sent)).count());
+					acked++;
+				}
+			}
+		});
+
+		std::vector<char> buf(std::max(chunk, sizeof(Clock::rep)), 0);
+		for (int i = 0; i < iterations; i++) {
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			auto sent = Clock::now().time_since_epoch().count();
+			std::memcpy(buf.data(), &sent, sizeof(sent));
+			h.Push(buf.data(), chunk);
+			while (acked.load() <= i) std::this_thread::yield();
+		}
+		finished = true;
+		parser.join();
+
+		std::sort(samples.begin(), samples.end());
+		return { samples[samples.size() / 2], samples[(samples.size() * 99) / 100], samples.back() };
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t total = 256u * 1024 * 1024;
+	int iterations = 5000;
+	if (argc > 1) total = std::stoul(argv[1]) * 1024 * 1024;
+	if (argc > 2) iterations = std::stoi(argv[2]);
+
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "Receiver -> parser handoff, " << (total >> 20) << " MiB per throughput run, "
+		<< iterations << " latency samples" << std::endl << std::endl;
+
+	std::cout << std::left << std::setw(12) << "chunk" << std::setw(22) << "mutex+condvar MB/s" << "spsc+wakeup MB/s" << std::endl;
+	for (std::size_t chunk : { 16, 64, 512, 1460, 4096 }) {
+		auto a = Throughput<MutexHandoff>(chunk, total);
+		auto b = Throughput<RingHandoff>(chunk, total);
+		std::cout << std::setw(12) << chunk << std::setw(22) << a.mbps << b.mbps << std::endl;
+	}
+
+	std::cout << std::endl << std::setw(12) << "chunk" << std::setw(34) << "mutex+condvar us (p50/p99/max)" << "spsc+wakeup us (p50/p99/max)" << std::endl;
+	for (std::size_t chunk : { 16, 64, 512 }) {
+		auto a = Latency<MutexHandoff>(chunk, iterations);
+		auto b = Latency<RingHandoff>(chunk, iterations);
+		std::ostringstream sa, sb;
+		sa << std::fixed << std::setprecision(1) << a.median_us << " / " << a.p99_us << " / " << a.max_us;
+		sb << std::fixed << std::setprecision(1) << b.median_us << " / " << b.p99_us << " / " << b.max_us;
+		std::cout << std::setw(12) << chunk << std::setw(34) << sa.str() << sb.str() << std::endl;
+	}
+	return 0;
+}
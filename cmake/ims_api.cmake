@@ -5,6 +5,7 @@ set(ims_api_source_files
     ${api_source_dir}/Auxiliary.cpp
     ${api_source_dir}/Compensation.cpp
     ${api_source_dir}/CM_Common.cpp
+    ${api_source_dir}/RxHandoff.cpp
     ${api_source_dir}/CM_CYUSB.cpp
     ${api_source_dir}/CM_ENET.cpp
     ${api_source_dir}/tftp_client.cpp
@@ -19,6 +20,7 @@ set(ims_api_source_files
     ${api_source_dir}/Diagnostics.cpp
     ${api_source_dir}/IEventHandler.cpp
     ${api_source_dir}/IEventTrigger.cpp
+    ${api_source_dir}/EventDispatcher.cpp
     ${api_source_dir}/FileSystem.cpp
     ${api_source_dir}/Image.cpp
     ${api_source_dir}/ImageOps.cpp
@@ -35,6 +37,7 @@ set(ims_api_source_files
     ${api_source_dir}/LibVersion.cpp
     ${api_source_dir}/PrivateUtil.cpp
     ${api_source_dir}/FirmwareUpgrade.cpp
+    ${api_source_dir}/HardwareCatalog.cpp
     ${api_source_dir}/SignalPath.cpp
     ${api_source_dir}/WaveShaping.cpp
     ${api_source_dir}/SystemFunc.cpp
@@ -28,6 +28,7 @@ set(ims_public_api_header_files
 
 set(ims_private_api_header_files
     ${api_include_dir}/CM_Common.h
+    ${api_include_dir}/RxHandoff.h
     ${api_include_dir}/CM_CYUSB.h
     ${api_include_dir}/CM_ENET.h
     ${api_include_dir}/tftp_client.h
@@ -36,7 +37,11 @@ set(ims_private_api_header_files
     ${api_include_dir}/CM_RS422.h
     ${api_include_dir}/IConnectionManager.h
     ${api_include_dir}/IEventTrigger.h
+    ${api_include_dir}/EventDispatcher.h
     ${api_include_dir}/MessageEvent.h
+    ${api_include_dir}/MessageRegistry.h
+    ${api_include_dir}/DeadlineQueue.h
+    ${api_include_dir}/Compensation_p.h
     ${api_include_dir}/FileSystem_p.h
     ${api_include_dir}/Image_p.h
     ${api_include_dir}/DeviceReport.h
@@ -47,6 +52,7 @@ set(ims_private_api_header_files
     ${api_include_dir}/BulkVerifier.h
     ${api_include_dir}/EEPROM.h
     ${api_include_dir}/IMSConstants.h
+    ${api_include_dir}/HardwareCatalog.h
     ${api_include_dir}/PrivateUtil.h
     ${api_lib_dir}/sqlite3/sqlite3.h
 )
@@ -0,0 +1,34 @@
+# Copyright 2026 Isomet (UK) Ltd. All rights reserved.
+
+set(api_bench_dir ${CMAKE_CURRENT_SOURCE_DIR}/bench)
+
+find_package(Threads REQUIRED)
+
+# Receiver -> parser character handoff (standalone, does not link the library)
+add_executable(ims_rx_handoff_bench
+    ${api_bench_dir}/rx_handoff_bench.cpp
+    ${api_source_dir}/RxHandoff.cpp
+)
+target_include_directories(ims_rx_handoff_bench PRIVATE ${api_include_dir})
+target_link_libraries(ims_rx_handoff_bench PRIVATE Threads::Threads)
+
+# Library hot path and end-to-end download benchmarks.  The end-to-end cases run against the
+# device simulator, and several microbenchmarks call library internals that are not exported
+# from the Windows DLL, so this target is only built on Linux / macOS.
+if (NOT WIN32)
+    set(api_sim_dir ${CMAKE_CURRENT_SOURCE_DIR}/sim)
+
+    add_executable(ims_bench
+        ${api_bench_dir}/ims_bench.cpp
+        ${api_bench_dir}/BenchHarness.cpp
+        ${api_bench_dir}/bench_protocol.cpp
+        ${api_bench_dir}/bench_image.cpp
+        ${api_bench_dir}/bench_compensation.cpp
+        ${api_bench_dir}/bench_project.cpp
+        ${api_bench_dir}/bench_download.cpp
+        ${api_sim_dir}/SimDevice.cpp
+        ${api_sim_dir}/SimServer.cpp
+    )
+    target_include_directories(ims_bench PRIVATE ${api_include_dir} ${api_sim_dir} ${api_bench_dir} ${Boost_INCLUDE_DIRS})
+    target_link_libraries(ims_bench PRIVATE ${IMS_TARGET_NAME} Threads::Threads)
+endif()
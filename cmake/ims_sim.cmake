@@ -0,0 +1,14 @@
+# Copyright 2026 Isomet (UK) Ltd. All rights reserved.
+
+set(api_sim_dir ${CMAKE_CURRENT_SOURCE_DIR}/sim)
+
+find_package(Threads REQUIRED)
+
+# Simulated Ethernet iMS system (POSIX sockets only)
+add_executable(ims_sim
+    ${api_sim_dir}/ims_sim.cpp
+    ${api_sim_dir}/SimDevice.cpp
+    ${api_sim_dir}/SimServer.cpp
+)
+target_include_directories(ims_sim PRIVATE ${api_include_dir} ${api_sim_dir})
+target_link_libraries(ims_sim PRIVATE Threads::Threads)
@@ -47,6 +47,7 @@
 #include "IMSTypeDefs.h"
 #include "Compensation.h"
 #include <string>
+#include <vector>
 
 /// \cond LIB_CREATION
 #if defined _WIN32 || defined __CYGWIN__
@@ -248,6 +249,15 @@ namespace iMS
 		/// \brief Returns a Compensation Function for the device at any operating wavelength
 		/// \param[in] wavelength The desired optical wavelength 
 		CompensationFunction GetCompensationFunction(micrometre wavelength);
+		/// \brief Returns Compensation Functions for the device at each of a list of operating wavelengths
+		///
+		/// Equivalent to calling GetCompensationFunction() for each wavelength in turn, but functions that
+		/// have not been generated before are calculated in parallel.  Generated functions are cached, so
+		/// switching between a fixed set of lasers costs no recalculation after the first time.
+		/// \param[in] wavelengths The desired optical wavelengths
+		/// \return One Compensation Function per wavelength, in the same order
+		/// \since 2.1
+		std::vector<CompensationFunction> GetCompensationFunctions(const std::vector<micrometre>& wavelengths);
 		//@}
 	private:
 		class Impl;
@@ -29,6 +29,8 @@
 #include "Message.h"
 
 namespace iMS {
+	class HostReport;
+
 	class BulkVerifierEvents
 	{
 	public:
@@ -61,6 +63,9 @@ namespace iMS {
 		~BulkVerifier();
 
 		void AddChunk(const std::shared_ptr<VerifyChunk>);
+		// Sends a readback request and adds the chunk of data it should return.  No response is
+		// processed until the chunk has been added, however quickly the device answers.
+		MessageHandle SendChunk(const HostReport& rpt, const std::vector<std::uint8_t>& data, int addr);
 		void WaitUntilBufferClear();
 		void Finalize();
 		void VerifyReset();
@@ -27,6 +27,7 @@
 #include "IConnectionManager.h"
 #include "MessageRegistry.h"
 #include "PrivateUtil.h"  // for logging
+#include "RxHandoff.h"
 
 #include <list>
 #include <mutex>
@@ -65,8 +66,10 @@ namespace iMS {
 		void MessageEventUnsubscribe(const int message, const IEventHandler* handler);
 		bool MemoryDownload(boost::container::deque<std::uint8_t>& arr, std::uint32_t start_addr, int image_index, const std::array<std::uint8_t, 16>& uuid);
 		bool MemoryUpload(boost::container::deque<std::uint8_t>& arr, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid);
+		bool MemoryUpload(MemorySink sink, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid);
         void MemoryTransfer();
 		int MemoryProgress();
+		int MemoryTransferGranularity() const;
 
 		// Send an I/O Report
 		virtual MessageHandle SendMsg(HostReport const& Rpt);
@@ -75,6 +78,8 @@ namespace iMS {
 		const DeviceReport Response(const MessageHandle) const;
 		const bool& Open() const;
 
+		void SetEventDispatchThreads(int threads);
+
 	protected:
         struct DefaultPolicy {
             DefaultPolicy(uint32_t _addr, int _index) : addr(_addr), index(_index) {}
@@ -92,16 +97,32 @@ namespace iMS {
 		template <typename Policy = DefaultPolicy> 
         class FastTransfer {
         public:
+            // An upload given a sink hands its data to the sink and leaves 'data' alone
             FastTransfer(boost::container::deque<uint8_t>& data, int len,
-                        const Policy& policy = Policy{})
-                : m_data(data), m_len(len), m_policy(policy),
+                        const Policy& policy = Policy{}, MemorySink sink = nullptr)
+                : m_data(sink ? m_scratch : data), m_len(len), m_policy(policy),
                 m_transCount(((m_len - 1) / Policy::TRANSFER_UNIT) + 1) 
             {
+                m_sink = std::move(sink);
                 m_data_it = m_data.cbegin();
                 m_currentTrans = 0;
                 startNextTransaction();
             }
 
+            // Hands a block of uploaded data on: appended to m_data, or passed to m_sink if one was given.
+            // Once the sink has declined a block the upload is abandoned and nothing more is delivered.
+            bool deliver(const uint8_t* data, std::size_t len) {
+                if (m_abandoned) return false;
+                m_delivered += len;
+                if (!m_sink) {
+                    m_data.insert(m_data.end(), data, data + len);
+                }
+                else if (!m_sink(data, len)) {
+                    m_abandoned = true;
+                }
+                return !m_abandoned;
+            }
+
             void startNextTransaction() {
                 if (m_currentTrans < m_transCount) {
                     m_currentTrans++;
@@ -112,6 +133,7 @@ namespace iMS {
             }
 
             // Common members
+            boost::container::deque<uint8_t> m_scratch;
             boost::container::deque<uint8_t>& m_data;
             const int m_len;
             typename boost::container::deque<uint8_t>::const_iterator m_data_it;
@@ -121,8 +143,15 @@ namespace iMS {
             unsigned int m_transBytesRemaining;
 
             Policy m_policy;  // holds addr, index, uuid, etc.
+
+            MemorySink m_sink;
+            std::size_t m_delivered{ 0 };
+            bool m_abandoned{ false };
         };
 
+        // Both forms of MemoryUpload start here.  Uploaded data is appended to 'arr', or handed to 'sink' if one is given.
+        virtual bool StartUpload(boost::container::deque<std::uint8_t>& arr, MemorySink sink, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid);
+
 		MessageEventTrigger mMsgEvent;
 
 		bool DeviceIsOpen{ false };
@@ -137,10 +166,13 @@ namespace iMS {
 
 		// Message Receiving Thread
 		std::thread receiverThread;
-		std::deque<char> m_rxCharQueue;
-		mutable std::mutex m_rxmutex;
-		std::condition_variable m_rxcond;
+		SPSCByteRing m_rxRing;
+		RxWakeup m_rxWake;
 		virtual void ResponseReceiver() = 0;
+		// Hand received characters to the parser thread.  Only to be called from the receiver thread.
+		void PushRxBytes(const char* data, std::size_t len);
+		// Wake the parser thread after adding work that does not go through m_rxRing
+		void NotifyParser();
 
 		// Message List Manager Thread
 		std::thread parserThread;
@@ -148,6 +180,8 @@ namespace iMS {
 		std::chrono::milliseconds autoFreeTimeout;
         MessageRegistry<MessageHandle, Message> m_msgRegistry;
 		virtual void MessageListManager();
+		// Block until every registered message has completed or timed out (used by Disconnect)
+		void WaitForPendingMessages();
 
 		// Memory Transfer Thread
         std::atomic<_FastTransferStatus> FastTransferStatus{ _FastTransferStatus::IDLE };
@@ -155,6 +189,8 @@ namespace iMS {
 		std::thread memoryTransferThread;
 		mutable std::mutex m_tfrmutex;
 		std::condition_variable m_tfrcond;
+		// Wake the memory transfer thread so that it sees DeviceIsOpen has been cleared
+		void StopMemoryTransfer();
 
         std::atomic<_ConnectionStatus> m_status {_ConnectionStatus::UNKNOWN};
 
@@ -199,7 +235,7 @@ namespace iMS {
 
         template <typename P>
         void PushEvent(MessageEvents::Events e, const P& payload);
-        void PushInterruptEvent(int p, const std::vector<uint8_t>& data);
+        void PushInterruptEvent(int p, std::vector<uint8_t>&& data);
 
 		std::deque<std::uint8_t> m_glblRx;            
 		// Record any trigger events that occur during processing 
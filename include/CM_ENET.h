@@ -47,7 +47,7 @@ namespace iMS
 		void Disconnect();
 		void SetTimeouts(int send_timeout_ms = 500, int rx_timeout_ms = 5000, int free_timeout_ms = 30000, int discover_timeout_ms = 2500);
 		bool MemoryDownload(boost::container::deque<std::uint8_t>& arr, std::uint32_t start_addr, int image_index, const std::array<std::uint8_t, 16>& uuid);
-		bool MemoryUpload(boost::container::deque<std::uint8_t>& arr, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid);
+		int MemoryTransferGranularity() const;
 
 	private:
 		CM_ENET();
@@ -73,6 +73,7 @@ namespace iMS
 		void MessageSender();
 		void ResponseReceiver();
 		void MemoryTransfer();
+		bool StartUpload(boost::container::deque<std::uint8_t>& arr, MemorySink sink, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid);
 		void InterruptReceiver();
 	};
 
@@ -71,6 +71,7 @@
 
 #include <memory>
 #include <deque>
+#include <vector>
 
 /// \cond LIB_CREATION
 #if defined _WIN32 || defined __CYGWIN__
@@ -193,13 +194,13 @@ namespace iMS
 		CompensationPoint(Degrees phase, unsigned int sync_dig = 0, double sync_anlg = 0.0);
 		CompensationPoint(unsigned int sync_dig, double sync_anlg = 0.0);
 		CompensationPoint(double sync_anlg);
-		~CompensationPoint();
+		~CompensationPoint() = default;
 		//@}
 
 		/// \brief Copy Constructor
-		CompensationPoint(const CompensationPoint &);
+		CompensationPoint(const CompensationPoint &) = default;
 		/// \brief Assignment Constructor
-		CompensationPoint &operator =(const CompensationPoint &);
+		CompensationPoint &operator =(const CompensationPoint &) = default;
 
 		/// \brief Equality Operator
 		/// \since 1.3
@@ -256,8 +257,11 @@ namespace iMS
 		const double& SyncAnlg() const;
 		//@}
 	private:
-		class Impl;
-		Impl * p_Impl;
+		// Held by value so that a CompensationTable is a flat array of points with no per-entry allocation
+		Percent m_ampl;
+		Degrees m_phase;
+		std::uint32_t m_sync_D;
+		double m_sync_A;
 	};
 
 	///
@@ -863,6 +867,23 @@ namespace iMS
 		/// \since 1.0
 		CompensationTableDownload(std::shared_ptr<IMSSystem> ims, const CompensationTable& tbl, const RFChannel& chan = RFChannel::all);
 		///
+		/// \brief Constructor for downloading a Channel scoped CompensationTable to every channel at once
+		///
+		/// Channel scoped compensation tables for all channels of the Synthesiser are combined into a single
+		/// download, which runs at the same speed as a Global scope download rather than one message per LUT
+		/// entry for each channel.  Element 0 of \c tbls is applied to channel 1, element 1 to channel 2 and
+		/// so on.  There must be at least as many tables as the Synthesiser has channels, otherwise
+		/// StartDownload() and StartVerify() will fail.
+		///
+		/// As with the single table constructor, the vector is stored by reference and must remain valid
+		/// until the CompensationTableDownload object is destroyed.  Store() is not supported for this form.
+		///
+		/// \param[in] ims A reference to the iMS System which is the target for downloading the tables
+		/// \param[in] tbls A const reference to one CompensationTable per RF Channel
+		/// \throws std::invalid_argument if \c tbls is empty
+		/// \since 2.1
+		CompensationTableDownload(std::shared_ptr<IMSSystem> ims, const std::vector<CompensationTable>& tbls);
+		///
 		/// \brief Destructor for CompensationTableDownload Object
 		~CompensationTableDownload();
 		//@}
@@ -870,6 +891,27 @@ namespace iMS
 		/// \name Bulk Transfer Initiation
 		//@{
 		bool StartDownload();
+		///
+		/// \brief Initiates a full or incremental CompensationTable download
+		///
+		/// The library keeps a record of the table contents last downloaded successfully to each iMS System,
+		/// for the global scope and for each channel.  With \c incremental set, the current contents of the
+		/// CompensationTable are compared against that record and only the LUT entries that differ are sent,
+		/// merged into full size messages.  If there is no record for the target and scope (for example the
+		/// first download after connecting, or after a previous download failed), the whole table is sent.
+		/// The record is discarded whenever the iMS System is connected or disconnected.
+		///
+		/// Each incremental download takes a fresh copy of the CompensationTable, so edits made to the table
+		/// since the previous download are always picked up.  A DOWNLOAD_FINISHED event is raised as usual,
+		/// immediately if nothing has changed.
+		///
+		/// The record cannot see changes made to the Synthesiser LUT by other means, such as a power cycle or
+		/// recalling a table from non-volatile memory.  Perform a full download to resynchronise after these.
+		///
+		/// \param[in] incremental true to send only the entries that changed since the last download
+		/// \return Boolean indicating whether Download has started successfully
+		/// \since 2.1
+		bool StartDownload(bool incremental);
 		bool StartVerify();
 		//@}
 
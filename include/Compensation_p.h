@@ -0,0 +1,156 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Compensation Private Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/Compensation/h/Compensation_p.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 605 $
+/------------------------------------------------------------------------------
+/ Description: Columnar working copy of a CompensationTable and memory mapped
+/              access to iMS_LUT files
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+///
+/// \file Compensation_p.h
+///
+/// \brief Internal structure-of-arrays form of a CompensationTable
+///
+/// \author Dave Cowan
+/// \date 2026-10-18
+/// \since 2.1
+/// \ingroup group_Compensation
+///
+
+#ifndef IMS_COMPENSATION_P_H__
+#define IMS_COMPENSATION_P_H__
+
+#include "Compensation.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace iMS
+{
+	class IMSSystem;
+	class MappedFile;
+
+	/// \brief One contiguous array per compensation feature
+	///
+	/// CompensationTable stores its points in a deque to support the public container API.  Bulk
+	/// operations (resampling, applying functions, file export and formatting for download) gather
+	/// the table into columns once, work on each column as a flat array, then scatter the results back.
+	struct CompensationColumns
+	{
+		std::vector<double> ampl;
+		std::vector<double> phase;
+		std::vector<std::uint32_t> syncDig;
+		std::vector<double> syncAnlg;
+
+		CompensationColumns() {}
+		explicit CompensationColumns(std::size_t n) { resize(n); }
+		explicit CompensationColumns(const CompensationTable& tbl) { Gather(tbl); }
+
+		std::size_t size() const { return ampl.size(); }
+		void resize(std::size_t n);
+
+		/// Copies every point of the table into the columns, resizing them to match
+		void Gather(const CompensationTable& tbl);
+		/// Writes the columns back over the table's points through the CompensationPoint setters,
+		/// so sync analog values are clamped as for any other assignment
+		void Scatter(CompensationTable& tbl) const;
+
+		/// Appends the hardware representation of points [first, first + count) to 'out', 8 bytes
+		/// per point: phase, amplitude, sync digital and sync analog, each 16-bit little endian
+		void Format(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>& out, std::size_t first = 0, std::size_t count = static_cast<std::size_t>(-1)) const;
+	};
+
+	/// \brief Fields of the 64 byte header at the start of an iMS_LUT file
+	struct iMSLUTFileHeader2
+	{
+		std::string signature;
+		std::uint16_t protver;
+		std::uint16_t length;
+		double start_freq;  // in MHz
+		double end_freq;    // in MHz
+		std::uint16_t pt_size;
+		std::uint16_t chan_count;
+
+		iMSLUTFileHeader2() {};
+		iMSLUTFileHeader2(const std::string& s) : signature(s) {};
+	};
+
+	/// \brief An iMS_LUT file mapped read-only into memory
+	///
+	/// The header is parsed and validated once, when the file is opened.  Tables are then decoded
+	/// straight from the mapped file, so any number of tables can be retrieved, repeatedly, without
+	/// the file being opened or read again.  The file stays mapped until the last reference is released.
+	class LUTFileMap
+	{
+	public:
+		static constexpr std::size_t HeaderSize = 64;
+		/// Amplitude, phase and sync analog as 64-bit doubles, sync digital as a 32-bit integer
+		static constexpr std::size_t PointSize = 28;
+
+		/// \brief The points of one table in the file, decoded on access
+		class TableView
+		{
+		public:
+			TableView(const char* data, int length, int pt_size) : m_data(data), m_length(length), m_pt_size(pt_size) {}
+
+			int size() const { return m_length; }
+			double Amplitude(int i) const;
+			double Phase(int i) const;
+			std::uint32_t SyncDig(int i) const;
+			double SyncAnlg(int i) const;
+
+		private:
+			const char* m_data;
+			int m_length;
+			int m_pt_size;
+		};
+
+		/// Returns null if the file can't be opened or is not a valid iMS_LUT file
+		static std::shared_ptr<const LUTFileMap> Open(const std::string& fileName);
+		~LUTFileMap();
+
+		const iMSLUTFileHeader2& Header() const { return m_hdr; }
+
+		/// The table for one channel of a channel scoped file.  The first table is returned for
+		/// RFChannel::all, for a global file, or for a channel beyond those in the file.
+		TableView Table(int chan) const;
+
+		/// Fills every point of 'tbl' from one table in the file, resampling from the file's frequency
+		/// range to that of 'tbl'.  Sync digital flags of file entries that fall between table entries are
+		/// combined.  Returns false, leaving 'tbl' unchanged, if the frequency ranges don't overlap.
+		bool Load(CompensationTable& tbl, int chan) const;
+
+		/// Encodes a complete iMS_LUT file, header and one table per element of 'tables', into 'out'.
+		/// Every table must have the same number of points.
+		static void Encode(const std::vector<CompensationColumns>& tables, double start_freq, double end_freq, std::vector<char>& out);
+
+	private:
+		LUTFileMap(std::unique_ptr<MappedFile> file, const iMSLUTFileHeader2& hdr);
+		LUTFileMap(const LUTFileMap&) = delete;
+		LUTFileMap& operator =(const LUTFileMap&) = delete;
+
+		std::unique_ptr<MappedFile> m_file;
+		iMSLUTFileHeader2 m_hdr;
+	};
+
+}
+
+#endif
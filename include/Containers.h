@@ -274,6 +274,12 @@ namespace iMS {
 		///
 		///  Removes all elements from the list container (which are destroyed), and leaving the ImageSequence with a size of 0.
 		void clear();
+		/// \brief Records that the contents have changed
+		///
+		/// Elements updated through an iterator aren't seen by the ListBase, so call this afterwards to give it a new UUID
+		/// and modified time, as any other modifier would.
+		/// \since 2.1
+		void MarkModified();
 		//@}
 
 		/// \name Helper Functions
@@ -442,6 +448,13 @@ namespace iMS {
 		/// \since 1.3
 		void clear();
 
+		/// \brief Records that the contents have changed
+		///
+		/// Elements updated through an iterator aren't seen by the DequeBase, so call this afterwards to give it a new UUID
+		/// and modified time, as operator[] would.
+		/// \since 2.1
+		void MarkModified();
+
 		/// \brief Inserts a single new element into the DequeBase
 		/// \since 1.3
 		iterator insert(iterator pos, const T& value);
@@ -0,0 +1,94 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Deadline Queue Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/Messaging/h/DeadlineQueue.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 600 $
+/------------------------------------------------------------------------------
+/ Description: Min-heap of (deadline, handle) pairs used by the message
+/              registry to expire receive timeouts and auto-free completed
+/              messages without scanning every registered message.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <vector>
+
+namespace iMS {
+
+    // Entries are never removed from the middle of the heap.  A handle whose message has since
+    // been freed, or which has been rescheduled, is simply discarded by the owner when it expires.
+    template<typename HandleType, typename Clock = std::chrono::steady_clock>
+    class DeadlineQueue
+    {
+    public:
+        using TimePoint = typename Clock::time_point;
+
+        DeadlineQueue() = default;
+        ~DeadlineQueue() = default;
+
+        void schedule(HandleType handle, TimePoint deadline)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_heap.push(Entry{ deadline, handle });
+        }
+
+        // Pop a single entry whose deadline is at or before 'now'.  Returns false when none has expired.
+        bool popExpired(TimePoint now, HandleType& handle)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_heap.empty() || m_heap.top().deadline > now) return false;
+            handle = m_heap.top().handle;
+            m_heap.pop();
+            return true;
+        }
+
+        std::optional<TimePoint> next() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_heap.empty()) return std::nullopt;
+            return m_heap.top().deadline;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_heap = Heap();
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_heap.size();
+        }
+
+    private:
+        struct Entry {
+            TimePoint deadline;
+            HandleType handle;
+            bool operator > (const Entry& other) const { return deadline > other.deadline; }
+        };
+        using Heap = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+
+        mutable std::mutex m_mutex;
+        Heap m_heap;
+    };
+
+}
@@ -0,0 +1,89 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Event Dispatcher Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/EventManager/h/EventDispatcher.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 601 $
+/------------------------------------------------------------------------------
+/ Description: Executor pool used by IEventTrigger to deliver events away from
+/              the thread that raised them.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_EVENT_DISPATCHER_H__
+#define IMS_EVENT_DISPATCHER_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace iMS {
+
+	// Runs posted tasks on a pool of worker threads, started on first use.  Tasks posted under
+	// the same key (normally the subscribed IEventHandler) run one at a time in the order they
+	// were posted; tasks for different keys may run concurrently if more than one thread is used.
+	class EventDispatcher
+	{
+	public:
+		using Task = std::function<void()>;
+
+		explicit EventDispatcher(std::size_t threads = 1);
+		~EventDispatcher();
+
+		void Post(const void* key, Task task);
+
+		// Block until every task posted so far has run.  Must not be called from a task.
+		void Drain();
+
+		std::size_t Threads() const;
+
+	private:
+		EventDispatcher(const EventDispatcher&) = delete;
+		EventDispatcher& operator =(const EventDispatcher&) = delete;
+
+		struct Strand {
+			std::deque<Task> tasks;
+			bool scheduled{ false };
+		};
+
+		// Shared with the workers, so that a worker whose task destroys the dispatcher can still
+		// finish its loop after the dispatcher has gone
+		struct State {
+			std::mutex mutex;
+			std::condition_variable workCond;
+			std::condition_variable idleCond;
+			std::unordered_map<const void*, Strand> strands;
+			std::deque<const void*> ready;
+			std::size_t pending{ 0 };
+			bool stopping{ false };
+		};
+
+		static void WorkerLoop(std::shared_ptr<State> state);
+
+		const std::size_t m_threadCount;
+		std::vector<std::thread> m_workers;
+		std::once_flag m_startFlag;
+
+		std::shared_ptr<State> m_state;
+	};
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Hardware Catalog Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/Other/h/HardwareCatalog.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 606 $
+/------------------------------------------------------------------------------
+/ Description: In-memory copy of the embedded hardware database, loaded once
+/              per process and indexed for the lookups made by the library.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_HARDWARECATALOG_H__
+#define IMS_HARDWARECATALOG_H__
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace iMS {
+
+	// A capability column of the hardware list.  It holds either TRUE/FALSE, or the firmware version
+	// from which the capability is present, which can only be resolved once the device's version is known.
+	struct HardwareCapability
+	{
+		bool present{ false };      // column is not NULL
+		bool value{ false };
+		std::optional<int> since;
+
+		bool For(int version) const { return since ? (version >= *since) : value; }
+	};
+
+	// One row of the hardware list.  Columns that are NULL or don't parse are left empty, so that the
+	// device keeps its default capability.
+	struct HardwareRecord
+	{
+		enum class Type { CONTROLLER, SYNTHESISER, OTHER };
+		Type type{ Type::OTHER };
+		std::string model;
+		std::string description;
+
+		// Controller
+		std::optional<int> nSynth;
+		HardwareCapability fastTransfer;
+		std::optional<int> maxImageSize;
+		HardwareCapability simultaneousPlayback;
+		std::optional<int> maxImageRate;
+		HardwareCapability remoteUpgrade;
+
+		// Synthesiser
+		std::optional<double> lowerFreq;
+		std::optional<double> upperFreq;
+		std::optional<int> freqBits;
+		std::optional<int> amplBits;
+		std::optional<int> phaseBits;
+		std::optional<int> lutDepth;
+		std::optional<int> lutAmplBits;
+		std::optional<int> lutPhaseBits;
+		std::optional<int> lutSyncAnlgBits;
+		std::optional<int> lutSyncDigBits;
+		std::optional<double> sysClock;
+		std::optional<int> channels;
+		std::optional<int> channelCompSince;    // firmware revision
+	};
+
+	// One wavelength of the crystal parameter table
+	struct CrystalRecord
+	{
+		std::string description;
+		double wavelength{ 0.0 };
+		double refractiveIndex{ 0.0 };
+		double acousticVelocity{ 0.0 };
+	};
+
+	// One row of the AO device table.  The crystal is kept by name, as a Crystal can't be constructed
+	// while the catalog is loading.
+	struct AODeviceRecord
+	{
+		std::string model;
+		std::string crystal;
+		std::optional<double> centre;
+		std::optional<double> bandwidth;
+		std::optional<double> geom;
+		std::optional<double> wavelength;
+	};
+
+	// The hardware list, crystal parameter and AO device tables are read from the embedded database
+	// the first time any of them is needed, parsed, then served from memory for the life of the process.
+	// The database is compiled into the library, so the catalog never goes stale.
+	class HardwareCatalog
+	{
+	public:
+		static const HardwareCatalog& Instance();
+
+		// False if the embedded database could not be opened
+		bool IsValid() const { return m_valid; }
+
+		// Rows of the hardware list for magicID, in table order
+		const std::vector<HardwareRecord>& Hardware(std::uint16_t magicID) const;
+		// Rows of the crystal parameter table for a material, in table order
+		const std::vector<CrystalRecord>& CrystalParams(const std::string& type) const;
+		// The first row of the AO device table for a model, or nullptr if there is none
+		const AODeviceRecord* AODevice(const std::string& model) const;
+		// Every AO device, in table order
+		const std::vector<AODeviceRecord>& AODevices() const { return m_aodevices; }
+
+	private:
+		HardwareCatalog();
+		HardwareCatalog(const HardwareCatalog&) = delete;
+		HardwareCatalog& operator =(const HardwareCatalog&) = delete;
+
+		bool m_valid;
+		std::unordered_map<std::uint16_t, std::vector<HardwareRecord>> m_hwlist;
+		std::unordered_map<std::string, std::vector<CrystalRecord>> m_xtalparam;
+		std::vector<AODeviceRecord> m_aodevices;
+		std::unordered_map<std::string, std::size_t> m_aodevice;
+		const std::vector<HardwareRecord> m_noHardware;
+		const std::vector<CrystalRecord> m_noCrystal;
+	};
+
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <list>
 #include <memory>
 #include <array>
+#include <functional>
 
 namespace iMS
 {
@@ -75,9 +76,23 @@ namespace iMS
 		// Transfer a block of data from the system memory
 		virtual bool MemoryUpload(boost::container::deque<std::uint8_t>& arr, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid) = 0;
 
+		// Receives each block of uploaded data as it arrives.  Returning false abandons the rest of the transfer.
+		using MemorySink = std::function<bool(const std::uint8_t* data, std::size_t len)>;
+
+		// Transfer a block of data from the system memory, handing it to 'sink' block by block instead of collecting it.
+		// Connection managers that cannot stream an upload leave this as is: the transfer is not started.
+		virtual bool MemoryUpload(MemorySink sink, std::uint32_t start_addr, int len, int image_index, const std::array<std::uint8_t, 16>& uuid)
+		{
+			(void)sink; (void)start_addr; (void)len; (void)image_index; (void)uuid;
+			return false;
+		}
+
 		// Get current status of Memory transfer
 		virtual int MemoryProgress() = 0;
 
+		// MemoryDownload pads the data it sends to a multiple of this many bytes
+		virtual int MemoryTransferGranularity() const { return 1; }
+
 		// True if there is an open connection to the device
 		virtual const bool& Open() const = 0;
 
@@ -86,6 +101,9 @@ namespace iMS
 
 		// Disregard any future events
 		virtual void MessageEventUnsubscribe(const int message, const IEventHandler* handler) = 0;
+
+		// Number of threads delivering Message Events (0 = deliver on the parser thread)
+		virtual void SetEventDispatchThreads(int threads) = 0;
 	};
 
 }
@@ -28,10 +28,13 @@
 #include <map>
 #include <cstdint>
 #include <shared_mutex>
+#include <memory>
+#include <mutex>
 
 namespace iMS {
 
 	class IEventHandler;
+	class EventDispatcher;
 
 	class IEventTrigger
 	{
@@ -49,6 +52,19 @@ namespace iMS {
 		template <typename T, typename T2>
 		void Trigger(void* sender, const int message, const T param, const T2 param2);
 
+		// Deliver posted events on a pool of executor threads owned by this trigger.  Events
+		// reach each handler in the order they were posted.  Zero threads delivers synchronously.
+		void DispatchThreads(std::size_t threads);
+		std::size_t DispatchThreads() const;
+
+		// As Trigger(), but returns without waiting for handlers when a dispatcher is configured.
+		// Parameters are taken by value so that payloads can be moved in and shared by all handlers.
+		template <typename T>
+		void Post(void* sender, const int message, T param);
+
+		template <typename T, typename T2>
+		void Post(void* sender, const int message, T param, T2 param2);
+
 	protected:
 		void updateCount(int count);
 		typedef std::vector<IEventHandler*> EventHandlerList;
@@ -56,6 +72,14 @@ namespace iMS {
 		EventHandlerMap mMap;
 		int messageCount;
 		std::shared_mutex m_mapMutex;
+
+	private:
+		std::shared_ptr<EventDispatcher> Dispatcher() const;
+		EventHandlerList Handlers(const int message);
+		bool IsSubscribed(const int message, const IEventHandler* handler) const;
+
+		std::shared_ptr<EventDispatcher> m_dispatcher;
+		mutable std::mutex m_dispatcherMutex;
 	};
 
 }
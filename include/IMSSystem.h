@@ -435,6 +435,18 @@ namespace iMS
     /// <param name="discover_timeout_ms">The round trip wait time for iMS systems to respond to with an announce packet to a discovery broadcast (Ethernet)</param>
     /// \since 1.8.10
         void SetTimeouts(int send_timeout_ms = 500, int rx_timeout_ms = 5000, int free_timeout_ms = 30000, int discover_timeout_ms = 2500);
+    /// \brief Sets the number of threads used to deliver connection events
+    ///
+    /// Responses received from the iMS System are parsed on a dedicated thread.  The events raised
+    /// as a result (including those used internally by the library to track the progress of
+    /// downloads) are queued and delivered on a separate pool of executor threads, so a slow
+    /// event handler does not delay the parsing of subsequent responses.  Each handler receives
+    /// its events in the order in which they were raised.
+    ///
+    /// Setting the thread count to zero delivers events directly on the parser thread.
+    /// \param[in] threads number of executor threads (default 1)
+    /// \since 2.1
+        void SetEventDispatchThreads(int threads = 1);
 
 	/// \brief Tests Connection Status
 	///
@@ -447,6 +459,13 @@ namespace iMS
     /// \warning This function may be removed in a future release.  Avoid using.
 		const std::shared_ptr<IConnectionManager> Connection() const;
 
+    /// \brief Changes each time the iMS System is connected or disconnected.  Intended for internal library use.
+    ///
+    /// Anything the library records about the state of the hardware on one connection (for example the
+    /// LUT and LTB contents used by incremental downloads) is discarded once the epoch has moved on.
+    /// \since 2.1
+		std::uint32_t ConnectionEpoch() const;
+
     /// \brief Add an iMS Controller to the System. Intended for internal library use.
     /// \since 1.0
 		void Ctlr(const IMSController&);
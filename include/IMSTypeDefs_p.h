@@ -59,6 +59,9 @@ namespace iMS
 		/// Not intended for use in application code
 		static unsigned int RenderAsImagePoint(std::shared_ptr<IMSSystem>, const MHz);
 		static unsigned int RenderAsStaticOffset(std::shared_ptr<IMSSystem> system, const MHz freq, int add_sub);
+		/// \brief As RenderAsStaticOffset, for a contiguous array of signed offsets in MHz.  Negative offsets are
+		/// rendered as a subtraction of their magnitude.
+		static void RenderAsStaticOffsets(std::shared_ptr<IMSSystem> system, const double* freq, std::size_t count, std::uint16_t* out);
 		static unsigned int RenderAsDDSValue(std::shared_ptr<IMSSystem>, const MHz);
 	private:
 		FrequencyRenderer() {}
@@ -80,6 +83,11 @@ namespace iMS
 		/// Not intended for use in application code
 		static unsigned int RenderAsCompensationPoint(std::shared_ptr<IMSSystem>, const Percent);
 
+		/// \brief As RenderAsCompensationPoint, for a contiguous array of amplitudes in percent
+		///
+		/// Not intended for use in application code
+		static void RenderAsCompensationPoints(std::shared_ptr<IMSSystem>, const double* ampl, std::size_t count, std::uint16_t* out);
+
 		/// \brief Used internally by the library to convert a Percent object into a hardware-dependent
 		/// integer representation used by the Calibration Tone for Single Tone amplitude
 		///
@@ -108,6 +116,11 @@ namespace iMS
 		/// Not intended for use in application code
 		static unsigned int RenderAsCompensationPoint(std::shared_ptr<IMSSystem>, const Degrees);
 
+		/// \brief As RenderAsCompensationPoint, for a contiguous array of phases in degrees
+		///
+		/// Not intended for use in application code
+		static void RenderAsCompensationPoints(std::shared_ptr<IMSSystem>, const double* deg, std::size_t count, std::uint16_t* out);
+
 		/// \brief Used internally by the library to convert a Degrees object into a hardware-dependent
 		/// integer representation used by the Calibration Tone for channel phase increment
 		///
@@ -994,6 +994,14 @@ namespace iMS {
 		ImageSequenceEntry &operator =(const ImageSequenceEntry &);
 	/// \brief Copy Constructor from another object derived from the base SequenceEntry class.  You should not need this.
 		ImageSequenceEntry(const SequenceEntry& entry);
+	/// \brief Copy Constructor with a different number of repeats
+	///
+	/// Creates an entry that plays the same Image with the same parameters as another, but a different number of times.
+	/// \param entry The ImageSequenceEntry to copy
+	/// \param Rpt Whether repeats are required (ImageRepeats::PROGRAM) or not (ImageRepeats::NONE)
+	/// \param rpts The number of repeats to perform
+	/// \since 2.1
+		ImageSequenceEntry(const ImageSequenceEntry& entry, const ImageRepeats& Rpt, const int rpts);
 	//@}
 
 	/// \brief Equality Operator checks ImageSequenceEntry object for equivalence
@@ -1136,6 +1144,111 @@ namespace iMS {
 		Impl *p_Impl;
 	};
 
+  ///
+  /// \class CompactSequence Image.h include/Image.h
+  /// \brief A contiguous form of ImageSequence for sequences of very many entries
+  ///
+  /// An ImageSequence is a list of shared pointers, one per entry, which is convenient to edit but costs a heap
+  /// allocation per entry and is slow to walk once it grows to millions of entries.  Long sequences usually play
+  /// a small number of distinct entries many times over, so a CompactSequence keeps each distinct SequenceEntry once,
+  /// in an entry table, and the order in which they are played as a contiguous array of 32-bit indices into that table.
+  ///
+  /// A CompactSequence is downloaded with SequenceDownload in the same way as an ImageSequence, and each entry in the
+  /// table is formatted once however many times it is played.  It has a UUID, which changes whenever the sequence is
+  /// modified, and is managed in the Sequence Queue with the SequenceManager functions that take a UUID.
+  ///
+  /// As in an ImageSequence, entries are shared, not copied, so an entry modified after it has been added affects
+  /// every position at which it is played.
+  /// \date 2026-10-19
+  /// \since 2.1
+  ///
+	class LIBSPEC CompactSequence
+	{
+	public:
+    /// \name Constructors & Destructor
+    //@{
+    /// \brief Create an empty sequence with Termination Action specifier
+    /// \param action The operation to perform once the Sequence has completed playback
+    /// \param val Optional parameter to the Termination Action
+		CompactSequence(SequenceTermAction action = SequenceTermAction::DISCARD, int val = 0);
+	/// \brief Create a CompactSequence from an ImageSequence
+	///
+	/// The entries and termination of the ImageSequence are copied.  An entry object that appears more than once in the
+	/// ImageSequence is added to the entry table only once.
+	/// \param seq The ImageSequence to convert
+		explicit CompactSequence(const ImageSequence& seq);
+	/// \brief Destructor
+		~CompactSequence();
+    /// \brief Copy Constructor
+		CompactSequence(const CompactSequence &);
+    /// \brief Assignment Constructor
+		CompactSequence &operator =(const CompactSequence &);
+    //@}
+
+    /// \name Entry Table
+    //@{
+    /// \brief Adds an entry to the entry table without playing it
+    /// \param[in] entry The entry to add.  If the same object is already in the table, it is not added again.
+    /// \return the index of the entry in the table
+		std::size_t AddEntry(const std::shared_ptr<SequenceEntry>& entry);
+    /// \return the number of distinct entries in the table
+		std::size_t EntryCount() const;
+    /// \param[in] index A position in the entry table
+    /// \return the entry at that position
+    /// \throws std::out_of_range if there is no such entry
+		const std::shared_ptr<SequenceEntry>& Entry(std::size_t index) const;
+    //@}
+
+    /// \name Playback Order
+    //@{
+    /// \brief Plays the entry at 'index' in the entry table next
+    /// \throws std::out_of_range if there is no such entry
+		void push_back(std::size_t index);
+    /// \brief Plays 'entry' next, adding it to the entry table if it is not already there
+		void push_back(const std::shared_ptr<SequenceEntry>& entry);
+    /// \brief Reserves space for 'n' entries to be played without reallocation
+		void reserve(std::size_t n);
+    /// \brief Removes every entry from the playback order and the entry table
+		void clear();
+    /// \return the number of entries played, counting each repeated entry every time
+		std::size_t size() const;
+    /// \return true if the sequence plays no entries
+		bool empty() const;
+    /// \return the entry table index of the entry played at position 'pos'
+		std::size_t operator[](std::size_t pos) const;
+    /// \return the playback order as a contiguous array of size() entry table indices
+		const std::uint32_t* data() const;
+    //@}
+
+    /// \brief Expands the sequence into an ImageSequence with the same entries and termination
+		ImageSequence ToImageSequence() const;
+
+    /// \brief Unique Identifier used to refer to the sequence in the Sequence Queue
+		const std::array<std::uint8_t, 16> GetUUID() const;
+
+    /// \name Control Sequence Terminating Actions
+    //@{
+    /// \brief Update Termination Action
+    /// \param[in] act Assign an operation to perform when the Sequence completes
+    /// \param[in] val Optional Parameter to use with some Termination Actions
+		void OnTermination(SequenceTermAction act, int val = 0);
+	/// \brief Update Termination Action
+	/// \param[in] act Assign an operation to perform when the Sequence completes
+	/// \param[in] term_seq Pointer to another sequence to insert before on completion
+		void OnTermination(SequenceTermAction act, const ImageSequence* term_seq);
+    /// \return a reference to the currently assigned Termination Action
+		const SequenceTermAction& TermAction() const;
+    /// \return a reference to the currently assigned Termination Action Parameter
+		const int& TermValue() const;
+	/// \return a pointer to the ImageSequence which this sequence will insert before when TermAction = INSERT or STOP_INSERT
+		const ImageSequence* TermInsertBefore() const;
+    //@}
+
+	private:
+		class Impl;
+		Impl *p_Impl;
+	};
+
 	///
 	/// \class ImageGroup Image.h include/Image.h
 	/// \brief An ImageGroup collects together multiple associated images and a single ImageSequence for controlling Image playback order
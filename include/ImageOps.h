@@ -47,6 +47,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 /// \cond LIB_CREATION
 #if defined _WIN32 || defined __CYGWIN__
@@ -120,6 +121,10 @@ namespace iMS
 			DOWNLOAD_FAIL_TRANSFER_ABORT,
 	  /// Event raised when a new download has been accepted prior to memory transfer commencing, reporting the new image index handle
 			IMAGE_DOWNLOAD_NEW_HANDLE,
+	  /// Event raised periodically during an ImageDownload verify, reporting the number of bytes read back and checked so far
+			VERIFY_PROGRESS,
+	  /// Event raised by ImageGroupDownload as each Image of the group reaches the Controller, reporting the number of Images done so far
+			DOWNLOAD_PROGRESS,
 			Count
 		};
 	};
@@ -171,6 +176,19 @@ namespace iMS
 		~ImageDownload();
     //@}
 
+	///
+	/// \enum VerifyMode How StartVerify() checks the Image data read back from the Controller
+	/// \since 2.1
+		enum class VerifyMode {
+	  /// Every byte is compared with the formatted Image as it arrives and the readback stops at the first
+	  /// difference.  VERIFY_FAIL reports the byte offset of the difference.
+			COMPARE,
+	  /// Only a CRC-32 of the readback is compared with one of the formatted Image.  If this object downloaded
+	  /// the Image, the CRC recorded then is used and the Image is not formatted again.  VERIFY_FAIL reports -1
+	  /// if the CRCs differ.
+			DIGEST
+		};
+
 	/// \name Configure Image Format
 	//@{
 	///
@@ -224,8 +242,21 @@ namespace iMS
 	/// Like the download process, the verify process is carried out in the background on a separate thread, so
 	/// this function call will return once verify has started but before it has completed.  User software is
 	/// responsible for monitoring the events that determine the verification result.
+	///
+	/// From v2.1, the data is checked block by block as it is read back, VERIFY_PROGRESS events report
+	/// how far the verify has got, and a VERIFY_FAIL is raised as soon as a difference is found.  A
+	/// readback that ends before the end of the Image fails at the offset where it ended.
 	/// \return true if the verify process was begun successfully.
 		bool StartVerify();
+	///
+	/// \brief Asynchronously begins the Image Verify process, checking the readback as specified by \c mode
+	///
+	/// As StartVerify(), which verifies in VerifyMode::COMPARE.  The mode only affects Controllers that
+	/// support fast image transfer.
+	/// \param[in] mode Whether to compare every byte or only a CRC-32 of the Image data
+	/// \return true if the verify process was begun successfully.
+	/// \since 2.1
+		bool StartVerify(VerifyMode mode);
     //@}
 
     ///
@@ -274,6 +305,224 @@ namespace iMS
 		Impl * p_Impl;
 	};
 
+	///
+	/// \class ImageGroupDownload ImageOps.h include\ImageOps.h
+	/// \brief Downloads every Image of an ImageGroup to a Controller as one pipelined transfer
+	///
+	/// Loading an ImageGroup with one ImageDownload per Image sets each download up from scratch: worker threads are started,
+	/// the MSB mode is read and written, the Image is formatted, its Image Table entry is added and it is transferred, each step
+	/// waiting on the one before.  ImageGroupDownload sets up once for the whole group and overlaps the steps:
+	///
+	/// \li The MSB mode is checked once, before the first Image.
+	/// \li While one Image is transferred, the next is formatted and its Image Table entry added, so each transfer can start as
+	/// soon as the one before it completes.  At most two formatted Images are held at once.
+	/// \li One pair of worker threads and one transfer listener serve every Image in the group.
+	/// \li The Controller's Image Table held by the IMSSystem is updated once, when the group completes or fails.
+	///
+	/// Images already in the Controller's Image Table, and Images that appear in the group more than once, are downloaded only
+	/// once.  A group download needs a Controller with fast image transfer.
+	///
+	/// Events are raised through DownloadEvents:
+	/// \li DOWNLOAD_PROGRESS after each Image, with the number of Images of the group now on the Controller
+	/// \li IMAGE_DOWNLOAD_NEW_HANDLE as each Image is given its Image Table entry, with the new handle
+	/// \li DOWNLOAD_FINISHED when the whole group is on the Controller, with the number of Images in the group
+	/// \li DOWNLOAD_FAIL_MEMORY_FULL or DOWNLOAD_FAIL_TRANSFER_ABORT if an Image could not be added or transferred, with the position
+	/// of that Image in the group.  The Images before it remain on the Controller, and no further Images are downloaded.
+	///
+	/// \code
+	/// ImageGroupDownload dl(myiMS, myGroup);
+	/// dl.ImageGroupDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &handler);
+	/// dl.StartDownload();
+	/// \endcode
+	///
+	/// The IMSSystem and ImageGroup are held by reference, and the ImageGroup must not be modified until the download has finished.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ImageGroupDownload
+	{
+	public:
+		/// \brief How far a group download has got
+		struct Progress
+		{
+			/// Images of the group on the Controller, including those that were already there
+			std::size_t ImagesDone{ 0 };
+			/// Images in the group, not counting repeats
+			std::size_t ImagesTotal{ 0 };
+			/// Bytes of Image data transferred so far
+			std::uint64_t BytesTransferred{ 0 };
+		};
+
+		///
+		/// \name Constructor & Destructor
+		//@{
+		///
+		/// \brief Creates a download of every Image in an ImageGroup
+		/// \param[in] ims The iMS System to which the Images shall be downloaded
+		/// \param[in] grp The ImageGroup whose Images shall be downloaded
+		/// \since 2.1
+		ImageGroupDownload(std::shared_ptr<IMSSystem> ims, const ImageGroup& grp);
+		/// \brief Destructor.  A download in progress stops after the Image being transferred.
+		~ImageGroupDownload();
+		//@}
+
+		///
+		/// \name Download
+		//@{
+		/// \brief Formats every Image with \c fmt, as ImageDownload::SetFormat()
+		/// \since 2.1
+		void SetFormat(const ImageFormat& fmt);
+		///
+		/// \brief Asynchronously begins downloading the group
+		///
+		/// Returns as soon as the download has begun.  Use the DownloadEvents to follow it.
+		/// \return false if the Controller does not support fast image transfer, or a download from this object is already in progress
+		/// \since 2.1
+		bool StartDownload();
+		/// \brief Returns how far the download has got
+		/// \since 2.1
+		Progress GetProgress() const;
+		//@}
+
+		///
+		/// \name Event Notifications
+		//@{
+		///
+		/// \brief Subscribe a callback function handler to a given DownloadEvents entry
+		/// \param[in] message Use the DownloadEvents::Event enum to specify an event to subscribe to
+		/// \param[in] handler A function pointer to the user callback function to execute on the event trigger.
+		/// \since 2.1
+		void ImageGroupDownloadEventSubscribe(const int message, IEventHandler* handler);
+		///
+		/// \brief Unsubscribe a callback function handler from a given DownloadEvents entry
+		/// \param[in] message Use the DownloadEvents::Event enum to specify an event to unsubscribe from
+		/// \param[in] handler A function pointer to the user callback function that will no longer execute on an event
+		/// \since 2.1
+		void ImageGroupDownloadEventUnsubscribe(const int message, const IEventHandler* handler);
+		//@}
+
+	private:
+		// Make this object non-copyable
+		ImageGroupDownload(const ImageGroupDownload&);
+		const ImageGroupDownload& operator =(const ImageGroupDownload&);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
+	///
+	/// \class ImageFanOutDownload ImageOps.h include\ImageOps.h
+	/// \brief Downloads one Image to several iMS Systems at once
+	///
+	/// A machine with several heads usually plays the same Image on every Controller.  With one ImageDownload per IMSSystem, the
+	/// Image is formatted again for each system and the transfers run one after another.  ImageFanOutDownload instead:
+	///
+	/// \li Formats the Image once for each distinct combination of Image format, MSB mode and Synthesiser resolution and frequency
+	/// range among the targets.  Identical heads share a single formatted copy, which every transfer reads but none modifies.
+	/// \li Starts the transfers to every target together, so the whole download takes about as long as the slowest single transfer.
+	/// \li Reports progress and errors for all the targets together, with the outcome for each target available from TargetResult().
+	///
+	/// Targets that already hold the Image are not downloaded to again.  Every target needs a Controller with fast image transfer.
+	///
+	/// Events are raised through DownloadEvents:
+	/// \li DOWNLOAD_PROGRESS as each target completes, with the number of targets completed so far, successfully or not
+	/// \li DOWNLOAD_FINISHED when every target holds the Image, with the number of targets
+	/// \li DOWNLOAD_ERROR when every target has completed but at least one failed, with the number that failed
+	///
+	/// \code
+	/// ImageFanOutDownload dl({ head1, head2, head3, head4 }, myImage);
+	/// dl.ImageFanOutDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &handler);
+	/// dl.StartDownload();
+	/// \endcode
+	///
+	/// The Image is held by reference, and must remain valid and unmodified until the download has finished.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ImageFanOutDownload
+	{
+	public:
+		/// \brief How far a fan-out download has got
+		struct Progress
+		{
+			/// Targets whose download has completed, successfully or not
+			std::size_t TargetsDone{ 0 };
+			/// Targets whose download failed
+			std::size_t TargetsFailed{ 0 };
+			/// Targets in the download
+			std::size_t TargetsTotal{ 0 };
+			/// The number of times the Image was formatted
+			std::size_t Formats{ 0 };
+			/// Bytes of Image data transferred so far, over all targets
+			std::uint64_t BytesTransferred{ 0 };
+		};
+
+		///
+		/// \name Constructor & Destructor
+		//@{
+		///
+		/// \brief Creates a download of an Image to every one of a list of iMS Systems
+		/// \param[in] targets The iMS Systems to which the Image shall be downloaded
+		/// \param[in] img The Image to download
+		/// \since 2.1
+		ImageFanOutDownload(const std::vector<std::shared_ptr<IMSSystem>>& targets, const Image& img);
+		/// \brief Destructor.  Waits for a download in progress to finish.
+		~ImageFanOutDownload();
+		//@}
+
+		///
+		/// \name Download
+		//@{
+		/// \brief Formats the Image with \c fmt for every target, as ImageDownload::SetFormat().  By default each target uses its own default format.
+		/// \since 2.1
+		void SetFormat(const ImageFormat& fmt);
+		///
+		/// \brief Asynchronously begins downloading to every target
+		///
+		/// Returns as soon as the download has begun.  Use the DownloadEvents to follow it.
+		/// \return false if there are no targets, or a download from this object is already in progress
+		/// \since 2.1
+		bool StartDownload();
+		/// \brief Returns how far the download has got
+		/// \since 2.1
+		Progress GetProgress() const;
+		///
+		/// \brief Returns the outcome of the download to one target
+		/// \param[in] target The position of the target in the list passed to the constructor
+		/// \return -1 while the download to the target is in progress, otherwise DOWNLOAD_FINISHED, DOWNLOAD_ERROR,
+		/// DOWNLOAD_FAIL_MEMORY_FULL or DOWNLOAD_FAIL_TRANSFER_ABORT
+		/// \since 2.1
+		int TargetResult(std::size_t target) const;
+		//@}
+
+		///
+		/// \name Event Notifications
+		//@{
+		///
+		/// \brief Subscribe a callback function handler to a given DownloadEvents entry
+		/// \param[in] message Use the DownloadEvents::Event enum to specify an event to subscribe to
+		/// \param[in] handler A function pointer to the user callback function to execute on the event trigger.
+		/// \since 2.1
+		void ImageFanOutDownloadEventSubscribe(const int message, IEventHandler* handler);
+		///
+		/// \brief Unsubscribe a callback function handler from a given DownloadEvents entry
+		/// \param[in] message Use the DownloadEvents::Event enum to specify an event to unsubscribe from
+		/// \param[in] handler A function pointer to the user callback function that will no longer execute on an event
+		/// \since 2.1
+		void ImageFanOutDownloadEventUnsubscribe(const int message, const IEventHandler* handler);
+		//@}
+
+	private:
+		// Make this object non-copyable
+		ImageFanOutDownload(const ImageFanOutDownload&);
+		const ImageFanOutDownload& operator =(const ImageFanOutDownload&);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
 	///
   /// \class ImagePlayerEvents ImageOps.h include\ImageOps.h
   /// \brief All the different types of events that can be triggered by the ImagePlayer class
@@ -811,6 +1060,240 @@ namespace iMS
 		Impl* p_Impl;
 	};
 
+	///
+	/// \class ImageMemoryMap ImageOps.h include\ImageOps.h
+	/// \brief A host side view of how Images are laid out in Controller memory
+	///
+	/// The Controller chooses where each downloaded Image is stored and ImageTableViewer::Erase frees the space again.  Systems
+	/// that keep replacing Images can end up with plenty of free memory in total but no single gap large enough for the next
+	/// Image, and ImageDownload only finds out when the Controller refuses the download with DOWNLOAD_FAIL_MEMORY_FULL.
+	///
+	/// ImageMemoryMap rebuilds the layout from the address and size of each ImageTableEntry so that application software can
+	/// check whether an Image will fit before formatting and downloading it, and, when it won't, plan which Images to remove and
+	/// download again to merge enough free space.
+	///
+	/// Placement is predicted the way the Controller allocates memory: each Image goes in the lowest addressed gap large enough
+	/// to hold it, starting on an Alignment byte boundary.  Image sizes are rounded up to the transfer granularity of the
+	/// connection, as ImageDownload pads them.  The extent of Image memory is not reported by the Controller and should be given
+	/// to the constructor; without it, Fits() and PlanCompaction() only account for the Images already stored.
+	///
+	/// The map is a snapshot.  Call Refresh() after downloading or erasing Images.  It is only meaningful for Controllers
+	/// that support FastImageTransfer; other Controllers hold a single Image and have no Image Table.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ImageMemoryMap
+	{
+	public:
+		/// Granularity, in bytes, of Image start addresses in Controller memory
+		static const std::uint32_t DefaultAlignment = 4096;
+
+		/// \brief A contiguous span of Controller memory
+		struct Region
+		{
+			/// Absolute address of the first byte
+			std::uint32_t Address;
+			/// Length in bytes
+			std::uint32_t Size;
+		};
+
+		/// \brief The result of PlanCompaction()
+		///
+		/// To carry out the plan, erase every Image in Relocate, download the new Image, then download each Image in Relocate
+		/// again in the order listed.
+		struct CompactionPlan
+		{
+			/// True if a plan was found
+			bool Feasible{ false };
+			/// The Images to remove and download again, in download order
+			std::vector<ImageTableEntry> Relocate;
+			/// The total size of the Images in Relocate, which is the number of bytes that must be downloaded again
+			std::uint64_t RelocateBytes{ 0 };
+			/// Predicted address of the new Image
+			std::uint32_t Address{ 0 };
+		};
+
+		///
+		/// \name Constructors & Destructor
+		//@{
+		///
+		/// \brief Builds the map from the Image Table of an iMS System whose extent of Image memory is not known
+		///
+		/// Image memory is taken to start at address 0 and run to the top of the 32 bit address space, so an Image only fails
+		/// to fit if the Image Table leaves no room for it there.  Pass the real size wherever it is known.
+		/// \param[in] ims The iMS System whose Controller memory is to be mapped
+		/// \since 2.1
+		ImageMemoryMap(std::shared_ptr<IMSSystem> ims);
+		///
+		/// \brief Builds the map from the Image Table of an iMS System with a known extent of Image memory
+		///
+		/// \param[in] ims The iMS System whose Controller memory is to be mapped
+		/// \param[in] base Address of the first byte of Image memory
+		/// \param[in] size Length of Image memory in bytes
+		/// \param[in] alignment Granularity of Image start addresses
+		/// \since 2.1
+		ImageMemoryMap(std::shared_ptr<IMSSystem> ims, std::uint32_t base, std::uint64_t size, std::uint32_t alignment = DefaultAlignment);
+		~ImageMemoryMap();
+		//@}
+
+		///
+		/// \brief Rebuilds the map from the current Image Table
+		/// \since 2.1
+		void Refresh();
+
+		///
+		/// \name Memory Usage
+		//@{
+		/// \brief Total length of Image memory in bytes
+		std::uint64_t Capacity() const;
+		/// \brief Bytes occupied by Images
+		std::uint64_t UsedBytes() const;
+		/// \brief Bytes not occupied by any Image, including those lost to alignment
+		std::uint64_t FreeBytes() const;
+		/// \brief The largest Image, in bytes, that could be stored without removing any others
+		std::uint32_t LargestFree() const;
+		/// \brief Every gap between Images, in address order
+		std::vector<Region> FreeRegions() const;
+		/// \brief The occupied span of each Image in the table, in address order
+		std::vector<Region> UsedRegions() const;
+		/// \brief 0 when all free memory is in a single gap, approaching 1 as it is split into many small gaps
+		double Fragmentation() const;
+		//@}
+
+		///
+		/// \name Will It Fit?
+		//@{
+		/// \brief Returns true if an Image of the given size can be stored without removing any others
+		/// \param[in] bytes Size of the Image in Controller memory
+		bool Fits(std::uint64_t bytes) const;
+		/// \brief Returns true if the Image can be downloaded without removing any others
+		///
+		/// An Image that is already in the Image Table always fits, since ImageDownload will not download it again.
+		/// \param[in] img The Image to check
+		/// \param[in] fmt The ImageFormat it will be downloaded with
+		bool Fits(const Image& img, const ImageFormat& fmt) const;
+		/// \overload
+		/// Uses the default ImageFormat for the iMS System
+		bool Fits(const Image& img) const;
+		/// \brief The number of bytes an Image will occupy in Controller memory
+		///
+		/// Only the first point of the Image is formatted to find its size.
+		/// \param[in] img The Image to size
+		/// \param[in] fmt The ImageFormat it will be downloaded with
+		std::uint64_t ImageBytes(const Image& img, const ImageFormat& fmt) const;
+		//@}
+
+		///
+		/// \brief Finds the least data to download again in order to make room for a new Image
+		///
+		/// Considers removing each run of adjacent Images whose removal would open a large enough gap, and chooses the run with the
+		/// smallest total size for which the new Image and every removed Image can all be stored again.
+		/// \param[in] bytes Size of the new Image in Controller memory
+		/// \return The plan.  If the Image already fits, the plan is feasible and Relocate is empty.
+		/// \since 2.1
+		CompactionPlan PlanCompaction(std::uint64_t bytes) const;
+
+	private:
+		// Make this object non-copyable
+		ImageMemoryMap(const ImageMemoryMap& other);
+		ImageMemoryMap& operator= (const ImageMemoryMap& other);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
+	///
+	/// \class SequenceCompactor ImageOps.h include\ImageOps.h
+	/// \brief Shortens an ImageSequence without changing what it plays
+	///
+	/// Generated sequences often play the same Image several times in a row, each time as a separate ImageSequenceEntry.
+	/// Every entry costs a record in the Sequence Buffer, so long runs make downloads slower and use up Controller sequence
+	/// memory.  SequenceCompactor produces an equivalent sequence with fewer entries:
+	///
+	/// \li Consecutive ImageSequenceEntry's that are identical apart from their repeat count are merged into one entry whose
+	/// repeat count covers them all.  Each repeat is triggered, delayed and clocked exactly as the next entry would have been.
+	/// The repeat count is limited by the Controller (255 for v1 firmware, 16777215 for v2) and longer runs are split.
+	/// \li If the sequence repeats itself (SequenceTermAction::REPEAT, or REPEAT_FROM an entry) and the part that repeats is
+	/// itself made of several copies of a shorter pattern, only one copy of the pattern is kept.
+	///
+	/// The second step produces identical RF output, but the sequence reaches its end, and starts again, more often.  Turn it off
+	/// with FoldRepeats(false) if application software counts passes through the sequence.
+	///
+	/// ToneSequenceEntry's are never merged.  The Sequence Buffer has no way of expressing a pattern of several entries played
+	/// several times other than at the end of a repeating sequence, so such patterns elsewhere in the sequence are left as they are.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC SequenceCompactor
+	{
+	public:
+		/// \brief How much smaller the last compacted sequence is
+		struct Report
+		{
+			/// Number of entries in the original sequence
+			std::size_t EntriesBefore{ 0 };
+			/// Number of entries in the compacted sequence
+			std::size_t EntriesAfter{ 0 };
+			/// Size of the original Sequence Buffer in bytes
+			std::uint64_t BytesBefore{ 0 };
+			/// Size of the compacted Sequence Buffer in bytes
+			std::uint64_t BytesAfter{ 0 };
+			/// Number of runs of identical entries that were merged
+			std::size_t MergedRuns{ 0 };
+			/// Number of entries removed because they repeated a pattern at the end of a repeating sequence
+			std::size_t FoldedEntries{ 0 };
+			/// For each entry of the compacted sequence, the index of the first entry in the original sequence that it replaces
+			std::vector<std::size_t> FirstEntry;
+
+			/// \brief Fraction of the Sequence Buffer saved, from 0 (no saving) towards 1
+			double Reduction() const { return (BytesBefore == 0) ? 0.0 : 1.0 - (double)BytesAfter / (double)BytesBefore; }
+		};
+
+		///
+		/// \name Constructor & Destructor
+		//@{
+		///
+		/// \brief Creates a compactor for sequences that will be downloaded to an iMS System
+		///
+		/// The iMS System determines the largest repeat count an entry can hold and the size of each Sequence Buffer record.
+		/// \param[in] ims The iMS System to which compacted sequences will be downloaded
+		/// \since 2.1
+		SequenceCompactor(std::shared_ptr<IMSSystem> ims);
+		~SequenceCompactor();
+		//@}
+
+		/// \brief Enables or disables folding the repeating part of a sequence down to a single copy of its pattern
+		///
+		/// Enabled by default.
+		/// \param[in] enable True to fold repeated patterns, false to merge runs of identical entries only
+		/// \since 2.1
+		void FoldRepeats(bool enable);
+
+		///
+		/// \brief Returns a compacted copy of an ImageSequence
+		///
+		/// The original sequence is not modified.  Entries that are not merged are shared with it, as they would be by copying
+		/// the ImageSequence; merged entries are new objects.  The termination action is copied, with the entry index of
+		/// SequenceTermAction::REPEAT_FROM moved to the corresponding entry of the compacted sequence.
+		/// \param[in] seq The ImageSequence to compact
+		/// \return A sequence that plays the same Images, in the same order, with the same timing
+		/// \since 2.1
+		ImageSequence Compact(const ImageSequence& seq);
+		/// \brief Returns the Report for the last call to Compact()
+		/// \since 2.1
+		const Report& LastReport() const;
+
+	private:
+		// Make this object non-copyable
+		SequenceCompactor(const SequenceCompactor& other);
+		SequenceCompactor& operator= (const SequenceCompactor& other);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
 
 	///
 	/// \class SequenceDownload ImageOps.h include\ImageOps.h
@@ -843,6 +1326,14 @@ namespace iMS
     /// \param[in] seq A const reference to the ImageSequence which shall be downloaded to the target
     /// \since 1.2.4
 		SequenceDownload(std::shared_ptr<IMSSystem> ims, const ImageSequence& seq);
+    /// \brief Constructor for Object Creation from a CompactSequence
+    ///
+    /// As for an ImageSequence, the CompactSequence is stored by reference and must remain valid until the
+    /// SequenceDownload object is destroyed.  Redownload() formats a CompactSequence in full, as Download() does.
+    /// \param[in] ims A reference to the iMS System which is the target for downloading the sequence
+    /// \param[in] seq A const reference to the CompactSequence which shall be downloaded to the target
+    /// \since 2.1
+		SequenceDownload(std::shared_ptr<IMSSystem> ims, const CompactSequence& seq);
     /// \brief Destructor
 		~SequenceDownload();
     //@}
@@ -875,6 +1366,27 @@ namespace iMS
 	/// \brief Initiates an asynchronous sequence download using similar syntax to the ImageDownload class.
 	/// Identical to calling Download(true)
 		inline bool StartDownload() { return Download(true); }
+
+	/// \brief Downloads an edited ImageSequence as a new sequence, reusing the host side format of unchanged entries
+	///
+	/// This is not an update of the sequence on the Controller, which has no means of editing a sequence that is
+	/// already in the queue.  Redownload() transfers the whole of the edited ImageSequence (which has a new UUID)
+	/// and adds it to the end of the queue exactly as Download() does; remove the earlier version with
+	/// SequenceManager::RemoveSequence() if it is no longer wanted.
+	///
+	/// The only difference from Download() is on the host.  SequenceDownload keeps the formatted form of the
+	/// sequence it last downloaded, and Redownload() formats only the entries that have been appended, inserted
+	/// or replaced since then.  The transfer usually takes far longer than the formatting, so expect the overall
+	/// time to be much the same as Download() unless the sequence is long and the connection fast.  The first
+	/// call formats in full.
+	///
+	/// Entries are recognised by identity.  An entry that has been modified in place, for example with
+	/// SequenceEntry::SetFrequencyOffset(), keeps its earlier format: replace it with a new entry instead, or use
+	/// Download().
+	/// \param[in] asynchronous as for Download()
+	/// \return as for Download()
+	/// \since 2.1
+		bool Redownload(bool asynchronous = false);
 	//@}
 
 	///
@@ -910,6 +1422,8 @@ namespace iMS
 		SequenceDownload(const SequenceDownload &);
 		const SequenceDownload &operator =(const SequenceDownload &);
 
+		bool Transfer(bool asynchronous, bool incremental);
+
 		class Impl;
 		Impl * p_Impl;
 	};
@@ -1243,6 +1757,551 @@ namespace iMS
 		class Impl;
 		Impl * p_Impl;
 	};
+
+	///
+	/// \class SequencePositionTracker ImageOps.h include\ImageOps.h
+	/// \brief Follows sequence playback from Controller interrupts, estimating the current entry and point between them
+	///
+	/// SequenceManager::GetCurrentPosition() reads the position from the Controller each time it is called, so following playback
+	/// closely by calling it over and over keeps the link busy.  SequencePositionTracker instead listens for the interrupts the Controller
+	/// raises when a sequence starts, finishes or fails and when a ToneSequenceEntry begins.  It timestamps each one as it arrives and
+	/// works out how far playback has got since from the length and clock rate of each entry.  The position is only read from the
+	/// Controller now and then, while a sequence is playing, to correct for triggers and pauses that the host can't see.
+	///
+	/// The time an entry takes to play is its number of points, taken from the Image Table, divided by its internal clock rate, plus
+	/// its post image delay when the queue uses ImageTrigger::POST_DELAY, multiplied by the number of times it is played.  Entries that
+	/// are clocked externally or wait for an external or host trigger, ToneSequenceEntry's, and entries of sequences that were not passed
+	/// to Track() take a time the host can't predict.  The estimate waits at the start of such an entry until an interrupt or read moves it on.
+	///
+	/// Each interrupt and read is also published, with its arrival time, to a ring of Samples, as is a regular estimate if a
+	/// PublishInterval() is set.  Reading the ring takes no lock and sends nothing to the Controller, so any number of readers, such as
+	/// a display and a logger, can each follow it at their own pace with ReadSample().
+	///
+	/// \warning The tracker subscribes to SequenceEvents::SEQUENCE_START, with the limitations on sequence rate described for
+	/// SequenceManager::SequenceEventSubscribe().
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC SequencePositionTracker
+	{
+	public:
+		/// \enum Source What caused a Sample to be published
+		enum class Source : std::uint8_t
+		{
+			/// A SequenceEvents::SEQUENCE_START interrupt
+			SEQUENCE_START,
+			/// A SequenceEvents::SEQUENCE_FINISHED interrupt
+			SEQUENCE_FINISHED,
+			/// A SequenceEvents::SEQUENCE_ERROR interrupt
+			SEQUENCE_ERROR,
+			/// A SequenceEvents::SEQUENCE_TONE interrupt
+			TONE_START,
+			/// A position read from the Controller
+			POSITION_READ,
+			/// A regular estimate, published every PublishInterval()
+			ESTIMATE
+		};
+
+		/// \brief Where playback is, or was, at a point in time
+		struct Position
+		{
+			/// False until the first interrupt or read has been received
+			bool Valid{ false };
+			/// True between the start of a sequence and the interrupt that says playback has finished or failed
+			bool Playing{ false };
+			/// True if Entry, Repeat and Point were worked out from entry timing, false if they are as last reported by the Controller
+			bool Interpolated{ false };
+			/// The UUID of the sequence at the head of the queue
+			std::array<std::uint8_t, 16> UUID{};
+			/// Index of the entry being played
+			std::uint32_t Entry{ 0 };
+			/// How many times the entry has already been played
+			std::uint32_t Repeat{ 0 };
+			/// Index of the point in the Image being played
+			std::uint32_t Point{ 0 };
+			/// The time the position applies to
+			std::chrono::steady_clock::time_point Time;
+		};
+
+		/// \brief One entry in the ring of published positions
+		struct Sample : Position
+		{
+			/// What caused the Sample to be published
+			Source Src{ Source::ESTIMATE };
+		};
+
+		///
+		/// \name Constructor & Destructor
+		//@{
+		///
+		/// \brief Starts tracking playback on a SequenceManager
+		///
+		/// The SequenceManager must remain valid until the tracker is destroyed.
+		/// \param[in] ims The iMS System playing the sequences
+		/// \param[in] mgr The SequenceManager that controls playback
+		/// \param[in] capacity Number of Samples kept in the ring, rounded up to a power of 2
+		/// \since 2.1
+		SequencePositionTracker(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr, std::size_t capacity = 1024);
+		/// \brief Destructor.  Stops tracking.
+		~SequencePositionTracker();
+		//@}
+
+		///
+		/// \name Tracked Sequences
+		//@{
+		/// \brief Allows the position in an ImageSequence to be interpolated
+		///
+		/// Call this with the configuration that will be passed to SequenceManager::StartSequenceQueue().  The Images played by the
+		/// sequence should already be in the Image Table.  The sequence is copied, so may be modified or destroyed afterwards.
+		/// \param[in] seq The ImageSequence
+		/// \param[in] cfg The configuration it will be played with
+		/// \since 2.1
+		void Track(const ImageSequence& seq, const SequenceManager::SeqConfiguration& cfg = SequenceManager::SeqConfiguration());
+		/// \brief Forgets an ImageSequence passed to Track()
+		/// \since 2.1
+		void Untrack(const ImageSequence& seq);
+		//@}
+
+		///
+		/// \name Settings
+		//@{
+		/// \brief Sets how often the position is read from the Controller while a sequence is playing
+		///
+		/// Defaults to 1 second.  Zero turns reads off, leaving the estimate to interrupts alone.
+		/// \since 2.1
+		void ResyncInterval(std::chrono::milliseconds interval);
+		/// \brief Sets how often an estimate is published to the ring while a sequence is playing
+		///
+		/// Defaults to zero, which publishes interrupts and reads only.
+		/// \since 2.1
+		void PublishInterval(std::chrono::milliseconds interval);
+		//@}
+
+		///
+		/// \name Position
+		//@{
+		/// \brief Estimates the current position.  Nothing is sent to the Controller.
+		/// \since 2.1
+		Position Estimate() const;
+		/// \brief Estimates the position at a given time, which should not be earlier than the last Sample published
+		/// \since 2.1
+		Position Estimate(std::chrono::steady_clock::time_point t) const;
+		//@}
+
+		///
+		/// \name Sample Ring
+		//@{
+		/// \brief The number of Samples published so far, which is the cursor that the next Sample will be read at
+		/// \since 2.1
+		std::uint64_t Published() const;
+		/// \brief Reads the Sample at a cursor from the ring, without locking
+		///
+		/// Start the cursor at 0, or at Published() to skip earlier Samples, and pass it back on each call.  When a Sample is read
+		/// the cursor moves on to the next.  If the reader has fallen so far behind that the Sample at the cursor has been overwritten,
+		/// the cursor jumps forward to the oldest Sample still in the ring.
+		/// \param[in,out] cursor The reader's position in the ring
+		/// \param[out] s The Sample read
+		/// \return false if no Sample has been published at the cursor yet
+		/// \since 2.1
+		bool ReadSample(std::uint64_t& cursor, Sample& s) const;
+		//@}
+
+	private:
+		// Make this object non-copyable
+		SequencePositionTracker(const SequencePositionTracker&);
+		const SequencePositionTracker& operator =(const SequencePositionTracker&);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
+	///
+	/// \class ImageCacheEvents ImageOps.h include\ImageOps.h
+	/// \brief All the different types of events that can be triggered by the ImageCache class
+	///
+	/// Events carrying an Image pass its size in Controller memory, in bytes, as \c param and its UUID as the 16 byte \c data vector.
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ImageCacheEvents
+	{
+	public:
+		/// \enum Events List of Events raised by the Image Cache
+		enum Events {
+			/// Event raised when an Image has been downloaded to the Controller by the cache
+			IMAGE_LOADED,
+			/// Event raised when the cache has erased an Image from the Controller to make room for another
+			IMAGE_EVICTED,
+			/// Event raised when an Image could not be made resident, because it has not been added to the cache, or too much
+			/// of the memory is pinned, or the download failed.  \c param is 0.
+			IMAGE_LOAD_FAILED,
+			/// Event raised when the last Image waiting to be prefetched has been dealt with
+			PREFETCH_IDLE,
+			Count
+		};
+	};
+
+	///
+	/// \class ImageCache ImageOps.h include\ImageOps.h
+	/// \brief Keeps the Images an application is about to play resident in Controller memory, evicting those least recently used
+	///
+	/// Applications that work with more Images than the Controller can hold at once would otherwise have to choose which
+	/// ImageTableEntry to Erase before each ImageDownload.  ImageCache makes that choice for them.  The application adds every
+	/// Image it may play to the cache, then asks for them to be made resident as they are needed:
+	///
+	/// \li Require() blocks until an Image, or every Image in an ImageSequence, is in Controller memory.
+	/// \li Prefetch() does the same on a background thread, so that the Images for the next job are downloaded while the current
+	/// one plays.
+	///
+	/// When there is not enough room for an Image, the resident Image that was used least recently is erased, and so on until
+	/// the new Image fits, as predicted by ImageMemoryMap and confirmed by the Controller accepting the download.  Images are
+	/// never evicted while pinned, nor while a sequence that plays them is in the Controller's queue, provided that sequence was
+	/// downloaded by this application with SequenceDownload or pinned through the cache.  Pin() an Image for as long as it is
+	/// loaded in an ImagePlayer.  Require(), Prefetch() and Touch() all count as a use, as does the start of a sequence when the
+	/// cache has been attached to a SequenceManager.  Only Images that have been added to the cache, or that it downloaded, are
+	/// ever evicted; of those, Images that have never been used are the first to go.  A download that has not finished within
+	/// 30 seconds counts as failed.
+	///
+	/// Example usage:
+	/// \code
+	/// ImageCache cache(myiMS);
+	/// cache.Add(myImageGroup);
+	/// cache.Attach(seqMgr);
+	///
+	/// cache.Require(job1);              // make sure the first job's Images are present
+	/// SequenceDownload(myiMS, job1).Download();
+	/// cache.Prefetch(job2);             // load the next job's Images during playback
+	/// \endcode
+	///
+	/// Images are held by reference, so each must remain valid, and unmodified, for as long as it is in the cache.  Like
+	/// ImageMemoryMap, the cache is only useful with Controllers that support FastImageTransfer.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ImageCache
+	{
+	public:
+		///
+		/// \name Constructors & Destructor
+		//@{
+		///
+		/// \brief Creates a cache for an iMS System whose extent of Image memory is not known
+		///
+		/// Images are then only evicted when the Controller refuses a download with DOWNLOAD_FAIL_MEMORY_FULL.
+		/// \param[in] ims The iMS System whose Controller memory is to be managed
+		/// \since 2.1
+		ImageCache(std::shared_ptr<IMSSystem> ims);
+		///
+		/// \brief Creates a cache for an iMS System with a known extent of Image memory
+		/// \param[in] ims The iMS System whose Controller memory is to be managed
+		/// \param[in] base Address of the first byte of Image memory
+		/// \param[in] size Length of Image memory in bytes
+		/// \since 2.1
+		ImageCache(std::shared_ptr<IMSSystem> ims, std::uint32_t base, std::uint64_t size);
+		/// \brief Destructor.  Waits for any prefetch download in progress to finish.  Resident Images are left in Controller memory.
+		~ImageCache();
+		//@}
+
+		///
+		/// \brief Sets the ImageFormat used for every Image downloaded by the cache
+		/// \param[in] fmt The format.  If not set, the default ImageFormat for the iMS System is used.
+		/// \since 2.1
+		void SetFormat(const ImageFormat& fmt);
+
+		///
+		/// \name Cached Images
+		//@{
+		/// \brief Makes an Image available to the cache for downloading
+		/// \param[in] img The Image.  It is held by reference.
+		/// \since 2.1
+		void Add(const Image& img);
+		/// \brief Makes every Image in an ImageGroup available to the cache
+		/// \param[in] grp The ImageGroup.  Its Images are held by reference.
+		/// \since 2.1
+		void Add(const ImageGroup& grp);
+		/// \brief Removes an Image from the cache.  It is not erased from the Controller.
+		/// \param[in] img The Image
+		/// \since 2.1
+		void Remove(const Image& img);
+		/// \brief Returns true if the Image is currently in the Controller's Image Table
+		/// \since 2.1
+		bool IsResident(const Image& img) const;
+		//@}
+
+		///
+		/// \name Residency
+		//@{
+		/// \brief Downloads an Image unless it is already resident, evicting others to make room if necessary
+		/// \param[in] img The Image, which is added to the cache if it was not already
+		/// \return true if the Image is resident
+		/// \since 2.1
+		bool Require(const Image& img);
+		/// \brief Makes every Image used by an ImageSequence resident, and pins them for as long as the sequence is pinned
+		///
+		/// The sequence is pinned before any Image is downloaded, so loading its later Images can't evict its earlier ones.
+		/// Every Image in the sequence must have been added to the cache.
+		/// \param[in] seq The ImageSequence
+		/// \return true if every Image is resident
+		/// \since 2.1
+		bool Require(const ImageSequence& seq);
+		/// \brief Pins an ImageSequence and queues its Images to be downloaded in the background
+		///
+		/// Returns immediately.  Require() can be called later to wait for the Images; it does not download any Image twice.
+		/// \param[in] seq The ImageSequence
+		/// \since 2.1
+		void Prefetch(const ImageSequence& seq);
+		/// \brief Evicts least recently used Images until an Image of the given size will fit
+		/// \param[in] bytes Size of the Image in Controller memory
+		/// \return true if an Image of that size now fits
+		/// \since 2.1
+		bool MakeRoom(std::uint64_t bytes);
+		//@}
+
+		///
+		/// \name Usage & Pinning
+		//@{
+		/// \brief Records that an Image has just been used, such as by an ImagePlayer
+		/// \since 2.1
+		void Touch(const Image& img);
+		/// \overload
+		void Touch(const std::array<std::uint8_t, 16>& uuid);
+		/// \brief Prevents an Image from being evicted until it is unpinned as often as it was pinned
+		/// \since 2.1
+		void Pin(const Image& img);
+		/// \brief Releases one pin on an Image
+		/// \since 2.1
+		void Unpin(const Image& img);
+		/// \brief Pins every Image used by an ImageSequence.  A sequence that is already pinned is not pinned again.
+		/// \since 2.1
+		void Pin(const ImageSequence& seq);
+		/// \brief Releases the pin on every Image used by an ImageSequence
+		/// \since 2.1
+		void Unpin(const ImageSequence& seq);
+		//@}
+
+		///
+		/// \name Sequence Tracking
+		//@{
+		/// \brief Follows sequence playback on a SequenceManager
+		///
+		/// While attached, the start of each pinned sequence counts as a use of its Images.  Each time a sequence starts, and when
+		/// playback finishes, the Controller's sequence queue is read back on the prefetch thread, and any pinned sequence that has been seen in the queue
+		/// but is no longer there is unpinned.  The SequenceManager must remain valid until Detach() is called or the cache is destroyed.
+		/// \param[in] mgr The SequenceManager that controls playback
+		/// \since 2.1
+		void Attach(SequenceManager& mgr);
+		/// \brief Stops following the SequenceManager passed to Attach()
+		/// \since 2.1
+		void Detach();
+		//@}
+
+		///
+		/// \name Event Notifications
+		//@{
+		///
+		/// \brief Subscribe a callback function handler to a given ImageCacheEvents entry
+		/// \param[in] message Use the ImageCacheEvents::Events enum to specify an event to subscribe to
+		/// \param[in] handler A function pointer to the user callback function to execute on the event trigger.
+		/// \since 2.1
+		void ImageCacheEventSubscribe(const int message, IEventHandler* handler);
+		///
+		/// \brief Unsubscribe a callback function handler from a given ImageCacheEvents entry
+		/// \param[in] message Use the ImageCacheEvents::Events enum to specify an event to unsubscribe from
+		/// \param[in] handler A function pointer to the user callback function that will no longer execute on an event
+		/// \since 2.1
+		void ImageCacheEventUnsubscribe(const int message, const IEventHandler* handler);
+		//@}
+
+	private:
+		// Make this object non-copyable
+		ImageCache(const ImageCache&);
+		const ImageCache& operator =(const ImageCache&);
+
+		class Impl;
+		Impl* p_Impl;
+	};
+
+	///
+	/// \class PlaylistEvents ImageOps.h include\ImageOps.h
+	/// \brief All the different types of events that can be triggered by the PlaylistScheduler class
+	///
+	/// Each event passes the index of the PlaylistScheduler::Step it concerns as \c param.
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC PlaylistEvents
+	{
+	public:
+		/// \enum Events List of Events raised by the Playlist Scheduler
+		enum Events {
+			/// Event raised when the Images of a step are resident and its sequence has been added to the queue
+			STEP_STAGED,
+			/// Event raised when the sequence of a step begins its first pass
+			STEP_STARTED,
+			/// Event raised when the next step has taken over from a step
+			STEP_FINISHED,
+			/// Event raised when the last step has finished and the queue has emptied
+			PLAYLIST_FINISHED,
+			/// Event raised when the Images or sequence of a step could not be downloaded.  Staging stops, and the step before
+			/// keeps playing until Stop() is called.
+			STAGING_FAILED,
+			/// Event raised when the Controller would not end a step so that the next could take over.  The handover is tried a few
+			/// times before this is raised, after which the playlist is stopped.
+			HANDOVER_FAILED,
+			Count
+		};
+	};
+
+	///
+	/// \class PlaylistScheduler ImageOps.h include\ImageOps.h
+	/// \brief Plays a list of ImageGroups one after another, downloading each while the one before plays
+	///
+	/// A recipe made of several ImageGroups would otherwise be played by downloading the Images of each group, downloading its
+	/// sequence and starting the queue, one group at a time, leaving a gap in the output at every change.  PlaylistScheduler takes the
+	/// whole list of groups up front, as Steps, and keeps the Controller's sequence queue topped up from a background thread:
+	///
+	/// \li While one step plays, the Images of the next are made resident through an ImageCache, and a copy of its sequence is
+	/// downloaded to the queue behind the one playing.  Images of finished steps are unpinned, so they are the first to be evicted
+	/// when memory runs short.
+	/// \li Each step's sequence is queued to repeat (SequenceTermAction::REPEAT, or REPEAT_FROM if the group's sequence already does).
+	/// Once the step has played for long enough, and the next step is in the queue, its termination is changed to DISCARD, so the
+	/// Controller moves on to the next step at the end of the current pass with no gap.
+	/// \li A step that must change early is ended with Advance().  Steps queued but not yet played are removed from the queue by Stop().
+	///
+	/// Because a step never hands over until the next is in the queue, a step whose successor is slow to download plays extra passes
+	/// rather than leaving the output idle.  Passes and MinDuration are therefore minimums.  The Controller also needs time to act on the
+	/// new termination action, so a pass should last several milliseconds for a step to end after exactly the number of passes asked for.
+	///
+	/// The scheduler follows playback through SequenceEvents::SEQUENCE_START, with the limitations on sequence rate described for
+	/// SequenceManager::SequenceEventSubscribe().  The sequence queue should only be changed through the scheduler while it is running.
+	///
+	/// Example usage:
+	/// \code
+	/// PlaylistScheduler playlist(myiMS, seqMgr);
+	/// playlist.Add(PlaylistScheduler::Step(warmup, 1));
+	/// playlist.Add(PlaylistScheduler::Step(recipeA, 0, std::chrono::seconds(30)));   // at least 30s, then on to recipeB
+	/// playlist.Add(PlaylistScheduler::Step(recipeB, 0));                             // until Advance() is called
+	/// playlist.Start();
+	/// \endcode
+	///
+	/// ImageGroups are held by reference, so each must remain valid, and unmodified, until the scheduler is destroyed.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC PlaylistScheduler
+	{
+	public:
+		/// \brief One ImageGroup in the playlist, and how long to play its sequence for
+		struct Step
+		{
+			/// The ImageGroup whose Images and sequence are played
+			const ImageGroup* Group;
+			/// The least number of passes through the sequence.  0 plays it until Advance() is called.
+			std::uint32_t Passes;
+			/// The least time for which to play the sequence, from the start of its first pass
+			std::chrono::milliseconds MinDuration;
+
+			/// \brief Creates a step
+			/// \param[in] grp The ImageGroup to play.  It is held by reference.
+			/// \param[in] passes The least number of passes, or 0 to play until Advance() is called
+			/// \param[in] min_duration The least time to play for
+			Step(const ImageGroup& grp, std::uint32_t passes = 1, std::chrono::milliseconds min_duration = std::chrono::milliseconds(0)) :
+				Group(&grp), Passes(passes), MinDuration(min_duration) {}
+		};
+
+		///
+		/// \name Constructor & Destructor
+		//@{
+		///
+		/// \brief Creates an empty playlist for an iMS System
+		///
+		/// The SequenceManager must remain valid until the scheduler is destroyed.
+		/// \param[in] ims The iMS System on which to play
+		/// \param[in] mgr The SequenceManager that controls its sequence queue
+		/// \since 2.1
+		PlaylistScheduler(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr);
+		/// \brief Destructor.  Waits for any download in progress to finish.  Playback is not stopped.
+		~PlaylistScheduler();
+		//@}
+
+		///
+		/// \name Playlist
+		//@{
+		/// \brief Adds a step to the end of the playlist.  Steps may be added during playback.
+		/// \since 2.1
+		void Add(const Step& step);
+		/// \brief Removes every step.  Has no effect while the playlist is running.
+		/// \since 2.1
+		void Clear();
+		/// \brief Returns the number of steps in the playlist
+		/// \since 2.1
+		std::size_t Size() const;
+		/// \brief Sets whether playback returns to the first step after the last.  Defaults to false.
+		/// \since 2.1
+		void Loop(bool loop);
+		/// \brief Sets how many steps after the one playing are kept staged in the queue.  Defaults to 1.
+		/// \since 2.1
+		void Lookahead(std::size_t steps);
+		/// \brief The ImageCache through which Images are made resident, for setting its format or subscribing to its events
+		/// \since 2.1
+		ImageCache& Cache();
+		//@}
+
+		///
+		/// \name Playback
+		//@{
+		/// \brief Stages the first step, then starts the sequence queue
+		///
+		/// The sequence queue should be empty.  Returns once the first step is playing, with later steps staged in the background.
+		/// \param[in] cfg The configuration with which to play every step
+		/// \param[in] start_trig How the first step is triggered, as for SequenceManager::StartSequenceQueue()
+		/// \return false if the playlist is empty or already running, or the first step could not be staged
+		/// \since 2.1
+		bool Start(const SequenceManager::SeqConfiguration& cfg = SequenceManager::SeqConfiguration(),
+			SequenceManager::ImageTrigger start_trig = SequenceManager::ImageTrigger::CONTINUOUS);
+		/// \brief Moves on to the next step at the end of the current pass, however long the current step has played
+		/// \since 2.1
+		void Advance();
+		/// \brief Stops playback and removes the playlist's sequences from the queue
+		/// \param[in] style Whether to stop at the end of the current Image or at once
+		/// \since 2.1
+		void Stop(ImagePlayer::StopStyle style = ImagePlayer::StopStyle::GRACEFULLY);
+		/// \brief Returns true from Start() until Stop() is called or the playlist finishes
+		/// \since 2.1
+		bool Running() const;
+		/// \brief Returns the index of the step playing, or -1 if none
+		/// \since 2.1
+		int Current() const;
+		//@}
+
+		///
+		/// \name Event Notifications
+		//@{
+		///
+		/// \brief Subscribe a callback function handler to a given PlaylistEvents entry
+		/// \param[in] message Use the PlaylistEvents::Events enum to specify an event to subscribe to
+		/// \param[in] handler A function pointer to the user callback function to execute on the event trigger.
+		/// \since 2.1
+		void PlaylistEventSubscribe(const int message, IEventHandler* handler);
+		///
+		/// \brief Unsubscribe a callback function handler from a given PlaylistEvents entry
+		/// \param[in] message Use the PlaylistEvents::Events enum to specify an event to unsubscribe from
+		/// \param[in] handler A function pointer to the user callback function that will no longer execute on an event
+		/// \since 2.1
+		void PlaylistEventUnsubscribe(const int message, const IEventHandler* handler);
+		//@}
+
+	private:
+		// Make this object non-copyable
+		PlaylistScheduler(const PlaylistScheduler&);
+		const PlaylistScheduler& operator =(const PlaylistScheduler&);
+
+		class Impl;
+		Impl* p_Impl;
+	};
 }
 
 #undef EXPIMP_TEMPLATE
@@ -37,6 +37,7 @@
 
 //#include "IMSTypeDefs.h"
 #include "Image.h"
+#include <boost/container/deque.hpp>
 #include <list>
 
 namespace iMS {
@@ -86,6 +87,16 @@ namespace iMS {
 		std::weak_ptr<IMSSystem> m_ims;
 	};
 
+	// Free functions for formatting Image and ImageSequence objects into the bytestreams downloaded to the
+	// Controller (ImageOps.cpp).  FormatImage returns the number of bytes in each point, FormatSequenceBuffer
+	// the length of the whole buffer (0 on error).
+	int FormatImage(const Image& img, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& img_data, ImageFormat formatSpec, int MSBFirst);
+	// Formats only points [first, first + count) of the Image, so that large Images can be produced a piece at a time
+	int FormatImage(const Image& img, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& img_data, ImageFormat formatSpec, int MSBFirst, std::size_t first, std::size_t count);
+	// If 'offsets' is given, the position of each entry's record in the buffer is appended to it
+	int FormatSequenceBuffer(const ImageSequence& seq, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& seq_data, std::vector<std::size_t>* offsets = nullptr);
+	int FormatSequenceBuffer(const CompactSequence& seq, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& seq_data, std::vector<std::size_t>* offsets = nullptr);
+
 }
 
 #endif
\ No newline at end of file
@@ -89,13 +89,13 @@
 ///
 /// The API Minor Version number for use in preprocessing directives
 ///
-#define IMS_API_MINOR 0
+#define IMS_API_MINOR 1
 ///
 /// \brief Patch Version Number
 ///
 /// The API Patch Version number for use in preprocessing directives
 ///
-#define IMS_API_PATCH 3
+#define IMS_API_PATCH 0
 //@}
 
 /// \namespace iMS
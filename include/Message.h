@@ -49,6 +49,9 @@ namespace iMS
 		enum class Status { UNSENT, SENT, SEND_ERROR, TIMEOUT_ON_SEND, RX_PARTIAL, INTERRUPT, RX_OK, CANCELLED, TIMEOUT_ON_RXCV, RX_ERROR_VALID, RX_ERROR_INVALID, PROCESSED_INTERRUPT };
 
 		void setStatus(const Status s);
+		// Sets the status only if it is still 'expected', so a sender cannot overwrite a response that has already
+		// been parsed.  Returns true if the status was changed
+		bool setStatusIf(const Status expected, const Status s);
 		Status getStatus() const;
 		std::string getStatusText() const;
 		MessageHandle getMessageHandle() const;
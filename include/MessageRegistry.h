@@ -24,8 +24,11 @@
 #pragma once
 
 #include "Message.h"
+#include "DeadlineQueue.h"
 
 #include <unordered_map>
+#include <map>
+#include <optional>
 #include <shared_mutex>
 #include <memory>
 #include <functional>
@@ -39,15 +42,49 @@ namespace iMS {
     public:
         using MessagePtr = std::shared_ptr<MessageType>;
         using MapType = std::map<HandleType, MessagePtr>;
+        using Deadlines = DeadlineQueue<HandleType>;
+        using TimePoint = typename Deadlines::TimePoint;
 
         MessageRegistry() = default;
         ~MessageRegistry() = default;
 
-        // Add or replace a message by handle
+        // Add or replace a message by handle.  The message is due for service immediately.
         void addMessage(HandleType handle, MessagePtr msg)
         {
-            std::unique_lock lock(m_mutex);
-            m_messages[handle] = std::move(msg);
+            addMessage(handle, std::move(msg), std::chrono::steady_clock::now());
+        }
+
+        // Add or replace a message by handle, with the time at which it should first be serviced
+        void addMessage(HandleType handle, MessagePtr msg, TimePoint deadline)
+        {
+            {
+                std::unique_lock lock(m_mutex);
+                m_messages[handle] = std::move(msg);
+            }
+            m_deadlines.schedule(handle, deadline);
+        }
+
+        // Request that a registered message is serviced again at the given time
+        void scheduleMessage(HandleType handle, TimePoint deadline)
+        {
+            m_deadlines.schedule(handle, deadline);
+        }
+
+        // Retrieve the next message whose deadline has passed.  Stale entries belonging to messages
+        // that have already been removed are discarded.
+        MessagePtr popExpired(TimePoint now)
+        {
+            HandleType handle;
+            while (m_deadlines.popExpired(now, handle)) {
+                if (auto msg = findMessage(handle)) return msg;
+            }
+            return nullptr;
+        }
+
+        // Earliest deadline of any registered message
+        std::optional<TimePoint> nextDeadline() const
+        {
+            return m_deadlines.next();
         }
 
         // Find a message (shared read access)
@@ -71,8 +108,11 @@ namespace iMS {
         // Clear all
         void clear()
         {
-            std::unique_lock lock(m_mutex);
-            m_messages.clear();
+            {
+                std::unique_lock lock(m_mutex);
+                m_messages.clear();
+            }
+            m_deadlines.clear();
         }
 
         // Check existence
@@ -117,6 +157,7 @@ namespace iMS {
     private:
         mutable std::shared_mutex m_mutex;
         MapType m_messages;
+        Deadlines m_deadlines;
 
         std::mutex m_waitMutex;
         std::condition_variable m_cv;        
@@ -27,9 +27,11 @@
 #include <array>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <optional>
 
@@ -86,6 +88,33 @@ namespace iMS {
 
     bool float_compare(double a, double b, double epsilon = 1e-6);
 
+    // A whole file mapped read-only into memory for as long as the object exists.  IsOpen() is false
+    // if the file doesn't exist, is empty or can't be mapped.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& fileName);
+        ~MappedFile();
+
+        bool IsOpen() const { return (m_data != nullptr); }
+        const char* Data() const { return m_data; }
+        std::size_t Size() const { return m_size; }
+
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator =(const MappedFile&) = delete;
+
+        const char* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+#ifdef _WIN32
+        void* m_file{ nullptr };
+        void* m_mapping{ nullptr };
+#endif
+    };
+
+    // Move 'replacement' over 'fileName' in one step, so that 'fileName' is never missing or part written.
+    // An open MappedFile of 'fileName' keeps the old contents.
+    bool RenameReplacing(const std::string& replacement, const std::string& fileName);
+
     class LazyWorker {
     public:
         using WorkerFunc = std::function<void(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)>;
@@ -114,6 +143,24 @@ namespace iMS {
         WorkerFunc workerFunc;
     };
 
+    // Flag set once by one thread (typically an event handler) that another thread can block on.
+    // Replaces polling an atomic<bool> in a sleep loop.
+    class CompletionSignal {
+    public:
+        void set();
+        void reset();
+        bool is_set() const;
+
+        void wait() const;
+        // Returns false if the timeout elapsed before the flag was set
+        bool wait_for(std::chrono::milliseconds timeout) const;
+
+    private:
+        mutable std::mutex mtx;
+        mutable std::condition_variable cond;
+        bool done{ false };
+    };
+
     // Execute Function only if object pointed to still exists
     template <typename T, typename Func>
     void with_locked(const std::weak_ptr<T>& weak, Func&& func)
@@ -0,0 +1,167 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Receive Handoff Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/ConnectionManager/h/RxHandoff.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 602 $
+/------------------------------------------------------------------------------
+/ Description: Lock-free single-producer / single-consumer byte ring and wake-up
+/              primitive used to pass received characters from a Connection
+/              Manager's receiver thread to its parser thread.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_RX_HANDOFF_H__
+#define IMS_RX_HANDOFF_H__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iMS {
+
+	// Fixed capacity byte ring.  Write() may only be called from one thread and Read() from one
+	// other thread; neither blocks nor takes a lock.
+	class SPSCByteRing
+	{
+	public:
+		// Capacity is rounded up to a power of two
+		explicit SPSCByteRing(std::size_t capacity = (1 << 20))
+		{
+			std::size_t cap = 1;
+			while (cap < capacity) cap <<= 1;
+			m_buf.resize(cap);
+			m_mask = cap - 1;
+		}
+
+		// Producer: copies as many bytes as will fit and returns the number written
+		std::size_t Write(const std::uint8_t* data, std::size_t len)
+		{
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			const std::size_t head = m_head.load(std::memory_order_acquire);
+			const std::size_t n = std::min(len, m_buf.size() - (tail - head));
+			if (n == 0) return 0;
+
+			const std::size_t pos = tail & m_mask;
+			const std::size_t first = std::min(n, m_buf.size() - pos);
+			std::memcpy(&m_buf[pos], data, first);
+			std::memcpy(&m_buf[0], data + first, n - first);
+
+			m_tail.store(tail + n, std::memory_order_seq_cst);
+			return n;
+		}
+
+		// Consumer: appends every available byte to the end of 'out' and returns the count
+		template <typename Container>
+		std::size_t Read(Container& out)
+		{
+			const std::size_t head = m_head.load(std::memory_order_relaxed);
+			const std::size_t tail = m_tail.load(std::memory_order_acquire);
+			const std::size_t n = tail - head;
+			if (n == 0) return 0;
+
+			const std::size_t pos = head & m_mask;
+			const std::size_t first = std::min(n, m_buf.size() - pos);
+			out.insert(out.end(), m_buf.cbegin() + pos, m_buf.cbegin() + pos + first);
+			out.insert(out.end(), m_buf.cbegin(), m_buf.cbegin() + (n - first));
+
+			m_head.store(head + n, std::memory_order_release);
+			return n;
+		}
+
+		bool Empty() const
+		{
+			return m_tail.load(std::memory_order_seq_cst) == m_head.load(std::memory_order_acquire);
+		}
+
+		std::size_t Capacity() const { return m_buf.size(); }
+
+		// Discard contents.  Only valid while neither producer nor consumer is running.
+		void Reset()
+		{
+			m_head.store(0);
+			m_tail.store(0);
+		}
+
+	private:
+		std::vector<std::uint8_t> m_buf;
+		std::size_t m_mask;
+
+		alignas(64) std::atomic<std::size_t> m_head{ 0 };  // advanced by consumer
+		alignas(64) std::atomic<std::size_t> m_tail{ 0 };  // advanced by producer
+	};
+
+	// Wakes a single waiting thread.  Notify() costs one atomic load unless the waiter is actually
+	// asleep, so a producer can call it after every write.  On Linux the waiter sleeps on a futex;
+	// elsewhere a mutex and condition variable are used.
+	class RxWakeup
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		RxWakeup();
+		~RxWakeup();
+
+		// Wake the waiter if it is asleep, or about to go to sleep
+		void Notify()
+		{
+			if (m_waiting.load(std::memory_order_seq_cst)) Signal();
+		}
+
+		// Wake the waiter unconditionally
+		void Signal();
+
+		// Sleep until 'ready' returns true, Notify()/Signal() is called or the deadline passes.
+		// On multi-core hosts, polls briefly first so a steady stream of data does not put the
+		// waiter to sleep.
+		template <typename Pred>
+		void WaitUntil(Clock::time_point deadline, Pred ready)
+		{
+			for (int i = 0; i < m_spinCount; i++) {
+				if (ready()) return;
+			}
+			m_waiting.store(true, std::memory_order_seq_cst);
+			// Any Signal() after this point changes the sequence number and so ends the sleep
+			const std::uint32_t seq = m_seq.load(std::memory_order_seq_cst);
+			if (!ready()) {
+				Sleep(deadline, seq);
+			}
+			m_waiting.store(false, std::memory_order_relaxed);
+		}
+
+	private:
+		RxWakeup(const RxWakeup&) = delete;
+		RxWakeup& operator =(const RxWakeup&) = delete;
+
+		void Sleep(Clock::time_point deadline, std::uint32_t seq);
+
+		int m_spinCount;
+		std::atomic<bool> m_waiting{ false };
+		std::atomic<std::uint32_t> m_seq{ 0 };
+#if !defined(__linux__)
+		std::mutex m_mutex;
+		std::condition_variable m_cond;
+#endif
+	};
+
+}
+
+#endif
@@ -48,6 +48,7 @@
 #include <array>
 #include <chrono>
 #include <climits>
+#include <vector>
 
 /// \cond LIB_CREATION
 #if defined _WIN32 || defined __CYGWIN__
@@ -838,6 +839,135 @@ namespace iMS
 
 		VelocityConfiguration() : VelocityGain({ { 500, 500 } }) {}
 	};
+
+	///
+	/// \class ToneIndexStreamEvents SignalPath.h include\SignalPath.h
+	/// \brief All the different types of events that can be triggered by the ToneIndexStream class.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ToneIndexStreamEvents
+	{
+	public:
+		/// \enum Events List of Events raised by the ToneIndexStream class
+		enum Events {
+			/// Raised when the Synthesiser rejects or fails to acknowledge an index update.  The parameter is the LTB index that was being selected.
+			WRITE_ERROR,
+			/// Raised when every queued index has been sent and acknowledged
+			STREAM_IDLE,
+			Count
+		};
+	};
+
+	///
+	/// \class ToneIndexStream SignalPath.h include\SignalPath.h
+	/// \brief Steps the Local Tone Buffer index from the host at high rates
+	///
+	/// SignalPath::UpdateLocalToneBuffer(const unsigned int index) reads the LTB control register back from the
+	/// Synthesiser before every write, so each index change costs two complete round trips.  ToneIndexStream
+	/// instead keeps a shadow of the control register, shared with SignalPath, and only ever writes to it.
+	///
+	/// Indices are queued, either to be sent as soon as possible or at a given time, and a background thread
+	/// sends them in order without waiting for each one to be acknowledged.  Acknowledgements are checked as they
+	/// arrive; any failure is reported through the ToneIndexStreamEvents::WRITE_ERROR event.
+	///
+	/// The Local Tone Buffer must already be in Host Software control mode, selected with one of the
+	/// SignalPath::UpdateLocalToneBuffer methods taking a ToneBufferControl parameter.  The shadow is read from the
+	/// Synthesiser once, on the first Push, if no SignalPath method has already established it.  Changes
+	/// made to the control register outside of this library (e.g. by a Sequence containing a ToneBufferEntry) are not
+	/// seen by the shadow; call SignalPath::UpdateLocalToneBuffer again to resynchronise it.
+	///
+	/// \author Dave Cowan
+	/// \date 2026-10-19
+	/// \since 2.1
+	class LIBSPEC ToneIndexStream
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		///
+		/// \brief Constructor
+		///
+		/// \param[in] ims A const reference to the iMS System whose Local Tone Buffer index will be streamed
+		/// \since 2.1
+		ToneIndexStream(std::shared_ptr<IMSSystem> ims);
+		///
+		/// \brief Destructor
+		///
+		/// Indices still queued are discarded.
+		~ToneIndexStream();
+
+		///
+		/// \name Queueing Indices
+		//@{
+		///
+		/// \brief Queues an LTB index to be selected as soon as possible
+		///
+		/// \param[in] index The LTB index to select (0 - 255)
+		/// \return false if the Synthesiser is not present or the control register shadow could not be established
+		/// \since 2.1
+		bool Push(unsigned int index);
+		///
+		/// \brief Queues an LTB index to be selected at a given time
+		///
+		/// Indices are always sent in the order they are queued.  An index whose time has already passed is sent immediately.
+		/// \param[in] index The LTB index to select (0 - 255)
+		/// \param[in] at When to send the index update to the Synthesiser
+		/// \return false if the Synthesiser is not present or the control register shadow could not be established
+		/// \since 2.1
+		bool Push(unsigned int index, Clock::time_point at);
+		///
+		/// \brief Queues a list of LTB indices to be selected at a fixed rate
+		///
+		/// \param[in] indices The LTB indices to select, in order
+		/// \param[in] period The interval between each index update
+		/// \param[in] start When to send the first index.  Defaults to immediately.
+		/// \return false if the Synthesiser is not present or the control register shadow could not be established
+		/// \since 2.1
+		bool Push(const std::vector<unsigned int>& indices, std::chrono::microseconds period, Clock::time_point start = Clock::time_point());
+		//@}
+
+		///
+		/// \brief Discards any queued indices that have not yet been sent
+		/// \since 2.1
+		void Clear();
+		///
+		/// \brief Returns the number of queued indices that have not yet been sent
+		/// \since 2.1
+		std::size_t Queued() const;
+		///
+		/// \brief Returns the number of index updates that have been sent but not yet acknowledged
+		/// \since 2.1
+		std::size_t Outstanding() const;
+
+		///
+		/// \name Event Notifications
+		//@{
+		///
+		/// \brief Subscribe a callback function handler to a given ToneIndexStreamEvents event
+		///
+		/// \param[in] message Use the ToneIndexStreamEvents::Event enum to specify an event to subscribe to
+		/// \param[in] handler A function pointer to the user callback function to execute on the event trigger.
+		/// \since 2.1
+		void ToneIndexStreamEventSubscribe(const int message, IEventHandler* handler);
+		///
+		/// \brief Unsubscribe a callback function handler from a given ToneIndexStreamEvents event
+		///
+		/// \param[in] message Use the ToneIndexStreamEvents::Event enum to specify an event to unsubscribe from
+		/// \param[in] handler A function pointer to the user callback function that will no longer execute on an event
+		/// \since 2.1
+		void ToneIndexStreamEventUnsubscribe(const int message, const IEventHandler* handler);
+		//@}
+
+	private:
+		// Makes this object non-copyable
+		ToneIndexStream(const ToneIndexStream &);
+		const ToneIndexStream &operator =(const ToneIndexStream &);
+
+		class Impl;
+		Impl * p_Impl;
+	};
 }
 
 #undef EXPIMP_TEMPLATE
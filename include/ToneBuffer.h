@@ -351,6 +351,20 @@ namespace iMS {
 		/// \brief Downloads a single TBEntry to LTB memory on Synthesiser
 		/// \since 1.9
 		bool StartDownload(std::size_t index);
+		/// \brief Downloads only the TBEntry 's that have changed since the last download to this Synthesiser
+		///
+		/// The library keeps a record of the LTB contents last downloaded successfully to each iMS System,
+		/// from any ToneBufferDownload.  The current contents of the ToneBuffer are compared against that record
+		/// and only the entries that differ are sent.  Entries with no record (for example, before the first
+		/// download after connecting, or after a download error) are always sent.  The record is discarded
+		/// whenever the iMS System is connected or disconnected.  A single DOWNLOAD_FINISHED
+		/// event is raised once every entry sent has been acknowledged, immediately if nothing has changed.
+		///
+		/// The record cannot see changes made to the LTB by other means, such as a power cycle or recalling
+		/// a ToneBuffer from non-volatile memory.  Perform a full download to resynchronise after these.
+		/// \return Boolean indicating whether Download has started successfully
+		/// \since 2.1
+		bool StartIncrementalDownload();
 		/// \brief No Verify is possible. Always returns false
 		/// \since 1.1
 		bool StartVerify() { return false; };
@@ -3,6 +3,7 @@
 
 #include "tftp_packet.h"
 #include <cstdint>
+#include <functional>
 
 #define TFTP_CLIENT_SERVER_TIMEOUT 2000
 
@@ -38,6 +39,8 @@ class TFTPClient {
 		~TFTPClient();
 
 		bool getFile(const char* filename, boost::container::deque<std::uint8_t>&);
+		// Passes each block to 'sink' as it arrives.  If the sink returns false the transfer is abandoned.
+		bool getFile(const char* filename, const std::function<bool(const std::uint8_t*, std::size_t)>& sink);
 		bool sendFile(const boost::container::deque<std::uint8_t>&, const char* destination);
 
 		int waitForPacket(TFTP_Packet* packet, int timeout_ms = TFTP_CLIENT_SERVER_TIMEOUT);
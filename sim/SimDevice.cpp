@@ -0,0 +1,771 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Simulated iMS Device CPP
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/sim/SimDevice.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 603 $
+/------------------------------------------------------------------------------
+/ Description:
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "SimDevice.h"
+
+#include "HostReport.h"
+#include "IMSConstants.h"
+#include "IOReport.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace iMS {
+namespace sim {
+
+	namespace {
+		// DeviceReport header bits
+		const std::uint8_t DEV_HDR_DATA_OK = 0x40;
+		const std::uint8_t DEV_HDR_GNL_ERROR = 0x20;
+		const std::uint8_t DEV_HDR_CRC_ERROR = 0x00;
+
+		const std::size_t HDR_LEN = 7;
+		const std::size_t CRC_LEN = 2;
+		const std::size_t HOST_PAYLOAD_MAX = 64;
+
+		const std::uint16_t CHAN_SCOPE_SUPPORTED = 0x100;
+
+		// File System Table location in Synthesiser EEPROM
+		const std::uint32_t FST_START = 512;
+
+		// Sequence download buffer base address reported to the host
+		const std::uint32_t SEQ_BUFFER_ADDR = 0x40000000;
+
+		// Image memory allocations are aligned to this many bytes
+		const std::uint32_t IMAGE_ALIGN = 4096;
+
+		std::uint8_t Action(HostReport::Actions a) { return static_cast<std::uint8_t>(a); }
+
+		std::uint32_t GetU32(const std::vector<std::uint8_t>& v, std::size_t pos)
+		{
+			std::uint32_t r = 0;
+			for (std::size_t i = 0; i < 4 && (pos + i) < v.size(); i++) r |= static_cast<std::uint32_t>(v[pos + i]) << (8 * i);
+			return r;
+		}
+
+		std::uint16_t GetU16(const std::vector<std::uint8_t>& v, std::size_t pos)
+		{
+			return static_cast<std::uint16_t>(GetU32(v, pos) & 0xFFFF);
+		}
+
+		void PutU32(std::vector<std::uint8_t>& v, std::uint32_t x)
+		{
+			for (int i = 0; i < 4; i++) v.push_back(static_cast<std::uint8_t>((x >> (8 * i)) & 0xFF));
+		}
+
+		void PutU16(std::vector<std::uint8_t>& v, std::uint16_t x)
+		{
+			v.push_back(static_cast<std::uint8_t>(x & 0xFF));
+			v.push_back(static_cast<std::uint8_t>(x >> 8));
+		}
+
+		std::string UUIDString(const std::array<std::uint8_t, 16>& uuid)
+		{
+			static const char hex[] = "0123456789abcdef";
+			std::string s;
+			for (auto b : uuid) {
+				s += hex[b >> 4];
+				s += hex[b & 0xF];
+			}
+			return s;
+		}
+	}
+
+	SimDevice::SimDevice(const SimConfig& cfg) :
+		m_cfg(cfg),
+		m_ctrlrRegs(0x10000, 0),
+		m_synthRegs(0x10000, 0),
+		m_synthEEPROM(cfg.synthEEPROM, 0xFF),
+		m_images(cfg.imageSlots)
+	{
+		// Build date 2026-10-18 10:00, packed as the firmware does
+		const std::uint16_t date = static_cast<std::uint16_t>((26 << 9) | (10 << 5) | 18);
+		for (auto regs : { &m_ctrlrRegs, &m_synthRegs }) {
+			(*regs)[5] = static_cast<std::uint16_t>((m_cfg.fwMajor << 8) | (m_cfg.fwMinor & 0xFF));
+			(*regs)[6] = m_cfg.fwRevision;
+			(*regs)[7] = date;
+			(*regs)[8] = 0x0A00;
+		}
+		m_ctrlrRegs[0] = m_cfg.ctrlrMagic;
+		m_synthRegs[0] = m_cfg.synthMagic;
+		// Firmware supports channel scoped compensation
+		m_synthRegs[SYNTH_REG_Chan_Scope] = CHAN_SCOPE_SUPPORTED;
+
+		// Empty File System Table: magic, no entries, version 1
+		if (m_synthEEPROM.size() >= FST_START + 512) {
+			std::fill(m_synthEEPROM.begin() + FST_START, m_synthEEPROM.begin() + FST_START + 512, 0);
+			m_synthEEPROM[FST_START + 0] = static_cast<std::uint8_t>(m_cfg.synthMagic & 0xFF);
+			m_synthEEPROM[FST_START + 1] = static_cast<std::uint8_t>(m_cfg.synthMagic >> 8);
+			m_synthEEPROM[FST_START + 2] = 0;
+			m_synthEEPROM[FST_START + 3] = 1;
+		}
+		m_auxEEPROM[Action(HostReport::Actions::AOD_EEPROM)] = std::vector<std::uint8_t>(2048, 0xFF);
+		m_auxEEPROM[Action(HostReport::Actions::RFA_EEPROM)] = std::vector<std::uint8_t>(2048, 0xFF);
+
+		m_player = std::thread(&SimDevice::Player, this);
+	}
+
+	SimDevice::~SimDevice()
+	{
+		{
+			std::lock_guard<std::mutex> lck{ m_mutex };
+			m_running = false;
+		}
+		m_cond.notify_all();
+		m_player.join();
+	}
+
+	std::uint16_t SimDevice::CRC16(const std::uint8_t* data, std::size_t len)
+	{
+		// Same generator as the SDK's CRCGenerator: poly 0x8005, initial value 0, MSB first
+		unsigned int crc = 0;
+		for (std::size_t n = 0; n < len; n++) {
+			crc ^= static_cast<unsigned int>(data[n]) << 8;
+			for (int i = 0; i < 8; i++) {
+				crc <<= 1;
+				if (crc & 0x10000) crc = (crc ^ 0x8005) & 0xFFFF;
+			}
+		}
+		return static_cast<std::uint16_t>(crc);
+	}
+
+	std::vector<std::uint8_t> SimDevice::EncodeReport(std::uint8_t id, std::uint8_t hdr, std::uint8_t context, std::uint16_t addr,
+		const std::vector<std::uint8_t>& payload)
+	{
+		std::vector<std::uint8_t> out;
+		out.reserve(HDR_LEN + payload.size() + CRC_LEN);
+		out.push_back(id);
+		out.push_back(hdr);
+		out.push_back(context);
+		PutU16(out, static_cast<std::uint16_t>(payload.size()));
+		PutU16(out, addr);
+		out.insert(out.end(), payload.begin(), payload.end());
+		PutU16(out, CRC16(out.data(), out.size()));
+		return out;
+	}
+
+	SimDevice::ParseResult SimDevice::ParseHostFrame(const std::vector<std::uint8_t>& buf, HostFrame& frame, std::size_t& used)
+	{
+		if (buf.empty()) return ParseResult::INCOMPLETE;
+		if ((buf[0] != static_cast<std::uint8_t>(ReportTypes::HOST_REPORT_ID_SYNTH)) &&
+			(buf[0] != static_cast<std::uint8_t>(ReportTypes::HOST_REPORT_ID_CTRLR))) {
+			used = 1;
+			return ParseResult::BAD_ID;
+		}
+		if (buf.size() < HDR_LEN) return ParseResult::INCOMPLETE;
+
+		const std::uint8_t hdr = buf[1];
+		const std::uint16_t len = static_cast<std::uint16_t>(buf[3] | (buf[4] << 8));
+
+		// The length field carries the requested length for reads and the payload length for
+		// writes, but a few writes set a length without attaching any payload.  Try the usual
+		// interpretation first and let the CRC decide.
+		const std::size_t carried = std::min<std::size_t>(len, HOST_PAYLOAD_MAX);
+		const bool is_read = (hdr & static_cast<std::uint8_t>(HostReport::Dir::READ)) != 0;
+		const std::size_t candidates[2] = { is_read ? 0 : carried, is_read ? carried : 0 };
+
+		bool all_present = true;
+		for (std::size_t n : candidates) {
+			if (buf.size() < HDR_LEN + n + CRC_LEN) {
+				all_present = false;
+				continue;
+			}
+			const std::uint16_t crc = static_cast<std::uint16_t>(buf[HDR_LEN + n] | (buf[HDR_LEN + n + 1] << 8));
+			if (crc == CRC16(buf.data(), HDR_LEN + n)) {
+				frame.id = buf[0];
+				frame.hdr = hdr;
+				frame.context = buf[2];
+				frame.len = len;
+				frame.addr = static_cast<std::uint16_t>(buf[5] | (buf[6] << 8));
+				frame.payload.assign(buf.begin() + HDR_LEN, buf.begin() + HDR_LEN + n);
+				used = HDR_LEN + n + CRC_LEN;
+				return ParseResult::FRAME;
+			}
+		}
+		if (!all_present) return ParseResult::INCOMPLETE;
+
+		used = HDR_LEN + candidates[0] + CRC_LEN;
+		return ParseResult::BAD_CRC;
+	}
+
+	std::vector<std::uint8_t> SimDevice::CRCErrorResponse(const std::vector<std::uint8_t>& buf)
+	{
+		const std::uint8_t id = (buf[0] == static_cast<std::uint8_t>(ReportTypes::HOST_REPORT_ID_CTRLR)) ?
+			static_cast<std::uint8_t>(ReportTypes::DEVICE_REPORT_ID_CTRLR) : static_cast<std::uint8_t>(ReportTypes::DEVICE_REPORT_ID_SYNTH);
+		return EncodeReport(id, DEV_HDR_CRC_ERROR, 0, 0, std::vector<std::uint8_t>());
+	}
+
+	void SimDevice::SetInterruptSink(InterruptSink sink)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+		m_interruptSink = std::move(sink);
+	}
+
+	void SimDevice::OnConnect()
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+		m_intrMask = 0;
+	}
+
+	std::vector<std::uint8_t> SimDevice::Handle(const HostFrame& req)
+	{
+		const bool ctrlr = (req.id == static_cast<std::uint8_t>(ReportTypes::HOST_REPORT_ID_CTRLR));
+
+		// Recover the HostReport action from the header nibble and the extended action flag in
+		// the context byte.  Controller actions reuse the context byte for operation codes so
+		// only CTRLR_FW_UPGRADE (nibble 0) is interpreted that way.
+		std::uint8_t action = req.hdr & 0x0F;
+		if (ctrlr) {
+			action |= 0x10;
+			if ((action == 0x10) && (req.context & 0x1)) action = Action(HostReport::Actions::CTRLR_FW_UPGRADE);
+		}
+		else if ((action <= 0x01) && (req.context & 0x1)) {
+			action |= 0x20;
+		}
+
+		Payload out;
+		std::uint16_t addr = req.addr;
+		bool ok;
+		{
+			std::lock_guard<std::mutex> lck{ m_mutex };
+			ok = ctrlr ? HandleCtrlr(action, req, addr, out) : HandleSynth(action, req, out);
+		}
+
+		if (m_cfg.verbose) {
+			std::cout << (ctrlr ? "CTRLR " : "SYNTH ") << ((req.hdr & 0x80) ? "RD " : "WR ")
+				<< "act=0x" << std::hex << static_cast<int>(action) << " ctx=" << static_cast<int>(req.context)
+				<< " addr=" << std::dec << req.addr << " len=" << req.len << " payload=" << req.payload.size()
+				<< (ok ? "" : " -> ERROR") << std::endl;
+		}
+
+		const std::uint8_t id = ctrlr ? static_cast<std::uint8_t>(ReportTypes::DEVICE_REPORT_ID_CTRLR) :
+			static_cast<std::uint8_t>(ReportTypes::DEVICE_REPORT_ID_SYNTH);
+		const std::uint8_t hdr = ok ? static_cast<std::uint8_t>(DEV_HDR_DATA_OK | (req.hdr & 0x0F)) : DEV_HDR_GNL_ERROR;
+		if (!ok) out.clear();
+		return EncodeReport(id, hdr, req.context, addr, out);
+	}
+
+	bool SimDevice::HandleSynth(std::uint8_t action, const HostFrame& req, Payload& out)
+	{
+		switch (static_cast<HostReport::Actions>(action))
+		{
+		case HostReport::Actions::SYNTH_REG: {
+			const bool ok = RegisterAccess(m_synthRegs, req, out);
+			// The channel scope support flag is read only
+			m_synthRegs[SYNTH_REG_Chan_Scope] |= CHAN_SCOPE_SUPPORTED;
+			// Writing an index to ProgLocal commits the staged tone to that LTB entry
+			if (ok && !(req.hdr & 0x80) && (req.addr == SYNTH_REG_ProgLocal)) {
+				auto& entry = m_ltb[m_synthRegs[SYNTH_REG_ProgLocal] & 0xFF];
+				entry.assign(m_synthRegs.begin() + SYNTH_REG_ProgSyncDig, m_synthRegs.begin() + SYNTH_REG_ProgPhase3 + 1);
+				entry.push_back(m_synthRegs[SYNTH_REG_ProgFreq0L]);
+				m_ltbWrites++;
+			}
+			return ok;
+		}
+		case HostReport::Actions::SYNTH_EEPROM: return MemoryAccess(m_synthEEPROM, req, out);
+		case HostReport::Actions::AOD_EEPROM:
+		case HostReport::Actions::RFA_EEPROM: return MemoryAccess(m_auxEEPROM[action], req, out);
+		default: return GenericAccess(action, req, out);
+		}
+	}
+
+	bool SimDevice::HandleCtrlr(std::uint8_t action, const HostFrame& req, std::uint16_t& addr, Payload& out)
+	{
+		switch (static_cast<HostReport::Actions>(action))
+		{
+		case HostReport::Actions::CTRLR_REG: return RegisterAccess(m_ctrlrRegs, req, out);
+		case HostReport::Actions::CTRLR_IMGIDX: return HandleImageIndex(req, addr, out);
+		case HostReport::Actions::CTRLR_SEQQUEUE: return HandleSeqQueue(req, out);
+		case HostReport::Actions::CTRLR_SEQPLAY: return HandleSeqPlay(req);
+		case HostReport::Actions::CTRLR_INTREN: {
+			if (req.hdr & 0x80) {
+				PutU32(out, m_intrMask);
+			}
+			else if (!req.payload.empty()) {
+				const std::uint32_t mask = GetU32(req.payload, 0);
+				if (req.addr == 1) m_intrMask |= mask;
+				else m_intrMask &= mask;
+			}
+			else if (req.addr == 0) {
+				// Disconnect sends an empty mask
+				m_intrMask = 0;
+			}
+			return true;
+		}
+		default: return GenericAccess(action, req, out);
+		}
+	}
+
+	// Registers not otherwise modelled behave as plain storage
+	bool SimDevice::GenericAccess(std::uint8_t action, const HostFrame& req, Payload& out)
+	{
+		const std::uint32_t key = (static_cast<std::uint32_t>(action) << 24) | (static_cast<std::uint32_t>(req.context) << 16) | req.addr;
+		if (req.hdr & 0x80) {
+			auto it = m_generic.find(key);
+			out = (it != m_generic.end()) ? it->second : Payload();
+			out.resize(req.len, 0);
+		}
+		else if (!req.payload.empty()) {
+			m_generic[key] = req.payload;
+		}
+		return true;
+	}
+
+	bool SimDevice::RegisterAccess(std::vector<std::uint16_t>& regs, const HostFrame& req, Payload& out)
+	{
+		if (req.hdr & 0x80) {
+			const std::size_t words = (std::max<std::size_t>(req.len, 2) + 1) / 2;
+			if (req.addr + words > regs.size()) return false;
+			for (std::size_t i = 0; i < words; i++) PutU16(out, regs[req.addr + i]);
+			out.resize(std::max<std::size_t>(req.len, 2));
+			return true;
+		}
+
+		for (std::size_t i = 0; i < req.payload.size(); i += 2) {
+			const std::size_t r = req.addr + (i / 2);
+			if (r >= regs.size()) return false;
+			// Identity registers are read only
+			if ((r == 0) || ((r >= 5) && (r <= 8))) continue;
+			regs[r] = GetU16(req.payload, i);
+		}
+		return true;
+	}
+
+	bool SimDevice::MemoryAccess(std::vector<std::uint8_t>& mem, const HostFrame& req, Payload& out)
+	{
+		const std::size_t addr = (static_cast<std::size_t>(req.context) << 16) | req.addr;
+		if (req.hdr & 0x80) {
+			if (addr + req.len > mem.size()) return false;
+			out.assign(mem.begin() + addr, mem.begin() + addr + req.len);
+			return true;
+		}
+		if (addr + req.payload.size() > mem.size()) return false;
+		std::copy(req.payload.begin(), req.payload.end(), mem.begin() + addr);
+		return true;
+	}
+
+	bool SimDevice::AllocateImage(std::uint32_t bytes, std::uint32_t& address) const
+	{
+		// First fit between existing allocations, sorted by address
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> used;
+		for (const auto& s : m_images) {
+			if (s.used) used.emplace_back(s.address, s.address + s.bytes);
+		}
+		std::sort(used.begin(), used.end());
+
+		const std::uint32_t size = ((bytes + IMAGE_ALIGN - 1) / IMAGE_ALIGN) * IMAGE_ALIGN;
+		std::uint64_t candidate = 0;
+		for (const auto& u : used) {
+			if (candidate + size <= u.first) break;
+			candidate = std::max<std::uint64_t>(candidate, ((static_cast<std::uint64_t>(u.second) + IMAGE_ALIGN - 1) / IMAGE_ALIGN) * IMAGE_ALIGN);
+		}
+		if (candidate + size > m_cfg.imageMemory) return false;
+		address = static_cast<std::uint32_t>(candidate);
+		return true;
+	}
+
+	bool SimDevice::HandleImageIndex(const HostFrame& req, std::uint16_t& addr, Payload& out)
+	{
+		switch (static_cast<HostReport::ImageIndexOperations>(req.context))
+		{
+		case HostReport::ImageIndexOperations::ADD_ENTRY: {
+			if (req.payload.size() < 28) return false;
+			auto slot = std::find_if(m_images.begin(), m_images.end(), [](const ImageSlot& s) { return !s.used; });
+			if (slot == m_images.end()) return false;
+
+			ImageSlot s;
+			std::copy(req.payload.begin(), req.payload.begin() + 16, s.uuid.begin());
+			s.bytes = GetU32(req.payload, 16);
+			s.npts = GetU32(req.payload, 20);
+			s.format = GetU32(req.payload, 24);
+			s.name.fill(' ');
+			for (std::size_t i = 0; i < 16 && (28 + i) < req.payload.size(); i++) s.name[i] = req.payload[28 + i];
+			if (!AllocateImage(s.bytes, s.address)) return false;
+			s.used = true;
+			*slot = std::move(s);
+
+			addr = static_cast<std::uint16_t>(std::distance(m_images.begin(), slot));
+			PutU32(out, slot->address);
+			return true;
+		}
+		case HostReport::ImageIndexOperations::DEL_ENTRY: {
+			if (req.addr >= m_images.size() || !m_images[req.addr].used) return false;
+			m_images[req.addr] = ImageSlot();
+			return true;
+		}
+		case HostReport::ImageIndexOperations::GET_ENTRY: {
+			if (req.addr >= m_images.size() || !m_images[req.addr].used) return false;
+			const ImageSlot& s = m_images[req.addr];
+			out.assign(s.uuid.begin(), s.uuid.end());
+			PutU32(out, s.bytes);
+			PutU32(out, s.npts);
+			PutU32(out, s.format);
+			PutU32(out, s.address);
+			out.push_back(s.status);
+			out.insert(out.end(), s.name.begin(), s.name.end());
+			return true;
+		}
+		case HostReport::ImageIndexOperations::CHECK_UUID: {
+			if (req.payload.size() < 16) return false;
+			for (std::size_t i = 0; i < m_images.size(); i++) {
+				if (m_images[i].used && std::equal(m_images[i].uuid.begin(), m_images[i].uuid.end(), req.payload.begin())) {
+					PutU16(out, static_cast<std::uint16_t>(i));
+					return true;
+				}
+			}
+			return false;
+		}
+		case HostReport::ImageIndexOperations::GET_TABLE_SIZE: {
+			PutU16(out, static_cast<std::uint16_t>(m_images.size()));
+			return true;
+		}
+		case HostReport::ImageIndexOperations::ERASE_ALL: {
+			std::fill(m_images.begin(), m_images.end(), ImageSlot());
+			return true;
+		}
+		default: return false;
+		}
+	}
+
+	std::deque<SimDevice::Sequence>::iterator SimDevice::FindSequence(const std::uint8_t* uuid)
+	{
+		return std::find_if(m_seqQueue.begin(), m_seqQueue.end(),
+			[&](const Sequence& s) { return std::equal(s.uuid.begin(), s.uuid.end(), uuid); });
+	}
+
+	std::uint32_t SimDevice::PlayPosition() const
+	{
+		if (m_seqQueue.empty() || !m_headStarted || (m_seqQueue.front().entries == 0)) return 0;
+
+		auto remaining = (m_playState == PlayState::PAUSED) ? m_pausedRemaining : (m_headDeadline - std::chrono::steady_clock::now());
+		const double done = 1.0 - std::max(0.0, std::chrono::duration<double>(remaining).count() /
+			std::chrono::duration<double>(m_cfg.seqPlayTime).count());
+		return std::min(m_seqQueue.front().entries - 1, static_cast<std::uint32_t>(done * m_seqQueue.front().entries));
+	}
+
+	bool SimDevice::HandleSeqQueue(const HostFrame& req, Payload& out)
+	{
+		if (req.hdr & 0x80) {
+			switch (req.context)
+			{
+			case 0:
+				// Queue length, fast download and large sequence support
+				PutU16(out, static_cast<std::uint16_t>(m_seqQueue.size()));
+				out.push_back(1);
+				out.push_back(1);
+				return true;
+			case 1:
+				if (req.addr >= m_seqQueue.size()) return false;
+				out.assign(m_seqQueue[req.addr].uuid.begin(), m_seqQueue[req.addr].uuid.end());
+				return true;
+			case 8:
+				out.push_back(static_cast<std::uint8_t>(m_playState));
+				PutU32(out, PlayPosition());
+				if (m_seqQueue.empty()) out.resize(21, 0);
+				else out.insert(out.end(), m_seqQueue.front().uuid.begin(), m_seqQueue.front().uuid.end());
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		const Payload& p = req.payload;
+		switch (req.context)
+		{
+		case 0: {
+			// Create sequence
+			if (p.size() < 18) return false;
+			Sequence s;
+			std::copy(p.begin(), p.begin() + 16, s.uuid.begin());
+			s.entries = GetU16(p, 16);
+			if ((p.size() >= 23) && (p[18] != 0)) {
+				s.fast = true;
+				s.size = GetU32(p, 19);
+				if ((s.entries == 0) && (p.size() >= 27)) s.entries = GetU32(p, 23);
+			}
+			if (s.entries == 0) return false;
+			m_seqQueue.push_back(s);
+
+			if (s.fast) {
+				m_fastPending = true;
+				m_fastUUID = s.uuid;
+				PutU32(out, SEQ_BUFFER_ADDR);
+				PutU32(out, m_cfg.seqBuffer);
+			}
+			return true;
+		}
+		case 1: case 6: case 7:
+			// Sequence entry (image, tone buffer, ...) for the sequence being built
+			return (!m_seqQueue.empty() && !m_seqQueue.back().committed && (req.addr < m_seqQueue.back().entries));
+		case 2: {
+			// Commit
+			if (m_seqQueue.empty() || m_seqQueue.back().committed || p.size() < 5) return false;
+			Sequence& s = m_seqQueue.back();
+			s.termAction = p[0];
+			s.termValue = GetU32(p, 1);
+			if (p.size() >= 21) std::copy(p.begin() + 5, p.begin() + 21, s.termTag.begin());
+			s.committed = true;
+			m_fastPending = false;
+			m_cond.notify_all();
+			return true;
+		}
+		case 3: {
+			// Update termination
+			if (p.size() < 21) return false;
+			auto it = FindSequence(p.data());
+			if (it == m_seqQueue.end()) return false;
+			it->termAction = p[16];
+			it->termValue = GetU32(p, 17);
+			if (p.size() >= 37) std::copy(p.begin() + 21, p.begin() + 37, it->termTag.begin());
+			return true;
+		}
+		case 4: {
+			// Remove
+			if (p.size() < 16) return false;
+			auto it = FindSequence(p.data());
+			if (it == m_seqQueue.end()) return false;
+			if (it == m_seqQueue.begin()) m_headStarted = false;
+			m_seqQueue.erase(it);
+			m_cond.notify_all();
+			return true;
+		}
+		case 5: {
+			// Clear
+			m_seqQueue.clear();
+			m_fastPending = false;
+			if (m_playState != PlayState::STOPPED) StopPlayback(CTRLR_INTERRUPT_SEQUENCE_ERROR);
+			return true;
+		}
+		case 9: {
+			// Move src in front of dest
+			if (p.size() < 32) return false;
+			auto src = FindSequence(p.data() + 16);
+			if ((src == m_seqQueue.end()) || (FindSequence(p.data()) == m_seqQueue.end())) return false;
+			if (src == m_seqQueue.begin()) m_headStarted = false;
+			Sequence s = *src;
+			m_seqQueue.erase(src);
+			auto dest = FindSequence(p.data());
+			if (dest == m_seqQueue.begin()) m_headStarted = false;
+			m_seqQueue.insert(dest, s);
+			return true;
+		}
+		case 10: {
+			// Move to end
+			if (p.size() < 16) return false;
+			auto src = FindSequence(p.data());
+			if (src == m_seqQueue.end()) return false;
+			if (src == m_seqQueue.begin()) m_headStarted = false;
+			Sequence s = *src;
+			m_seqQueue.erase(src);
+			m_seqQueue.push_back(s);
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	bool SimDevice::HandleSeqPlay(const HostFrame& req)
+	{
+		switch (req.addr)
+		{
+		case CTRLR_SEQPLAY_Seq_Start:
+			if (m_playState == PlayState::STOPPED) {
+				m_playState = PlayState::PLAYING;
+				m_headStarted = false;
+			}
+			break;
+		case CTRLR_SEQPLAY_Seq_Stop:
+			if (m_playState != PlayState::STOPPED) StopPlayback(CTRLR_INTERRUPT_SEQUENCE_FINISHED);
+			break;
+		case CTRLR_SEQPLAY_Seq_Pause:
+			if (m_playState == PlayState::PLAYING) {
+				m_playState = PlayState::PAUSED;
+				m_pausedRemaining = m_headDeadline - std::chrono::steady_clock::now();
+			}
+			break;
+		case CTRLR_SEQPLAY_Seq_Restart:
+			if (m_playState == PlayState::PAUSED) {
+				m_playState = PlayState::PLAYING;
+				m_headDeadline = std::chrono::steady_clock::now() + m_pausedRemaining;
+			}
+			break;
+		case CTRLR_SEQPLAY_USR_Trig:
+		default:
+			break;
+		}
+		m_cond.notify_all();
+		return true;
+	}
+
+	void SimDevice::StopPlayback(std::uint16_t interrupt)
+	{
+		m_playState = PlayState::STOPPED;
+		m_headStarted = false;
+		RaiseInterrupt(interrupt, 0);
+		m_cond.notify_all();
+	}
+
+	void SimDevice::FinishSequence()
+	{
+		enum TermAction { DISCARD = 0, RECYCLE = 1, STOP_DISCARD = 2, STOP_RECYCLE = 3, REPEAT = 4, REPEAT_FROM = 5, INSERT = 7, STOP_INSERT = 8 };
+
+		Sequence head = m_seqQueue.front();
+		bool stop = false;
+		switch (head.termAction)
+		{
+		case STOP_DISCARD: stop = true; // fall through
+		case DISCARD: m_seqQueue.pop_front(); break;
+		case STOP_RECYCLE: stop = true; // fall through
+		case RECYCLE: m_seqQueue.pop_front(); m_seqQueue.push_back(head); break;
+		case STOP_INSERT: stop = true; // fall through
+		case INSERT: {
+			m_seqQueue.pop_front();
+			m_seqQueue.insert(FindSequence(head.termTag.data()), head);
+			break;
+		}
+		case REPEAT:
+		case REPEAT_FROM:
+		default: break;
+		}
+		m_headStarted = false;
+
+		if (stop || m_seqQueue.empty()) StopPlayback(CTRLR_INTERRUPT_SEQUENCE_FINISHED);
+	}
+
+	void SimDevice::Player()
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		while (m_running) {
+			if ((m_playState != PlayState::PLAYING) || m_seqQueue.empty() || !m_seqQueue.front().committed) {
+				m_cond.wait(lck);
+				continue;
+			}
+			if (!m_headStarted) {
+				m_headStarted = true;
+				m_headDeadline = std::chrono::steady_clock::now() + m_cfg.seqPlayTime;
+				const auto& uuid = m_seqQueue.front().uuid;
+				RaiseInterrupt(CTRLR_INTERRUPT_SEQUENCE_START, Payload(uuid.begin(), uuid.end()));
+			}
+			m_cond.wait_until(lck, m_headDeadline);
+			if ((m_playState == PlayState::PLAYING) && m_headStarted && !m_seqQueue.empty() &&
+				(std::chrono::steady_clock::now() >= m_headDeadline)) {
+				FinishSequence();
+			}
+		}
+	}
+
+	void SimDevice::RaiseInterrupt(std::uint16_t type, const Payload& data)
+	{
+		if (!(m_intrMask & (1u << type)) || !m_interruptSink) return;
+		m_interruptSink(EncodeReport(static_cast<std::uint8_t>(ReportTypes::INTERRUPT_REPORT_ID_CTRLR), DEV_HDR_DATA_OK, 0, type, data));
+	}
+
+	void SimDevice::RaiseInterrupt(std::uint16_t type, std::uint16_t value)
+	{
+		Payload p;
+		PutU16(p, value);
+		RaiseInterrupt(type, p);
+	}
+
+	void SimDevice::FileWritten(const std::string& name, std::vector<std::uint8_t>&& data)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+
+		for (auto& s : m_images) {
+			if (s.used && (UUIDString(s.uuid) == name)) {
+				s.data = std::move(data);
+				s.status = 1;
+				return;
+			}
+		}
+
+		if (m_fastPending) {
+			// Chunks of a fast sequence download are named after the sequence UUID, with the first
+			// byte incremented for each chunk.  Completion is reported by interrupt.
+			auto it = FindSequence(m_fastUUID.data());
+			if (it != m_seqQueue.end()) {
+				it->received += static_cast<std::uint32_t>(data.size());
+				it->buffer.insert(it->buffer.end(), data.begin(), data.end());
+				if (it->received >= it->size) {
+					RaiseInterrupt(CTRLR_INTERRUPT_SEQDL_COMPLETE, static_cast<std::uint16_t>(std::min<std::uint32_t>(it->entries, 0xFFFF)));
+				}
+				else {
+					RaiseInterrupt(CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED, 0);
+				}
+				return;
+			}
+			m_fastPending = false;
+			RaiseInterrupt(CTRLR_INTERRUPT_SEQDL_ERROR, 0);
+			return;
+		}
+
+		m_files[name] = std::move(data);
+	}
+
+	bool SimDevice::SequenceBuffer(const std::array<std::uint8_t, 16>& uuid, std::vector<std::uint8_t>& data)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+
+		auto it = FindSequence(uuid.data());
+		if (it == m_seqQueue.end()) return false;
+		data = it->buffer;
+		return true;
+	}
+
+	bool SimDevice::FileRead(const std::string& name, std::vector<std::uint8_t>& data)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+
+		for (const auto& s : m_images) {
+			if (s.used && (UUIDString(s.uuid) == name)) {
+				data = s.data;
+				return true;
+			}
+		}
+		auto it = m_files.find(name);
+		if (it == m_files.end()) return false;
+		data = it->second;
+		return true;
+	}
+
+	std::vector<std::uint16_t> SimDevice::ToneBufferEntry(std::size_t index)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+		return m_ltb.at(index);
+	}
+
+	std::uint32_t SimDevice::ToneBufferWrites()
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+		return m_ltbWrites;
+	}
+
+	std::uint16_t SimDevice::SynthRegister(std::uint16_t addr)
+	{
+		std::lock_guard<std::mutex> lck{ m_mutex };
+		return m_synthRegs.at(addr);
+	}
+
+}
+}
@@ -0,0 +1,218 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Simulated iMS Device Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/sim/SimDevice.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 603 $
+/------------------------------------------------------------------------------
+/ Description: Protocol and state model of an iMS Controller + Synthesiser.
+/              Decodes HostReport frames, maintains register files, EEPROM,
+/              the image index table and the sequence queue, and produces
+/              DeviceReport responses and Controller interrupts.  Contains no
+/              socket code; see SimServer for the network side.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_SIM_DEVICE_H__
+#define IMS_SIM_DEVICE_H__
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace iMS {
+namespace sim {
+
+	struct SimConfig
+	{
+		std::string serial{ "iMSP-SIM001" };
+		std::array<std::uint8_t, 6> mac{ { 0x00, 0x1e, 0xc0, 0x53, 0x49, 0x4d } };
+
+		// Hardware identity, looked up by the SDK in its hardware database
+		std::uint16_t ctrlrMagic{ 44332 };   // iMSP
+		std::uint16_t synthMagic{ 51195 };   // iMS4
+		std::uint16_t fwMajor{ 1 };
+		std::uint16_t fwMinor{ 8 };
+		std::uint16_t fwRevision{ 60 };
+
+		// Controller resources
+		std::uint32_t imageMemory{ 256u << 20 };
+		std::uint16_t imageSlots{ 64 };
+		std::uint32_t seqBuffer{ 1u << 20 };
+		std::uint32_t synthEEPROM{ 128u << 10 };
+
+		// Simulated playback time of each sequence
+		std::chrono::microseconds seqPlayTime{ 10000 };
+
+		// Link impairments applied by SimServer
+		std::uint32_t latencyUs{ 0 };
+		std::uint32_t jitterUs{ 0 };
+		double lossRate{ 0.0 };
+		std::uint32_t seed{ 1 };
+
+		std::uint16_t tftpPort{ 69 };
+		bool verbose{ false };
+	};
+
+	struct HostFrame
+	{
+		std::uint8_t id{ 0 };
+		std::uint8_t hdr{ 0 };
+		std::uint8_t context{ 0 };
+		std::uint16_t len{ 0 };
+		std::uint16_t addr{ 0 };
+		std::vector<std::uint8_t> payload;
+	};
+
+	class SimDevice
+	{
+	public:
+		using InterruptSink = std::function<void(std::vector<std::uint8_t>&&)>;
+
+		enum class ParseResult { INCOMPLETE, FRAME, BAD_CRC, BAD_ID };
+
+		explicit SimDevice(const SimConfig& cfg);
+		~SimDevice();
+
+		// Attempts to decode one HostReport from the front of 'buf'.  'used' is set to the number
+		// of bytes to discard for FRAME, BAD_CRC and BAD_ID results.
+		static ParseResult ParseHostFrame(const std::vector<std::uint8_t>& buf, HostFrame& frame, std::size_t& used);
+
+		// Serialises a DeviceReport exactly as the Controller firmware does
+		static std::vector<std::uint8_t> EncodeReport(std::uint8_t id, std::uint8_t hdr, std::uint8_t context, std::uint16_t addr,
+			const std::vector<std::uint8_t>& payload);
+
+		static std::uint16_t CRC16(const std::uint8_t* data, std::size_t len);
+
+		// Response to a frame that failed its CRC check
+		static std::vector<std::uint8_t> CRCErrorResponse(const std::vector<std::uint8_t>& buf);
+
+		// Executes one host request and returns the serialised response
+		std::vector<std::uint8_t> Handle(const HostFrame& req);
+
+		// Interrupt reports are passed to 'sink' (which must not call back into the device)
+		void SetInterruptSink(InterruptSink sink);
+
+		// Called at the start of each host connection. Interrupt enables are reset, as on hardware.
+		void OnConnect();
+
+		// TFTP file store. Names are UUIDs formatted as 32 lower case hex digits.
+		void FileWritten(const std::string& name, std::vector<std::uint8_t>&& data);
+		bool FileRead(const std::string& name, std::vector<std::uint8_t>& data);
+
+		// Register values committed to one Local Tone Buffer entry: ProgSyncDig to ProgPhase3, then ProgFreq0L
+		std::vector<std::uint16_t> ToneBufferEntry(std::size_t index);
+		// Number of LTB entries programmed since the device was created
+		std::uint32_t ToneBufferWrites();
+		// Current value of a Synthesiser register
+		std::uint16_t SynthRegister(std::uint16_t addr);
+		// Sequence buffer received by fast download for a queued sequence
+		bool SequenceBuffer(const std::array<std::uint8_t, 16>& uuid, std::vector<std::uint8_t>& data);
+
+	private:
+		struct ImageSlot
+		{
+			bool used{ false };
+			std::array<std::uint8_t, 16> uuid{};
+			std::uint32_t bytes{ 0 };
+			std::uint32_t npts{ 0 };
+			std::uint32_t format{ 0 };
+			std::uint32_t address{ 0 };
+			std::uint8_t status{ 0 };
+			std::array<std::uint8_t, 16> name{};
+			std::vector<std::uint8_t> data;
+		};
+
+		struct Sequence
+		{
+			std::array<std::uint8_t, 16> uuid{};
+			std::uint32_t entries{ 0 };
+			bool fast{ false };
+			std::uint32_t size{ 0 };
+			std::uint32_t received{ 0 };
+			std::vector<std::uint8_t> buffer;
+			bool committed{ false };
+			std::uint8_t termAction{ 0 };
+			std::uint32_t termValue{ 0 };
+			std::array<std::uint8_t, 16> termTag{};
+		};
+
+		enum class PlayState { STOPPED, PLAYING, PAUSED };
+
+		using Payload = std::vector<std::uint8_t>;
+
+		bool HandleSynth(std::uint8_t action, const HostFrame& req, Payload& out);
+		bool HandleCtrlr(std::uint8_t action, const HostFrame& req, std::uint16_t& addr, Payload& out);
+		bool GenericAccess(std::uint8_t action, const HostFrame& req, Payload& out);
+		bool HandleImageIndex(const HostFrame& req, std::uint16_t& addr, Payload& out);
+		bool HandleSeqQueue(const HostFrame& req, Payload& out);
+		bool HandleSeqPlay(const HostFrame& req);
+
+		bool RegisterAccess(std::vector<std::uint16_t>& regs, const HostFrame& req, Payload& out);
+		bool MemoryAccess(std::vector<std::uint8_t>& mem, const HostFrame& req, Payload& out);
+		bool AllocateImage(std::uint32_t bytes, std::uint32_t& address) const;
+
+		std::deque<Sequence>::iterator FindSequence(const std::uint8_t* uuid);
+		std::uint32_t PlayPosition() const;
+		void StopPlayback(std::uint16_t interrupt);
+		void FinishSequence();
+		void RaiseInterrupt(std::uint16_t type, const Payload& data);
+		void RaiseInterrupt(std::uint16_t type, std::uint16_t value);
+		void Player();
+
+		const SimConfig m_cfg;
+
+		std::mutex m_mutex;
+		std::condition_variable m_cond;
+		bool m_running{ true };
+
+		std::vector<std::uint16_t> m_ctrlrRegs;
+		std::vector<std::uint16_t> m_synthRegs;
+		std::array<std::vector<std::uint16_t>, 256> m_ltb;
+		std::uint32_t m_ltbWrites{ 0 };
+		std::vector<std::uint8_t> m_synthEEPROM;
+		std::map<std::uint8_t, std::vector<std::uint8_t>> m_auxEEPROM;
+		std::map<std::uint32_t, Payload> m_generic;
+
+		std::vector<ImageSlot> m_images;
+
+		std::map<std::string, Payload> m_files;
+
+		std::deque<Sequence> m_seqQueue;
+		bool m_fastPending{ false };
+		std::array<std::uint8_t, 16> m_fastUUID{};
+		PlayState m_playState{ PlayState::STOPPED };
+		bool m_headStarted{ false };
+		std::chrono::steady_clock::time_point m_headDeadline;
+		std::chrono::steady_clock::duration m_pausedRemaining{};
+
+		std::uint32_t m_intrMask{ 0 };
+		InterruptSink m_interruptSink;
+
+		std::thread m_player;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,398 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Simulated iMS Device Server CPP
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/sim/SimServer.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 603 $
+/------------------------------------------------------------------------------
+/ Description:
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "SimServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace iMS {
+namespace sim {
+
+	namespace {
+		const int POLL_MS = 250;
+
+		// Minimum spacing of interrupt reports.  The host reads each interrupt with a single
+		// recv(), so reports sent back to back could otherwise be coalesced and lost.
+		const auto INTR_SPACING = std::chrono::milliseconds(2);
+
+		const std::size_t TFTP_BLOCK = 512;
+		enum TftpOp : std::uint16_t { TFTP_RRQ = 1, TFTP_WRQ = 2, TFTP_DATA = 3, TFTP_ACK = 4, TFTP_ERROR = 5 };
+
+		int OpenSocket(int type, int port, bool broadcast)
+		{
+			int s = socket(AF_INET, type, 0);
+			if (s < 0) return -1;
+			int on = 1;
+			setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+			if (broadcast) setsockopt(s, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+			sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_port = htons(static_cast<std::uint16_t>(port));
+			addr.sin_addr.s_addr = INADDR_ANY;
+			if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+				std::cerr << "ims_sim: unable to bind port " << port << ": " << std::strerror(errno) << std::endl;
+				close(s);
+				return -1;
+			}
+			return s;
+		}
+
+		bool WaitReadable(int s, int timeout_ms)
+		{
+			pollfd p{ s, POLLIN, 0 };
+			return (poll(&p, 1, timeout_ms) > 0) && (p.revents & (POLLIN | POLLHUP | POLLERR));
+		}
+
+		std::string PeerKey(const sockaddr_in& a)
+		{
+			char ip[INET_ADDRSTRLEN];
+			inet_ntop(AF_INET, &a.sin_addr, ip, sizeof(ip));
+			return std::string(ip) + ":" + std::to_string(ntohs(a.sin_port));
+		}
+
+		void SendAll(int s, const std::vector<std::uint8_t>& data)
+		{
+			std::size_t sent = 0;
+			while (sent < data.size()) {
+				ssize_t n = send(s, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+				if (n <= 0) return;
+				sent += static_cast<std::size_t>(n);
+			}
+		}
+	}
+
+	SimServer::SimServer(const SimConfig& cfg, SimDevice& device) :
+		m_cfg(cfg), m_device(device), m_rng(cfg.seed)
+	{
+		m_device.SetInterruptSink([this](std::vector<std::uint8_t>&& data) { Queue(std::move(data), true); });
+	}
+
+	SimServer::~SimServer()
+	{
+		Stop();
+		m_device.SetInterruptSink(nullptr);
+	}
+
+	void SimServer::Stop()
+	{
+		m_stop.store(true);
+		m_outCond.notify_all();
+	}
+
+	bool SimServer::Drop()
+	{
+		if (m_cfg.lossRate <= 0.0) return false;
+		std::lock_guard<std::mutex> lck{ m_rngMutex };
+		return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < m_cfg.lossRate;
+	}
+
+	SimServer::Clock::duration SimServer::Delay()
+	{
+		std::int64_t us = m_cfg.latencyUs;
+		if (m_cfg.jitterUs) {
+			std::lock_guard<std::mutex> lck{ m_rngMutex };
+			us += std::uniform_int_distribution<std::int64_t>(-static_cast<std::int64_t>(m_cfg.jitterUs), m_cfg.jitterUs)(m_rng);
+		}
+		return std::chrono::microseconds(std::max<std::int64_t>(us, 0));
+	}
+
+	void SimServer::Queue(std::vector<std::uint8_t>&& data, bool interrupt)
+	{
+		const auto delay = Delay();
+		std::lock_guard<std::mutex> lck{ m_outMutex };
+		if (!m_connected) return;
+
+		auto due = Clock::now() + delay;
+		if (interrupt) {
+			due = std::max(due, m_lastIntrDue + INTR_SPACING);
+			m_lastIntrDue = due;
+		}
+		else {
+			due = std::max(due, m_lastMsgDue);
+			m_lastMsgDue = due;
+		}
+		auto pos = std::upper_bound(m_out.begin(), m_out.end(), due, [](const Clock::time_point& t, const Outgoing& o) { return t < o.due; });
+		m_out.insert(pos, Outgoing{ due, interrupt, std::move(data) });
+		m_outCond.notify_all();
+	}
+
+	void SimServer::Sender()
+	{
+		std::unique_lock<std::mutex> lck{ m_outMutex };
+		while (!m_stop.load()) {
+			if (m_out.empty()) {
+				m_outCond.wait_for(lck, std::chrono::milliseconds(POLL_MS));
+				continue;
+			}
+			if (Clock::now() < m_out.front().due) {
+				m_outCond.wait_until(lck, m_out.front().due);
+				continue;
+			}
+			Outgoing o = std::move(m_out.front());
+			m_out.pop_front();
+			const int s = o.interrupt ? m_intrSock : m_msgSock;
+			if (s >= 0) SendAll(s, o.data);
+		}
+	}
+
+	bool SimServer::Run()
+	{
+		m_listenSock = OpenSocket(SOCK_STREAM, MSG_PORT, false);
+		m_discoverySock = OpenSocket(SOCK_DGRAM, ANNOUNCE_PORT, true);
+		m_tftpSock = OpenSocket(SOCK_DGRAM, m_cfg.tftpPort, false);
+		if ((m_listenSock < 0) || (m_discoverySock < 0) || (m_tftpSock < 0) || (listen(m_listenSock, 1) < 0)) {
+			for (int s : { m_listenSock, m_discoverySock, m_tftpSock }) if (s >= 0) close(s);
+			return false;
+		}
+
+		std::cout << "ims_sim: " << m_cfg.serial << " listening on port " << MSG_PORT
+			<< ", discovery " << ANNOUNCE_PORT << ", TFTP " << m_cfg.tftpPort << std::endl;
+
+		m_discovery = std::thread(&SimServer::Discovery, this);
+		m_tftp = std::thread(&SimServer::Tftp, this);
+		m_sender = std::thread(&SimServer::Sender, this);
+
+		while (!m_stop.load()) {
+			if (!WaitReadable(m_listenSock, POLL_MS)) continue;
+			sockaddr_in peer;
+			socklen_t len = sizeof(peer);
+			int s = accept(m_listenSock, reinterpret_cast<sockaddr*>(&peer), &len);
+			if (s < 0) continue;
+			Serve(s, peer);
+		}
+
+		m_discovery.join();
+		m_tftp.join();
+		m_sender.join();
+		close(m_listenSock);
+		close(m_discoverySock);
+		close(m_tftpSock);
+		return true;
+	}
+
+	void SimServer::Serve(int msgSock, const sockaddr_in& peer)
+	{
+		int flag = 1;
+		setsockopt(msgSock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		// The host listens for the interrupt connection once its own connect() has completed
+		int intrSock = socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in intrAddr = peer;
+		intrAddr.sin_port = htons(INTR_PORT);
+		if (connect(intrSock, reinterpret_cast<sockaddr*>(&intrAddr), sizeof(intrAddr)) < 0) {
+			std::cerr << "ims_sim: interrupt connection failed: " << std::strerror(errno) << std::endl;
+			close(intrSock);
+			intrSock = -1;
+		}
+		else {
+			setsockopt(intrSock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+		}
+
+		std::cout << "ims_sim: host connected from " << PeerKey(peer) << std::endl;
+		m_device.OnConnect();
+		{
+			std::lock_guard<std::mutex> lck{ m_outMutex };
+			m_msgSock = msgSock;
+			m_intrSock = intrSock;
+			m_lastMsgDue = m_lastIntrDue = Clock::now();
+			m_connected = true;
+		}
+
+		std::vector<std::uint8_t> rx;
+		std::uint8_t buf[4096];
+		while (!m_stop.load()) {
+			if (!WaitReadable(msgSock, POLL_MS)) continue;
+			ssize_t n = recv(msgSock, buf, sizeof(buf), 0);
+			if (n <= 0) break;
+			rx.insert(rx.end(), buf, buf + n);
+
+			while (!rx.empty()) {
+				HostFrame frame;
+				std::size_t used = 0;
+				auto result = SimDevice::ParseHostFrame(rx, frame, used);
+				if (result == SimDevice::ParseResult::INCOMPLETE) break;
+
+				if (result == SimDevice::ParseResult::FRAME) {
+					auto resp = m_device.Handle(frame);
+					if (!Drop()) Queue(std::move(resp), false);
+				}
+				else if (result == SimDevice::ParseResult::BAD_CRC) {
+					Queue(SimDevice::CRCErrorResponse(rx), false);
+				}
+				rx.erase(rx.begin(), rx.begin() + used);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lck{ m_outMutex };
+			m_connected = false;
+			m_out.clear();
+			m_msgSock = m_intrSock = -1;
+		}
+		close(msgSock);
+		if (intrSock >= 0) close(intrSock);
+		std::cout << "ims_sim: host disconnected" << std::endl;
+	}
+
+	void SimServer::Discovery()
+	{
+		const char query[] = "Discovery: Who is out there?";
+		char buf[512];
+		while (!m_stop.load()) {
+			if (!WaitReadable(m_discoverySock, POLL_MS)) continue;
+			sockaddr_in from;
+			socklen_t len = sizeof(from);
+			ssize_t n = recvfrom(m_discoverySock, buf, sizeof(buf) - 1, 0, reinterpret_cast<sockaddr*>(&from), &len);
+			if (n <= 0) continue;
+			buf[n] = '\0';
+			if (std::strncmp(buf, query, sizeof(query) - 1) != 0) continue;
+
+			// Lines are CRLF terminated; the host strips the character before each '\n'
+			char ip[INET_ADDRSTRLEN];
+			inet_ntop(AF_INET, &from.sin_addr, ip, sizeof(ip));
+			char mac[32];
+			std::snprintf(mac, sizeof(mac), "%02x:%02x:%02x:%02x:%02x:%02x",
+				m_cfg.mac[0], m_cfg.mac[1], m_cfg.mac[2], m_cfg.mac[3], m_cfg.mac[4], m_cfg.mac[5]);
+			std::string reply = "SNO: " + m_cfg.serial + "\r\nMAC: " + mac + "\r\nReqIP: " + ip + "\r\n";
+			sendto(m_discoverySock, reply.data(), reply.size(), 0, reinterpret_cast<sockaddr*>(&from), len);
+
+			if (m_cfg.verbose) std::cout << "ims_sim: discovery from " << PeerKey(from) << std::endl;
+		}
+	}
+
+	void SimServer::Tftp()
+	{
+		struct Transfer
+		{
+			std::string name;
+			bool write;
+			std::vector<std::uint8_t> data;
+			std::uint16_t block;
+		};
+		std::map<std::string, Transfer> transfers;
+
+		auto sendPacket = [&](const sockaddr_in& to, std::vector<std::uint8_t> pkt) {
+			if (Drop()) return;
+			sendto(m_tftpSock, pkt.data(), pkt.size(), 0, reinterpret_cast<const sockaddr*>(&to), sizeof(to));
+		};
+		auto header = [](std::uint16_t op, std::uint16_t num) {
+			return std::vector<std::uint8_t>{ static_cast<std::uint8_t>(op >> 8), static_cast<std::uint8_t>(op & 0xFF),
+				static_cast<std::uint8_t>(num >> 8), static_cast<std::uint8_t>(num & 0xFF) };
+		};
+		auto sendBlock = [&](const sockaddr_in& to, const Transfer& t) {
+			auto pkt = header(TFTP_DATA, t.block);
+			const std::size_t start = std::min(t.data.size(), (t.block - 1) * TFTP_BLOCK);
+			const std::size_t end = std::min(t.data.size(), start + TFTP_BLOCK);
+			pkt.insert(pkt.end(), t.data.begin() + start, t.data.begin() + end);
+			sendPacket(to, pkt);
+		};
+
+		std::vector<std::uint8_t> buf(4 + TFTP_BLOCK + 64);
+		while (!m_stop.load()) {
+			if (!WaitReadable(m_tftpSock, POLL_MS)) continue;
+			sockaddr_in from;
+			socklen_t len = sizeof(from);
+			ssize_t n = recvfrom(m_tftpSock, buf.data(), buf.size(), 0, reinterpret_cast<sockaddr*>(&from), &len);
+			if (n < 4) continue;
+
+			const std::string key = PeerKey(from);
+			const std::uint16_t op = static_cast<std::uint16_t>((buf[0] << 8) | buf[1]);
+			const std::uint16_t num = static_cast<std::uint16_t>((buf[2] << 8) | buf[3]);
+
+			switch (op)
+			{
+			case TFTP_RRQ:
+			case TFTP_WRQ: {
+				Transfer t;
+				t.name = std::string(reinterpret_cast<const char*>(&buf[2]), strnlen(reinterpret_cast<const char*>(&buf[2]), n - 2));
+				t.write = (op == TFTP_WRQ);
+				t.block = t.write ? 0 : 1;
+				if (!t.write && !m_device.FileRead(t.name, t.data)) {
+					auto pkt = header(TFTP_ERROR, 1);
+					const char msg[] = "File not found";
+					pkt.insert(pkt.end(), msg, msg + sizeof(msg));
+					sendPacket(from, pkt);
+					break;
+				}
+				if (m_cfg.verbose) std::cout << "ims_sim: TFTP " << (t.write ? "WRQ " : "RRQ ") << t.name << std::endl;
+				if (t.write) sendPacket(from, header(TFTP_ACK, 0));
+				else sendBlock(from, t);
+				transfers[key] = std::move(t);
+				break;
+			}
+			case TFTP_DATA: {
+				auto it = transfers.find(key);
+				if ((it == transfers.end()) || !it->second.write) break;
+				Transfer& t = it->second;
+				if (num == static_cast<std::uint16_t>(t.block + 1)) {
+					t.data.insert(t.data.end(), buf.begin() + 4, buf.begin() + n);
+					t.block = num;
+				}
+				sendPacket(from, header(TFTP_ACK, num));
+				if (static_cast<std::size_t>(n - 4) < TFTP_BLOCK) {
+					if (m_cfg.verbose) std::cout << "ims_sim: TFTP received " << t.data.size() << " bytes" << std::endl;
+					m_device.FileWritten(t.name, std::move(t.data));
+					transfers.erase(it);
+				}
+				break;
+			}
+			case TFTP_ACK: {
+				auto it = transfers.find(key);
+				if ((it == transfers.end()) || it->second.write) break;
+				Transfer& t = it->second;
+				if (num == t.block) {
+					// The final block is the first one shorter than a full block
+					if ((static_cast<std::size_t>(t.block) * TFTP_BLOCK) > t.data.size()) {
+						transfers.erase(it);
+						break;
+					}
+					t.block++;
+				}
+				// A repeated ACK for the previous block asks for the current one again
+				sendBlock(from, t);
+				break;
+			}
+			case TFTP_ERROR:
+			default:
+				transfers.erase(key);
+				break;
+			}
+		}
+	}
+
+}
+}
@@ -0,0 +1,111 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Simulated iMS Device Server Header
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/sim/SimServer.h $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 603 $
+/------------------------------------------------------------------------------
+/ Description: Network front end of the device simulator.  Answers UDP
+/              discovery, accepts the CM_ENET message connection, connects
+/              back to the host interrupt port, serves TFTP image / sequence
+/              transfers and applies configurable latency, jitter and loss.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#ifndef IMS_SIM_SERVER_H__
+#define IMS_SIM_SERVER_H__
+
+#include "SimDevice.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+
+namespace iMS {
+namespace sim {
+
+	class SimServer
+	{
+	public:
+		// Ports used by CM_ENET
+		static const int ANNOUNCE_PORT = 28242;
+		static const int MSG_PORT = 28244;
+		static const int INTR_PORT = 28245;
+
+		SimServer(const SimConfig& cfg, SimDevice& device);
+		~SimServer();
+
+		// Runs until Stop() is called.  Returns false if a listening socket could not be opened.
+		bool Run();
+		void Stop();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Outgoing
+		{
+			Clock::time_point due;
+			bool interrupt;
+			std::vector<std::uint8_t> data;
+		};
+
+		void Discovery();
+		void Tftp();
+		void Serve(int msgSock, const sockaddr_in& peer);
+		void Sender();
+
+		void Queue(std::vector<std::uint8_t>&& data, bool interrupt);
+		bool Drop();
+		Clock::duration Delay();
+
+		const SimConfig m_cfg;
+		SimDevice& m_device;
+		std::atomic<bool> m_stop{ false };
+
+		int m_listenSock{ -1 };
+		int m_discoverySock{ -1 };
+		int m_tftpSock{ -1 };
+
+		std::thread m_discovery;
+		std::thread m_tftp;
+		std::thread m_sender;
+
+		// Responses and interrupts wait here until their simulated delivery time.  Delivery order
+		// is preserved per socket, as it would be over TCP.
+		std::mutex m_outMutex;
+		std::condition_variable m_outCond;
+		std::deque<Outgoing> m_out;
+		Clock::time_point m_lastMsgDue;
+		Clock::time_point m_lastIntrDue;
+		int m_msgSock{ -1 };
+		int m_intrSock{ -1 };
+		bool m_connected{ false };
+
+		std::mutex m_rngMutex;
+		std::mt19937 m_rng;
+	};
+
+}
+}
+
+#endif
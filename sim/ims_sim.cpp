@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------------------
+/ Title      : iMS Device Simulator
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/sim/ims_sim.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 603 $
+/------------------------------------------------------------------------------
+/ Description: Standalone iMS Controller + Synthesiser simulator.  Presents
+/              itself to the SDK as an Ethernet connected iMS system so that
+/              connection, download and playback code can be exercised and
+/              benchmarked without hardware.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "SimDevice.h"
+#include "SimServer.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace iMS::sim;
+
+namespace {
+
+	SimServer* g_server = nullptr;
+
+	void OnSignal(int)
+	{
+		if (g_server) g_server->Stop();
+	}
+
+	void Usage()
+	{
+		std::cout <<
+			"Usage: ims_sim [options]\n"
+			"  --serial <str>         serial number reported to discovery (default iMSP-SIM001)\n"
+			"  --ctrlr-magic <n>      Controller magic number (default 44332, iMSP)\n"
+			"  --synth-magic <n>      Synthesiser magic number (default 51195, iMS4)\n"
+			"  --fw-revision <n>      firmware revision reported by both devices (default 60)\n"
+			"  --image-memory <bytes> Controller image memory (default 268435456)\n"
+			"  --image-slots <n>      image index table size (default 64)\n"
+			"  --seq-buffer <bytes>   fast sequence download buffer size (default 1048576)\n"
+			"  --seq-play-us <us>     playback time of each sequence (default 10000)\n"
+			"  --latency-us <us>      added one way response latency (default 0)\n"
+			"  --jitter-us <us>       uniform +/- jitter on the latency (default 0)\n"
+			"  --loss <fraction>      probability of dropping a response or TFTP packet (default 0)\n"
+			"  --seed <n>             random seed for jitter and loss (default 1)\n"
+			"  --tftp-port <n>        TFTP server port (default 69; the SDK always uses 69)\n"
+			"  --verbose              log every request\n";
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	SimConfig cfg;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg == "--help" || arg == "-h") {
+			Usage();
+			return 0;
+		}
+		if (arg == "--verbose") {
+			cfg.verbose = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			std::cerr << "ims_sim: missing value for " << arg << std::endl;
+			return 1;
+		}
+		const std::string val = argv[++i];
+		try {
+			if (arg == "--serial") cfg.serial = val;
+			else if (arg == "--ctrlr-magic") cfg.ctrlrMagic = static_cast<std::uint16_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--synth-magic") cfg.synthMagic = static_cast<std::uint16_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--fw-revision") cfg.fwRevision = static_cast<std::uint16_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--image-memory") cfg.imageMemory = static_cast<std::uint32_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--image-slots") cfg.imageSlots = static_cast<std::uint16_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--seq-buffer") cfg.seqBuffer = static_cast<std::uint32_t>(std::stoul(val, nullptr, 0));
+			else if (arg == "--seq-play-us") cfg.seqPlayTime = std::chrono::microseconds(std::stoul(val));
+			else if (arg == "--latency-us") cfg.latencyUs = static_cast<std::uint32_t>(std::stoul(val));
+			else if (arg == "--jitter-us") cfg.jitterUs = static_cast<std::uint32_t>(std::stoul(val));
+			else if (arg == "--loss") cfg.lossRate = std::stod(val);
+			else if (arg == "--seed") cfg.seed = static_cast<std::uint32_t>(std::stoul(val));
+			else if (arg == "--tftp-port") cfg.tftpPort = static_cast<std::uint16_t>(std::stoul(val));
+			else {
+				std::cerr << "ims_sim: unknown option " << arg << std::endl;
+				Usage();
+				return 1;
+			}
+		}
+		catch (const std::exception&) {
+			std::cerr << "ims_sim: bad value for " << arg << ": " << val << std::endl;
+			return 1;
+		}
+	}
+
+	SimDevice device(cfg);
+	SimServer server(cfg, device);
+
+	g_server = &server;
+	std::signal(SIGINT, OnSignal);
+	std::signal(SIGTERM, OnSignal);
+
+	const bool ok = server.Run();
+	g_server = nullptr;
+	return ok ? 0 : 1;
+}
@@ -23,11 +23,18 @@
 
 #include "AcoustoOptics.h"
 #include "PrivateUtil.h"
+#include "HardwareCatalog.h"
 #include "spline.h"
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
 
 // For PI
 #define _USE_MATH_DEFINES
@@ -35,61 +42,6 @@
 
 namespace iMS
 {
-	struct CrystalData {
-		CrystalData() {}
-
-		std::string Description;
-		double Wavelength;
-		double RefractiveIndex;
-		double AcousticVelocity;
-	};
-
-	static int xtalparam_callback(void *data, int argc, char **argv, char **azColName) {
-		std::list<CrystalData> *xtal_list = (std::list<CrystalData>*)data;
-		CrystalData xtal_data;
-		for (int i = 0; i < argc; i++)
-		{
-//			std::cout << azColName[i] << " = " << (argv[i] ? argv[i] : "NULL") << std::endl;
-			if (argv[i] != nullptr)
-			{
-				// Get String arg
-				std::string s(argv[i]);
-
-				// and to double
-				double dparam = 1;
-				bool dparam_ok = true;
-				try
-				{
-					dparam = std::stod(s);
-				}
-				catch (std::invalid_argument&)
-				{
-					dparam_ok = false;
-				}
-				catch (std::out_of_range&)
-				{
-					dparam_ok = false;
-				}
-
-				if (std::string(azColName[i]) == "Name") {
-					xtal_data.Description = s;
-				}
-				else if ((std::string(azColName[i]) == "Wavelength") && dparam_ok) {
-					xtal_data.Wavelength = dparam;
-				}
-				else if ((std::string(azColName[i]) == "RefractiveIndex") && dparam_ok) {
-					xtal_data.RefractiveIndex = dparam;
-				}
-				else if ((std::string(azColName[i]) == "AcousticVelocity") && dparam_ok) {
-					xtal_data.AcousticVelocity = dparam;
-				}
-
-			}
-		}
-		xtal_list->push_back(xtal_data);
-		return 0;
-	}
-
 	std::ostream& operator<< (std::ostream& os, const Crystal::Material& material)
 	{
 		switch (material)
@@ -118,6 +70,74 @@ namespace iMS
 		else return Crystal::Material::TeO2;
 	}
 
+	// Physical properties of one crystal material.  The database is embedded in the library and never
+	// changes, so each material is read from it once and then shared by every Crystal of that material.
+	struct CrystalParams
+	{
+		std::string description;
+		double acousticVelocity{ 0.0 };
+		tk::spline refrIndexSpline;
+
+		// NOT 360 / 2 * PI !!!
+		double BraggAngle(double wavelength, double frequency) const
+		{
+			return 360.0 * (wavelength * frequency) / (2.0 * refrIndexSpline(wavelength) * acousticVelocity * 1000.0);
+		}
+	};
+
+	static std::shared_ptr<const CrystalParams> ReadCrystalParams(Crystal::Material mat)
+	{
+		auto params = std::make_shared<CrystalParams>();
+		const HardwareCatalog& catalog = HardwareCatalog::Instance();
+
+		if (catalog.IsValid())
+		{
+			std::stringstream getMat;
+			getMat << mat;
+			const std::vector<CrystalRecord>& data = catalog.CrystalParams(getMat.str());
+			if (data.empty() && (mat != Crystal::Material::TeO2)) {
+				// Not every material has an entry.  Those that don't take the properties of the default
+				// material, as they always have.
+				return ReadCrystalParams(Crystal::Material::TeO2);
+			}
+
+			std::map<double, double> wavelength_map;
+			for (const auto& row : data) {
+				wavelength_map.emplace(row.wavelength, row.refractiveIndex);
+				params->acousticVelocity = row.acousticVelocity;
+				params->description = row.description;
+			}
+
+			// Values in map will be natively sorted into ascending wavelengths
+			std::vector<double> wavelength(wavelength_map.size()), refrIndex(wavelength_map.size());
+
+			if (wavelength_map.size() >= 1) {
+				int i = 0;
+				for (auto& f : wavelength_map) {
+					wavelength[i] = f.first;
+					refrIndex[i++] = f.second;
+				}
+
+				//refrIndexSpline.set_boundary(tk::spline::first_deriv, 0.0, tk::spline::first_deriv, 0.0, false);
+				params->refrIndexSpline.set_points(wavelength, refrIndex);
+			}
+		}
+		return params;
+	}
+
+	static std::shared_ptr<const CrystalParams> GetCrystalParams(Crystal::Material mat)
+	{
+		static std::mutex cache_mutex;
+		static std::map<Crystal::Material, std::shared_ptr<const CrystalParams>> cache;
+
+		std::lock_guard<std::mutex> lck(cache_mutex);
+		auto it = cache.find(mat);
+		if (it == cache.end()) {
+			it = cache.emplace(mat, ReadCrystalParams(mat)).first;
+		}
+		return it->second;
+	}
+
 	class Crystal::Impl
 	{
 	public:
@@ -130,9 +150,7 @@ namespace iMS
 		Crystal* m_parent;
 		Material mat;
 		bool isDirty;
-		double acousticVelocity;
-		std::string description;
-		tk::spline refrIndexSpline;
+		std::shared_ptr<const CrystalParams> params;
 	};
 
 	Crystal::Impl::Impl(Crystal* parent, Crystal::Material material)
@@ -142,63 +160,24 @@ namespace iMS
 	}
 
 	void Crystal::Impl::updateFromDB() {
-		sqlite3 *xtalparam = nullptr;
-		int rc;
-
-		xtalparam = get_db();
-		if (xtalparam != nullptr)
-		{
-			std::stringstream getMat;
-			getMat << "SELECT * FROM xtalparam WHERE Type = \'";
-			getMat << this->mat << "\'" << std::endl;
-			std::list<CrystalData> data;
-			rc = sqlite3_exec(xtalparam, getMat.str().c_str(), xtalparam_callback, (void *)&data, nullptr);
-			if (rc != SQLITE_OK) {
-				sqlite3_close(xtalparam);
-			}
-			else {
-				std::map<double, double> wavelength_map;
-				for (std::list<CrystalData>::const_iterator it = data.begin(); it != data.end(); ++it) {
-					wavelength_map.emplace(it->Wavelength, it->RefractiveIndex);
-					acousticVelocity = it->AcousticVelocity;
-					description = it->Description;
-				}
-
-				// Values in map will be natively sorted into ascending wavelengths
-				std::vector<double> wavelength(wavelength_map.size()), refrIndex(wavelength_map.size());
-
-				if (wavelength_map.size() >= 1) {
-					int i = 0;
-					for (auto& f : wavelength_map) {
-						wavelength[i] = f.first;
-						refrIndex[i++] = f.second;
-					}
-
-					refrIndexSpline = tk::spline();
-					//refrIndexSpline.set_boundary(tk::spline::first_deriv, 0.0, tk::spline::first_deriv, 0.0, false);
-					refrIndexSpline.set_points(wavelength, refrIndex);
-				}
-			}
-
-			sqlite3_close(xtalparam);
-		}
+		params = GetCrystalParams(mat);
 		isDirty = false;
 	}
 
 	Crystal::Crystal(Crystal::Material material) : p_Impl(new Impl(this, material)) {
 	}
 
-	Crystal::Crystal(const Crystal &rhs) : p_Impl(new Impl(this, Crystal::Material::TeO2))
+	Crystal::Crystal(const Crystal &rhs) : p_Impl(new Impl(*rhs.p_Impl))
 	{
-		p_Impl->mat = rhs.p_Impl->mat;
-		p_Impl->isDirty = true;
+		p_Impl->m_parent = this;
 	}
 
 	const Crystal &Crystal::operator =(const Crystal &rhs)
 	{
 		if (this == &rhs) return *this;
 		p_Impl->mat = rhs.p_Impl->mat;
-		p_Impl->isDirty = true;
+		p_Impl->params = rhs.p_Impl->params;
+		p_Impl->isDirty = rhs.p_Impl->isDirty;
 		return *this;
 	}
 
@@ -223,7 +202,7 @@ namespace iMS
 		if (p_Impl->isDirty) {
 			p_Impl->updateFromDB();
 		}
-		return p_Impl->description;
+		return p_Impl->params->description;
 	}
 
 	const double Crystal::AcousticVelocity() const
@@ -231,7 +210,7 @@ namespace iMS
 		if (p_Impl->isDirty) {
 			p_Impl->updateFromDB();
 		}
-		return p_Impl->acousticVelocity;
+		return p_Impl->params->acousticVelocity;
 	}
 
 	double Crystal::RefractiveIndex(micrometre wavelength)
@@ -239,7 +218,7 @@ namespace iMS
 		if (p_Impl->isDirty) {
 			p_Impl->updateFromDB();
 		}
-		return p_Impl->refrIndexSpline(wavelength.operator double());
+		return p_Impl->params->refrIndexSpline(wavelength.operator double());
 	}
 
 	Degrees Crystal::BraggAngle(micrometre wavelength, MHz frequency)
@@ -247,10 +226,7 @@ namespace iMS
 		if (p_Impl->isDirty) {
 			p_Impl->updateFromDB();
 		}
-
-		// NOT 360 / 2 * PI !!!
-		return Degrees(360.0 * (wavelength.operator double() * frequency.operator double()) /
-			(2.0 * RefractiveIndex(wavelength) * AcousticVelocity() * 1000.0));
+		return Degrees(p_Impl->params->BraggAngle(wavelength.operator double(), frequency.operator double()));
 	}
 
 	struct AODeviceData
@@ -265,56 +241,67 @@ namespace iMS
 		micrometre wavelength;
 	};
 
-	static int aodev_callback(void *data, int argc, char **argv, char **azColName) {
-		std::list<AODeviceData>* aodevlist = (std::list<AODeviceData>*)data;
-		AODeviceData aodev_data;
-		for (int i = 0; i < argc; i++)
+	// Model parameters from the catalog, converted once per model for the life of the process
+	static bool GetAODeviceData(const std::string& Model, AODeviceData& dev)
+	{
+		static std::mutex cache_mutex;
+		static std::map<std::string, AODeviceData> cache;
+
+		std::lock_guard<std::mutex> lck(cache_mutex);
+		auto it = cache.find(Model);
+		if (it == cache.end()) {
+			const AODeviceRecord* rec = HardwareCatalog::Instance().AODevice(Model);
+			if (rec == nullptr) return false;
+
+			AODeviceData data;
+			data.model = rec->model;
+			if (!rec->crystal.empty()) data.xtal = Crystal(GetMaterialFromString(rec->crystal));
+			if (rec->centre) data.centre = *rec->centre;
+			if (rec->geom) data.geom = *rec->geom;
+			if (rec->bandwidth) data.bandwidth = *rec->bandwidth;
+			if (rec->wavelength) data.wavelength = *rec->wavelength;
+			it = cache.emplace(Model, data).first;
+		}
+		dev = it->second;
+		return true;
+	}
+
+	// Compensation functions already generated, keyed on everything that goes into the calculation.  The
+	// model name alone is not enough since every user defined device is called "Custom".
+	class CompensationFunctionCache
+	{
+	public:
+		using Key = std::tuple<std::string, Crystal::Material, double, double, double, double>;
+
+		static CompensationFunctionCache& Instance()
 		{
-			//			std::cout << azColName[i] << " = " << (argv[i] ? argv[i] : "NULL") << std::endl;
-			if (argv[i] != nullptr)
-			{
-				// Get String arg
-				std::string s(argv[i]);
-
-				// and to double
-				double dparam = 1;
-				bool dparam_ok = true;
-				try
-				{
-					dparam = std::stod(s);
-				}
-				catch (std::invalid_argument&)
-				{
-					dparam_ok = false;
-				}
-				catch (std::out_of_range&)
-				{
-					dparam_ok = false;
-				}
+			static CompensationFunctionCache theCache;
+			return theCache;
+		}
 
-				if (std::string(azColName[i]) == "Model") {
-					aodev_data.model = s;
-				}
-				else if (std::string(azColName[i]) == "Crystal") {
-					aodev_data.xtal = Crystal(GetMaterialFromString(s));
-				}
-				else if ((std::string(azColName[i]) == "CentreFrequency") && dparam_ok) {
-					aodev_data.centre = dparam;
-				}
-				else if ((std::string(azColName[i]) == "GeomConstant") && dparam_ok) {
-					aodev_data.geom = dparam;
-				}
-				else if ((std::string(azColName[i]) == "SweepBW") && dparam_ok) {
-					aodev_data.bandwidth = dparam;
-				}
-				else if ((std::string(azColName[i]) == "Wavelength") && dparam_ok) {
-					aodev_data.wavelength = dparam;
-				}
-			}
+		bool Find(const Key& key, CompensationFunction& func)
+		{
+			std::lock_guard<std::mutex> lck(m_mutex);
+			auto it = m_funcs.find(key);
+			if (it == m_funcs.end()) return false;
+			func = it->second;
+			return true;
 		}
-		aodevlist->push_back(aodev_data);
-		return 0;
-	}
+
+		void Insert(const Key& key, const CompensationFunction& func)
+		{
+			std::lock_guard<std::mutex> lck(m_mutex);
+			// Keep the cache bounded for applications that sweep through arbitrary wavelengths
+			if (m_funcs.size() >= MaxEntries) m_funcs.clear();
+			m_funcs.emplace(key, func);
+		}
+
+	private:
+		static const std::size_t MaxEntries = 1024;
+
+		std::mutex m_mutex;
+		std::map<Key, CompensationFunction> m_funcs;
+	};
 
 	class AODevice::Impl {
 	public:
@@ -334,6 +321,12 @@ namespace iMS
 			m_model("Custom") {}
 		~Impl() {}
 
+		CompensationFunctionCache::Key CacheKey(micrometre wavelength) const
+		{
+			return CompensationFunctionCache::Key(m_model, m_xtal.Type(), m_geomConstant, m_centre, m_bandwidth, wavelength);
+		}
+		CompensationFunction BuildCompensationFunction(const CrystalParams& xtal, micrometre wavelength) const;
+
 		Crystal m_xtal;
 		double m_geomConstant;
 		MHz m_centre;
@@ -355,30 +348,15 @@ namespace iMS
 	AODevice::AODevice(const std::string& Model)
 		: p_Impl(new Impl())
 	{
-		sqlite3 *aodev = nullptr;
-		int rc;
-
-		aodev = get_db();
-		if (aodev != nullptr)
+		AODeviceData data;
+		if (GetAODeviceData(Model, data))
 		{
-			std::stringstream getDev;
-			getDev << "SELECT * FROM aodevice WHERE Model = \'";
-			getDev << Model << "\'" << std::endl;
-			std::list<AODeviceData> data;
-			rc = sqlite3_exec(aodev, getDev.str().c_str(), aodev_callback, (void *)&data, nullptr);
-			if (rc != SQLITE_OK) {
-				sqlite3_close(aodev);
-			}
-			else {
-				p_Impl->m_xtal = data.front().xtal;
-				p_Impl->m_centre = data.front().centre;
-				p_Impl->m_bandwidth = data.front().bandwidth;
-				p_Impl->m_geomConstant = data.front().geom;
-				p_Impl->m_wavelength = data.front().wavelength;
-				p_Impl->m_model = data.front().model;
-			}
-
-			sqlite3_close(aodev);
+			p_Impl->m_xtal = data.xtal;
+			p_Impl->m_centre = data.centre;
+			p_Impl->m_bandwidth = data.bandwidth;
+			p_Impl->m_geomConstant = data.geom;
+			p_Impl->m_wavelength = data.wavelength;
+			p_Impl->m_model = data.model;
 		}
 	}
 
@@ -457,29 +435,29 @@ namespace iMS
 		return fc;
 	}
 
-	CompensationFunction AODevice::GetCompensationFunction(micrometre wavelength)
+	CompensationFunction AODevice::Impl::BuildCompensationFunction(const CrystalParams& xtal, micrometre wavelength) const
 	{
 		CompensationFunction func;
 		func.SetStyle(CompensationFeature::PHASE, CompensationFunction::InterpolationStyle::LINEXTEND);
 
-		double sweep = p_Impl->m_bandwidth * AODevice::Impl::margin;
+		double sweep = m_bandwidth * AODevice::Impl::margin;
 
-		MHz lower = p_Impl->m_centre - (sweep / 2.0);
-		MHz upper = p_Impl->m_centre + (sweep / 2.0);
+		MHz lower = m_centre - (sweep / 2.0);
+		MHz upper = m_centre + (sweep / 2.0);
 
 		MHz f = lower;
 		double step_size = (upper - lower) / (AODevice::Impl::nPts - 1);
 
-		Degrees fc = p_Impl->m_xtal.BraggAngle(wavelength, p_Impl->m_centre);
+		Degrees fc = xtal.BraggAngle(wavelength, m_centre);
 
 		for (int i=0; i< AODevice::Impl::nPts; i++) {
-			Degrees ft = p_Impl->m_xtal.BraggAngle(wavelength, f);
+			Degrees ft = xtal.BraggAngle(wavelength, f);
 
 			func.push_back(
 				CompensationPointSpecification(
 					CompensationPoint(
 						Percent(50.0),
-						Degrees((fc - ft) * p_Impl->m_geomConstant * f)
+						Degrees((fc - ft) * m_geomConstant * f)
 					),
 					f
 				)
@@ -488,32 +466,76 @@ namespace iMS
 		}
 
 		// Add lower bookend: half centre frequency with phase matched to lowest freq value
-		Degrees fl = p_Impl->m_xtal.BraggAngle(wavelength, lower);
+		Degrees fl = xtal.BraggAngle(wavelength, lower);
 		func.push_front(
 			CompensationPointSpecification(
 				CompensationPoint(
 					Percent(0.0),
-					Degrees((fc - fl) * p_Impl->m_geomConstant * lower)
+					Degrees((fc - fl) * m_geomConstant * lower)
 				),
-				MHz(p_Impl->m_centre / 2.0)
+				MHz(m_centre / 2.0)
 			)
 		);
 
 		// Add upper bookend: twice centre frequency with phase matched to highest freq value
-		Degrees fu = p_Impl->m_xtal.BraggAngle(wavelength, upper);
+		Degrees fu = xtal.BraggAngle(wavelength, upper);
 		func.push_back(
 			CompensationPointSpecification(
 				CompensationPoint(
 					Percent(0.0),
-					Degrees((fc - fu) * p_Impl->m_geomConstant * upper)
+					Degrees((fc - fu) * m_geomConstant * upper)
 				),
-				MHz(p_Impl->m_centre * 2.0)
+				MHz(m_centre * 2.0)
 			)
 		);
 
 		return func;
 	}
 
+	CompensationFunction AODevice::GetCompensationFunction(micrometre wavelength)
+	{
+		auto& cache = CompensationFunctionCache::Instance();
+		const auto key = p_Impl->CacheKey(wavelength);
+
+		CompensationFunction func;
+		if (!cache.Find(key, func)) {
+			func = p_Impl->BuildCompensationFunction(*GetCrystalParams(p_Impl->m_xtal.Type()), wavelength);
+			cache.Insert(key, func);
+		}
+		return func;
+	}
+
+	std::vector<CompensationFunction> AODevice::GetCompensationFunctions(const std::vector<micrometre>& wavelengths)
+	{
+		auto& cache = CompensationFunctionCache::Instance();
+		std::vector<CompensationFunction> funcs(wavelengths.size());
+
+		// Anything not already in the cache is shared out between worker threads
+		std::vector<std::size_t> missing;
+		for (std::size_t i = 0; i < wavelengths.size(); i++) {
+			if (!cache.Find(p_Impl->CacheKey(wavelengths[i]), funcs[i])) missing.push_back(i);
+		}
+		if (missing.empty()) return funcs;
+
+		auto xtal = GetCrystalParams(p_Impl->m_xtal.Type());
+		std::atomic<std::size_t> next{ 0 };
+		auto worker = [&]() {
+			for (std::size_t n = next++; n < missing.size(); n = next++) {
+				const std::size_t i = missing[n];
+				funcs[i] = p_Impl->BuildCompensationFunction(*xtal, wavelengths[i]);
+				cache.Insert(p_Impl->CacheKey(wavelengths[i]), funcs[i]);
+			}
+		};
+
+		const std::size_t n_threads = std::min<std::size_t>(missing.size(), std::max(1u, std::thread::hardware_concurrency()));
+		std::vector<std::thread> workers;
+		for (std::size_t t = 1; t < n_threads; t++) workers.emplace_back(worker);
+		worker();
+		for (auto& t : workers) t.join();
+
+		return funcs;
+	}
+
 	class AODeviceList::Impl
 	{
 	public:
@@ -532,25 +554,8 @@ namespace iMS
 	AODeviceList::AODeviceList()
 		: p_Impl(new Impl())
 	{
-		sqlite3 *aodev = nullptr;
-		int rc;
-
-		aodev = get_db();
-		if (aodev != nullptr)
-		{
-			std::stringstream getDev;
-			getDev << "SELECT Model FROM aodevice";
-			std::list<AODeviceData> data;
-			rc = sqlite3_exec(aodev, getDev.str().c_str(), aodev_callback, (void *)&data, nullptr);
-			if (rc != SQLITE_OK) {
-				sqlite3_close(aodev);
-			}
-			else {
-				for (std::list<AODeviceData>::iterator it = data.begin(); it != data.end(); ++it)
-					p_Impl->aodevlist.push_back(it->model);
-			}
-
-			sqlite3_close(aodev);
+		for (const auto& rec : HardwareCatalog::Instance().AODevices()) {
+			p_Impl->aodevlist.push_back(rec.model);
 		}
 	}
 
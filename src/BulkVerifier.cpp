@@ -162,6 +162,18 @@ namespace iMS {
 		vfylck.unlock();
 	}
 
+	MessageHandle BulkVerifier::SendChunk(const HostReport& rpt, const std::vector<std::uint8_t>& data, int addr)
+	{
+		return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> MessageHandle
+		{
+			// Holding the receive lock defers the response until the chunk is in the list
+			std::unique_lock<std::mutex> lck{ p_Impl->m_rxmutex };
+			MessageHandle h = ims->Connection()->SendMsg(rpt);
+			AddChunk(std::make_shared<VerifyChunk>(h, data, addr));
+			return h;
+		}).value_or(NullMessage);
+	}
+
 	void BulkVerifier::WaitUntilBufferClear()
 	{
 		// Clear Buffer to prevent Hardware overrun
@@ -181,7 +193,14 @@ namespace iMS {
 		if (!p_Impl->vfy_list.empty()) {
 			p_Impl->vfy_final = p_Impl->vfy_list.back()->handle();
 		}
-		else p_Impl->vfy_final = NullMessage;
+		else {
+			// Every readback has already been checked, so there is no final message left to wait for
+			p_Impl->vfy_final = NullMessage;
+			if (p_Impl->error_list.empty())
+				p_Impl->m_Event.Trigger<int>((void *)p_Impl, BulkVerifierEvents::VERIFY_SUCCESS, 0);
+			else
+				p_Impl->m_Event.Trigger<int>((void *)p_Impl, BulkVerifierEvents::VERIFY_FAIL, static_cast<int>(p_Impl->error_list.size()));
+		}
 
 		vfylck.unlock();
 	}
@@ -416,28 +416,13 @@ namespace iMS {
 			}
 
 			// wait for all messages to have been processed
-			bool msg_waiting{ false };
-			do
-			{
-                m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& msg) {
-                    if (!msg->isComplete())
-					{
-						msg_waiting = true;
-					}
-                });
-				if (msg_waiting)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(25));
-					msg_waiting = false;
-				}
-				else {
-					break;
-				}
-			} while (1);
+			WaitForPendingMessages();
 
 			// Stop Threads
 			DeviceIsOpen = false;  // must set this to cancel threads
             m_txcond.notify_all();
+            m_rxWake.Signal();
+            StopMemoryTransfer();
 			senderThread.join();
 			receiverThread.join();
 			parserThread.join();
@@ -529,9 +514,7 @@ namespace iMS {
             } while (!HasOverlappedIoCompleted(outContext.OvLap));
 
             pImpl->Ept.cOutEpt->FinishDataXfer((PUCHAR)&((*(outContext.Buffer))[0]), outContext.bufLen, outContext.OvLap, outContext.context);
-            if (m->getStatus() == Message::Status::UNSENT) {
-                m->setStatus(Message::Status::SENT);
-            }
+            m->setStatusIf(Message::Status::UNSENT, Message::Status::SENT);
             ResetEvent(outContext.OvLap->hEvent);
 
             // Indicate to receive thread that a receive transfer has been started
@@ -628,7 +611,7 @@ namespace iMS {
 			}
 
 			// Signal Parser thread
-			m_rxcond.notify_one();
+			NotifyParser();
 		}
 	}
 
@@ -647,7 +630,9 @@ namespace iMS {
 		// Setup transfer
 		int length = arr.size();
 		length = (((length - 1) / CYUSB_Policy::TRANSFER_GRANULARITY) + 1) * CYUSB_Policy::TRANSFER_GRANULARITY;
-		arr.resize(length);  // Increase the buffer size to the transfer granularity
+		// Increase the buffer size to the transfer granularity.  A buffer already padded is left untouched, so one
+		// buffer can be transferred on several connections at once.
+		if ((int)arr.size() != length) arr.resize(length);
 		{
             CYUSB_Policy policy(start_addr);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
@@ -661,7 +646,12 @@ namespace iMS {
 		return true; 
 	}
 
-	bool CM_CYUSB::MemoryUpload(boost::container::deque<uint8_t>& arr, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
+	int CM_CYUSB::MemoryTransferGranularity() const
+	{
+		return CYUSB_Policy::TRANSFER_GRANULARITY;
+	}
+
+	bool CM_CYUSB::StartUpload(boost::container::deque<uint8_t>& arr, MemorySink sink, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
 	{
 		(void)image_index;
 		(void)uuid;
@@ -679,7 +669,7 @@ namespace iMS {
 		{
             CYUSB_Policy policy(start_addr);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
-			pImpl->m_fti = new FastTransfer(arr, length, policy);
+			pImpl->m_fti = new FastTransfer(arr, length, policy, std::move(sink));
 		}
 
 		// Signal thread to do the grunt work
@@ -700,15 +690,8 @@ namespace iMS {
 		{
 			{
 				std::unique_lock<std::mutex> lck{ m_tfrmutex };
-				while (!m_tfrcond.wait_for(lck, std::chrono::milliseconds(100), [&] {return pImpl->m_fti != nullptr; }))
-				{
-					if (FastTransferStatus.load() != _FastTransferStatus::IDLE)
-					{
-						break;
-					}
-					// Timeout every 100ms to allow threads to terminate on disconnect
-					if (DeviceIsOpen == false) break;
-				}
+				// Woken by MemoryDownload/MemoryUpload, or by StopMemoryTransfer on disconnect
+				m_tfrcond.wait(lck, [&] {return !DeviceIsOpen || pImpl->m_fti != nullptr; });
 				if (DeviceIsOpen == false)
 				{
 					// End thread
@@ -809,7 +792,7 @@ namespace iMS {
 #if defined(DMA_PERFORMANCE_MEASUREMENT_MODE)
 							boost::chrono::steady_clock::time_point t_pre_copy = boost::chrono::steady_clock::now();
 #endif
-							pImpl->m_fti->m_data.insert(pImpl->m_fti->m_data.end(), dataBuffer, dataBuffer + buf_len);
+							pImpl->m_fti->deliver(dataBuffer, buf_len);
 							//pImpl->m_fti->m_data_it += len;
 #if defined(DMA_PERFORMANCE_MEASUREMENT_MODE)
 							boost::chrono::steady_clock::time_point t_final = boost::chrono::steady_clock::now();
@@ -820,6 +803,8 @@ namespace iMS {
 					}
 					// Set up index data for next DMA Transaction
 					pImpl->m_fti->startNextTransaction();
+					// An abandoned upload still reads out the DMA transaction in progress, but starts no more
+					if (pImpl->m_fti->m_abandoned) break;
 				}
 
 #if defined(DMA_PERFORMANCE_MEASUREMENT_MODE)
@@ -875,7 +860,7 @@ namespace iMS {
             m_msgRegistry.addMessage(m->getMessageHandle(), m);        
 
             // Signal Parser thread
-			m_rxcond.notify_one();
+			NotifyParser();
 		}
 	}
 
@@ -38,6 +38,9 @@
 
 namespace iMS {
 
+	// Upper bound on how long the parser thread sleeps when no data or deadlines are pending
+	static const std::chrono::milliseconds ParserMaxIdle(250);
+
 	void DebugLogReportTrace(std::shared_ptr<Message> msg)
 	{
 		std::stringstream ss;
@@ -59,6 +62,55 @@ namespace iMS {
 	CM_Common::CM_Common()
 	{
 		//BOOST_LOG_SEV(lg::get(), sev::info) << "CM_Common Default Constructor";
+
+		// Message events are handed to an executor so handlers never hold up response parsing
+		mMsgEvent.DispatchThreads(1);
+	}
+
+	void CM_Common::SetEventDispatchThreads(int threads)
+	{
+		mMsgEvent.DispatchThreads(static_cast<std::size_t>(std::max(0, threads)));
+	}
+
+	void CM_Common::PushRxBytes(const char* data, std::size_t len)
+	{
+		auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+		std::size_t written = m_rxRing.Write(bytes, len);
+		while ((written < len) && DeviceIsOpen) {
+			// Ring full: make sure the parser is running and let it catch up
+			m_rxWake.Signal();
+			std::this_thread::yield();
+			written += m_rxRing.Write(bytes + written, len - written);
+		}
+		// Only costs a system call if the parser is asleep
+		m_rxWake.Notify();
+	}
+
+	void CM_Common::NotifyParser()
+	{
+		m_rxWake.Signal();
+	}
+
+	void CM_Common::WaitForPendingMessages()
+	{
+		std::vector<std::shared_ptr<Message>> pending;
+		m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& msg) {
+			if (!msg->isComplete()) pending.push_back(msg);
+		});
+
+		// The parser thread completes each one, at the latest when its receive timeout expires
+		for (auto& msg : pending) {
+			msg->waitForCompletion();
+		}
+	}
+
+	void CM_Common::StopMemoryTransfer()
+	{
+		{
+			// Taking the lock ensures the thread is either waiting or has yet to test DeviceIsOpen
+			std::lock_guard<std::mutex> tfr_lck{ m_tfrmutex };
+		}
+		m_tfrcond.notify_all();
 	}
 
 	void CM_Common::MessageEventSubscribe(const int message, IEventHandler* handler)
@@ -82,6 +134,13 @@ namespace iMS {
 		{
 			// Create a message, add report, assign it an ID, and place in queue.
 			std::shared_ptr<Message> m = std::make_shared<Message>(Rpt);
+
+            // Registered before it is queued, so that a prompt response always finds the message waiting for it
+            // rather than lying unclaimed until the parser next wakes.  First check for a response timeout is due
+            // once rxTimeout has elapsed
+            auto hnd = m->getMessageHandle();
+            m_msgRegistry.addMessage(hnd, m, std::chrono::steady_clock::now() + rxTimeout);
+
             {
                 std::unique_lock <std::mutex> txlck{ m_txmutex };
 				m_queue.push(m);
@@ -91,9 +150,6 @@ namespace iMS {
 				m_txcond.notify_one();
 			}
 
-            auto hnd = m->getMessageHandle();
-            m_msgRegistry.addMessage(hnd, m);
-
 			return hnd;
 		}
 		else {
@@ -265,30 +321,45 @@ namespace iMS {
 
     void CM_Common::HandleTimeoutsAndCleanup()
     {
-        std::vector<MessageHandle> messagesToRemove;
+        // Only messages whose deadline has passed are visited.  Each one is either timed out, freed
+        // or rescheduled for the next point in time at which its state could change.
+        const auto now = std::chrono::steady_clock::now();
+        const auto margin = std::chrono::milliseconds(1);
 
-        m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& m)
+        while (auto m = m_msgRegistry.popExpired(now))
         {
+            auto hnd = m->getMessageHandle();
+            auto elapsed = m->TimeElapsed();
+
             if (m->getStatus() == Message::Status::SENT ||
                 m->getStatus() == Message::Status::RX_PARTIAL)
             {
-                if (m->TimeElapsed() > rxTimeout)
+                if (elapsed <= rxTimeout)
                 {
-                    m->setStatus(Message::Status::TIMEOUT_ON_RXCV);
-                    LogNotifyEvent(sev::warning, m, "Msg RX Timeout",
-                                MessageEvents::RESPONSE_TIMED_OUT, m->getMessageHandle());
+                    m_msgRegistry.scheduleMessage(hnd, now + (rxTimeout - elapsed) + margin);
+                    continue;
                 }
+                m->setStatus(Message::Status::TIMEOUT_ON_RXCV);
+                LogNotifyEvent(sev::warning, m, "Msg RX Timeout",
+                            MessageEvents::RESPONSE_TIMED_OUT, hnd);
+            }
+
+            if (!m->isComplete())
+            {
+                // Not yet sent, or an interrupt still waiting to be parsed
+                m_msgRegistry.scheduleMessage(hnd, now + rxTimeout);
             }
     #ifndef DEBUG_PRESERVE_LIST
-            else if (m->TimeElapsed() > autoFreeTimeout && m->isComplete())
+            else if (elapsed > autoFreeTimeout)
             {
-                messagesToRemove.push_back(m->getMessageHandle());
+                m_msgRegistry.removeMessage(hnd);
+            }
+            else
+            {
+                m_msgRegistry.scheduleMessage(hnd, now + (autoFreeTimeout - elapsed) + margin);
             }
     #endif
-        });
-
-        for (auto& msg : messagesToRemove)
-            m_msgRegistry.removeMessage(msg);
+        }
     }
 
     void CM_Common::HandleMessage(const std::shared_ptr<Message>& m)
@@ -326,21 +397,22 @@ namespace iMS {
         m_PendingEvents.push_back(PendingEvent{ e, payload });
     }
 
-    void CM_Common::PushInterruptEvent(int p, const std::vector<uint8_t>& data) {
-        m_PendingEvents.push_back({ MessageEvents::Events::INTERRUPT_RECEIVED, std::make_pair(p, data) });
+    void CM_Common::PushInterruptEvent(int p, std::vector<uint8_t>&& data) {
+        m_PendingEvents.push_back({ MessageEvents::Events::INTERRUPT_RECEIVED, std::make_pair(p, std::move(data)) });
     }
 
     void CM_Common::TriggerPendingEvents()
     {
+        // Events are queued to the dispatcher; byte payloads are moved rather than copied
         for (auto& ev : m_PendingEvents) {
             std::visit([&](auto&& arg) {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, int>)
-                    mMsgEvent.Trigger<int>(this, ev.type, arg);
+                    mMsgEvent.Post<int>(this, ev.type, arg);
                 else if constexpr (std::is_same_v<T, std::pair<int, int>>)
-                    mMsgEvent.Trigger<int, int>(this, ev.type, arg.first, arg.second);
-                else if constexpr (std::is_same_v<T, std::vector<std::uint8_t>>)
-                    mMsgEvent.Trigger<int,std::vector<uint8_t>>(this, ev.type, arg.first, arg.second);
+                    mMsgEvent.Post<int, int>(this, ev.type, arg.first, arg.second);
+                else if constexpr (std::is_same_v<T, std::pair<int, std::vector<std::uint8_t>>>)
+                    mMsgEvent.Post<int, std::vector<uint8_t>>(this, ev.type, arg.first, std::move(arg.second));
             }, ev.payload);
         }
         m_PendingEvents.clear();
@@ -351,24 +423,20 @@ namespace iMS {
 		while (DeviceIsOpen)
 		{
 
-			// Grab any outstanding characters from the queue
-            std::deque<char> localCopy;
-            {
-                std::unique_lock<std::mutex> lck{ m_rxmutex };
-
-                m_rxcond.wait_for(lck, std::chrono::milliseconds(10), [&] {
-                    return (!m_rxCharQueue.empty() || !DeviceIsOpen);
-                });
-                if (!m_rxCharQueue.empty()) {
-                    std::swap(localCopy, m_rxCharQueue);
-                }
-                if (!DeviceIsOpen) break;
+            // Sleep until data arrives or the next message deadline falls due
+            auto wake = std::chrono::steady_clock::now() + ParserMaxIdle;
+            if (auto next = m_msgRegistry.nextDeadline()) {
+                wake = std::min(wake, *next);
             }
+            m_rxWake.WaitUntil(wake, [&] {
+                auto next = m_msgRegistry.nextDeadline();
+                return (!m_rxRing.Empty() || !DeviceIsOpen ||
+                    (next && *next <= std::chrono::steady_clock::now()));
+            });
+            if (!DeviceIsOpen) break;
 
-			// Do some message management
-            m_glblRx.insert(m_glblRx.end(),
-               std::make_move_iterator(localCopy.begin()),
-               std::make_move_iterator(localCopy.end()));
+			// Grab any outstanding characters from the receiver
+            m_rxRing.Read(m_glblRx);
 
             // Test for and parse interrupts in the global rx buffer
             HandleInterrupts();
@@ -410,7 +478,9 @@ namespace iMS {
 		// Setup transfer
 		int length = arr.size();
 		length = (((length - 1) / DefaultPolicy::TRANSFER_UNIT) + 1) * DefaultPolicy::TRANSFER_UNIT;
-		arr.resize(length);  // Increase the buffer size to the transfer granularity
+		// Increase the buffer size to the transfer granularity.  A buffer already padded is left untouched, so one
+		// buffer can be transferred on several connections at once.
+		if ((int)arr.size() != length) arr.resize(length);
 		{
             DefaultPolicy policy(start_addr, image_index);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
@@ -425,6 +495,18 @@ namespace iMS {
 	}
 
 	bool CM_Common::MemoryUpload(boost::container::deque<uint8_t>& arr, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
+	{
+		return this->StartUpload(arr, nullptr, start_addr, len, image_index, uuid);
+	}
+
+	bool CM_Common::MemoryUpload(MemorySink sink, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
+	{
+		// The transfer collects nothing when it has a sink, so 'unused' is never referred to
+		boost::container::deque<uint8_t> unused;
+		return this->StartUpload(unused, std::move(sink), start_addr, len, image_index, uuid);
+	}
+
+	bool CM_Common::StartUpload(boost::container::deque<uint8_t>& arr, MemorySink sink, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
 	{
 		(void)uuid;
 
@@ -455,7 +537,7 @@ namespace iMS {
 		{
             DefaultPolicy policy(start_addr, image_index);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
-			fti = new FastTransfer(arr, len, policy);
+			fti = new FastTransfer(arr, len, policy, std::move(sink));
 		}
 
 		// Signal thread to do the grunt work
@@ -465,6 +547,11 @@ namespace iMS {
 		return true;
 	}
 
+	int CM_Common::MemoryTransferGranularity() const
+	{
+		return DefaultPolicy::TRANSFER_UNIT;
+	}
+
 	void CM_Common::MemoryTransfer()
 	{
         unsigned int dl_max_in_flight = DefaultPolicy::DMA_MAX_TRANSACTION_SIZE / std::max<unsigned int>(1,DefaultPolicy::DL_TRANSFER_SIZE); 
@@ -503,9 +590,9 @@ namespace iMS {
                 return anyRemoved || (expecting_more && inflight.size() < max_in_flight);
             });
 
-            // Append upload payloads after releasing the lock
+            // Deliver upload payloads after releasing the lock
             for (auto& p : completedPayloads) {
-                fti->m_data.insert(fti->m_data.end(), p.begin(), p.end());
+                fti->deliver(p.data(), p.size());
             }
         };       
 
@@ -530,7 +617,7 @@ namespace iMS {
                 bool downloading = FastTransferStatus.load() == _FastTransferStatus::DOWNLOADING;
                 unsigned int max_in_flight = downloading ? dl_max_in_flight : ul_max_in_flight;
                 for (unsigned int i = 0; i < fti->m_transCount; i++) {
-                    if (FastTransferStatus.load() == _FastTransferStatus::IDLE)
+                    if ((FastTransferStatus.load() == _FastTransferStatus::IDLE) || fti->m_abandoned)
                         break;
 
                     HostReport::Dir dir = downloading ? HostReport::Dir::WRITE : HostReport::Dir::READ;
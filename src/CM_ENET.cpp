@@ -780,10 +780,7 @@ static std::string logErrorString(int err = INT_MAX) {
 			while (!m_queue.empty()) m_queue.pop();
 			//while (!pImpl->m_rxBuf.empty()) pImpl->m_rxBuf.pop_front();
 
-            {
-                std::lock_guard<std::mutex> lock(m_rxmutex);
-                m_rxCharQueue.clear();
-            }
+            m_rxRing.Reset();
 
 			// Start Report Sending Thread
 			senderThread = std::thread(&CM_ENET::MessageSender, this);
@@ -831,29 +828,14 @@ static std::string logErrorString(int err = INT_MAX) {
 
 			// wait for all messages to have been processed
 			BOOST_LOG_SEV(lg::get(), sev::info) << "Waiting for all messages to complete processing" << std::endl;
-			bool msg_waiting{ false };
-			do
-			{
-                m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& msg) {
-                    if (!msg->isComplete())
-					{
-						msg_waiting = true;
-					}
-                });
-				if (msg_waiting)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(25));
-					msg_waiting = false;
-				}
-				else {
-					break;
-				}
-			} while (1);
+			WaitForPendingMessages();
 
 			// Stop Threads
 			BOOST_LOG_SEV(lg::get(), sev::info) << "Stopping threads" << std::endl;
 			DeviceIsOpen = false;  // must set this to cancel threads
             m_txcond.notify_all();
+            m_rxWake.Signal();
+            StopMemoryTransfer();
 			senderThread.join();
 			BOOST_LOG_SEV(lg::get(), sev::debug) << "sender thread joined" << std::endl;
 			receiverThread.join();
@@ -972,9 +954,7 @@ static std::string logErrorString(int err = INT_MAX) {
             }
 
 
-            if (m->getStatus() == Message::Status::UNSENT) {
-                m->setStatus(Message::Status::SENT);
-            }
+            m->setStatusIf(Message::Status::UNSENT, Message::Status::SENT);
 
 #else
             outContext->bufLen = (unsigned long)outContext->Buffer->size();
@@ -1036,8 +1016,9 @@ static std::string logErrorString(int err = INT_MAX) {
                     }
                 }
 
+                // The response may already have been parsed
                 if (outContext->BytesXfer >= outContext->bufLen) {
-                    m->setStatus(Message::Status::SENT);
+                    m->setStatusIf(Message::Status::UNSENT, Message::Status::SENT);
                 }
             }
 #endif
@@ -1051,11 +1032,12 @@ static std::string logErrorString(int err = INT_MAX) {
 		int lastRet = 0;
 
 		TIMEVAL Timeout;
-		Timeout.tv_sec = 0;
-		Timeout.tv_usec = 250000;
 
 		while (DeviceIsOpen == true)
 		{
+			// select() may update the timeout with the time remaining, so reload it on every pass
+			Timeout.tv_sec = 0;
+			Timeout.tv_usec = 250000;
 			FD_ZERO(&Read);
 			FD_SET(pImpl->msgSock, &Read);
 			select(pImpl->msgSock+1, &Read, NULL, NULL, &Timeout);
@@ -1082,18 +1064,8 @@ static std::string logErrorString(int err = INT_MAX) {
 					}
 				}
 				else if (ret > 0) {
-                    {
-                        std::scoped_lock<std::mutex> rxlck{ m_rxmutex };
-                        m_rxCharQueue.insert(m_rxCharQueue.end(), szBuffer, szBuffer + ret);
-                        // for (int i = 0; i < ret; i++)
-                        // {
-                        //     m_rxCharQueue.push_back(szBuffer[i]);
-                        //     //std::cout << std::hex;
-                        //     //std::cout << std::setfill('0') << std::setw(2) << static_cast<int>(szBuffer[i]) << " ";
-                        // }
-                    }
-					// Signal Parser thread
-					m_rxcond.notify_one();
+					// Hand bytes to Parser thread
+					PushRxBytes(szBuffer, ret);
 				}
 				lastRet = ret;
 			}
@@ -1112,7 +1084,9 @@ static std::string logErrorString(int err = INT_MAX) {
 		// Setup transfer
 		int length = (int)arr.size();
 		length = (((length - 1) / ENET_Policy::TRANSFER_UNIT) + 1) * ENET_Policy::TRANSFER_UNIT;
-		arr.resize(length);  // Increase the buffer size to the transfer granularity
+		// Increase the buffer size to the transfer granularity.  A buffer already padded is left untouched, so one
+		// buffer can be transferred on several connections at once.
+		if ((int)arr.size() != length) arr.resize(length);
 		{
             ENET_Policy policy(uuid);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
@@ -1126,7 +1100,12 @@ static std::string logErrorString(int err = INT_MAX) {
 		return true;
 	}
 
-	bool CM_ENET::MemoryUpload(boost::container::deque<uint8_t>& arr, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
+	int CM_ENET::MemoryTransferGranularity() const
+	{
+		return ENET_Policy::TRANSFER_UNIT;
+	}
+
+	bool CM_ENET::StartUpload(boost::container::deque<uint8_t>& arr, MemorySink sink, uint32_t start_addr, int len, int image_index, const std::array<uint8_t, 16>& uuid)
 	{
 		BOOST_LOG_SEV(lg::get(), sev::debug) << "CM_ENET::MemoryUpload addr = " << start_addr << " index = " << image_index << " size = " << len << std::endl;
 		// Only proceed if idle
@@ -1139,7 +1118,7 @@ static std::string logErrorString(int err = INT_MAX) {
 		{
             ENET_Policy policy(uuid);
 			std::unique_lock<std::mutex> tfr_lck{ m_tfrmutex };
-			pImpl->m_fti = new FastTransfer(arr, 0, policy);
+			pImpl->m_fti = new FastTransfer(arr, 0, policy, std::move(sink));
 		}
 
 		// Signal thread to do the grunt work
@@ -1156,15 +1135,8 @@ static std::string logErrorString(int err = INT_MAX) {
 		{
 			{
 				std::unique_lock<std::mutex> lck{ m_tfrmutex };
-				while (!m_tfrcond.wait_for(lck, std::chrono::milliseconds(100), [&] {return pImpl->m_fti != nullptr; }))
-				{
-					if (FastTransferStatus.load() != _FastTransferStatus::IDLE)
-					{
-						break;
-					}
-					// Timeout every 100ms to allow threads to terminate on disconnect
-					if (DeviceIsOpen == false) break;
-				}
+				// Woken by MemoryDownload/MemoryUpload, or by StopMemoryTransfer on disconnect
+				m_tfrcond.wait(lck, [&] {return !DeviceIsOpen || pImpl->m_fti != nullptr; });
 				if (DeviceIsOpen == false)
 				{
 					// End thread
@@ -1194,14 +1166,18 @@ static std::string logErrorString(int err = INT_MAX) {
 					}
 				}
 				else if (FastTransferStatus.load() == _FastTransferStatus::UPLOADING) {
-					if (!client->getFile(UUIDToStr(pImpl->m_fti->m_policy.uuid).c_str(), pImpl->m_fti->m_data))
+					pImpl->m_fti->m_data.clear();
+					FastTransfer* fti = pImpl->m_fti;
+					if (!client->getFile(UUIDToStr(fti->m_policy.uuid).c_str(), [fti](const std::uint8_t* data, std::size_t len) { return fti->deliver(data, len); }))
 					{
-						mMsgEvent.Trigger<int>(this, MessageEvents::MEMORY_TRANSFER_ERROR, -1);
+						// A transfer abandoned by its sink is not an error
+						if (!fti->m_abandoned) mMsgEvent.Trigger<int>(this, MessageEvents::MEMORY_TRANSFER_ERROR, -1);
 					}
 				}
 				delete client;
 
-				int bytesTransferred = (int)pImpl->m_fti->m_data.size();
+				int bytesTransferred = (FastTransferStatus.load() == _FastTransferStatus::UPLOADING) ?
+					(int)pImpl->m_fti->m_delivered : (int)pImpl->m_fti->m_data.size();
 				delete pImpl->m_fti;
 				pImpl->m_fti = nullptr;
 
@@ -1270,7 +1246,7 @@ static std::string logErrorString(int err = INT_MAX) {
                         m_msgRegistry.addMessage(m->getMessageHandle(), m);
 
                         // Signal Parser thread
-						m_rxcond.notify_one();
+						NotifyParser();
 
 						errorLogged = false;
 					}
@@ -227,10 +227,7 @@ namespace iMS {
 			m_msgRegistry.clear();
 			while (!m_queue.empty()) m_queue.pop();
 
-            {
-                std::lock_guard<std::mutex> lock(m_rxmutex);
-                m_rxCharQueue.clear();
-            }
+            m_rxRing.Reset();
 
 			// Start Report Sending Thread
 			senderThread = std::thread(&CM_FTDI::MessageSender, this);
@@ -272,29 +269,13 @@ namespace iMS {
 			}
 
 			// wait for all messages to have been processed
-			bool msg_waiting{ false };
-			do
-			{
-                m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& msg) {
-                    if (!msg->isComplete())
-					{
-						msg_waiting = true;
-					}
-                });
-				if (msg_waiting)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(25));
-					msg_waiting = false;
-				}
-				else {
-					break;
-				}
-			} while (1);
+			WaitForPendingMessages();
 
 			// Stop Threads
 			DeviceIsOpen = false;  // must set this to cancel threads
             m_txcond.notify_all();
-            m_tfrcond.notify_one();
+            m_rxWake.Signal();
+            StopMemoryTransfer();
 #if defined(_WIN32)
             SetEvent(pImpl->hShutdown);
 #elif defined(__linux__)
@@ -387,9 +368,7 @@ namespace iMS {
                 }
             } while (totalBytesWritten < b.size());
 
-            if (m->getStatus() == Message::Status::UNSENT) {
-                m->setStatus(Message::Status::SENT);
-            }
+            m->setStatusIf(Message::Status::UNSENT, Message::Status::SENT);
 		}
 	}
 
@@ -421,11 +400,7 @@ namespace iMS {
                         ss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(RxBuffer[i]) << " ";
 //                    BOOST_LOG_SEV(lg::get(), sev::trace) << "RECD: " << ss.str();
 
-                    {
-                        std::scoped_lock lock(m_rxmutex);
-                        m_rxCharQueue.insert(m_rxCharQueue.end(), RxBuffer, RxBuffer + BytesRead);
-                    }
-                    m_rxcond.notify_one();
+                    PushRxBytes(reinterpret_cast<const char*>(RxBuffer), BytesRead);
                 }
             }            
 		}
@@ -466,11 +441,7 @@ namespace iMS {
             if (BytesAvailable > sizeof(RxBuffer)) BytesAvailable = sizeof(RxBuffer);
 
             if (FT_Read(pImpl->ftdiDevice, RxBuffer, BytesAvailable, &BytesRead) == FT_OK && BytesRead > 0) {
-                {
-                    std::scoped_lock lock(m_rxmutex);
-                    m_rxCharQueue.insert(m_rxCharQueue.end(), RxBuffer, RxBuffer + BytesRead);
-                }
-                m_rxcond.notify_one();
+                PushRxBytes(reinterpret_cast<const char*>(RxBuffer), BytesRead);
             }
         } // while(DeviceIsOpen)
 
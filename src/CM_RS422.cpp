@@ -371,10 +371,7 @@ namespace iMS {
 			m_msgRegistry.clear();
 			while (!m_queue.empty()) m_queue.pop();
 
-            {
-                std::lock_guard<std::mutex> lock(m_rxmutex);
-                m_rxCharQueue.clear();
-            }
+            m_rxRing.Reset();
 
 			// Start Report Sending Thread
 			senderThread = std::thread(&CM_RS422::MessageSender, this);
@@ -400,7 +397,8 @@ namespace iMS {
 			if (pImpl->fp == NULL) {
 				DeviceIsOpen = false;
                 m_txcond.notify_all();
-                m_tfrcond.notify_one();
+                m_rxWake.Signal();
+                StopMemoryTransfer();
                 SetEvent(pImpl->hShutdown);
 				return;
 			}
@@ -427,29 +425,13 @@ namespace iMS {
 			}
 
 			// wait for all messages to have been processed
-			bool msg_waiting{ false };
-			do
-			{
-                m_msgRegistry.forEachMessage([&](const std::shared_ptr<Message>& msg) {
-                    if (!msg->isComplete())
-					{
-						msg_waiting = true;
-					}
-                });
-				if (msg_waiting)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(25));
-					msg_waiting = false;
-				}
-				else {
-					break;
-				}
-			} while (1);
+			WaitForPendingMessages();
 
 			// Stop Threads
 			DeviceIsOpen = false;  // must set this to cancel threads
             m_txcond.notify_all();
-            m_tfrcond.notify_one();
+            m_rxWake.Signal();
+            StopMemoryTransfer();
             SetEvent(pImpl->hShutdown);
 
 			senderThread.join();
@@ -558,9 +540,7 @@ namespace iMS {
             } 
             CloseHandle(osWrite.hEvent);
 
-            if (m->getStatus() == Message::Status::UNSENT) {
-                m->setStatus(Message::Status::SENT);
-            } else if (m->getStatus() == Message::Status::SEND_ERROR) {
+            if (!m->setStatusIf(Message::Status::UNSENT, Message::Status::SENT) && (m->getStatus() == Message::Status::SEND_ERROR)) {
                 mMsgEvent.Trigger<int>(this, MessageEvents::SEND_ERROR, m->getMessageHandle());
             }
 		}
@@ -641,15 +621,7 @@ namespace iMS {
             
             if (bytesRead > 0)
             {
-                {
-                    std::scoped_lock lock(m_rxmutex);
-                    m_rxCharQueue.insert(m_rxCharQueue.end(), chRead, chRead + bytesRead);
-                    // std::unique_lock<std::mutex> rxlck{ m_rxmutex };
-                    // for (DWORD i = 0; i < bytesRead; i++) {
-                    //     m_rxCharQueue.push(chRead[i]);
-                    // }
-                }
-                m_rxcond.notify_one();
+                PushRxBytes(reinterpret_cast<const char*>(chRead), bytesRead);
 
                 // // Logging
                 // std::stringstream ss;
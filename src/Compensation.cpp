@@ -29,10 +29,15 @@
 #include "FileSystem.h"
 #include "FileSystem_p.h"
 #include "IMSTypeDefs_p.h"
+#include "Compensation_p.h"
 #include "IMSConstants.h"
 #include "spline.h"
 
 #include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+#include <stdexcept>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -76,20 +81,8 @@ namespace iMS
 		~CompensationEventTrigger() {};
 	};
 
-	class CompensationPoint::Impl
-	{
-	public:
-		Impl(Percent ampl = 0.0, Degrees phase = 0.0, unsigned int sync_dig = 0, double sync_anlg = 0.0) :
-			m_ampl(ampl), m_phase(phase), m_sync_D(sync_dig), m_sync_A(sync_anlg) {}
-		~Impl() {};
-		Percent m_ampl{ 0.0 };
-		Degrees m_phase{ 0.0 };
-		std::uint32_t m_sync_D{ 0 };
-		double m_sync_A{ 0.0 };
-	};
-
 	CompensationPoint::CompensationPoint(Percent ampl, Degrees phase, unsigned int sync_dig, double sync_anlg) : 
-		p_Impl (new Impl(ampl, phase, sync_dig, sync_anlg))
+		m_ampl(ampl), m_phase(phase), m_sync_D(sync_dig), m_sync_A(sync_anlg)
 	{}
 
     CompensationPoint::CompensationPoint(Degrees phase, unsigned int sync_dig, double sync_anlg) : 
@@ -104,52 +97,26 @@ namespace iMS
         CompensationPoint(0.0, 0.0, 0, sync_anlg)
     {}
 
-	CompensationPoint::~CompensationPoint()
-	{
-		delete p_Impl;
-		p_Impl = nullptr;
-	}
-
-	// Copy Constructor
-	CompensationPoint::CompensationPoint(const CompensationPoint &rhs) : p_Impl(new Impl())
-	{
-		this->p_Impl->m_ampl = rhs.p_Impl->m_ampl;
-		this->p_Impl->m_phase = rhs.p_Impl->m_phase;
-		this->p_Impl->m_sync_D = rhs.p_Impl->m_sync_D;
-		this->p_Impl->m_sync_A = rhs.p_Impl->m_sync_A;
-	}
-
-	// Assignment Constructor
-	CompensationPoint& CompensationPoint::operator =(const CompensationPoint &rhs)
-	{
-		if (this == &rhs) return *this;
-		this->p_Impl->m_ampl = rhs.p_Impl->m_ampl;
-		this->p_Impl->m_phase = rhs.p_Impl->m_phase;
-		this->p_Impl->m_sync_D = rhs.p_Impl->m_sync_D;
-		this->p_Impl->m_sync_A = rhs.p_Impl->m_sync_A;
-		return *this;
-	}
-
 	bool CompensationPoint::operator==(CompensationPoint const& rhs) const
 	{
-		return ((p_Impl->m_ampl == rhs.p_Impl->m_ampl) &&
-			(p_Impl->m_phase == rhs.p_Impl->m_phase) &&
-			(p_Impl->m_sync_A == rhs.p_Impl->m_sync_A) &&
-			(p_Impl->m_sync_D == rhs.p_Impl->m_sync_D));
+		return ((m_ampl == rhs.m_ampl) &&
+			(m_phase == rhs.m_phase) &&
+			(m_sync_A == rhs.m_sync_A) &&
+			(m_sync_D == rhs.m_sync_D));
 	}
 
-	void CompensationPoint::Amplitude(const Percent& ampl) { p_Impl->m_ampl = ampl; };
-	const Percent& CompensationPoint::Amplitude() const { return p_Impl->m_ampl; };
-	void CompensationPoint::Phase(const Degrees& phase) { p_Impl->m_phase = phase; };
-	const Degrees& CompensationPoint::Phase() const { return p_Impl->m_phase; };
-	void CompensationPoint::SyncDig(const unsigned int& sync) { p_Impl->m_sync_D = sync; };
-	const std::uint32_t& CompensationPoint::SyncDig() const { return p_Impl->m_sync_D; };
+	void CompensationPoint::Amplitude(const Percent& ampl) { m_ampl = ampl; };
+	const Percent& CompensationPoint::Amplitude() const { return m_ampl; };
+	void CompensationPoint::Phase(const Degrees& phase) { m_phase = phase; };
+	const Degrees& CompensationPoint::Phase() const { return m_phase; };
+	void CompensationPoint::SyncDig(const unsigned int& sync) { m_sync_D = sync; };
+	const std::uint32_t& CompensationPoint::SyncDig() const { return m_sync_D; };
 	void CompensationPoint::SyncAnlg(const double& sync) { 
 //		float f = fmaxf(fminf((float)sync, 1.0), 0.0);
 		float f = ((float)sync > 1.0f) ? 1.0f : ((float)sync < 0.0f) ? 0.0f : (float)sync;
-		p_Impl->m_sync_A = f;
+		m_sync_A = f;
 	};
-	const double& CompensationPoint::SyncAnlg() const { return p_Impl->m_sync_A; };
+	const double& CompensationPoint::SyncAnlg() const { return m_sync_A; };
 
 	class CompensationPointSpecification::Impl
 	{
@@ -310,20 +277,6 @@ namespace iMS
 		DequeBase<CompensationPoint>::insert(DequeBase<CompensationPoint>::begin(), LUTSize, pt);
 	}
 
-	struct iMSLUTFileHeader2
-	{
-		std::string signature;
-		std::uint16_t protver;
-		std::uint16_t length;
-		double start_freq;  // in MHz
-		double end_freq;    // in MHz
-		std::uint16_t pt_size;
-		std::uint16_t chan_count;
-
-		iMSLUTFileHeader2() {};
-		iMSLUTFileHeader2(const std::string& s) : signature(s) {};
-	};
-
 	// File Read Constructor
 	CompensationTable::CompensationTable(std::shared_ptr<IMSSystem> iMS, const std::string& fileName, const RFChannel& chan) : CompensationTable(iMS)
 	{
@@ -352,186 +305,57 @@ namespace iMS
 		unsigned int LUTSize = (1 << m_LUTDepth);
 		unsigned int OtherLUTSize = (1 << other.p_Impl->m_LUTDepth);
 
+		// Resample column by column from a flat copy of the source table
+		const CompensationColumns src(other);
+		CompensationColumns dst(LUTSize);
+		if (src.size() < OtherLUTSize) return false;
+
+		// Map each entry onto the source once.  Entries beyond the last source interval take the last
+		// source value, expressed as a zero-width step so that every column uses the same formula.
+		std::vector<unsigned int> lo(LUTSize), hi(LUTSize);
+		std::vector<double> x(LUTSize), x1(LUTSize), x2(LUTSize);
 		while (index < LUTSize) {
 			MHz lut_freq = CalculateFrequencyAtIndex(m_UpperFrequency, m_LowerFrequency, index, LUTSize);
 			unsigned int other_index = CalculateIndexFromFrequency(other.p_Impl->m_UpperFrequency, other.p_Impl->m_LowerFrequency, lut_freq, OtherLUTSize);
 			unsigned int syncd = 0;
 
+			lo[index] = other_index;
 			if (other_index < (OtherLUTSize - 1)) {
-				MHz other_lfreq = CalculateFrequencyAtIndex(other.p_Impl->m_UpperFrequency, other.p_Impl->m_LowerFrequency, other_index, OtherLUTSize);
-				MHz other_ufreq = CalculateFrequencyAtIndex(other.p_Impl->m_UpperFrequency, other.p_Impl->m_LowerFrequency, other_index + 1, OtherLUTSize);
-
-				m_parent->DequeBase<CompensationPoint>::operator[](index).Amplitude(
-					Percent(lin_interp(other_lfreq, other[other_index].Amplitude(), other_ufreq, other[other_index + 1].Amplitude(), lut_freq))
-				);
-				m_parent->DequeBase<CompensationPoint>::operator[](index).Phase(
-					Degrees(lin_interp(other_lfreq, other[other_index].Phase(), other_ufreq, other[other_index + 1].Phase(), lut_freq))
-				);
-				m_parent->DequeBase<CompensationPoint>::operator[](index).SyncAnlg(
-					Degrees(lin_interp(other_lfreq, other[other_index].SyncAnlg(), other_ufreq, other[other_index + 1].SyncAnlg(), lut_freq))
-				);
+				hi[index] = other_index + 1;
+				x[index] = lut_freq;
+				x1[index] = CalculateFrequencyAtIndex(other.p_Impl->m_UpperFrequency, other.p_Impl->m_LowerFrequency, other_index, OtherLUTSize);
+				x2[index] = CalculateFrequencyAtIndex(other.p_Impl->m_UpperFrequency, other.p_Impl->m_LowerFrequency, other_index + 1, OtherLUTSize);
 			}
 			else {
-				m_parent->DequeBase<CompensationPoint>::operator[](index).Amplitude(other[other_index].Amplitude());
-				m_parent->DequeBase<CompensationPoint>::operator[](index).Phase(other[other_index].Phase());
-				m_parent->DequeBase<CompensationPoint>::operator[](index).SyncAnlg(other[other_index].SyncAnlg());
+				hi[index] = other_index;
+				x[index] = x1[index] = 0.0;
+				x2[index] = 1.0;
 			}
 
 			while (prev_index <= other_index) {
-				syncd |= other[prev_index++].SyncDig();
+				syncd |= src.syncDig[prev_index++];
 			}
-			m_parent->DequeBase<CompensationPoint>::operator[](index).SyncDig(syncd);
+			dst.syncDig[index] = syncd;
 
 			index++;
 		}
-		return true;
-	}
-
-	bool ReadCompensationTableHeader(iMSLUTFileHeader2& hdr, const std::string& fileName) {
-		const std::string FileHeader = "iMS_LUT";
 
-		char * header;
-		std::ifstream ifile(fileName, std::ios::binary | std::ios::in | std::ios::ate);
-
-		if (ifile.is_open())
-		{
-			unsigned int size = static_cast<unsigned int>(ifile.tellg());
-			header = new char[64]; // Header block always 64 bytes
-			if (size < 64)
-			{
-				ifile.close();
-				return false;
-			}
-			ifile.seekg(0, std::ios::beg);
-			ifile.read(header, 64);
-			hdr = iMSLUTFileHeader2(std::string(header, FileHeader.size()));
-			hdr.protver = header[8] | (static_cast<std::uint16_t>(header[9]) << 8);
-			hdr.length = static_cast<std::uint16_t>(header[10]) | (static_cast<std::uint16_t>(header[11]) << 8);
-			std::uint64_t d = PCharToUInt<std::uint64_t>(&header[12]);
-			hdr.start_freq = *reinterpret_cast<double*>(&d); // TODO: Fix this by providing a definition for PCharToDouble
-			d = PCharToUInt<std::uint64_t>(&header[20]);
-			hdr.end_freq = *reinterpret_cast<double*>(&d);
-			hdr.pt_size = static_cast<std::uint16_t>(header[28]) | (static_cast<std::uint16_t>(header[29]) << 8);
-			if (hdr.protver > 2) {
-				hdr.chan_count = static_cast<std::uint16_t>(header[30]) | (static_cast<std::uint16_t>(header[31]) << 8);
-			}
-			else hdr.chan_count = 1;
-
-			// Sanity checks
-			if (hdr.signature != FileHeader)
-			{
-				delete[] header;
-				ifile.close();
-				return false; // not an iMS LUT file
-			}
-			if (hdr.protver < 2)
-			{
-				delete[] header;
-				ifile.close();
-				return false; // unsupported protocol version
-			}
-			if ((size - 64) != static_cast<unsigned int>(hdr.chan_count * hdr.length * hdr.pt_size))
-			{
-				delete[] header;
-				ifile.close();
-				return false; // unexpected file length
+		auto resample = [&](const std::vector<double>& s, std::vector<double>& d) {
+			for (unsigned int i = 0; i < LUTSize; i++) {
+				d[i] = lin_interp(x1[i], s[lo[i]], x2[i], s[hi[i]], x[i]);
 			}
-			delete[] header;
-			ifile.close();
-		}
-		else {
-			return false;
-		}
+		};
+		resample(src.ampl, dst.ampl);
+		resample(src.phase, dst.phase);
+		resample(src.syncAnlg, dst.syncAnlg);
 
+		dst.Scatter(*m_parent);
 		return true;
 	}
 
 	void CompensationTable::Impl::Load(const std::string& fileName, const RFChannel& chan)
 	{
-		iMSLUTFileHeader2 hdr;
-		if (!ReadCompensationTableHeader(hdr, fileName)) return;
-		if ((hdr.start_freq > m_UpperFrequency) || (hdr.end_freq < m_LowerFrequency))
-		{
-			return; // Frequencies must overlap
-		}
-
-		std::ifstream ifile(fileName, std::ios::binary | std::ios::in);
-
-		if (ifile.is_open())
-		{
-			// All set!
-			int offset = 64;
-			if (chan <= hdr.chan_count) offset += ((static_cast<unsigned int>(chan) - 1) * static_cast<unsigned int>(hdr.length * hdr.pt_size));
-			ifile.seekg(offset, std::ios::beg);
-			char * data;
-			data = new char[hdr.pt_size];
-
-			int i = 0, j = 0;
-
-			Percent pct(0.0);
-			Degrees deg(0.0);
-			std::uint32_t syncd;
-			double synca;
-
-			std::uint64_t d;
-
-			do
-			{
-				ifile.read(data, hdr.pt_size);
-
-				// Amplitude
-				d = PCharToUInt<std::uint64_t>(&data[0]);
-				pct = *reinterpret_cast<double*>(&d);
-				
-				// Phase
-				d = PCharToUInt<std::uint64_t>(&data[8]);
-				deg = *reinterpret_cast<double*>(&d);
-				
-				// Sync Digital
-				syncd = PCharToUInt<std::uint32_t>(&data[16]);
-				
-				// Sync Analog
-				d = PCharToUInt<std::uint64_t>(&data[20]);
-				synca = *reinterpret_cast<double*>(&d);
-			} while (m_parent->FrequencyAt(i) > CalculateFrequencyAtIndex(hdr.end_freq, hdr.start_freq, j++, hdr.length));
-
-			for (i = 0; i < (1 << m_LUTDepth); )
-			{
-				m_parent->DequeBase<CompensationPoint>::operator[](i).Amplitude(pct);
-				m_parent->DequeBase<CompensationPoint>::operator[](i).Phase(deg);
-				m_parent->DequeBase<CompensationPoint>::operator[](i).SyncDig(syncd);
-				m_parent->DequeBase<CompensationPoint>::operator[](i).SyncAnlg(synca);
-
-				i++;
-
-				syncd = 0;
-				while ((m_parent->FrequencyAt(i) >= CalculateFrequencyAtIndex(hdr.end_freq, hdr.start_freq, j, hdr.length)) && (j < hdr.length))
-				{
-					ifile.read(data, hdr.pt_size);
-
-					// Amplitude
-					d = PCharToUInt<std::uint64_t>(&data[0]);
-					pct = *reinterpret_cast<double*>(&d);
-
-					// Phase
-					d = PCharToUInt<std::uint64_t>(&data[8]);
-					deg = *reinterpret_cast<double*>(&d);
-
-					// Sync Digital
-					syncd |= PCharToUInt<std::uint32_t>(&data[16]);
-
-					// Sync Analog
-					d = PCharToUInt<std::uint64_t>(&data[20]);
-					synca = *reinterpret_cast<double*>(&d);
-
-					j++;
-				}
-
-			}
-			delete[] data;
-		}
-		else throw std::exception();
-		ifile.close();
+		if (auto map = LUTFileMap::Open(fileName)) map->Load(*m_parent, chan);
 	}
 
 	// Non-Volatile Memory Recall Constructor
@@ -583,199 +407,497 @@ namespace iMS
 		return *this;
 	}
 
-	void FunctionInterpolate(const std::map<double, double>& func, 
-		const MHz& lower, const MHz& upper,
-		const CompensationFunction::InterpolationStyle style,
-		std::vector<double>& result, int result_size)
+	// Evaluates a CompensationFunction at every entry of a table.  The LUT frequencies and the sorted
+	// spec points are prepared once and shared by all four features.  For each interpolation style in
+	// use, the segment or spec point that applies at each entry is resolved in a single walk; each
+	// feature is then filled by a flat loop over contiguous arrays that the compiler can vectorise.
+	class FunctionEvaluator
 	{
-		std::vector<double> freq(func.size()), val(func.size());
-		int i = 0;
+	public:
+		FunctionEvaluator(const CompensationFunction& func, double lower, double upper, std::size_t size);
 
-		result = std::vector<double>(result_size, 0.0);
+		void Evaluate(const CompensationFeature feat, std::vector<double>& result) const;
 
-		if ((func.size() < 1) || (result_size < 1)) return;
+	private:
+		using Style = CompensationFunction::InterpolationStyle;
 
-		for (auto& f : func) {
-			freq[i] = f.first;
-			val[i++] = f.second;
+		// Interpolation between two breakpoints for each entry
+		struct Segments
+		{
+			std::vector<std::size_t> index;  // lower breakpoint
+			std::vector<double> x1, x2;      // breakpoint frequencies
+		};
+
+		void BuildLinear();
+		void BuildLinExtend();
+		void BuildSpotStep(bool step);
+		void Interp(const Segments& seg, const std::vector<double>& y, std::vector<double>& result) const;
+
+		const CompensationFunction& m_func;
+		const double m_lower;
+		const double m_upper;
+		std::vector<double> m_grid;               // LUT entry frequencies
+		std::vector<double> m_freq;               // spec point frequencies, ascending
+		std::array<std::vector<double>, 4> m_val; // spec point values, indexed by feature
+
+		Segments m_linear;
+		Segments m_linextend;
+		std::vector<std::ptrdiff_t> m_spot;       // spec point emitted at each entry, or -1
+		std::vector<std::ptrdiff_t> m_step;       // spec point held at each entry, or -1
+	};
+
+	static std::size_t FeatureIndex(const CompensationFeature feat)
+	{
+		switch (feat) {
+		case CompensationFeature::AMPLITUDE: return 0;
+		case CompensationFeature::PHASE: return 1;
+		case CompensationFeature::SYNC_DIG: return 2;
+		default: return 3;
 		}
+	}
 
-		unsigned int index = 0;
+	FunctionEvaluator::FunctionEvaluator(const CompensationFunction& func, double lower, double upper, std::size_t size)
+		: m_func(func), m_lower(lower), m_upper(upper), m_grid(size)
+	{
+		for (std::size_t i = 0; i < size; i++) {
+			m_grid[i] = CalculateFrequencyAtIndex(upper, lower, static_cast<unsigned int>(i), static_cast<unsigned int>(size));
+		}
 
-		switch (style) {
-		case CompensationFunction::InterpolationStyle::BSPLINE: 
-		{
-			tk::spline spline;
-			//spline.set_boundary(tk::spline::second_deriv, 0.0, tk::spline::first_deriv, -2.0, false);
-			spline.set_points(freq, val);
+		// Sort the spec points by frequency.  Where several share a frequency, the first one is used.
+		std::vector<const CompensationPointSpecification*> spec;
+		for (auto it = func.begin(); it != func.end(); ++it) spec.push_back(&(*it));
+		std::stable_sort(spec.begin(), spec.end(), [](const CompensationPointSpecification* a, const CompensationPointSpecification* b) {
+			return a->Freq() < b->Freq();
+		});
+		for (const auto* s : spec) {
+			if (!m_freq.empty() && (m_freq.back() == s->Freq())) continue;
+			m_freq.push_back(s->Freq());
+			m_val[0].push_back(s->Spec().Amplitude());
+			m_val[1].push_back(s->Spec().Phase());
+			m_val[2].push_back(s->Spec().SyncDig());
+			m_val[3].push_back(s->Spec().SyncAnlg());
+		}
+		if (m_freq.empty() || m_grid.empty()) return;
 
-			while (index < result_size) {
-				MHz lut_freq = CalculateFrequencyAtIndex(upper, lower, index, result_size);
-				result[index++] = spline(lut_freq);
+		// Resolve the entry mapping once for each style used by any feature
+		std::set<Style> styles;
+		for (auto feat : { CompensationFeature::AMPLITUDE, CompensationFeature::PHASE, CompensationFeature::SYNC_DIG, CompensationFeature::SYNC_ANLG }) {
+			styles.insert(func.GetStyle(feat));
+		}
+		for (auto style : styles) {
+			switch (style) {
+			case Style::LINEAR: BuildLinear(); break;
+			case Style::LINEXTEND: BuildLinExtend(); break;
+			case Style::SPOT: BuildSpotStep(false); break;
+			case Style::STEP: BuildSpotStep(true); break;
+			case Style::BSPLINE: break;
 			}
+		}
+	}
 
-			break;
+	// Linear between spec points, held flat from the lower LUT frequency to the first spec point and
+	// from the last spec point to the upper LUT frequency.  Breakpoint i + 1 is spec point i.
+	void FunctionEvaluator::BuildLinear()
+	{
+		const std::size_t n = m_grid.size();
+		const std::size_t last = m_freq.size();
+		m_linear.index.resize(n);
+		m_linear.x1.resize(n);
+		m_linear.x2.resize(n);
+
+		std::size_t s = 0;
+		double f1 = m_lower, f2 = m_freq[0];
+		for (std::size_t i = 0; i < n; i++) {
+			while ((m_grid[i] > f2) && (s < last)) {
+				s++;
+				f1 = f2;
+				f2 = (s < last) ? m_freq[s] : m_upper;
+			}
+			m_linear.index[i] = s;
+			m_linear.x1[i] = f1;
+			m_linear.x2[i] = f2;
 		}
+	}
 
-		case CompensationFunction::InterpolationStyle::LINEAR: 
-		{
-			std::map<double, double>::const_iterator it = func.begin(), it2 = func.begin();
-			double f1 = lower;
-			double f2 = it2->first;
-			double v1 = it->second;
-			double v2 = it2->second;
-			while (index < result_size) {
-				MHz lut_freq = CalculateFrequencyAtIndex(upper, lower, index, result_size);
-				while (lut_freq > f2) {
-					it = it2; f1 = f2; v1 = v2;
-					if (it2 != func.end()) {
-						it2++;
-					}
-					if (it2 != func.end()) {
-						f2 = it2->first;
-						v2 = it2->second;
-					}
-					else {
-						f2 = upper;
-					}
-				}
-				result[index++] = lin_interp(f1, v1, f2, v2, lut_freq);
+	// Linear through the nearest pair of spec points, extrapolated beyond the first and last
+	void FunctionEvaluator::BuildLinExtend()
+	{
+		const std::size_t n = m_grid.size();
+		const std::size_t count = m_freq.size();
+		m_linextend.index.resize(n);
+		m_linextend.x1.resize(n);
+		m_linextend.x2.resize(n);
+
+		std::size_t s = 0;
+		for (std::size_t i = 0; i < n; i++) {
+			while ((s + 2 < count) && (m_grid[i] > m_freq[s + 1])) s++;
+			m_linextend.index[i] = s;
+			m_linextend.x1[i] = m_freq[s];
+			m_linextend.x2[i] = m_freq[std::min(s + 1, count - 1)];
+		}
+	}
+
+	// Each spec point is taken up by the first entry above its frequency, one spec point per entry.
+	// SPOT emits it at that entry only, STEP holds it until the next one is taken up.
+	void FunctionEvaluator::BuildSpotStep(bool step)
+	{
+		std::vector<std::ptrdiff_t>& map = step ? m_step : m_spot;
+		const std::size_t n = m_grid.size();
+		map.assign(n, -1);
+
+		std::size_t next = 0;
+		std::ptrdiff_t held = -1;
+		for (std::size_t i = 0; i < n; i++) {
+			if ((next < m_freq.size()) && (m_grid[i] > m_freq[next])) {
+				held = static_cast<std::ptrdiff_t>(next++);
+				map[i] = held;
 			}
-			break;
+			else if (step) {
+				map[i] = held;
+			}
+		}
+	}
+
+	void FunctionEvaluator::Interp(const Segments& seg, const std::vector<double>& y, std::vector<double>& result) const
+	{
+		const std::size_t n = m_grid.size();
+		std::vector<double> y1(n), y2(n);
+		for (std::size_t i = 0; i < n; i++) {
+			y1[i] = y[seg.index[i]];
+			y2[i] = y[seg.index[i] + 1];
 		}
 
-		case CompensationFunction::InterpolationStyle::LINEXTEND:
+		const double* x = m_grid.data();
+		const double* x1 = seg.x1.data();
+		const double* x2 = seg.x2.data();
+		double* r = result.data();
+		for (std::size_t i = 0; i < n; i++) {
+			r[i] = lin_interp(x1[i], y1[i], x2[i], y2[i], x[i]);
+		}
+	}
+
+	void FunctionEvaluator::Evaluate(const CompensationFeature feat, std::vector<double>& result) const
+	{
+		const std::size_t n = m_grid.size();
+		result.assign(n, 0.0);
+		if (m_freq.empty() || (n == 0)) return;
+
+		const std::vector<double>& val = m_val[FeatureIndex(feat)];
+
+		switch (m_func.GetStyle(feat)) {
+		case Style::BSPLINE:
 		{
-			std::map<double, double>::const_iterator it = func.begin(), it2 = func.begin();
-			if (it2 != func.end()) it2++;
-			double f1 = it->first;
-			double f2 = it2->first;
-			double v1 = it->second;
-			double v2 = it2->second;
-			while (index < result_size) {
-				MHz lut_freq = CalculateFrequencyAtIndex(upper, lower, index, result_size);
-				while ((lut_freq > f2) && (it2 != func.end())) {
-					it2++;
-					if (it2 != func.end()) {
-						it = it2; f1 = f2; v1 = v2;
-						f2 = it2->first;
-						v2 = it2->second;
-					}
-				}
-				result[index++] = lin_interp(f1, v1, f2, v2, lut_freq);
+			tk::spline spline;
+			spline.set_points(m_freq, val);
+			for (std::size_t i = 0; i < n; i++) {
+				result[i] = spline(m_grid[i]);
 			}
 			break;
 		}
-
-		case CompensationFunction::InterpolationStyle::SPOT:
+		case Style::LINEAR:
 		{
-			std::map<double, double>::const_iterator it = func.begin();
-			while (index < result_size) {
-				MHz lut_freq = CalculateFrequencyAtIndex(upper, lower, index, result_size);
-				if (it != func.end()) {
-					if (lut_freq > it->first) {
-						result[index++] = it->second;
-						it++;
-					}
-					else {
-						result[index++] = 0.0;
-					}
-				}
-				else {
-					result[index++] = 0.0;
-				}
+			// Breakpoint values: first and last spec values repeated at the LUT frequency limits
+			std::vector<double> y(val.size() + 2);
+			y.front() = val.front();
+			std::copy(val.begin(), val.end(), y.begin() + 1);
+			y.back() = val.back();
+			Interp(m_linear, y, result);
+			break;
+		}
+		case Style::LINEXTEND:
+		{
+			if (val.size() < 2) {
+				std::fill(result.begin(), result.end(), val.front());
+				break;
 			}
+			Interp(m_linextend, val, result);
 			break;
 		}
-
-		case CompensationFunction::InterpolationStyle::STEP: 
+		case Style::SPOT:
+		case Style::STEP:
 		{
-			std::map<double, double>::const_iterator it = func.begin();
-			double d = 0.0;
-			while (index < result_size) {
-				MHz lut_freq = CalculateFrequencyAtIndex(upper, lower, index, result_size);
-				if (it != func.end()) {
-					if (lut_freq > it->first) {
-						d = it->second;
-						it++;
-					}
-				}
-				result[index++] = d;
+			const std::vector<std::ptrdiff_t>& map = (m_func.GetStyle(feat) == Style::STEP) ? m_step : m_spot;
+			for (std::size_t i = 0; i < n; i++) {
+				result[i] = (map[i] < 0) ? 0.0 : val[map[i]];
 			}
 			break;
 		}
-
 		}
+	}
 
+	// Combines one interpolated value with an existing point
+	static inline void ModifyPoint(CompensationPoint& pt, const CompensationFeature feat, double value, bool multiply)
+	{
+		switch (feat) {
+		case CompensationFeature::AMPLITUDE: {
+			if (multiply) value *= (pt.Amplitude() / 100.0);
+			pt.Amplitude(Percent(value));
+			break;
+		}
+		case CompensationFeature::PHASE: {
+			if (multiply) value *= (pt.Phase() / 360.0);
+			pt.Phase(Degrees(value));
+			break;
+		}
+		case CompensationFeature::SYNC_DIG: {
+			std::uint32_t val = static_cast<std::uint32_t>(value);
+			if (multiply) val |= pt.SyncDig();
+			pt.SyncDig(val);
+			break;
+		}
+		case CompensationFeature::SYNC_ANLG: {
+			if (multiply) value *= pt.SyncAnlg();
+			pt.SyncAnlg(value);
+			break;
+		}
+		}
 	}
 
 	bool CompensationTable::ApplyFunction(const CompensationFunction& func, const CompensationFeature feat, CompensationModifier modifier)
 	{
-		std::map<double, double> func_map;
+		const FunctionEvaluator eval(func, p_Impl->m_LowerFrequency, p_Impl->m_UpperFrequency, this->Size());
 		std::vector<double> result;
-		for (auto it = func.begin(); it != func.end(); ++it)
-		{
-			switch (feat) {
-			case CompensationFeature::AMPLITUDE: func_map.emplace(it->Freq(), it->Spec().Amplitude()); break;
-			case CompensationFeature::PHASE: func_map.emplace(it->Freq(), it->Spec().Phase()); break;
-			case CompensationFeature::SYNC_DIG: func_map.emplace(it->Freq(), it->Spec().SyncDig()); break;
-			case CompensationFeature::SYNC_ANLG: func_map.emplace(it->Freq(), it->Spec().SyncAnlg()); break;
-			}
-		}
-
-		FunctionInterpolate(func_map, p_Impl->m_LowerFrequency, p_Impl->m_UpperFrequency,
-			func.GetStyle(feat), result, this->Size());
+		eval.Evaluate(feat, result);
 
-		for (unsigned int index = 0; index < this->Size(); index++) {
-			switch (feat) {
-			case CompensationFeature::AMPLITUDE: {
-				if (modifier == CompensationModifier::MULTIPLY) {
-					double val = DequeBase<CompensationPoint>::operator[](index).Amplitude();
-					result[index] *= (val / 100.0);
-				}
-				DequeBase<CompensationPoint>::operator[](index).Amplitude(Percent(result[index]));
-				break;
-			}
-			case CompensationFeature::PHASE: {
-				if (modifier == CompensationModifier::MULTIPLY) {
-					double val = DequeBase<CompensationPoint>::operator[](index).Phase();
-					result[index] *= (val / 360.0);
-				}
-				DequeBase<CompensationPoint>::operator[](index).Phase(Degrees(result[index]));
-				break;
-			}
-			case CompensationFeature::SYNC_DIG: {
-				if (modifier == CompensationModifier::MULTIPLY) {
-					uint32_t val = DequeBase<CompensationPoint>::operator[](index).SyncDig();
-					result[index] = val | (static_cast<uint32_t>(result[index]));
-				}
-				DequeBase<CompensationPoint>::operator[](index).SyncDig(static_cast<uint32_t>(result[index]));
-				break;
-			}
-			case CompensationFeature::SYNC_ANLG: {
-				if (modifier == CompensationModifier::MULTIPLY) {
-					double val = DequeBase<CompensationPoint>::operator[](index).SyncAnlg();
-					result[index] *= val;
-				}
-				DequeBase<CompensationPoint>::operator[](index).SyncAnlg(result[index]);
-				break;
-			}
-			}
+		const bool multiply = (modifier == CompensationModifier::MULTIPLY);
+		std::size_t index = 0;
+		for (auto it = begin(); it != end(); ++it, ++index) {
+			ModifyPoint(*it, feat, result[index], multiply);
 		}
+
+		// Points written through iterators aren't tracked by the table
+		this->MarkModified();
 		return true;
 	}
 
 	bool CompensationTable::ApplyFunction(const CompensationFunction& func, CompensationModifier modifier)
 	{
-		this->ApplyFunction(func, CompensationFeature::AMPLITUDE, modifier);
-		this->ApplyFunction(func, CompensationFeature::PHASE, modifier);
-		this->ApplyFunction(func, CompensationFeature::SYNC_DIG, modifier);
-		this->ApplyFunction(func, CompensationFeature::SYNC_ANLG, modifier);
+		const FunctionEvaluator eval(func, p_Impl->m_LowerFrequency, p_Impl->m_UpperFrequency, this->Size());
+		CompensationColumns result(this->Size());
+		eval.Evaluate(CompensationFeature::AMPLITUDE, result.ampl);
+		eval.Evaluate(CompensationFeature::PHASE, result.phase);
+		eval.Evaluate(CompensationFeature::SYNC_ANLG, result.syncAnlg);
+		std::vector<double> syncd;
+		eval.Evaluate(CompensationFeature::SYNC_DIG, syncd);
+
+		// All four features are written back in a single pass over the table
+		const bool multiply = (modifier == CompensationModifier::MULTIPLY);
+		std::size_t index = 0;
+		for (auto it = begin(); it != end(); ++it, ++index) {
+			ModifyPoint(*it, CompensationFeature::AMPLITUDE, result.ampl[index], multiply);
+			ModifyPoint(*it, CompensationFeature::PHASE, result.phase[index], multiply);
+			ModifyPoint(*it, CompensationFeature::SYNC_DIG, syncd[index], multiply);
+			ModifyPoint(*it, CompensationFeature::SYNC_ANLG, result.syncAnlg[index], multiply);
+		}
+
+		this->MarkModified();
 		return true;
 	}
 
 	const std::size_t CompensationTable::Size() const { return DequeBase<CompensationPoint>::size(); };
 
+	void CompensationColumns::resize(std::size_t n)
+	{
+		ampl.resize(n);
+		phase.resize(n);
+		syncDig.resize(n);
+		syncAnlg.resize(n);
+	}
+
+	void CompensationColumns::Gather(const CompensationTable& tbl)
+	{
+		resize(tbl.Size());
+		std::size_t i = 0;
+		for (auto it = tbl.cbegin(); it != tbl.cend(); ++it, ++i) {
+			ampl[i] = it->Amplitude();
+			phase[i] = it->Phase();
+			syncDig[i] = it->SyncDig();
+			syncAnlg[i] = it->SyncAnlg();
+		}
+	}
+
+	void CompensationColumns::Scatter(CompensationTable& tbl) const
+	{
+		std::size_t i = 0;
+		for (auto it = tbl.begin(); (it != tbl.end()) && (i < size()); ++it, ++i) {
+			it->Amplitude(Percent(ampl[i]));
+			it->Phase(Degrees(phase[i]));
+			it->SyncDig(syncDig[i]);
+			it->SyncAnlg(syncAnlg[i]);
+		}
+		// Points written through iterators aren't tracked by the table
+		tbl.MarkModified();
+	}
+
+	void CompensationColumns::Format(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>& out, std::size_t first, std::size_t count) const
+	{
+		if (first >= size()) return;
+		count = std::min(count, size() - first);
+
+		std::vector<std::uint16_t> phase_hw(count), ampl_hw(count);
+		PhaseRenderer::RenderAsCompensationPoints(ims, &phase[first], count, phase_hw.data());
+		AmplitudeRenderer::RenderAsCompensationPoints(ims, &ampl[first], count, ampl_hw.data());
+
+		const std::uint16_t sync_mask = static_cast<std::uint16_t>((1 << ims->Synth().GetCap().LUTSyncDBits) - 1);
+		const double anlg_scale = pow(2.0, ims->Synth().GetCap().LUTSyncABits) - 1.0;
+
+		std::size_t pos = out.size();
+		out.resize(pos + count * 8);
+		std::uint8_t* p = &out[pos];
+		for (std::size_t i = 0; i < count; i++, p += 8) {
+			const std::uint16_t sync_dgtl = static_cast<std::uint16_t>(syncDig[first + i]) & sync_mask;
+			const double anlg = std::max<double>(0.0, std::min<double>(1.0, syncAnlg[first + i]));
+			const std::uint16_t sync_anlg = static_cast<std::uint16_t>(std::floor(anlg * anlg_scale + 0.5));
+			p[0] = static_cast<std::uint8_t>(phase_hw[i] & 0xFF);
+			p[1] = static_cast<std::uint8_t>((phase_hw[i] >> 8) & 0xFF);
+			p[2] = static_cast<std::uint8_t>(ampl_hw[i] & 0xFF);
+			p[3] = static_cast<std::uint8_t>((ampl_hw[i] >> 8) & 0xFF);
+			p[4] = static_cast<std::uint8_t>(sync_dgtl & 0xFF);
+			p[5] = static_cast<std::uint8_t>((sync_dgtl >> 8) & 0xFF);
+			p[6] = static_cast<std::uint8_t>(sync_anlg & 0xFF);
+			p[7] = static_cast<std::uint8_t>((sync_anlg >> 8) & 0xFF);
+		}
+	}
+
+	namespace {
+		double PCharToDouble(const char* const c)
+		{
+			std::uint64_t d = PCharToUInt<std::uint64_t>(c);
+			return *reinterpret_cast<double*>(&d);
+		}
+
+		void DoubleToPChar(char* const c, double v)
+		{
+			UIntToPChar<std::uint64_t>(c, *reinterpret_cast<const std::uint64_t*>(&v));
+		}
+	}
+
+	double LUTFileMap::TableView::Amplitude(int i) const { return PCharToDouble(&m_data[i * m_pt_size]); }
+	double LUTFileMap::TableView::Phase(int i) const { return PCharToDouble(&m_data[i * m_pt_size + 8]); }
+	std::uint32_t LUTFileMap::TableView::SyncDig(int i) const { return PCharToUInt<std::uint32_t>(&m_data[i * m_pt_size + 16]); }
+	double LUTFileMap::TableView::SyncAnlg(int i) const { return PCharToDouble(&m_data[i * m_pt_size + 20]); }
+
+	LUTFileMap::LUTFileMap(std::unique_ptr<MappedFile> file, const iMSLUTFileHeader2& hdr) : m_file(std::move(file)), m_hdr(hdr) {}
+
+	LUTFileMap::~LUTFileMap() {}
+
+	std::shared_ptr<const LUTFileMap> LUTFileMap::Open(const std::string& fileName)
+	{
+		const std::string FileHeader = "iMS_LUT";
+
+		auto file = std::make_unique<MappedFile>(fileName);
+		if (!file->IsOpen() || (file->Size() < HeaderSize)) return nullptr;
+
+		const char* header = file->Data();
+		iMSLUTFileHeader2 hdr(std::string(header, FileHeader.size()));
+		hdr.protver = PCharToUInt<std::uint16_t>(&header[8]);
+		hdr.length = PCharToUInt<std::uint16_t>(&header[10]);
+		hdr.start_freq = PCharToDouble(&header[12]);
+		hdr.end_freq = PCharToDouble(&header[20]);
+		hdr.pt_size = PCharToUInt<std::uint16_t>(&header[28]);
+		if (hdr.protver > 2) {
+			hdr.chan_count = PCharToUInt<std::uint16_t>(&header[30]);
+		}
+		else hdr.chan_count = 1;
+
+		// Sanity checks
+		if (hdr.signature != FileHeader) return nullptr; // not an iMS LUT file
+		if (hdr.protver < 2) return nullptr; // unsupported protocol version
+		if ((hdr.length == 0) || (hdr.chan_count == 0) || (hdr.pt_size < PointSize)) return nullptr; // no usable points
+		if ((file->Size() - HeaderSize) != static_cast<std::size_t>(hdr.chan_count) * hdr.length * hdr.pt_size) return nullptr; // unexpected file length
+
+		return std::shared_ptr<const LUTFileMap>(new LUTFileMap(std::move(file), hdr));
+	}
+
+	LUTFileMap::TableView LUTFileMap::Table(int chan) const
+	{
+		std::size_t offset = HeaderSize;
+		if ((chan >= RFChannel::min) && (chan <= m_hdr.chan_count)) {
+			offset += static_cast<std::size_t>(chan - 1) * m_hdr.length * m_hdr.pt_size;
+		}
+		return TableView(m_file->Data() + offset, m_hdr.length, m_hdr.pt_size);
+	}
+
+	bool LUTFileMap::Load(CompensationTable& tbl, int chan) const
+	{
+		if ((m_hdr.start_freq > tbl.UpperFrequency()) || (m_hdr.end_freq < tbl.LowerFrequency()))
+		{
+			return false; // Frequencies must overlap
+		}
+
+		const TableView view = Table(chan);
+		const int length = view.size();
+		const int size = static_cast<int>(tbl.Size());
+		auto file_freq = [&](int j) { return CalculateFrequencyAtIndex(m_hdr.end_freq, m_hdr.start_freq, j, length); };
+
+		CompensationColumns cols(size);
+		double pct, deg, synca;
+		std::uint32_t syncd;
+		auto read = [&](int j) {
+			pct = view.Amplitude(j);
+			deg = view.Phase(j);
+			synca = view.SyncAnlg(j);
+		};
+
+		// Skip file entries below the first table entry
+		int i = 0, j = 0;
+		do
+		{
+			read(std::min(j, length - 1));
+			syncd = view.SyncDig(std::min(j, length - 1));
+		} while (tbl.FrequencyAt(i) > file_freq(j++));
+
+		// Each table entry takes the last file entry at or below its frequency
+		for (i = 0; i < size; )
+		{
+			cols.ampl[i] = pct;
+			cols.phase[i] = deg;
+			cols.syncDig[i] = syncd;
+			cols.syncAnlg[i] = synca;
+
+			i++;
+
+			syncd = 0;
+			while ((tbl.FrequencyAt(i) >= file_freq(j)) && (j < length))
+			{
+				read(j);
+				syncd |= view.SyncDig(j);
+				j++;
+			}
+		}
+		cols.Scatter(tbl);
+		return true;
+	}
+
+	void LUTFileMap::Encode(const std::vector<CompensationColumns>& tables, double start_freq, double end_freq, std::vector<char>& out)
+	{
+		const std::string FileHeader = "iMS_LUT";
+		const std::size_t length = tables.empty() ? 0 : tables.front().size();
+		out.assign(HeaderSize + tables.size() * length * PointSize, 0);
+
+		// Header block always 64 bytes
+		char* header = out.data();
+		std::copy(FileHeader.begin(), FileHeader.end(), header);
+		UIntToPChar<std::uint16_t>(&header[8], 3);
+		UIntToPChar<std::uint16_t>(&header[10], static_cast<std::uint16_t>(length));
+		DoubleToPChar(&header[12], start_freq);
+		DoubleToPChar(&header[20], end_freq);
+		UIntToPChar<std::uint16_t>(&header[28], static_cast<std::uint16_t>(PointSize));
+		UIntToPChar<std::uint16_t>(&header[30], static_cast<std::uint16_t>(tables.size()));
+
+		// Then the table contents, one channel at a time
+		char* p = out.data() + HeaderSize;
+		for (const auto& cols : tables) {
+			for (std::size_t i = 0; i < length; i++, p += PointSize)
+			{
+				DoubleToPChar(&p[0], cols.ampl[i]);
+				DoubleToPChar(&p[8], cols.phase[i]);
+				UIntToPChar<std::uint32_t>(&p[16], cols.syncDig[i]);
+				DoubleToPChar(&p[20], cols.syncAnlg[i]);
+			}
+		}
+	}
+
 	const MHz CompensationTable::FrequencyAt(const unsigned int index) const
 	{
 		return CalculateFrequencyAtIndex(p_Impl->m_UpperFrequency, p_Impl->m_LowerFrequency, index, this->Size());
@@ -816,96 +938,57 @@ namespace iMS
 	};
 
 	bool CompensationTableExporter::Impl::ExportLUTFile(bool global_lut) {
-		const std::string FileHeader = "iMS_LUT";
-		const int CompensationPointSize = sizeof(std::uint64_t) * 3 + sizeof(std::uint32_t);
-		char * header;
-		std::ofstream ofile(m_name, std::ios::binary | std::ios::out);
-		std::unique_ptr<CompensationTable> local_table;
+		std::vector<CompensationColumns> tables;
+		double start_freq, end_freq;
 
 		if (global_lut) {
 			if (m_gtbl == nullptr) return false;
-            int size = static_cast<int>(m_gtbl->Size());
-			local_table = std::make_unique<CompensationTable>(size, m_gtbl->LowerFrequency(), m_gtbl->UpperFrequency(), *m_gtbl);
+			tables.emplace_back(*m_gtbl);
+			start_freq = m_gtbl->LowerFrequency();
+			end_freq = m_gtbl->UpperFrequency();
 		} else {
 			// Check each of the Comp Tables is valid
 			for (int i = RFChannel::min; i <= m_chan_count; i++) {
 				if (m_ctbl[i - RFChannel::min] == nullptr) return false;
 			}
+			// Every channel is resampled to the dimensions of the first.  The channels are independent
+			// so they are built concurrently.
             int size = static_cast<int>(m_ctbl[0]->Size());
-			local_table = std::make_unique<CompensationTable>(size, m_ctbl[0]->LowerFrequency(), m_ctbl[0]->UpperFrequency(), *m_ctbl[0]);
+			const MHz lower = m_ctbl[0]->LowerFrequency();
+			const MHz upper = m_ctbl[0]->UpperFrequency();
+			tables.resize(m_chan_count);
+			std::vector<std::thread> builders;
+			for (int j = 0; j < m_chan_count; j++) {
+				builders.emplace_back([&, j]() {
+					if (j == 0) tables[j].Gather(*m_ctbl[j]);
+					else tables[j].Gather(CompensationTable(size, lower, upper, *m_ctbl[j]));
+				});
+			}
+			for (auto& t : builders) t.join();
+			start_freq = lower;
+			end_freq = upper;
 		}
 
-		if (ofile.is_open())
+		// The whole file is encoded in memory and written in one go, to a temporary file that then
+		// replaces the old one, so that an importer still mapping the old file never sees it truncated
+		std::vector<char> data;
+		LUTFileMap::Encode(tables, start_freq, end_freq, data);
+
+		const std::string tmp_name = m_name + ".tmp";
 		{
-			header = new char[64]; // Header block always 64 bytes
-			iMSLUTFileHeader2 hdr(FileHeader);
-			hdr.protver = 3;
-			hdr.length = static_cast<std::uint16_t>(local_table->Size());
-			hdr.start_freq = local_table->LowerFrequency();
-			hdr.end_freq = local_table->UpperFrequency();
-			hdr.pt_size = CompensationPointSize;
-			if (global_lut)
-				hdr.chan_count = 1;
-			else
-				hdr.chan_count = m_chan_count;
-
-#if defined(_WIN32)
-			strncpy_s(header, 64, hdr.signature.c_str(), 8);
-#else
-			strncpy(header, hdr.signature.c_str(), 8);
-#endif
-			UIntToPChar<std::uint16_t>(&header[8], hdr.protver);
-			UIntToPChar<std::uint16_t>(&header[10], hdr.length);
-
-			std::uint64_t i = *reinterpret_cast<std::uint64_t*>(&hdr.start_freq);
-			UIntToPChar<std::uint64_t>(&header[12], i);
-
-			i = *reinterpret_cast<std::uint64_t*>(&hdr.end_freq);
-			UIntToPChar<std::uint64_t>(&header[20], i);
-
-			UIntToPChar<std::uint16_t>(&header[28], hdr.pt_size);
-			UIntToPChar<std::uint16_t>(&header[30], hdr.chan_count);
-
-			ofile.write(header, 64);
-			delete[] header;
-
-			// Done with Header, now let's move onto the table contents
-			char * data;
-			data = new char[CompensationPointSize];
-			for (int j = 0; j < hdr.chan_count; ) {
-				for (int i = 0; i < hdr.length; i++)
-				{
-					// Amplitude
-					Percent pct = local_table->operator[](i).Amplitude();
-					std::uint64_t d = *reinterpret_cast<std::uint64_t*>(&pct);
-					UIntToPChar<std::uint64_t>(&data[0], d);
-
-					// Phase
-					Degrees deg = local_table->operator[](i).Phase();
-					d = *reinterpret_cast<std::uint64_t*>(&deg);
-					UIntToPChar<std::uint64_t>(&data[8], d);
-
-					// Sync Digital
-					std::uint32_t syncd = local_table->operator[](i).SyncDig();
-					UIntToPChar<std::uint32_t>(&data[16], syncd);
-
-					// Sync Analog
-					double synca = local_table->operator[](i).SyncAnlg();
-					d = *reinterpret_cast<std::uint64_t*>(&synca);
-					UIntToPChar<std::uint64_t>(&data[20], d);
-
-					ofile.write(data, CompensationPointSize);
-				}
-				if (++j != hdr.chan_count) {
-					local_table.release();
-                    int size = static_cast<int>(m_ctbl[j]->Size());
-					local_table = std::make_unique<CompensationTable>(size, m_ctbl[j]->LowerFrequency(), m_ctbl[j]->UpperFrequency(), *m_ctbl[j]);
-				}
+			std::ofstream ofile(tmp_name, std::ios::binary | std::ios::out | std::ios::trunc);
+			if (!ofile.is_open()) return false;
+			ofile.write(data.data(), data.size());
+			if (!ofile) {
+				ofile.close();
+				std::remove(tmp_name.c_str());
+				return false;
 			}
-			delete[] data;
 		}
-		else return false;
-		ofile.close();
+		if (!RenameReplacing(tmp_name, m_name)) {
+			std::remove(tmp_name.c_str());
+			return false;
+		}
 		return true;
 	}
 
@@ -961,14 +1044,27 @@ namespace iMS
 		Impl(const std::string& fileName);
 		~Impl() {}
 
+		// Retrieves one table from the mapped file, at the file's own dimensions
+		CompensationTable Retrieve(int chan) const;
+
 		const std::string m_name;
 		bool m_valid;
 		iMSLUTFileHeader2 hdr;
+		// File stays mapped for the lifetime of the importer
+		std::shared_ptr<const LUTFileMap> m_map;
 	};
 	
-	CompensationTableImporter::Impl::Impl(const std::string& fileName) : m_name(fileName)
+	CompensationTableImporter::Impl::Impl(const std::string& fileName) : m_name(fileName), m_map(LUTFileMap::Open(fileName))
 	{
-		m_valid = ReadCompensationTableHeader(hdr, fileName);
+		m_valid = (m_map != nullptr);
+		if (m_valid) hdr = m_map->Header();
+	}
+
+	CompensationTable CompensationTableImporter::Impl::Retrieve(int chan) const
+	{
+		CompensationTable tbl(hdr.length, hdr.start_freq, hdr.end_freq);
+		m_map->Load(tbl, chan);
+		return tbl;
 	}
 
 	CompensationTableImporter::CompensationTableImporter(const std::string& fileName) : p_Impl(new Impl(fileName))
@@ -1013,11 +1109,7 @@ namespace iMS
 	CompensationTable CompensationTableImporter::RetrieveGlobalLUT()
 	{
 		if (p_Impl->m_valid) {
-			return CompensationTable(p_Impl->hdr.length,
-				p_Impl->hdr.start_freq,
-				p_Impl->hdr.end_freq,
-				p_Impl->m_name,
-				RFChannel::all);
+			return p_Impl->Retrieve(RFChannel::all);
 		}
 		else {
 			return CompensationTable();
@@ -1027,17 +1119,88 @@ namespace iMS
 	CompensationTable CompensationTableImporter::RetrieveChannelLUT(RFChannel& chan)
 	{
 		if ((p_Impl->m_valid) && (chan <= p_Impl->hdr.chan_count))  {
-			return CompensationTable(p_Impl->hdr.length,
-				p_Impl->hdr.start_freq,
-				p_Impl->hdr.end_freq,
-				p_Impl->m_name,
-				chan);
+			return p_Impl->Retrieve(chan);
 		}
 		else {
 			return CompensationTable();
 		}
 	}
 
+	// Record of the LUT contents last downloaded successfully to each iMS System, in the hardware format,
+	// for the global table (scope 0), each channel (scopes 1 to 4) and all four channel tables downloaded
+	// together (ALL_CHANNELS).  The record is only kept for the current connection.  Used for incremental
+	// downloads.
+	class LUTShadowRegistry
+	{
+	public:
+		enum { ALL_CHANNELS = 5 };
+
+		static LUTShadowRegistry& Instance()
+		{
+			static LUTShadowRegistry reg;
+			return reg;
+		}
+
+		bool Get(std::shared_ptr<IMSSystem> ims, int scope, std::vector<std::uint8_t>& data)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) return false;
+			auto sit = it->second.scopes.find(scope);
+			if (sit == it->second.scopes.end()) return false;
+			data = sit->second;
+			return true;
+		}
+
+		void Set(std::shared_ptr<IMSSystem> ims, int scope, std::vector<std::uint8_t>&& data)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) {
+				it = m_shadow.emplace(ims.get(), Entry{ ims, ims->ConnectionEpoch(), {} }).first;
+			}
+			// The global table and the channel tables share the same LUT memory
+			auto& scopes = it->second.scopes;
+			if ((scope == 0) || (scope == ALL_CHANNELS)) scopes.clear();
+			else {
+				scopes.erase(0);
+				scopes.erase(ALL_CHANNELS);
+			}
+			scopes[scope] = std::move(data);
+		}
+
+		void Invalidate(std::shared_ptr<IMSSystem> ims, int scope)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it != m_shadow.end()) it->second.scopes.erase(scope);
+		}
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<IMSSystem> owner;
+			std::uint32_t epoch;
+			std::map<int, std::vector<std::uint8_t>> scopes;
+		};
+		using ShadowMap = std::map<const IMSSystem*, Entry>;
+
+		// Finds the entry for a system, discarding any left by a destroyed system at the same address
+		// or recorded before the system was last connected or disconnected
+		ShadowMap::iterator Find(std::shared_ptr<IMSSystem> ims)
+		{
+			auto it = m_shadow.find(ims.get());
+			if ((it != m_shadow.end()) && ((it->second.owner.lock() != ims) || (it->second.epoch != ims->ConnectionEpoch()))) {
+				m_shadow.erase(it);
+				return m_shadow.end();
+			}
+			return it;
+		}
+
+		std::mutex m_mutex;
+		ShadowMap m_shadow;
+	};
+
 	class CompensationTableDownload::Impl
 	{
 	public:
@@ -1053,9 +1216,29 @@ namespace iMS
 		const CompensationTable& m_TableRef;
 		std::shared_ptr<CompensationTable> m_Table;
 
+		// One table per channel, downloaded together as a single interleaved channel scoped LUT
+		const std::vector<CompensationTable>* m_ChannelRefs{ nullptr };
+		std::vector<std::shared_ptr<CompensationTable>> m_ChannelTables;
+		bool Interleaved() const { return (m_ChannelRefs != nullptr); }
+		bool ChannelScoped() const { return Interleaved() || !m_channel.IsAll(); }
+
+		// Create local copies of the table(s) reinterpreted to match the connected device
+		bool LocalCopy(std::shared_ptr<IMSSystem>);
+
 		CompensationEventTrigger m_Event;
 
-		void AddPointToVector(std::shared_ptr<IMSSystem>, std::vector<std::uint8_t>&, const CompensationPoint&);
+		// Hardware representation of the whole table, 8 bytes per point
+		std::vector<std::uint8_t> FormatTable(std::shared_ptr<IMSSystem>) const;
+
+		// Scope of the download in the LUT shadow registry
+		int Scope() const { return Interleaved() ? LUTShadowRegistry::ALL_CHANNELS : m_channel.IsAll() ? 0 : static_cast<int>(m_channel); }
+
+		bool m_incremental{ false };
+		// Table contents being downloaded, recorded in the registry if every message succeeds
+		std::vector<std::uint8_t> m_pending;
+		std::atomic<bool> m_failed{ false };
+		// Records the outcome in the registry and notifies listeners that the download has completed
+		void DownloadFinished();
 
 		class ResponseReceiver : public IEventHandler
 		{
@@ -1080,6 +1263,8 @@ namespace iMS
 		std::list <MessageHandle> dl_list;
 		MessageHandle dl_final;
 		mutable std::mutex dl_list_mutex;
+		// Signalled whenever responses are removed from dl_list
+		std::condition_variable dl_list_cond;
 
         bool downloadRequested{ false };
         void DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
@@ -1183,6 +1368,12 @@ namespace iMS
 		: p_Impl(new Impl(ims, tbl, chan))	
 	{}
 
+	CompensationTableDownload::CompensationTableDownload(std::shared_ptr<IMSSystem> ims, const std::vector<CompensationTable>& tbls)
+		: p_Impl(new Impl(ims, tbls.empty() ? throw std::invalid_argument("CompensationTableDownload requires at least one channel table") : tbls.front()))
+	{
+		p_Impl->m_ChannelRefs = &tbls;
+	}
+
 	CompensationTableDownload::~CompensationTableDownload() 
 	{ delete p_Impl; p_Impl = nullptr; }
 
@@ -1197,6 +1388,11 @@ namespace iMS
 	}
 
 	bool CompensationTableDownload::StartDownload()
+	{
+		return StartDownload(false);
+	}
+
+	bool CompensationTableDownload::StartDownload(bool incremental)
 	{
         return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
         {
@@ -1207,7 +1403,7 @@ namespace iMS
             HostReport *iorpt;
             std::uint16_t data;
 
-            if (!p_Impl->m_channel.IsAll()) {
+            if (p_Impl->ChannelScoped()) {
                 // Channel Scoped Compensation requested.  Confirm support in iMS firmware
                 iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::READ, SYNTH_REG_Chan_Scope);
                 DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
@@ -1222,14 +1418,8 @@ namespace iMS
                     return false;
             }
 
-            if (p_Impl->m_Table == nullptr) {
-                // Create Local copy of table that is reinterpreted to match connected device
-                if (p_Impl->m_channel.IsAll())
-                    p_Impl->m_Table = std::make_shared<CompensationTable>(ims, p_Impl->m_TableRef);
-                else
-                    p_Impl->m_Table = std::make_shared<CompensationTable>(ims->Synth().GetCap().LUTDepth - 2, 
-                        ims->Synth().GetCap().lowerFrequency, ims->Synth().GetCap().upperFrequency,
-                        p_Impl->m_TableRef);
+            if ((p_Impl->m_Table == nullptr) && p_Impl->m_ChannelTables.empty()) {
+                if (!p_Impl->LocalCopy(ims)) return false;
             }
 
 
@@ -1250,14 +1440,18 @@ namespace iMS
 
                 p_Impl->dl_list.clear();
                 p_Impl->downloadRequested = true;
+                p_Impl->m_incremental = incremental;
+                // Incremental downloads always start from the current table contents
+                if (incremental) p_Impl->LocalCopy(ims);
 
-                if (p_Impl->m_channel.IsAll()) {
+                if (!p_Impl->ChannelScoped()) {
                     iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_Chan_Scope);
                     iorpt->Payload<std::uint16_t>(0);
                 }
                 else {
+                    // Select channel scope for the channel being downloaded, or for all of them
                     iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_IO_Config_Mask);
-                    iorpt->Payload<std::uint16_t>(1 << (p_Impl->m_channel-1));
+                    iorpt->Payload<std::uint16_t>(p_Impl->Interleaved() ? 0xF : 1 << (p_Impl->m_channel-1));
                     if (NullMessage == conn->SendMsg(*iorpt))
                     {
                         delete iorpt;
@@ -1295,7 +1489,7 @@ namespace iMS
             // Make sure Synthesiser is present
             if (!ims->Synth().IsValid()) return false;
 
-            if (!p_Impl->m_channel.IsAll()) {
+            if (p_Impl->ChannelScoped()) {
                 // Channel Scoped Compensation requested.  Confirm support in iMS firmware
                 auto conn = ims->Connection();
 
@@ -1315,14 +1509,8 @@ namespace iMS
                     return false;
             }
 
-            if (p_Impl->m_Table == nullptr) {
-                // Create Local copy of table that is reinterpreted to match connected device
-                if (p_Impl->m_channel.IsAll())
-                    p_Impl->m_Table = std::make_shared<CompensationTable>(ims, p_Impl->m_TableRef);
-                else
-                    p_Impl->m_Table = std::make_shared<CompensationTable>(ims->Synth().GetCap().LUTDepth - 2,
-                        ims->Synth().GetCap().lowerFrequency, ims->Synth().GetCap().upperFrequency,
-                        p_Impl->m_TableRef);
+            if ((p_Impl->m_Table == nullptr) && p_Impl->m_ChannelTables.empty()) {
+                if (!p_Impl->LocalCopy(ims)) return false;
             }
 
             p_Impl->verifyWorker.start();
@@ -1383,22 +1571,49 @@ namespace iMS
 		p_Impl->m_Event.Unsubscribe(message, handler);
 	}
 
-	void CompensationTableDownload::Impl::AddPointToVector(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>& lut_data, const CompensationPoint& pt)
+	bool CompensationTableDownload::Impl::LocalCopy(std::shared_ptr<IMSSystem> ims)
 	{
-		std::uint16_t phase = PhaseRenderer::RenderAsCompensationPoint(ims, pt.Phase());
-		lut_data.push_back(static_cast<std::uint8_t>(phase & 0xFF));
-		lut_data.push_back(static_cast<std::uint8_t>((phase >> 8) & 0xFF));
-		std::uint16_t ampl = AmplitudeRenderer::RenderAsCompensationPoint(ims, pt.Amplitude());
-		lut_data.push_back(static_cast<std::uint8_t>(ampl & 0xFF));
-		lut_data.push_back(static_cast<std::uint8_t>((ampl >> 8) & 0xFF));
-		std::uint16_t sync_dgtl = pt.SyncDig();
-		sync_dgtl &= ((1 << ims->Synth().GetCap().LUTSyncDBits) - 1);
-		lut_data.push_back(static_cast<std::uint8_t>(sync_dgtl & 0xFF));
-		lut_data.push_back(static_cast<std::uint8_t>((sync_dgtl >> 8) & 0xFF));
-		double anlg = std::max<double>(0.0, std::min<double>(1.0, pt.SyncAnlg()));
-		std::uint16_t sync_anlg = static_cast<std::uint16_t>(std::floor(anlg * (pow(2.0, (ims->Synth().GetCap().LUTSyncABits))-1.0) + 0.5));
-		lut_data.push_back(static_cast<std::uint8_t>(sync_anlg & 0xFF));
-		lut_data.push_back(static_cast<std::uint8_t>((sync_anlg >> 8) & 0xFF));
+		const auto& cap = ims->Synth().GetCap();
+		if (Interleaved()) {
+			if (m_ChannelRefs->size() < static_cast<std::size_t>(cap.channels)) return false;
+			m_ChannelTables.clear();
+			for (int chan = 0; chan < 4; chan++) {
+				// Slots for channels the Synthesiser doesn't have are cleared
+				if (chan < cap.channels)
+					m_ChannelTables.push_back(std::make_shared<CompensationTable>(cap.LUTDepth - 2, cap.lowerFrequency, cap.upperFrequency, (*m_ChannelRefs)[chan]));
+				else
+					m_ChannelTables.push_back(std::make_shared<CompensationTable>(cap.LUTDepth - 2, cap.lowerFrequency, cap.upperFrequency));
+			}
+		}
+		else if (m_channel.IsAll())
+			m_Table = std::make_shared<CompensationTable>(ims, m_TableRef);
+		else
+			m_Table = std::make_shared<CompensationTable>(cap.LUTDepth - 2, cap.lowerFrequency, cap.upperFrequency, m_TableRef);
+		return true;
+	}
+
+	std::vector<std::uint8_t> CompensationTableDownload::Impl::FormatTable(std::shared_ptr<IMSSystem> ims) const
+	{
+		std::vector<std::uint8_t> data;
+		if (!Interleaved()) {
+			data.reserve(m_Table->Size() * 8);
+			CompensationColumns(*m_Table).Format(ims, data);
+			return data;
+		}
+
+		// Channel scoped LUT memory holds the four channels' entries for each index side by side
+		std::size_t length = m_ChannelTables[0]->Size();
+		for (const auto& tbl : m_ChannelTables) length = std::min(length, tbl->Size());
+		data.resize(length * 4 * 8);
+		std::vector<std::uint8_t> chan_data;
+		for (std::size_t chan = 0; chan < m_ChannelTables.size(); chan++) {
+			chan_data.clear();
+			CompensationColumns(*m_ChannelTables[chan]).Format(ims, chan_data, 0, length);
+			for (std::size_t idx = 0; idx < length; idx++) {
+				std::copy_n(&chan_data[idx * 8], 8, &data[((idx << 2) + chan) * 8]);
+			}
+		}
+		return data;
 	}
 
 	// CompensationTable Downloading Thread
@@ -1421,28 +1636,41 @@ namespace iMS
 			// Download loop
 			HostReport *iorpt;
 			int lut_index = 0;
-			int length = static_cast<int>(m_Table->Size());
 			int buf_bytes = 512;
 
 			dl_final = NullMessage;
 
+			// Render the whole table in one pass, then send it in slices
+			const std::vector<std::uint8_t> table_data = FormatTable(ims);
+			const int length = static_cast<int>(table_data.size() / 8);
 			std::vector<std::uint8_t> lut_data;
-			CompensationTable::const_iterator it = m_Table->cbegin();
-			while ((lut_index < length) && (it < m_Table->cend()))
+
+			// Incremental downloads skip any report whose contents match the last successful download
+			std::vector<std::uint8_t> shadow;
+			const bool skip_unchanged = m_incremental &&
+				LUTShadowRegistry::Instance().Get(ims, Scope(), shadow) && (shadow.size() == table_data.size());
+			m_pending = table_data;
+			m_failed = false;
+
+			while (lut_index < length)
 			{
 				std::uint16_t lut_addr;
+				// Up to 64 bytes of data per report for the global table, one point for a single channel
+				int points = m_channel.IsAll() ? std::min(8, length - lut_index) : 1;
+
+				if (skip_unchanged && std::equal(table_data.begin() + 8 * lut_index, table_data.begin() + 8 * (lut_index + points),
+					shadow.begin() + 8 * lut_index))
+				{
+					lut_index += points;
+					continue;
+				}
 
 				if (buf_bytes <= 0)
 				{
 					// Clear Buffer every kB to prevent Hardware overrun
-					do {
-						{
-							std::unique_lock<std::mutex> dllck{ dl_list_mutex };
-							if (dl_list.empty()) break;
-							dllck.unlock();
-						}
-						std::this_thread::sleep_for(std::chrono::milliseconds(50));
-					} while (1);
+					std::unique_lock<std::mutex> dllck{ dl_list_mutex };
+					dl_list_cond.wait(dllck, [this]() { return dl_list.empty(); });
+					dllck.unlock();
 					buf_bytes = 512;
 				}
 
@@ -1450,26 +1678,14 @@ namespace iMS
 					// Compensation Table applies to all channels
 					buf_bytes -= 64;
 					lut_addr = 8 * lut_index;
-					// Add up to 64 bytes of data to vector
-					for (int i = 0; i < 64; i += 8)
-					{
-						CompensationPoint pt = (*it);
-						AddPointToVector(ims, lut_data, pt);
-
-						if ((++it == m_Table->cend()) || (++lut_index == length))
-						{
-							break;
-						}
-					}
 				}
 				else {
 					// Compensation Table applies to one channel
 					buf_bytes -= 8;
 					lut_addr = 8 * ((lut_index << 2) + m_channel - 1);
-					CompensationPoint pt = (*it);
-					AddPointToVector(ims, lut_data, pt);
-					++it; ++lut_index;
 				}
+				lut_data.assign(table_data.begin() + 8 * lut_index, table_data.begin() + 8 * (lut_index + points));
+				lut_index += points;
 
 				iorpt = new HostReport(HostReport::Actions::LUT_ENTRY, HostReport::Dir::WRITE, lut_addr);
 				iorpt->Payload<std::vector<std::uint8_t>>(lut_data);
@@ -1486,6 +1702,11 @@ namespace iMS
 			
 			std::unique_lock<std::mutex> dllck{ dl_list_mutex };
 			if (!dl_list.empty()) dl_final = dl_list.back();
+			else if (!m_failed) {
+				// Nothing was sent because the LUT is already up to date, or every response has
+				// arrived before the final message could be identified
+				DownloadFinished();
+			}
 			dllck.unlock();
 
 			// Release lock, wait for next download trigger
@@ -1493,6 +1714,15 @@ namespace iMS
 		}
 	}
 
+	void CompensationTableDownload::Impl::DownloadFinished()
+	{
+		if (auto ims = m_ims.lock()) {
+			if (m_failed) LUTShadowRegistry::Instance().Invalidate(ims, Scope());
+			else LUTShadowRegistry::Instance().Set(ims, Scope(), std::move(m_pending));
+		}
+		m_Event.Trigger<int>((void *)this, CompensationEvents::DOWNLOAD_FINISHED, 0);
+	}
+
 	// CompensationTable Verifying Thread
 	void CompensationTableDownload::Impl::VerifyWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
@@ -1508,18 +1738,17 @@ namespace iMS
 
             auto ims = m_ims.lock();
             if (!ims) break;
-            auto conn = ims->Connection();
 
 			// Verify loop
 			HostReport* iorpt;
 
 			int lut_index = 0;
-			int length = static_cast<int>(m_Table->Size());
 			int buf_bytes = 1024;
 
+			const std::vector<std::uint8_t> table_data = FormatTable(ims);
+			const int length = static_cast<int>(table_data.size() / 8);
 			std::vector<std::uint8_t> lut_data;
-			CompensationTable::const_iterator it = m_Table->cbegin();
-			while ((lut_index < length) && (it < m_Table->cend()))
+			while (lut_index < length)
 			{
 				// Not a great hack: adding a gap ensures packets aren't coalesced (even with TCP_NODELAY enabled)
 				std::this_thread::sleep_for(std::chrono::milliseconds(5));
@@ -1531,41 +1760,31 @@ namespace iMS
 				}
 
 				std::uint16_t lut_addr;
+				int points;
 				if (m_channel.IsAll()) {
 					// Compensation Table applies to all channels
 					buf_bytes -= 64;
 					lut_addr = 8 * lut_index;
-					// Add up to 64 bytes of data to vector
-					for (int i = 0; i < 64; i += 8)
-					{
-						CompensationPoint pt = (*it);
-						AddPointToVector(ims, lut_data, pt);
-
-						if ((++it == m_Table->cend()) || (++lut_index == length))
-						{
-							break;
-						}
-					}
+					// Up to 64 bytes of data per report
+					points = std::min(8, length - lut_index);
 				}
 				else {
 					// Compensation Table applies to one channel
 					buf_bytes -= 8;
 					lut_addr = 8 * ((lut_index << 2) + m_channel - 1);
-					CompensationPoint pt = (*it);
-					AddPointToVector(ims, lut_data, pt);
-					++it; ++lut_index;
+					points = 1;
 				}
+				lut_data.assign(table_data.begin() + 8 * lut_index, table_data.begin() + 8 * (lut_index + points));
+				lut_index += points;
+
 				iorpt = new HostReport(HostReport::Actions::LUT_ENTRY, HostReport::Dir::READ, lut_addr);
 				ReportFields f = iorpt->Fields();
 				f.len = static_cast<std::uint16_t>(lut_data.size());
 				iorpt->Fields(f);
-				MessageHandle h = conn->SendMsg(*iorpt);
+				// Read back, checking against the CompensationTable data
+				verifier.SendChunk(*iorpt, lut_data, lut_addr);
 				delete iorpt;
 
-				// Add CompensationTable data to verify memory
-				std::shared_ptr<VerifyChunk> chunk(new VerifyChunk(h, lut_data, lut_addr));
-				verifier.AddChunk(chunk);
-
 				lut_data.clear();
 
 			}
@@ -1581,7 +1800,10 @@ namespace iMS
 	{
 		while (true) {
     		std::unique_lock<std::mutex> lck{ mtx };
-            cond.wait(lck);
+			// Responses may have been queued before this thread first reached here
+			cond.wait(lck, [this, &running]() {
+                return !rxok_list.empty() || !rxerr_list.empty() || !running;
+            });
 
 			// Allow thread to terminate 
 			if (!running) break;
@@ -1607,12 +1829,10 @@ namespace iMS
 					iter = dl_list.erase(iter);
 
 					// Download Finished?
-					if (handle == dl_final)
-					{
-						m_Event.Trigger<int>((void *)this, CompensationEvents::DOWNLOAD_FINISHED, 0);
-					}
+					if (handle == dl_final) DownloadFinished();
 				}
 				dllck.unlock();
+				dl_list_cond.notify_all();
 
 			}
 
@@ -1635,9 +1855,14 @@ namespace iMS
 
 					// Remove from list
 					iter = dl_list.erase(iter);
+
+					// The LUT contents on the Synthesiser are no longer known
+					m_failed = true;
+					if (auto ims = m_ims.lock()) LUTShadowRegistry::Instance().Invalidate(ims, Scope());
 					m_Event.Trigger<int>((void *)this, CompensationEvents::DOWNLOAD_ERROR, handle);
 				}
 				dllck.unlock();
+				dl_list_cond.notify_all();
 
 			}
 
@@ -1648,14 +1873,14 @@ namespace iMS
 	{
         return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> FileSystemIndex
         { 
+            // Non-volatile storage holds a single global or channel table
+            if (p_Impl->Interleaved()) return -1;
+            if (p_Impl->m_Table == nullptr) p_Impl->LocalCopy(ims);
+
             FileSystemManager fsm(ims);
             std::uint32_t addr;
 
-            std::vector<std::uint8_t> data;
-            for (CompensationTable::const_iterator it = p_Impl->m_Table->cbegin(); it != p_Impl->m_Table->cend(); ++it)
-            {
-                p_Impl->AddPointToVector(ims, data, (*it));
-            }
+            std::vector<std::uint8_t> data = p_Impl->FormatTable(ims);
 
             if (!fsm.FindSpace(addr, data)) return -1;
             FileSystemTableEntry fste(FileSystemTypes::COMPENSATION_TABLE, addr, data.size(), def, FileName);
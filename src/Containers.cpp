@@ -73,12 +73,11 @@ namespace iMS {
 	ListBase<T>::~ListBase() { delete p_ListImpl; p_ListImpl = nullptr; }
 
 	template <typename T>
-	ListBase<T>::ListBase(const ListBase<T> &rhs) : p_ListImpl(new ListImpl())
+	ListBase<T>::ListBase(const ListBase<T> &rhs) : p_ListImpl(new ListImpl(*rhs.p_ListImpl))
 	{
-		p_ListImpl->m_list = rhs.p_ListImpl->m_list;
-		p_ListImpl->m_name = rhs.p_ListImpl->m_name;
-		p_ListImpl->tag = rhs.p_ListImpl->tag;
-		p_ListImpl->m_modified_time = rhs.p_ListImpl->m_modified_time;
+		// Copied directly rather than default constructed, which would seed a random generator
+		// for a UUID that is then overwritten
+		p_ListImpl->tagDirty = false;
 	}
 
 	template <typename T>
@@ -189,6 +188,11 @@ namespace iMS {
 		p_ListImpl->m_list.clear();
 	}
 
+	template <typename T>
+	void ListBase<T>::MarkModified() {
+		this->p_ListImpl->updateUUID();
+	}
+
 	template <typename T>
 	const std::array<std::uint8_t, 16> ListBase<T>::GetUUID() const
 	{
@@ -370,6 +374,11 @@ namespace iMS {
 		p_DequeImpl->m_deque.clear();
 	}
 
+	template <typename T>
+	void DequeBase<T>::MarkModified() {
+		this->p_DequeImpl->updateUUID();
+	}
+
 	template <typename T>
 	typename DequeBase<T>::iterator DequeBase<T>::insert(iterator pos, const T& value) {
 		this->p_DequeImpl->updateUUID();
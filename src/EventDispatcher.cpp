@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Event Dispatcher CPP
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/EventManager/src/EventDispatcher.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 601 $
+/------------------------------------------------------------------------------
+/ Description:
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "EventDispatcher.h"
+#include "PrivateUtil.h"
+
+#include <algorithm>
+
+namespace iMS {
+
+	EventDispatcher::EventDispatcher(std::size_t threads)
+		: m_threadCount(std::max<std::size_t>(1, threads)),
+		m_state(std::make_shared<State>())
+	{
+	}
+
+	EventDispatcher::~EventDispatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lck{ m_state->mutex };
+			m_state->stopping = true;
+		}
+		m_state->workCond.notify_all();
+
+		// Workers finish any outstanding deliveries before exiting.  If a task has dropped the last
+		// reference, its worker carries on alone with its own reference to the shared state.
+		for (auto& t : m_workers) {
+			if (t.get_id() == std::this_thread::get_id()) {
+				t.detach();
+			}
+			else if (t.joinable()) {
+				t.join();
+			}
+		}
+	}
+
+	void EventDispatcher::Post(const void* key, Task task)
+	{
+		std::call_once(m_startFlag, [this]() {
+			for (std::size_t i = 0; i < m_threadCount; i++) {
+				m_workers.emplace_back(&EventDispatcher::WorkerLoop, m_state);
+			}
+		});
+
+		{
+			std::lock_guard<std::mutex> lck{ m_state->mutex };
+			Strand& s = m_state->strands[key];
+			s.tasks.push_back(std::move(task));
+			m_state->pending++;
+			if (s.scheduled) return;
+			s.scheduled = true;
+			m_state->ready.push_back(key);
+		}
+		m_state->workCond.notify_one();
+	}
+
+	void EventDispatcher::Drain()
+	{
+		std::unique_lock<std::mutex> lck{ m_state->mutex };
+		m_state->idleCond.wait(lck, [this] { return m_state->pending == 0; });
+	}
+
+	std::size_t EventDispatcher::Threads() const
+	{
+		return m_threadCount;
+	}
+
+	void EventDispatcher::WorkerLoop(std::shared_ptr<State> state)
+	{
+		State& st = *state;
+		std::unique_lock<std::mutex> lck{ st.mutex };
+		while (true)
+		{
+			st.workCond.wait(lck, [&] { return st.stopping || !st.ready.empty(); });
+			if (st.ready.empty()) break;  // stopping and nothing left to deliver
+
+			// Only one worker owns a strand at a time, which preserves per-key ordering
+			const void* key = st.ready.front();
+			st.ready.pop_front();
+			Task task = std::move(st.strands[key].tasks.front());
+			st.strands[key].tasks.pop_front();
+
+			lck.unlock();
+			try {
+				task();
+			}
+			catch (std::exception& e) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Unhandled exception in event handler: " << e.what();
+			}
+			catch (...) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Unhandled exception in event handler";
+			}
+			// Release the task (and anything it captured) before taking the lock
+			task = nullptr;
+			lck.lock();
+
+			auto it = st.strands.find(key);
+			if (it->second.tasks.empty()) {
+				st.strands.erase(it);
+			}
+			else {
+				// Round robin between handlers so one busy handler cannot starve the others
+				st.ready.push_back(key);
+				st.workCond.notify_one();
+			}
+
+			if (--st.pending == 0) {
+				st.idleCond.notify_all();
+			}
+		}
+	}
+
+}
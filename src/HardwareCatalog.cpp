@@ -0,0 +1,211 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Hardware Catalog
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/Other/src/HardwareCatalog.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 606 $
+/------------------------------------------------------------------------------
+/ Description: In-memory copy of the embedded hardware database, loaded once
+/              per process and indexed for the lookups made by the library.
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "HardwareCatalog.h"
+#include "PrivateUtil.h"
+
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+
+namespace iMS {
+
+	namespace {
+
+		// Integer columns are parsed as the hardware list always has been: the whole string, in any base
+		std::optional<int> to_int(const std::string& s) {
+			char* p;
+			int i = static_cast<int>(std::strtol(s.c_str(), &p, 0));
+			if (*p) return std::nullopt;
+			return i;
+		}
+
+		std::optional<double> to_double(const std::string& s) {
+			char* p;
+			double d = std::strtod(s.c_str(), &p);
+			if (*p) return std::nullopt;
+			return d;
+		}
+
+		// The crystal and AO device tables accept any leading number, as std::stod does
+		std::optional<double> leading_double(const std::string& s) {
+			try {
+				return std::stod(s);
+			}
+			catch (std::invalid_argument&) {}
+			catch (std::out_of_range&) {}
+			return std::nullopt;
+		}
+
+		HardwareCapability to_capability(const std::string& s) {
+			HardwareCapability cap;
+			cap.present = true;
+			cap.value = (s == "TRUE" || s == "True" || s == "true");
+			cap.since = to_int(s);
+			return cap;
+		}
+
+		// The name and value of each column of a row that is not NULL
+		using Columns = std::vector<std::pair<std::string, std::string>>;
+		using RowFunc = std::function<void(const Columns&)>;
+
+		// Reads a whole table, passing each row to 'row'
+		bool load_table(sqlite3* db, const std::string& query, const RowFunc& row)
+		{
+			auto callback = [](void *data, int argc, char **argv, char **azColName) -> int {
+				Columns cols;
+				for (int i = 0; i < argc; i++) {
+					if (argv[i] != nullptr) cols.emplace_back(azColName[i], argv[i]);
+				}
+				(*(const RowFunc*)data)(cols);
+				return 0;
+			};
+
+			int rc = sqlite3_exec(db, query.c_str(), callback, (void *)&row, nullptr);
+			if (rc != SQLITE_OK) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "imshw db err: " << rc << " reading " << query << std::endl;
+				return false;
+			}
+			return true;
+		}
+
+		void parse_hardware(HardwareRecord& hw, const std::string& c, const std::string& s)
+		{
+			if (c == "Type") {
+				if (s == "Controller") hw.type = HardwareRecord::Type::CONTROLLER;
+				else if (s == "Synthesiser") hw.type = HardwareRecord::Type::SYNTHESISER;
+			}
+			else if (c == "ModelNum") hw.model = s;
+			else if (c == "Description") hw.description = s;
+			else if (c == "nSynth") hw.nSynth = to_int(s);
+			else if (c == "FastTransfer") hw.fastTransfer = to_capability(s);
+			else if (c == "MaxImageSize") hw.maxImageSize = to_int(s);
+			else if (c == "SimultaneousPlayback") hw.simultaneousPlayback = to_capability(s);
+			else if (c == "MaxImageRate") hw.maxImageRate = to_int(s);
+			else if (c == "RemoteUpgrade") hw.remoteUpgrade = to_capability(s);
+			else if (c == "LowerFreq") hw.lowerFreq = to_double(s);
+			else if (c == "UpperFreq") hw.upperFreq = to_double(s);
+			else if (c == "FreqBits") hw.freqBits = to_int(s);
+			else if (c == "AmplBits") hw.amplBits = to_int(s);
+			else if (c == "PhsBits") hw.phaseBits = to_int(s);
+			else if (c == "LUTDepth") hw.lutDepth = to_int(s);
+			else if (c == "LUTAmplBits") hw.lutAmplBits = to_int(s);
+			else if (c == "LUTPhaseBits") hw.lutPhaseBits = to_int(s);
+			else if (c == "LUTSyncAnlgBits") hw.lutSyncAnlgBits = to_int(s);
+			else if (c == "LUTSyncDigBits") hw.lutSyncDigBits = to_int(s);
+			else if (c == "SysClock") hw.sysClock = to_double(s);
+			else if (c == "Channels") hw.channels = to_int(s);
+			else if (c == "ChannelComp") hw.channelCompSince = to_int(s);
+		}
+
+		void parse_crystal(CrystalRecord& xtal, const std::string& c, const std::string& s)
+		{
+			if (c == "Name") xtal.description = s;
+			else if (c == "Wavelength") xtal.wavelength = leading_double(s).value_or(xtal.wavelength);
+			else if (c == "RefractiveIndex") xtal.refractiveIndex = leading_double(s).value_or(xtal.refractiveIndex);
+			else if (c == "AcousticVelocity") xtal.acousticVelocity = leading_double(s).value_or(xtal.acousticVelocity);
+		}
+
+		void parse_aodevice(AODeviceRecord& dev, const std::string& c, const std::string& s)
+		{
+			if (c == "Model") dev.model = s;
+			else if (c == "Crystal") dev.crystal = s;
+			else if (c == "CentreFrequency") dev.centre = leading_double(s);
+			else if (c == "GeomConstant") dev.geom = leading_double(s);
+			else if (c == "SweepBW") dev.bandwidth = leading_double(s);
+			else if (c == "Wavelength") dev.wavelength = leading_double(s);
+		}
+
+	}
+
+	HardwareCatalog::HardwareCatalog() : m_valid(false)
+	{
+		sqlite3 *imshw = get_db();
+		if (imshw == nullptr) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "imshw db = null" << std::endl;
+			return;
+		}
+
+		// Each row is parsed once, here, and filed under its key column.  Rows with a NULL key are dropped
+		// from the index, as no lookup would ever match them.
+		bool hw_ok = load_table(imshw, "SELECT * FROM hwlist", [this](const Columns& cols) {
+			std::optional<std::uint16_t> magic;
+			HardwareRecord hw;
+			for (const auto& c : cols) {
+				if (c.first == "Magic") magic = static_cast<std::uint16_t>(std::strtol(c.second.c_str(), nullptr, 0));
+				else parse_hardware(hw, c.first, c.second);
+			}
+			if (magic) m_hwlist[*magic].push_back(hw);
+		});
+
+		bool xtal_ok = load_table(imshw, "SELECT * FROM xtalparam", [this](const Columns& cols) {
+			std::optional<std::string> type;
+			CrystalRecord xtal;
+			for (const auto& c : cols) {
+				if (c.first == "Type") type = c.second;
+				else parse_crystal(xtal, c.first, c.second);
+			}
+			if (type) m_xtalparam[*type].push_back(xtal);
+		});
+
+		bool dev_ok = load_table(imshw, "SELECT * FROM aodevice", [this](const Columns& cols) {
+			AODeviceRecord dev;
+			bool keyed = false;
+			for (const auto& c : cols) {
+				if (c.first == "Model") keyed = true;
+				parse_aodevice(dev, c.first, c.second);
+			}
+			if (keyed) m_aodevice.emplace(dev.model, m_aodevices.size());
+			m_aodevices.push_back(dev);
+		});
+
+		m_valid = hw_ok && xtal_ok && dev_ok;
+		sqlite3_close(imshw);
+	}
+
+	const HardwareCatalog& HardwareCatalog::Instance()
+	{
+		static const HardwareCatalog theCatalog;
+		return theCatalog;
+	}
+
+	const std::vector<HardwareRecord>& HardwareCatalog::Hardware(std::uint16_t magicID) const
+	{
+		auto it = m_hwlist.find(magicID);
+		return (it == m_hwlist.end()) ? m_noHardware : it->second;
+	}
+
+	const std::vector<CrystalRecord>& HardwareCatalog::CrystalParams(const std::string& type) const
+	{
+		auto it = m_xtalparam.find(type);
+		return (it == m_xtalparam.end()) ? m_noCrystal : it->second;
+	}
+
+	const AODeviceRecord* HardwareCatalog::AODevice(const std::string& model) const
+	{
+		auto it = m_aodevice.find(model);
+		return (it == m_aodevice.end()) ? nullptr : &m_aodevices[it->second];
+	}
+
+}
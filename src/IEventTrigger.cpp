@@ -23,8 +23,11 @@
 
 #include "IEventTrigger.h"
 #include "IEventHandler.h"
+#include "EventDispatcher.h"
 #include <iostream>
 #include <mutex>
+#include <algorithm>
+#include <type_traits>
 
 namespace iMS {
 
@@ -34,6 +37,9 @@ namespace iMS {
 
 	IEventTrigger::~IEventTrigger()
 	{
+		// Let any queued deliveries complete before the handler lists go away
+		DispatchThreads(0);
+
 		std::unique_lock maplck{ m_mapMutex };
 		for (int i = 0; i < messageCount; i++)
 		{
@@ -114,6 +120,126 @@ namespace iMS {
 		}
 	}
 
+	void IEventTrigger::DispatchThreads(std::size_t threads)
+	{
+		std::shared_ptr<EventDispatcher> old;
+		{
+			std::lock_guard<std::mutex> lck{ m_dispatcherMutex };
+			if (m_dispatcher && (threads > 0) && (m_dispatcher->Threads() == threads)) return;
+			old = std::move(m_dispatcher);
+			if (threads > 0) m_dispatcher = std::make_shared<EventDispatcher>(threads);
+		}
+		// Destroying the previous dispatcher (outside the lock) drains it
+	}
+
+	std::size_t IEventTrigger::DispatchThreads() const
+	{
+		std::lock_guard<std::mutex> lck{ m_dispatcherMutex };
+		return m_dispatcher ? m_dispatcher->Threads() : 0;
+	}
+
+	std::shared_ptr<EventDispatcher> IEventTrigger::Dispatcher() const
+	{
+		std::lock_guard<std::mutex> lck{ m_dispatcherMutex };
+		return m_dispatcher;
+	}
+
+	IEventTrigger::EventHandlerList IEventTrigger::Handlers(const int message)
+	{
+		std::shared_lock maplck{ m_mapMutex };
+		auto it = mMap.find(message);
+		if (it == mMap.end()) return EventHandlerList();
+		return *it->second;
+	}
+
+	bool IEventTrigger::IsSubscribed(const int message, const IEventHandler* handler) const
+	{
+		// Caller must hold m_mapMutex
+		auto it = mMap.find(message);
+		if (it == mMap.end()) return false;
+		return std::find(it->second->cbegin(), it->second->cend(), handler) != it->second->cend();
+	}
+
+	// Holds a payload shared by every handler an event is delivered to.  Each handler receives a
+	// copy except the last one to collect it, which takes ownership of the original.
+	template <typename T>
+	class SharedPayload
+	{
+	public:
+		SharedPayload(T&& value, std::size_t consumers) : m_value(std::move(value)), m_consumers(consumers) {}
+
+		T Take()
+		{
+			std::lock_guard<std::mutex> lck{ m_mutex };
+			if (--m_consumers == 0) return std::move(m_value);
+			return m_value;
+		}
+	private:
+		T m_value;
+		std::size_t m_consumers;
+		std::mutex m_mutex;
+	};
+
+	template<typename T>
+	void IEventTrigger::Post(void* sender, const int message, T param)
+	{
+		auto dispatcher = Dispatcher();
+		if (!dispatcher) {
+			Trigger<T>(sender, message, param);
+			return;
+		}
+
+		for (IEventHandler* handler : Handlers(message))
+		{
+			dispatcher->Post(handler, [this, sender, message, handler, param]() {
+				// Handlers that unsubscribed after the event was posted are skipped.  Holding the
+				// map lock means Unsubscribe() waits for an in-progress delivery to finish.
+				std::shared_lock maplck{ m_mapMutex };
+				if (IsSubscribed(message, handler)) {
+					handler->EventAction(sender, message, param);
+				}
+			});
+		}
+	}
+
+	template<typename T, typename T2>
+	void IEventTrigger::Post(void* sender, const int message, T param, T2 param2)
+	{
+		auto dispatcher = Dispatcher();
+		if (!dispatcher) {
+			Trigger<T, T2>(sender, message, param, std::move(param2));
+			return;
+		}
+
+		EventHandlerList handlers = Handlers(message);
+		if (handlers.empty()) return;
+
+		if constexpr (std::is_arithmetic_v<T2>) {
+			for (IEventHandler* handler : handlers)
+			{
+				dispatcher->Post(handler, [this, sender, message, handler, param, param2]() {
+					std::shared_lock maplck{ m_mapMutex };
+					if (IsSubscribed(message, handler)) {
+						handler->EventAction(sender, message, param, param2);
+					}
+				});
+			}
+		}
+		else {
+			auto payload = std::make_shared<SharedPayload<T2>>(std::move(param2), handlers.size());
+			for (IEventHandler* handler : handlers)
+			{
+				dispatcher->Post(handler, [this, sender, message, handler, param, payload]() {
+					T2 data = payload->Take();
+					std::shared_lock maplck{ m_mapMutex };
+					if (IsSubscribed(message, handler)) {
+						handler->EventAction(sender, message, param, std::move(data));
+					}
+				});
+			}
+		}
+	}
+
 	void IEventTrigger::updateCount(int count)
 	{
 		messageCount = count;
@@ -128,4 +254,9 @@ namespace iMS {
 	template void IEventTrigger::Trigger<double>(void* sender, const int message, const double param);
 	template void IEventTrigger::Trigger<int, std::vector<std::uint8_t>>(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
 
+	template void IEventTrigger::Post<int>(void* sender, const int message, int param);
+	template void IEventTrigger::Post<int, int>(void* sender, const int message, int param, int param2);
+	template void IEventTrigger::Post<double>(void* sender, const int message, double param);
+	template void IEventTrigger::Post<int, std::vector<std::uint8_t>>(void* sender, const int message, int param, std::vector<std::uint8_t> data);
+
 }
@@ -29,7 +29,9 @@
 #include "CS_ETH.h"
 #include "CS_RS422.h"
 #include "PrivateUtil.h"
+#include "HardwareCatalog.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
@@ -109,6 +111,8 @@ namespace iMS
 		IMSSynthesiser m_Synth;
 		std::string m_connString;
 		std::shared_ptr<IConnectionManager> m_conn;
+		// Advanced by every Connect() and Disconnect()
+		std::atomic<std::uint32_t> m_epoch{ 0 };
 
 		bool AddDevice(std::uint16_t magicID);
 
@@ -183,237 +187,64 @@ namespace iMS
 	//static std::vector<std::uint16_t> fpga_build;
 	//static FileSystemTable synth_fst;
 
-	static int hwlist_callback(void *data, int argc, char **argv, char **azColName) {
-		IMSSystem *system = (IMSSystem*)data;
-		//for (i = 0; i < argc; i++)
-		//{
-		//	std::cout << azColName[i] << " = " << (argv[i] ? argv[i] : "NULL") << std::endl;
-		//}
-		if (argc <= 1) return -1;
-
-		if (std::string(azColName[0]) == "Type") {
-			if (std::string(argv[0]) == "Controller")
-			{
-				// Create strings and capabilities struct from database
-				IMSController::Capabilities cap;
-				std::string desc;
-				std::string model;
-				FWVersion ver = system->Ctlr().GetVersion();
-
-				for (int i = 1; i < argc; i++)
-				{
-					if (argv[i] != nullptr)
-					{
-						// Get String arg
-						std::string s(argv[i]);
-						char* p;
-
-						// Convert to bool
-						bool b;
-						b = (s == "TRUE" || s == "True" || s == "true");
-
-						// And try parsing to int
-						bool iparam_ok = true;
-						int iparam = strtol(s.c_str(), &p, 0);
-						if (*p) {
-							iparam_ok = false;
-						}
-/*						try
-						{
-							iparam = std::stoi(s);
-						}
-						catch (std::invalid_argument&)
-						{
-							iparam_ok = false;
-						}
-						catch (std::out_of_range&)
-						{
-							iparam_ok = false;
-						}*/
-						if (iparam_ok) {
-							// In a boolean field, if a number is present it represents the minimum major version number from which the capability was added
-							b = (ver.major >= iparam);
-						}
-
-						if (std::string(azColName[i]) == "ModelNum") {
-							model = s;
-						}
-						else if (std::string(azColName[i]) == "Description") {
-							desc = s;
-						}
-						else if ((std::string(azColName[i]) == "nSynth") && iparam_ok) {
-							cap.nSynthInterfaces = iparam;
-						}
-						else if (std::string(azColName[i]) == "FastTransfer") {
-							cap.FastImageTransfer = b;
-						}
-						else if ((std::string(azColName[i]) == "MaxImageSize") && iparam_ok) {
-							cap.MaxImageSize = iparam;
-						}
-						else if (std::string(azColName[i]) == "SimultaneousPlayback") {
-							cap.SimultaneousPlayback = b;
-						}
-						else if ((std::string(azColName[i]) == "MaxImageRate") && iparam_ok) {
-							cap.MaxImageRate = iparam;
-						}
-						else if (std::string(azColName[i]) == "RemoteUpgrade") {
-							cap.RemoteUpgrade = b;
-						}
-					}
-				}
-
-				system->Ctlr(IMSController(model, desc, cap, ver, ImageTable()));
-				BOOST_LOG_SEV(lg::get(), sev::info) << "Added Controller " << model << std::endl;
+	// Creates the Controller or Synthesiser described by a hardware list row.  Capabilities that the
+	// catalog gives as a firmware version are resolved against the version already read from the device.
+	static void AddHardware(IMSSystem *system, const HardwareRecord& hw) {
+		if (hw.type == HardwareRecord::Type::CONTROLLER)
+		{
+			IMSController::Capabilities cap;
+			FWVersion ver = system->Ctlr().GetVersion();
+
+			if (hw.nSynth) cap.nSynthInterfaces = *hw.nSynth;
+			if (hw.fastTransfer.present) cap.FastImageTransfer = hw.fastTransfer.For(ver.major);
+			if (hw.maxImageSize) cap.MaxImageSize = *hw.maxImageSize;
+			if (hw.simultaneousPlayback.present) cap.SimultaneousPlayback = hw.simultaneousPlayback.For(ver.major);
+			if (hw.maxImageRate) cap.MaxImageRate = *hw.maxImageRate;
+			if (hw.remoteUpgrade.present) cap.RemoteUpgrade = hw.remoteUpgrade.For(ver.major);
+
+			system->Ctlr(IMSController(hw.model, hw.description, cap, ver, ImageTable()));
+			BOOST_LOG_SEV(lg::get(), sev::info) << "Added Controller " << hw.model << std::endl;
+		}
+		else if (hw.type == HardwareRecord::Type::SYNTHESISER)
+		{
+			IMSSynthesiser::Capabilities cap;
+			FWVersion ver = system->Synth().GetVersion();
+
+			if (hw.maxImageRate) cap.MaxImageRate = *hw.maxImageRate;
+			if (hw.lowerFreq) cap.lowerFrequency = *hw.lowerFreq;
+			if (hw.upperFreq) cap.upperFrequency = *hw.upperFreq;
+			if (hw.freqBits) cap.freqBits = *hw.freqBits;
+			if (hw.amplBits) cap.amplBits = *hw.amplBits;
+			if (hw.phaseBits) cap.phaseBits = *hw.phaseBits;
+			if (hw.lutDepth) cap.LUTDepth = *hw.lutDepth;
+			if (hw.lutAmplBits) cap.LUTAmplBits = *hw.lutAmplBits;
+			if (hw.lutPhaseBits) cap.LUTPhaseBits = *hw.lutPhaseBits;
+			if (hw.lutSyncAnlgBits) cap.LUTSyncABits = *hw.lutSyncAnlgBits;
+			if (hw.lutSyncDigBits) cap.LUTSyncDBits = *hw.lutSyncDigBits;
+			if (hw.sysClock) {
+				cap.sysClock = *hw.sysClock;
+				cap.syncClock = *hw.sysClock / 4.0;
 			}
-			else if (std::string(argv[0]) == "Synthesiser")
-			{
-				// Create strings and capabilities struct from database
-				IMSSynthesiser::Capabilities cap;
-				std::string desc;
-				std::string model;
-				FWVersion ver = system->Synth().GetVersion();
-
-				for (int i = 1; i < argc; i++)
-				{
-					if (argv[i] != nullptr)
-					{
-						// Get String arg
-						std::string s(argv[i]);
-						char* p;
-
-						// Convert to bool
-						bool b;
-						if (s == "TRUE" || s == "True" || s == "true") b = true; else b = false;
-
-						// try parsing to int
-						bool iparam_ok = true;
-						int iparam = strtol(s.c_str(), &p, 0);
-						if (*p) {
-							iparam_ok = false;
-						}
-/*						try 
-						{
-							iparam = std::stoi(s);
-						}
-						catch (std::invalid_argument&)
-						{
-							iparam_ok = false;
-						}
-						catch (std::out_of_range&)
-						{
-							iparam_ok = false;
-						}*/
-						if (iparam_ok) {
-							// In a boolean field, if a number is present it represents the minimum major version number from which the capability was added
-							b = (ver.major >= iparam);
-						}
-
-						// and to double
-						bool dparam_ok = true;
-						double dparam =	strtod(s.c_str(), &p);
-						if (*p) {
-							dparam_ok = false;
-						}
-/*						try
-						{
-							dparam = std::stod(s);
-						}
-						catch (std::invalid_argument&)
-						{
-							dparam_ok = false;
-						}
-						catch (std::out_of_range&)
-						{
-							dparam_ok = false;
-						}*/
-
-						if (std::string(azColName[i]) == "ModelNum") {
-							model = s;
-						}
-						else if (std::string(azColName[i]) == "Description") {
-							desc = s;
-						}
-						else if ((std::string(azColName[i]) == "MaxImageRate") && iparam_ok) {
-							cap.MaxImageRate = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LowerFreq") && dparam_ok) {
-							cap.lowerFrequency = dparam;
-						}
-						else if ((std::string(azColName[i]) == "UpperFreq") && dparam_ok) {
-							cap.upperFrequency = dparam;
-						}
-						else if ((std::string(azColName[i]) == "FreqBits") && iparam_ok) {
-							cap.freqBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "AmplBits") && iparam_ok) {
-							cap.amplBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "PhsBits") && iparam_ok) {
-							cap.phaseBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LUTDepth") && iparam_ok) {
-							cap.LUTDepth = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LUTAmplBits") && iparam_ok) {
-							cap.LUTAmplBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LUTPhaseBits") && iparam_ok) {
-							cap.LUTPhaseBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LUTSyncAnlgBits") && iparam_ok) {
-							cap.LUTSyncABits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "LUTSyncDigBits") && iparam_ok) {
-							cap.LUTSyncDBits = iparam;
-						}
-						else if ((std::string(azColName[i]) == "SysClock") && dparam_ok) {
-							cap.sysClock = dparam;
-							cap.syncClock = dparam / 4.0;
-						}
-						else if ((std::string(azColName[i]) == "Channels") && iparam_ok) {
-							cap.channels = iparam;
-						}
-						else if (std::string(azColName[i]) == "RemoteUpgrade") {
-							cap.RemoteUpgrade = b;
-						}
-						else if ((std::string(azColName[i]) == "ChannelComp") && iparam_ok) {
-							cap.ChannelComp = (ver.revision >= iparam) ? true : false;
-						}
-					}
-				}
+			if (hw.channels) cap.channels = *hw.channels;
+			if (hw.remoteUpgrade.present) cap.RemoteUpgrade = hw.remoteUpgrade.For(ver.major);
+			if (hw.channelCompSince) cap.ChannelComp = (ver.revision >= *hw.channelCompSince) ? true : false;
 
-				system->Synth(IMSSynthesiser(model, desc, cap, ver, FileSystemTable(), nullptr));
-				BOOST_LOG_SEV(lg::get(), sev::info) << "Added Synthesiser " << model << std::endl;
-			}
-		}
-		else {
-			BOOST_LOG_SEV(lg::get(), sev::warning) << "Unknown category " << azColName[0] << std::endl;			
-			return -1;
+			system->Synth(IMSSynthesiser(hw.model, hw.description, cap, ver, FileSystemTable(), nullptr));
+			BOOST_LOG_SEV(lg::get(), sev::info) << "Added Synthesiser " << hw.model << std::endl;
 		}
-		return 0;
- 	}
+	}
 
 	bool IMSSystem::Impl::AddDevice(std::uint16_t magicID)
 	{
-		sqlite3 *imshw = nullptr;
-		int rc;
-
-		imshw = get_db();
-		if (imshw == nullptr) {
+		const HardwareCatalog& catalog = HardwareCatalog::Instance();
+		if (!catalog.IsValid()) {
 			BOOST_LOG_SEV(lg::get(), sev::error) << "imshw db = null" << std::endl;
 			return false;
 		}
 
-		std::string getType("SELECT Type, * FROM hwlist WHERE Magic = ");
-		getType += std::to_string(magicID);
-		rc = sqlite3_exec(imshw, getType.c_str(), hwlist_callback, (void *)m_parent, nullptr);
-		if (rc != SQLITE_OK) {
-			sqlite3_close(imshw);
-			BOOST_LOG_SEV(lg::get(), sev::error) << "imshw db err: " << rc << std::endl;
-			return false;
+		for (const auto& hw : catalog.Hardware(magicID)) {
+			AddHardware(m_parent, hw);
 		}
-
-		sqlite3_close(imshw);
 		return true;
 	}
 
@@ -551,19 +382,31 @@ namespace iMS
 
 	void IMSSystem::Connect()
 	{
+		p_Impl->m_epoch++;
 		p_Impl->m_conn->Connect(p_Impl->m_connString);
 	}
 
 	void IMSSystem::Disconnect() 
 	{
+		p_Impl->m_epoch++;
 		p_Impl->m_conn->Disconnect();
 	}
+
+	std::uint32_t IMSSystem::ConnectionEpoch() const
+	{
+		return p_Impl->m_epoch.load();
+	}
 	
 	void IMSSystem::SetTimeouts(int send_timeout_ms, int rx_timeout_ms, int free_timeout_ms, int discover_timeout_ms)
 	{
 		p_Impl->m_conn->SetTimeouts(send_timeout_ms, rx_timeout_ms, free_timeout_ms, discover_timeout_ms);
 	}
 
+	void IMSSystem::SetEventDispatchThreads(int threads)
+	{
+		p_Impl->m_conn->SetEventDispatchThreads(threads);
+	}
+
 	bool IMSSystem::Open() const
 	{
 		return p_Impl->m_conn->Open();
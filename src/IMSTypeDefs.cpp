@@ -126,6 +126,24 @@ namespace iMS {
 		return static_cast<unsigned int>(static_cast<int>(d)& ((1ULL << system->Synth().GetCap().freqBits) - 1));
 	}
 
+	void FrequencyRenderer::RenderAsStaticOffsets(std::shared_ptr<IMSSystem> system, const double* freq, std::size_t count, std::uint16_t* out)
+	{
+		const double range = static_cast<double>(system->Synth().GetCap().upperFrequency) - static_cast<double>(system->Synth().GetCap().lowerFrequency);
+		const double int_repr = std::floor(std::pow(2.0, (system->Synth().GetCap().freqBits)) - 0.5);
+		const unsigned long long mask = (1ULL << system->Synth().GetCap().freqBits) - 1;
+
+		for (std::size_t i = 0; i < count; i++) {
+			const bool sub = (freq[i] < 0.0);
+			double d = sub ? -freq[i] : freq[i];
+			d = std::max(d, 0.0);
+			d = std::min(d, 0.5*range);
+			d /= range;
+			d = d * int_repr;
+			if (sub) d *= -1.0;
+			out[i] = static_cast<std::uint16_t>(static_cast<unsigned int>(static_cast<int>(d) & mask));
+		}
+	}
+
 	unsigned int FrequencyRenderer::RenderAsDDSValue(std::shared_ptr<IMSSystem> system, const MHz freq)
 	{
 		const int DDSFreqBits = 32;
@@ -161,6 +179,17 @@ namespace iMS {
 		return (static_cast<unsigned int>(d)& ((1ULL << system->Synth().GetCap().LUTAmplBits) - 1));
 	}
 
+	void AmplitudeRenderer::RenderAsCompensationPoints(std::shared_ptr<IMSSystem> system, const double* ampl, std::size_t count, std::uint16_t* out)
+	{
+		const int bits = system->Synth().GetCap().LUTAmplBits;
+		const double int_repr = std::floor(std::pow(2.0, bits) - 0.5);
+		const unsigned int mask = static_cast<unsigned int>((1ULL << bits) - 1);
+
+		for (std::size_t i = 0; i < count; i++) {
+			out[i] = static_cast<std::uint16_t>(static_cast<unsigned int>((ampl[i] / 100.0) * int_repr) & mask);
+		}
+	}
+
 	unsigned int AmplitudeRenderer::RenderAsCalibrationTone(std::shared_ptr<IMSSystem> system, const Percent ampl)
 	{
 		double d = ampl;
@@ -202,6 +231,17 @@ namespace iMS {
 		return (static_cast<unsigned int>(d) & ((1ULL << system->Synth().GetCap().LUTPhaseBits)-1));
 	}
 
+	void PhaseRenderer::RenderAsCompensationPoints(std::shared_ptr<IMSSystem> system, const double* deg, std::size_t count, std::uint16_t* out)
+	{
+		const int bits = system->Synth().GetCap().LUTPhaseBits;
+		const double int_repr = std::floor(std::pow(2.0, bits) - 0.5);
+		const unsigned int mask = static_cast<unsigned int>((1ULL << bits) - 1);
+
+		for (std::size_t i = 0; i < count; i++) {
+			out[i] = static_cast<std::uint16_t>(static_cast<unsigned int>((ModulusPhase(deg[i]) / 360.0) * int_repr) & mask);
+		}
+	}
+
 	unsigned int PhaseRenderer::RenderAsCalibrationTone(std::shared_ptr<IMSSystem> system, const Degrees deg)
 	{
 		double d = ModulusPhase(deg);
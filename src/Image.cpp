@@ -27,6 +27,9 @@
 #include "PrivateUtil.h"
 
 #include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 // Required for UUID
 #if defined(__QNXNTO__)
@@ -602,8 +605,10 @@ namespace iMS {
 	void SequenceEntry::SetFrequencyOffset(const MHz& offset, const RFChannel& chan)
 	{
 		if (chan.IsAll()) {
-			for (int ch = RFChannel::min; ; ch++)
+			for (int ch = RFChannel::min; ; ch++) {
 				p_Impl->offsets[ch - RFChannel::min] = offset;
+				if (ch == RFChannel::max) break;
+			}
 		}
 		else {
 			p_Impl->offsets[chan - RFChannel::min] = offset;
@@ -698,6 +703,20 @@ namespace iMS {
 		}
 	}
 
+	ImageSequenceEntry::ImageSequenceEntry(const ImageSequenceEntry& entry, const ImageRepeats& Rpt, const int rpts) :
+		SequenceEntry(entry.UUID(), rpts), p_Impl(new Impl())
+	{
+		p_Impl->ExtClockDivide = entry.p_Impl->ExtClockDivide;
+		p_Impl->imgDelay = entry.p_Impl->imgDelay;
+		p_Impl->InternalClock = entry.p_Impl->InternalClock;
+		this->SyncOutDelay() = entry.SyncOutDelay();
+		p_Impl->rpts = Rpt;
+		for (RFChannel ch = RFChannel::min; ; ch++) {
+			this->SetFrequencyOffset(entry.GetFrequencyOffset(ch), ch);
+			if (ch == RFChannel::max) break;
+		}
+	}
+
 	ImageSequenceEntry &ImageSequenceEntry::operator =(const ImageSequenceEntry &rhs)
 	{
 		if (this == &rhs) return *this;
@@ -818,6 +837,167 @@ namespace iMS {
 		return p_Impl->termInsert;
 	}
 
+	// CompactSequence
+	class CompactSequence::Impl
+	{
+	public:
+		Impl(SequenceTermAction ta, int val) : action(ta), termValue(val), termInsert(nullptr), tag(boost::uuids::random_generator()()), tagDirty(false) {}
+
+		std::vector<std::shared_ptr<SequenceEntry>> table;
+		std::unordered_map<const SequenceEntry*, std::uint32_t> tableIndex;
+		std::vector<std::uint32_t> order;
+
+		SequenceTermAction action;
+		int termValue;
+		const ImageSequence* termInsert;
+
+		// As for ListBase, a new UUID is generated the first time it is asked for after a modification
+		boost::uuids::uuid tag;
+		bool tagDirty;
+
+		std::uint32_t Add(const std::shared_ptr<SequenceEntry>& entry)
+		{
+			auto it = tableIndex.find(entry.get());
+			if (it != tableIndex.end()) return it->second;
+			const std::uint32_t index = static_cast<std::uint32_t>(table.size());
+			table.push_back(entry);
+			tableIndex.emplace(entry.get(), index);
+			tagDirty = true;
+			return index;
+		}
+	};
+
+	CompactSequence::CompactSequence(SequenceTermAction ta, int val) : p_Impl(new Impl(ta, val)) {}
+
+	CompactSequence::CompactSequence(const ImageSequence& seq) : p_Impl(new Impl(seq.TermAction(), seq.TermValue()))
+	{
+		p_Impl->termInsert = seq.TermInsertBefore();
+		p_Impl->order.reserve(seq.size());
+		for (ImageSequence::const_iterator it = seq.cbegin(); it != seq.cend(); ++it) {
+			p_Impl->order.push_back(p_Impl->Add(*it));
+		}
+	}
+
+	CompactSequence::~CompactSequence() { delete p_Impl; p_Impl = nullptr; }
+
+	CompactSequence::CompactSequence(const CompactSequence &rhs) : p_Impl(new Impl(*rhs.p_Impl)) {}
+
+	CompactSequence &CompactSequence::operator = (const CompactSequence &rhs)
+	{
+		if (this == &rhs) return *this;
+		*p_Impl = *rhs.p_Impl;
+		return *this;
+	}
+
+	std::size_t CompactSequence::AddEntry(const std::shared_ptr<SequenceEntry>& entry)
+	{
+		return p_Impl->Add(entry);
+	}
+
+	std::size_t CompactSequence::EntryCount() const
+	{
+		return p_Impl->table.size();
+	}
+
+	const std::shared_ptr<SequenceEntry>& CompactSequence::Entry(std::size_t index) const
+	{
+		return p_Impl->table.at(index);
+	}
+
+	void CompactSequence::push_back(std::size_t index)
+	{
+		if (index >= p_Impl->table.size()) throw std::out_of_range("CompactSequence: no entry at that index in the entry table");
+		p_Impl->order.push_back(static_cast<std::uint32_t>(index));
+		p_Impl->tagDirty = true;
+	}
+
+	void CompactSequence::push_back(const std::shared_ptr<SequenceEntry>& entry)
+	{
+		p_Impl->order.push_back(p_Impl->Add(entry));
+		p_Impl->tagDirty = true;
+	}
+
+	void CompactSequence::reserve(std::size_t n)
+	{
+		p_Impl->order.reserve(n);
+	}
+
+	void CompactSequence::clear()
+	{
+		p_Impl->table.clear();
+		p_Impl->tableIndex.clear();
+		p_Impl->order.clear();
+		p_Impl->tagDirty = true;
+	}
+
+	std::size_t CompactSequence::size() const
+	{
+		return p_Impl->order.size();
+	}
+
+	bool CompactSequence::empty() const
+	{
+		return p_Impl->order.empty();
+	}
+
+	std::size_t CompactSequence::operator[](std::size_t pos) const
+	{
+		return p_Impl->order[pos];
+	}
+
+	const std::uint32_t* CompactSequence::data() const
+	{
+		return p_Impl->order.data();
+	}
+
+	ImageSequence CompactSequence::ToImageSequence() const
+	{
+		ImageSequence seq(p_Impl->action, p_Impl->termValue);
+		if (p_Impl->termInsert != nullptr) seq.OnTermination(p_Impl->action, p_Impl->termInsert);
+		for (auto index : p_Impl->order) seq.push_back(p_Impl->table[index]);
+		return seq;
+	}
+
+	const std::array<std::uint8_t, 16> CompactSequence::GetUUID() const
+	{
+		if (p_Impl->tagDirty) {
+			p_Impl->tag = boost::uuids::random_generator()();
+			p_Impl->tagDirty = false;
+		}
+		std::array<std::uint8_t, 16> v;
+		std::copy_n(p_Impl->tag.begin(), 16, v.begin());
+		return v;
+	}
+
+	void CompactSequence::OnTermination(SequenceTermAction ta, int val)
+	{
+		p_Impl->action = ta;
+		p_Impl->termValue = val;
+		p_Impl->termInsert = nullptr;
+	}
+
+	void CompactSequence::OnTermination(SequenceTermAction ta, const ImageSequence* term_seq)
+	{
+		p_Impl->action = ta;
+		p_Impl->termValue = 0;
+		p_Impl->termInsert = term_seq;
+	}
+
+	const SequenceTermAction& CompactSequence::TermAction() const
+	{
+		return p_Impl->action;
+	}
+
+	const int& CompactSequence::TermValue() const
+	{
+		return p_Impl->termValue;
+	}
+
+	const ImageSequence* CompactSequence::TermInsertBefore() const
+	{
+		return p_Impl->termInsert;
+	}
+
 
 	// ImageGroup
 	class ImageGroup::Impl
@@ -37,9 +37,17 @@
 #include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <cmath>
 #include <iomanip>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
 //#include <iostream>
 
+#include <boost/crc.hpp>
+
 namespace iMS
 {
 //	class VerifyListener : public IEventHandler
@@ -50,6 +58,11 @@ namespace iMS
 
 	// Free function for formatting Image objects into bytestreams
 	int FormatImage(const Image& img, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& img_data, ImageFormat formatSpec, int MSBFirst)
+	{
+		return FormatImage(img, ims, img_data, formatSpec, MSBFirst, 0, img.Size());
+	}
+
+	int FormatImage(const Image& img, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& img_data, ImageFormat formatSpec, int MSBFirst, std::size_t first, std::size_t count)
 	{
 		// These are the old resolutions that must be used if the iMS is in LSB first mode.  Newer firmware supports MSB first mode with variable resolution
 		const int lsb_freqbits = 16;
@@ -58,15 +71,17 @@ namespace iMS
 		const int lsb_syncdbits = 12;
 		const int lsb_syncabits = 12;
 
-		int img_index = 0;
-		int length = img.Size();
+		if (first >= static_cast<std::size_t>(img.Size())) return 0;
+		const int first_index = static_cast<int>(first);
+		int img_index = first_index;
+		int length = static_cast<int>(std::min<std::size_t>(img.Size(), first + count));
 		int bytesPerPoint = 0;
 		int sync_anlg_channels = formatSpec.SyncAnlgChannels();
 		if (sync_anlg_channels > 2) sync_anlg_channels = 2;
 		// Restrict to maximum size of Controller memory;
 		//length = std::min(length, ims->Ctlr().GetCap().MaxImageSize);
 
-		Image::const_iterator it = img.cbegin();
+		Image::const_iterator it = img.cbegin() + first;
 		while ((img_index < length) && (it < img.cend()))
 		{
 			ImagePoint pt = (*it);
@@ -82,15 +97,15 @@ namespace iMS
 				if (!MSBFirst) {
 					for (int i = (ims->Synth().GetCap().freqBits - lsb_freqbits); i <= (ims->Synth().GetCap().freqBits - 1); i+=8) {
 						img_data.push_back(static_cast<std::uint8_t>((freq >> i) & 0xFF));
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 					for (int i = (ims->Synth().GetCap().amplBits - lsb_amplbits); i <= (ims->Synth().GetCap().amplBits - 1); i+=8) {
 						img_data.push_back(static_cast<std::uint8_t>((ampl >> i) & 0xFF));
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 					for (int i = (ims->Synth().GetCap().phaseBits - lsb_phasebits); i <= (ims->Synth().GetCap().phaseBits - 1); i+=8) {
 						img_data.push_back(static_cast<std::uint8_t>((phase >> i) & 0xFF));
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 
 					chan++;
@@ -113,7 +128,7 @@ namespace iMS
 						else {
 							img_data.push_back(static_cast<std::uint8_t>((freq >> i) & 0xFF));
 						}
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 					if (formatSpec.EnableAmpl()) {
 						for (int i = ims->Synth().GetCap().amplBits - 8; i >= amplEndBit; i-=8) {
@@ -123,7 +138,7 @@ namespace iMS
 							else {
 								img_data.push_back(static_cast<std::uint8_t>((ampl >> i) & 0xFF));
 							}
-							if (!img_index) bytesPerPoint++;
+							if (img_index == first_index) bytesPerPoint++;
 						}
 					}
 					if (formatSpec.EnablePhase()) {
@@ -134,7 +149,7 @@ namespace iMS
 							else {
 								img_data.push_back(static_cast<std::uint8_t>((phase >> i) & 0xFF));
 							}
-							if (!img_index) bytesPerPoint++;
+							if (img_index == first_index) bytesPerPoint++;
 						}
 					}
 
@@ -158,14 +173,14 @@ namespace iMS
 			if (!MSBFirst) {
 				for (int i = (ims->Synth().GetCap().LUTSyncDBits - lsb_syncdbits); i <= (ims->Synth().GetCap().LUTSyncDBits - 1); i += 8) {
 					img_data.push_back(static_cast<std::uint8_t>((syncd_mod >> i) & 0xFF));
-					if (!img_index) bytesPerPoint++;
+					if (img_index == first_index) bytesPerPoint++;
 				}
 
 				for (int j = 0; j < 2; j++) {
 					std::uint32_t synca_int = (std::uint32_t)((1 << ims->Synth().GetCap().LUTSyncABits) * synca[j]);
 					for (int i = (ims->Synth().GetCap().LUTSyncABits - lsb_syncabits); i <= (ims->Synth().GetCap().LUTSyncABits - 1); i += 8) {
 						img_data.push_back(static_cast<std::uint8_t>((synca_int >> i) & 0xFF));
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 				}
 			}
@@ -185,7 +200,7 @@ namespace iMS
 						else {
 							img_data.push_back(static_cast<std::uint8_t>((syncd_mod >> i) & 0xFF));
 						}
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 				}
 
@@ -198,7 +213,7 @@ namespace iMS
 						else {
 							img_data.push_back(static_cast<std::uint8_t>((synca_int >> i) & 0xFF));
 						}
-						if (!img_index) bytesPerPoint++;
+						if (img_index == first_index) bytesPerPoint++;
 					}
 				}
 			}
@@ -211,7 +226,79 @@ namespace iMS
 		return bytesPerPoint;
 	}
 
-	std::uint8_t FormatSequenceEntry(const std::shared_ptr<SequenceEntry>& seq_entry, std::shared_ptr<IMSSystem> ims, std::vector < std::uint8_t >& seq_data)
+	// Formats Sequence Buffer records for one iMS system.  Everything that depends only on the system is looked up
+	// once, on construction, and every record for a system is the same length, so records can be written straight
+	// into place in a buffer sized in advance.  Copies are independent and may be used on different threads.
+	class SequenceRecordFormatter
+	{
+	public:
+		// Type and length bytes and the largest payload the length byte can describe
+		static constexpr std::size_t MaxRecordSize = 2 + UINT8_MAX;
+
+		explicit SequenceRecordFormatter(std::shared_ptr<IMSSystem> ims);
+
+		static const int Channels = RFChannel::max - RFChannel::min + 1;
+
+		std::size_t RecordSize() const { return 2 + m_payload; }
+
+		// Renders the frequency offsets of 'count' entries together, Channels values per entry, for passing to Format()
+		bool RenderOffsets(const SequenceEntry* const* entries, std::size_t count, std::uint16_t* out) const;
+
+		// Writes the record for 'entry' (type, length, entry payload) to 'out', RecordSize() bytes.  Returns false if
+		// the entry is not of a type the Controller can play.
+		bool Format(const SequenceEntry* entry, const std::uint16_t* offsets, std::uint8_t* out);
+
+	private:
+		std::shared_ptr<IMSSystem> m_ims;
+		bool m_adv;
+		bool m_prescalerDisable;
+		std::uint16_t m_toneAddr;
+		std::uint16_t m_toneFlags;
+		std::size_t m_payload;
+
+		// Neighbouring entries usually share a clock rate, so the last one rendered is kept
+		double m_lastOsc{ -1.0 };
+		unsigned int m_lastClk{ 0 };
+	};
+
+	SequenceRecordFormatter::SequenceRecordFormatter(std::shared_ptr<IMSSystem> ims) : m_ims(ims)
+	{
+		m_adv = (ims->Ctlr().GetVersion().major >= 2);
+		m_prescalerDisable = (ims->Ctlr().GetVersion().revision >= 38);
+
+		m_toneAddr = SYNTH_REG_UseLocalIndex;
+		m_toneFlags = 0;
+		if (ims->Synth().GetVersion().revision < 90) {
+			// overwrites Compensation Use bits
+			m_toneAddr = SYNTH_REG_UseLocal;
+			// make them active
+			m_toneFlags = 0x1800;
+		}
+
+		// UUID, count, delay, 10 bytes of image or tone parameters then, for v2, repeats and synth registers
+		m_payload = 16 + 1 + 2 + 10;
+		if (m_adv) m_payload += 3 + 4 * (Channels + 1);
+	}
+
+	bool SequenceRecordFormatter::RenderOffsets(const SequenceEntry* const* entries, std::size_t count, std::uint16_t* out) const
+	{
+		// Only v2 Controllers program frequency offsets
+		if (!m_adv) return true;
+
+		std::vector<double> offsets(count * Channels);
+		for (std::size_t i = 0; i < count; i++) {
+			if (entries[i] == nullptr) return false;
+			int c = 0;
+			for (RFChannel chan = RFChannel::min; ; chan++, c++) {
+				offsets[i * Channels + c] = entries[i]->GetFrequencyOffset(chan);
+				if (chan == RFChannel::max) break;
+			}
+		}
+		FrequencyRenderer::RenderAsStaticOffsets(m_ims, offsets.data(), offsets.size(), out);
+		return true;
+	}
+
+	bool SequenceRecordFormatter::Format(const SequenceEntry* entry, const std::uint16_t* offsets, std::uint8_t* out)
 	{
 		/* Add Entries */
 		/* v1 Payload
@@ -246,109 +333,90 @@ namespace iMS
 		* ...
 		* [63:60] = synth prog reg 7
 		*/
-		std::uint8_t type;
-		bool adv_seq = (ims->Ctlr().GetVersion().major >= 2);
+		if (entry == nullptr) return false;
 
-		const std::shared_ptr<ToneSequenceEntry> tone_entry = std::dynamic_pointer_cast<ToneSequenceEntry>(seq_entry);
-		const std::shared_ptr<ImageSequenceEntry> img_entry = std::dynamic_pointer_cast<ImageSequenceEntry>(seq_entry);
+		const ImageSequenceEntry* img_entry = dynamic_cast<const ImageSequenceEntry*>(entry);
+		const ToneSequenceEntry* tone_entry = (img_entry == nullptr) ? dynamic_cast<const ToneSequenceEntry*>(entry) : nullptr;
 
+		std::uint8_t type;
 		if (tone_entry != nullptr) {
-			if (!adv_seq) {
-				//BOOST_LOG_SEV(lg::get(), sev::error) << "FormatSequenceEntry: Controller firmware needs v2.x for tone sequence entry support ";
-				return 0;
+			if (!m_adv) {
+				// Controller firmware needs v2.x for tone sequence entry support
+				return false;
 			}
 			type = 7;
 		}
 		else if (img_entry != nullptr) {
-			if (adv_seq) {
-				type = 6;
-			}
-			else {
-				type = 1;
-			}
+			type = m_adv ? 6 : 1;
 		}
 		else {
-			//BOOST_LOG_SEV(lg::get(), sev::error) << "FormatSequenceEntry: Unrecognised type name " << typeid(*seq_entry).name();
-			return 0;
+			// Unrecognised entry type
+			return false;
 		}
 
-		std::array<std::uint8_t, 16> img_uuid = seq_entry->UUID();
-		seq_data.clear();
-		seq_data.assign(img_uuid.begin(), img_uuid.begin() + 16);
+		std::uint8_t* p = out;
+		*p++ = type;
+		*p++ = static_cast<std::uint8_t>(m_payload);
 
-		if (adv_seq) {
+		const std::array<std::uint8_t, 16>& uuid = entry->UUID();
+		p = std::copy(uuid.begin(), uuid.end(), p);
+
+		if (m_adv) {
 			// Send Frequency offsets + Tone Select/Deselect
-			seq_data.push_back(static_cast<std::uint8_t>(RFChannel::max - RFChannel::min + 1 + 1));
+			*p++ = static_cast<std::uint8_t>(Channels + 1);
 		}
 		else {
-			seq_data.push_back(static_cast<std::uint8_t>(seq_entry->NumRpts()));
+			*p++ = static_cast<std::uint8_t>(entry->NumRpts());
 		}
 
 		using sdor_dly_type = std::chrono::duration<std::uint16_t, std::ratio < 1, 10000000 >>;
-		std::uint16_t sdor_dly = std::chrono::duration_cast<sdor_dly_type>(seq_entry->SyncOutDelay()).count();
-
-		seq_data.push_back(static_cast<std::uint8_t>(sdor_dly & 0xff));
-		seq_data.push_back(static_cast<std::uint8_t>(sdor_dly >> 8));
+		std::uint16_t sdor_dly = std::chrono::duration_cast<sdor_dly_type>(entry->SyncOutDelay()).count();
+		*p++ = static_cast<std::uint8_t>(sdor_dly & 0xff);
+		*p++ = static_cast<std::uint8_t>(sdor_dly >> 8);
 
 		if (img_entry != nullptr) {
-			unsigned int int_clk;
-			if (ims->Ctlr().GetVersion().revision < 38) {
-				int_clk = FrequencyRenderer::RenderAsPointRate(ims, img_entry->IntOsc(), false);
-			}
-			else {
-				int_clk = FrequencyRenderer::RenderAsPointRate(ims, img_entry->IntOsc(), true);
+			const double osc = img_entry->IntOsc();
+			if (osc != m_lastOsc) {
+				m_lastClk = FrequencyRenderer::RenderAsPointRate(m_ims, img_entry->IntOsc(), m_prescalerDisable);
+				m_lastOsc = osc;
 			}
+			const unsigned int int_clk = m_lastClk;
+			*p++ = static_cast<std::uint8_t>(int_clk & 0xff);
+			*p++ = static_cast<std::uint8_t>((int_clk >> 8) & 0xff);
+			*p++ = static_cast<std::uint8_t>((int_clk >> 16) & 0xff);
+			*p++ = static_cast<std::uint8_t>((int_clk >> 24) & 0xff);
 
-			seq_data.push_back(static_cast<std::uint8_t>(int_clk & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((int_clk >> 8) & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((int_clk >> 16) & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((int_clk >> 24) & 0xff));
-
-			seq_data.push_back(static_cast<std::uint8_t>(img_entry->ExtDiv() & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((img_entry->ExtDiv() >> 8) & 0xff));
+			*p++ = static_cast<std::uint8_t>(img_entry->ExtDiv() & 0xff);
+			*p++ = static_cast<std::uint8_t>((img_entry->ExtDiv() >> 8) & 0xff);
 
 			using img_dly_type = std::chrono::duration<std::uint32_t, std::ratio < 1, 10000 >>;
 			std::uint32_t img_dly = std::chrono::duration_cast<img_dly_type>(img_entry->PostImgDelay()).count();
-
-			seq_data.push_back(static_cast<std::uint8_t>(img_dly & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((img_dly >> 8) & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((img_dly >> 16) & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((img_dly >> 24) & 0xff));
-
+			*p++ = static_cast<std::uint8_t>(img_dly & 0xff);
+			*p++ = static_cast<std::uint8_t>((img_dly >> 8) & 0xff);
+			*p++ = static_cast<std::uint8_t>((img_dly >> 16) & 0xff);
+			*p++ = static_cast<std::uint8_t>((img_dly >> 24) & 0xff);
 		}
-		else if (tone_entry != nullptr) {
-			seq_data.push_back(static_cast<std::uint8_t>(tone_entry->InitialIndex()));
-			seq_data.insert(seq_data.end(), { 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+		else {
+			*p++ = static_cast<std::uint8_t>(tone_entry->InitialIndex());
+			p = std::fill_n(p, 9, std::uint8_t(0));
 		}
 
-		if (adv_seq) {
-			seq_data.push_back(static_cast<std::uint8_t>(seq_entry->NumRpts() & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((seq_entry->NumRpts() >> 8) & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((seq_entry->NumRpts() >> 16) & 0xff));
-		}
+		if (m_adv) {
+			*p++ = static_cast<std::uint8_t>(entry->NumRpts() & 0xff);
+			*p++ = static_cast<std::uint8_t>((entry->NumRpts() >> 8) & 0xff);
+			*p++ = static_cast<std::uint8_t>((entry->NumRpts() >> 16) & 0xff);
 
-		if (adv_seq) {
 			// Frequency offset registers
-			std::uint16_t addr = SYNTH_REG_Freq_Offset_Ch1 << 2, data;
-			for (RFChannel chan = RFChannel::min; ; chan++, addr += 4) {
-				const MHz& offset = seq_entry->GetFrequencyOffset(chan);
-				if (offset < 0.0) {
-					uint32_t offset_int = FrequencyRenderer::RenderAsStaticOffset(ims, -offset, 1);
-					data = static_cast<std::uint16_t>(offset_int);
-				}
-				else {
-					uint32_t offset_int = FrequencyRenderer::RenderAsStaticOffset(ims, offset, 0);
-					data = static_cast<std::uint16_t>(offset_int);
-				}
-				seq_data.push_back(static_cast<std::uint8_t>(addr & 0xff));
-				seq_data.push_back(static_cast<std::uint8_t>((addr >> 8) & 0xff));
-				seq_data.push_back(static_cast<std::uint8_t>(data & 0xff));
-				seq_data.push_back(static_cast<std::uint8_t>((data >> 8) & 0xff));
-
-				if (chan == RFChannel::max) break;
+			std::uint16_t addr = SYNTH_REG_Freq_Offset_Ch1 << 2;
+			for (int c = 0; c < Channels; c++, addr += 4) {
+				const std::uint16_t data = offsets[c];
+				*p++ = static_cast<std::uint8_t>(addr & 0xff);
+				*p++ = static_cast<std::uint8_t>((addr >> 8) & 0xff);
+				*p++ = static_cast<std::uint8_t>(data & 0xff);
+				*p++ = static_cast<std::uint8_t>((data >> 8) & 0xff);
 			}
 
-			uint16_t tonedata = 0;
+			std::uint16_t tonedata = m_toneFlags;
 			if (tone_entry != nullptr) {
 				switch (tone_entry->ControlSource()) {
 				case SignalPath::ToneBufferControl::HOST: tonedata |= 0x100; break;
@@ -359,78 +427,184 @@ namespace iMS
 
 				tonedata += (tone_entry->InitialIndex() & 0xFF);
 			}
-			uint16_t toneaddr = SYNTH_REG_UseLocalIndex;
-			if (ims->Synth().GetVersion().revision < 90) {
-				// overwrites Compensation Use bits
-				toneaddr = SYNTH_REG_UseLocal;
-				// make them active
-				tonedata |= 0x1800;
-			}
-			seq_data.push_back((toneaddr << 2) & 0xff);
-			seq_data.push_back((toneaddr >> 6) & 0xff);
-			seq_data.push_back(static_cast<std::uint8_t>(tonedata & 0xff));
-			seq_data.push_back(static_cast<std::uint8_t>((tonedata >> 8) & 0xff));
+			*p++ = (m_toneAddr << 2) & 0xff;
+			*p++ = (m_toneAddr >> 6) & 0xff;
+			*p++ = static_cast<std::uint8_t>(tonedata & 0xff);
+			*p++ = static_cast<std::uint8_t>((tonedata >> 8) & 0xff);
 		}
 
-		return type;
+		return true;
+	}
+
+	// Calls fn(first, last) for consecutive ranges of [0, n), sharing the ranges out between worker threads as
+	// AODevice::GetCompensationFunctions does.  Small jobs are done on the calling thread.  Returns false if any call did.
+	static bool ForEachChunk(std::size_t n, const std::function<bool(std::size_t, std::size_t)>& fn)
+	{
+		const std::size_t chunk = 16384;
+		const std::size_t chunks = (n + chunk - 1) / chunk;
+		if (chunks <= 1) return fn(0, n);
+
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<bool> ok{ true };
+		auto worker = [&]() {
+			for (std::size_t c = next++; (c < chunks) && ok; c = next++) {
+				if (!fn(c * chunk, std::min(n, (c + 1) * chunk))) ok = false;
+			}
+		};
+
+		const std::size_t n_threads = std::min<std::size_t>(chunks, std::max(1u, std::thread::hardware_concurrency()));
+		std::vector<std::thread> workers;
+		for (std::size_t t = 1; t < n_threads; t++) workers.emplace_back(worker);
+		worker();
+		for (auto& t : workers) t.join();
+
+		return ok;
 	}
 
-	int FormatSequenceBuffer(const ImageSequence& seq, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& seq_data)
+	// Sequence Buffer header: signature and number of entries.  The signature, and so the header length, changes
+	// above 65535 entries.
+	static void FormatSequenceHeader(std::size_t entries, boost::container::deque < std::uint8_t >& seq_data)
 	{
 		static const char signature[] = "iMS_SEQ";
 		static const char signature2[] = "iMS_SQ2";
-		seq_data.clear();
 
-		// Sequence Buffer header
-		if (seq.size() <= (int)UINT16_MAX)
+		if (entries <= UINT16_MAX)
 		{
 			seq_data.assign(signature, signature + sizeof(signature));
-			AppendVarToContainer< boost::container::deque<std::uint8_t>, std::uint16_t >(seq_data, static_cast<std::uint16_t>(seq.size()));
+			AppendVarToContainer< boost::container::deque<std::uint8_t>, std::uint16_t >(seq_data, static_cast<std::uint16_t>(entries));
 		}
 		else
 		{
 			seq_data.assign(signature2, signature2 + sizeof(signature2));
-			AppendVarToContainer< boost::container::deque<std::uint8_t>, std::uint32_t >(seq_data, static_cast<std::uint32_t>(seq.size()));
+			AppendVarToContainer< boost::container::deque<std::uint8_t>, std::uint32_t >(seq_data, static_cast<std::uint32_t>(entries));
+		}
+	}
+
+	// Length of the header FormatSequenceHeader() writes for a sequence of 'entries' entries
+	static std::size_t SequenceHeaderSize(std::size_t entries)
+	{
+		return 8 + ((entries <= UINT16_MAX) ? sizeof(std::uint16_t) : sizeof(std::uint32_t));
+	}
+
+	// Formats entries [first, last) of 'entries' into consecutive records starting at 'out'
+	template <typename OutputIt>
+	static bool FormatSequenceRecords(const std::vector<const SequenceEntry*>& entries, std::size_t first, std::size_t last, SequenceRecordFormatter fmt, OutputIt out)
+	{
+		std::vector<std::uint16_t> offsets((last - first) * SequenceRecordFormatter::Channels);
+		if (!fmt.RenderOffsets(entries.data() + first, last - first, offsets.data())) return false;
+
+		std::array<std::uint8_t, SequenceRecordFormatter::MaxRecordSize> rec;
+		for (std::size_t i = first; i < last; i++) {
+			if (!fmt.Format(entries[i], &offsets[(i - first) * SequenceRecordFormatter::Channels], rec.data())) return false;
+			out = std::copy_n(rec.data(), fmt.RecordSize(), out);
 		}
-		//seq_data.push_back(static_cast<std::uint16_t>(seq.size()) & 0xFF);
-		//seq_data.push_back(static_cast<std::uint16_t>((seq.size()) >> 8) & 0xFF);
+		return true;
+	}
+
+	int FormatSequenceBuffer(const ImageSequence& seq, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& seq_data, std::vector<std::size_t>* offsets)
+	{
+		const SequenceRecordFormatter fmt(ims);
+		const std::size_t rec_size = fmt.RecordSize();
 
-		std::vector<std::uint8_t> v;
+		// Random access to the entries, so that they can be shared out between threads
+		std::vector<const SequenceEntry*> entries;
+		entries.reserve(seq.size());
 		for (ImageSequence::const_iterator it = seq.cbegin(); it != seq.cend(); ++it) {
-			std::uint8_t type = FormatSequenceEntry(*it, ims, v);
-			if (type == 0) {
-				// error formatting sequence entry
-				return 0;
+			entries.push_back(it->get());
+		}
+
+		// The buffer is sized in advance and each range of entries formatted straight into its place
+		seq_data.clear();
+		FormatSequenceHeader(entries.size(), seq_data);
+		const std::size_t hdr_size = seq_data.size();
+		seq_data.resize(hdr_size + entries.size() * rec_size, boost::container::default_init);
+
+		if (!ForEachChunk(entries.size(), [&](std::size_t first, std::size_t last) {
+			return FormatSequenceRecords(entries, first, last, fmt, seq_data.begin() + (hdr_size + first * rec_size));
+		})) {
+			// error formatting sequence entry
+			seq_data.clear();
+			return 0;
+		}
+
+		if (offsets) {
+			offsets->reserve(offsets->size() + entries.size());
+			for (std::size_t i = 0; i < entries.size(); i++) offsets->push_back(hdr_size + i * rec_size);
+		}
+		return (int)seq_data.size();
+	}
+
+	int FormatSequenceBuffer(const CompactSequence& seq, std::shared_ptr<IMSSystem> ims, boost::container::deque < std::uint8_t >& seq_data, std::vector<std::size_t>* offsets)
+	{
+		const SequenceRecordFormatter fmt(ims);
+		const std::size_t rec_size = fmt.RecordSize();
+		const std::uint32_t* order = seq.data();
+		const std::size_t n = seq.size();
+
+		// Each entry in the table that is played is formatted once ...
+		const std::uint32_t unplayed = std::numeric_limits<std::uint32_t>::max();
+		std::vector<std::uint32_t> record(seq.EntryCount(), unplayed);
+		std::vector<const SequenceEntry*> entries;
+		for (std::size_t i = 0; i < n; i++) {
+			if (record[order[i]] == unplayed) {
+				record[order[i]] = static_cast<std::uint32_t>(entries.size());
+				entries.push_back(seq.Entry(order[i]).get());
 			}
-			seq_data.push_back(type);
-			seq_data.push_back(static_cast<std::uint8_t>(v.size()));
-			std::move(std::begin(v), std::end(v), std::back_inserter(seq_data));
 		}
 
+		std::vector<std::uint8_t> records(entries.size() * rec_size);
+		if (!ForEachChunk(entries.size(), [&](std::size_t first, std::size_t last) {
+			return FormatSequenceRecords(entries, first, last, fmt, records.begin() + first * rec_size);
+		})) {
+			// error formatting sequence entry
+			seq_data.clear();
+			return 0;
+		}
+
+		// ... then its record copied to every position it is played at
+		seq_data.clear();
+		FormatSequenceHeader(n, seq_data);
+		const std::size_t hdr_size = seq_data.size();
+		seq_data.resize(hdr_size + n * rec_size, boost::container::default_init);
+
+		ForEachChunk(n, [&](std::size_t first, std::size_t last) {
+			auto out = seq_data.begin() + (hdr_size + first * rec_size);
+			for (std::size_t i = first; i < last; i++) {
+				out = std::copy_n(&records[record[order[i]] * rec_size], rec_size, out);
+			}
+			return true;
+		});
+
+		if (offsets) {
+			offsets->reserve(offsets->size() + n);
+			for (std::size_t i = 0; i < n; i++) offsets->push_back(hdr_size + i * rec_size);
+		}
 		return (int)seq_data.size();
 	}
 
 	class DMASupervisor : public IEventHandler
 	{
 	private:
-		std::atomic<bool> m_busy{ true };
+		CompletionSignal m_done;
 		std::atomic<int> m_tfr_size{ 0 };
 	public:
 		void EventAction(void* /*sender*/, const int message, const int param)
 		{
 			switch (message)
 			{
-			case (MessageEvents::MEMORY_TRANSFER_ERROR): m_busy.store(false);
+			case (MessageEvents::MEMORY_TRANSFER_ERROR): m_done.set();
 				BOOST_LOG_SEV(lg::get(), sev::error) << "Memory Transfer Error";
 				break;
-			case (MessageEvents::MEMORY_TRANSFER_COMPLETE): m_busy.store(false); m_tfr_size.store(param);  
+			case (MessageEvents::MEMORY_TRANSFER_COMPLETE): m_tfr_size.store(param); m_done.set();
 				BOOST_LOG_SEV(lg::get(), sev::debug) << "Memory Transfer Complete " << param << " bytes transferred";
 				break;
 			}
 		}
-		bool Busy() const { return m_busy.load(); };
+		bool Busy() const { return !m_done.is_set(); };
+		// Block until the connection manager reports the transfer has finished
+		void Wait() const { m_done.wait(); }
 		void Reset() {
-			m_busy.store(true);
+			m_done.reset();
 			m_tfr_size.store(0);
 		}
 		int GetTransferredSize() {
@@ -438,6 +612,97 @@ namespace iMS
 		}
 	};
 
+	// Checks Image data read back from a Controller against the bytes the Image formats to, block by block as
+	// the upload delivers it.  The expected bytes are formatted a chunk of points at a time, so neither the
+	// readback nor a formatted copy of the Image is held in full.  Without 'compare', only a CRC-32 of the
+	// readback is kept.
+	class ImageStreamVerifier
+	{
+	public:
+		static constexpr std::size_t ChunkPoints = 4096;
+
+		// 'length' is the number of Image bytes expected, if known.  Otherwise it is found by formatting the
+		// first chunk of points.
+		ImageStreamVerifier(const Image& img, std::shared_ptr<IMSSystem> ims, const ImageFormat& fmt, int msbFirst, bool compare, std::uint64_t length = 0) :
+			m_img(img), m_ims(ims), m_fmt(fmt), m_msbFirst(msbFirst), m_compare(compare), m_length(length)
+		{
+			if (!m_length) {
+				int bytesPerPoint = FormatImage(m_img, m_ims, m_expected, m_fmt, m_msbFirst, 0, ChunkPoints);
+				m_next = ChunkPoints;
+				m_length = static_cast<std::uint64_t>(bytesPerPoint) * m_img.Size();
+			}
+		}
+
+		// The upload sink.  Returns false, abandoning the upload, at the first difference found.
+		bool Consume(const std::uint8_t* data, std::size_t len)
+		{
+			if (m_mismatch >= 0) return false;
+			// Anything beyond the end of the Image is transfer padding
+			len = static_cast<std::size_t>(std::min<std::uint64_t>(len, m_length - m_checked));
+			if (!m_compare) {
+				m_crc.process_bytes(data, len);
+				m_checked += len;
+				return true;
+			}
+			while (len) {
+				if ((m_pos == m_expected.size()) && !Refill()) break;
+				std::size_t n = std::min(len, m_expected.size() - m_pos);
+				auto mm = std::mismatch(data, data + n, m_expected.cbegin() + m_pos);
+				if (mm.first != data + n) {
+					m_mismatch = static_cast<std::int64_t>(m_checked + (mm.first - data));
+					return false;
+				}
+				m_pos += n;
+				m_checked += n;
+				data += n;
+				len -= n;
+			}
+			return true;
+		}
+
+		std::uint64_t Length() const { return m_length; }
+		// Number of Image bytes received and checked so far
+		std::uint64_t Checked() const { return m_checked; }
+		// Offset of the first difference found, or -1
+		std::int64_t Mismatch() const { return m_mismatch; }
+		std::uint32_t ReceivedCRC() const { return m_crc.checksum(); }
+
+		// CRC-32 of the formatted Image.  Only for a verifier that isn't comparing, as it consumes the chunks.
+		std::uint32_t ExpectedCRC()
+		{
+			boost::crc_32_type crc;
+			do {
+				for (auto b : m_expected) crc.process_byte(b);
+			} while (Refill());
+			return crc.checksum();
+		}
+
+	private:
+		bool Refill()
+		{
+			m_expected.clear();
+			m_pos = 0;
+			if (m_next >= static_cast<std::size_t>(m_img.Size())) return false;
+			FormatImage(m_img, m_ims, m_expected, m_fmt, m_msbFirst, m_next, ChunkPoints);
+			m_next += ChunkPoints;
+			return !m_expected.empty();
+		}
+
+		const Image& m_img;
+		std::shared_ptr<IMSSystem> m_ims;
+		const ImageFormat& m_fmt;
+		const int m_msbFirst;
+		const bool m_compare;
+		std::uint64_t m_length;
+
+		boost::container::deque<std::uint8_t> m_expected;
+		std::size_t m_pos{ 0 };
+		std::size_t m_next{ 0 };
+		std::uint64_t m_checked{ 0 };
+		std::int64_t m_mismatch{ -1 };
+		boost::crc_32_type m_crc;
+	};
+
 	class ImageDownloadEventTrigger :
 		public IEventTrigger
 	{
@@ -465,9 +730,21 @@ namespace iMS
 		int m_msbFirst{ 0 };
 
 		const std::unique_ptr<boost::container::deque<std::uint8_t>> m_imgdata;
-		const std::unique_ptr<boost::container::deque<std::uint8_t>> m_vfydata;
 		std::unique_ptr<ImageDownloadEventTrigger> m_Event;
 
+		ImageDownload::VerifyMode m_vfyMode{ ImageDownload::VerifyMode::COMPARE };
+		static constexpr std::uint64_t VerifyProgressInterval = 64 * 1024;
+
+		// CRC-32 of the formatted Image, recorded by a fast transfer download in place of keeping the data
+		struct DownloadDigest
+		{
+			bool valid{ false };
+			std::array<std::uint8_t, 16> uuid;
+			std::uint32_t fmtSpec{ 0 };
+			std::uint32_t bytes{ 0 };
+			std::uint32_t crc{ 0 };
+		} m_digest;
+
 		class ResponseReceiver : public IEventHandler
 		{
 		public:
@@ -514,7 +791,6 @@ namespace iMS
 		m_ims(ims),
 		m_Image(img),
 		m_imgdata(new boost::container::deque<std::uint8_t>()),
-		m_vfydata(new boost::container::deque<std::uint8_t>()),
 		m_Event(new ImageDownloadEventTrigger()),
 		Receiver(new ResponseReceiver(this)),
 		vfyResult(new VerifyResult(this)),
@@ -691,6 +967,11 @@ namespace iMS
 	//}
 
 	bool ImageDownload::StartVerify()
+	{
+		return StartVerify(VerifyMode::COMPARE);
+	}
+
+	bool ImageDownload::StartVerify(VerifyMode mode)
 	{
         auto ims = p_Impl->m_ims.lock();
         if (!ims) return false;
@@ -724,6 +1005,7 @@ namespace iMS
             }
 
             p_Impl->verifyRequested = true;
+            p_Impl->m_vfyMode = mode;
             break;
         }
 
@@ -809,6 +1091,7 @@ namespace iMS
 
 				// Create Byte Vector
 				m_imgdata->clear();
+				m_digest.valid = false;
 				int BytesInImagePoint = FormatImage(m_Image, ims, *m_imgdata, m_fmt, m_msbFirst);
 				std::uint32_t ImageBytes = BytesInImagePoint * m_Image.Size();
 
@@ -866,10 +1149,8 @@ namespace iMS
 					conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
 
 					// Start memory download
-					conn->MemoryDownload(*m_imgdata, ImageMemoryAddress, ImageMemoryIndex, uuid);
-
-					while (dmah->Busy()) {
-						std::this_thread::sleep_for(std::chrono::milliseconds(5));
+					if (conn->MemoryDownload(*m_imgdata, ImageMemoryAddress, ImageMemoryIndex, uuid)) {
+						dmah->Wait();
 					}
 					//std::cout << "Memory Download complete" << std::endl;
 
@@ -878,6 +1159,20 @@ namespace iMS
 					int tfr_size = dmah->GetTransferredSize();
 					delete dmah;
 
+					// Keep a CRC of the Image for verifying in DIGEST mode, rather than the formatted data itself.  The
+					// data is released before any event is raised, as the handler may destroy this object.
+					if (tfr_size > 0) {
+						boost::crc_32_type crc;
+						std::for_each(m_imgdata->cbegin(), m_imgdata->cbegin() + std::min<std::size_t>(ImageBytes, m_imgdata->size()), [&crc](std::uint8_t b) { crc.process_byte(b); });
+						m_digest.uuid = uuid;
+						m_digest.fmtSpec = fmt_spec;
+						m_digest.bytes = ImageBytes;
+						m_digest.crc = crc.checksum();
+						m_digest.valid = true;
+					}
+					m_imgdata->clear();
+					m_imgdata->shrink_to_fit();
+
 					if (tfr_size > 0) {
 						// Transfer complete.  Add data to index table
 						const IMSController& c = ims->Ctlr();
@@ -904,10 +1199,11 @@ namespace iMS
 				}
 				else {
 					// Problem setting up transfer, abort
+					m_imgdata->clear();
+					m_imgdata->shrink_to_fit();
 					m_Event->Trigger<int>((void *)this, ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL, 0);
                     BOOST_LOG_SEV(lg::get(), sev::error) << "Failed to setup Image Download. Memory or Index Table Full?";
 				}
-				//if (m_imgdata->size()) m_imgdata->clear();
 				delete iorpt;
 
 			}
@@ -1098,11 +1394,6 @@ namespace iMS
 			if (cap.FastImageTransfer) {
 				// Fast transfer to large capacity memory
 
-				// Create Byte Vector
-				m_imgdata->clear();
-				/*int BytesInImagePoint = */FormatImage(m_Image, ims, *m_imgdata, m_fmt, m_msbFirst);
-				//std::uint32_t ImageBytes = BytesInImagePoint * m_Image.Size();
-
 				// Find image in image table by checking UUID
 				int h = -1;
 				for (ImageTable::const_iterator it = ims->Ctlr().ImgTable().cbegin(); it != ims->Ctlr().ImgTable().cend(); ++it)
@@ -1115,47 +1406,57 @@ namespace iMS
 				}
 				ImageTableEntry ite = *(std::next(ims->Ctlr().ImgTable().cbegin(), h));
 
+				// The readback is checked as it arrives.  In DIGEST mode, a CRC recorded when this object downloaded
+				// the same Image in the same format saves formatting it again.
+				const bool compare = (m_vfyMode == ImageDownload::VerifyMode::COMPARE);
+				const bool recorded = !compare && m_digest.valid && (m_digest.uuid == m_Image.GetUUID()) && (m_digest.fmtSpec == m_fmt.GetFormatSpec());
+				ImageStreamVerifier sv(m_Image, ims, m_fmt, m_msbFirst, compare, recorded ? m_digest.bytes : 0);
+				std::uint64_t nextReport = VerifyProgressInterval;
+
+				auto sink = [&](const std::uint8_t* data, std::size_t len) {
+					bool ok = sv.Consume(data, len);
+					if (sv.Checked() >= nextReport) {
+						nextReport = ((sv.Checked() / VerifyProgressInterval) + 1) * VerifyProgressInterval;
+						m_Event->Trigger<int>((void *)this, ImageDownloadEvents::VERIFY_PROGRESS, static_cast<int>(sv.Checked()));
+					}
+					return ok;
+				};
+
 				dmah = new DMASupervisor();
 				conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
 
 				// Start memory upload
-				conn->MemoryUpload(*m_vfydata, ite.Address(), ite.Size(), h, ite.UUID());
-
-				while (dmah->Busy()) {
-					std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				if (conn->MemoryUpload(sink, ite.Address(), ite.Size(), h, ite.UUID())) {
+					dmah->Wait();
 				}
 
 				conn->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
-
-				//int tfr_size = dmah->GetTransferredSize();
 				delete dmah;
-				
-				if (m_vfydata->size() < m_imgdata->size()) {
-					m_imgdata->resize(m_vfydata->size());
+
+				bool passed = false;
+				int first_error = -1;
+				if (sv.Mismatch() >= 0) {
+					first_error = static_cast<int>(sv.Mismatch());
+				}
+				else if (sv.Checked() < sv.Length()) {
+					// Readback ended early
+					first_error = static_cast<int>(sv.Checked());
+				}
+				else if (compare) {
+					passed = true;
 				}
 				else {
-					m_vfydata->resize(m_imgdata->size());
+					passed = (sv.ReceivedCRC() == (recorded ? m_digest.crc : sv.ExpectedCRC()));
 				}
-				int tfr_len = (int)m_imgdata->size();
 
-				if (*m_vfydata == *m_imgdata) {
+				if (passed) {
                     BOOST_LOG_SEV(lg::get(), sev::info) << "Verify passed";
                     m_Event->Trigger<int>((void *)this, ImageDownloadEvents::VERIFY_SUCCESS, 0);
                 }
 				else {
-					int first_error = 0;
-					for (int i = 0; i < tfr_len; i++) {
-						if (m_vfydata->at(i) != m_imgdata->at(i)) {
-							first_error = i;
-							break;
-						}
-					}
                     BOOST_LOG_SEV(lg::get(), sev::info) << "Verify FAILED at " << first_error;
-					m_Event->Trigger<int>((void *)this, ImageDownloadEvents::VERIFY_FAIL, first_error); break;
+					m_Event->Trigger<int>((void *)this, ImageDownloadEvents::VERIFY_FAIL, first_error);
 				}
-
-				if (m_imgdata->size()) m_imgdata->clear();
-				if (m_vfydata->size()) m_vfydata->clear();
 			}
 			else {
 
@@ -1236,17 +1537,14 @@ namespace iMS
 					ReportFields f = iorpt->Fields();
 					f.len = static_cast<std::uint16_t>(img_data.size());
 					iorpt->Fields(f);
-					MessageHandle h = conn->SendMsg(*iorpt);
+					// Read back, checking against the image data
+					verifier.SendChunk(*iorpt, img_data, img_addr);
 					delete iorpt;
 
-					// Add image data to verify memory
-					std::shared_ptr<VerifyChunk> chunk(new VerifyChunk(h, img_data, img_addr));
-					verifier.AddChunk(chunk);
-
 					img_data.clear();
 				}
+				verifier.Finalize();
 			}
-			verifier.Finalize();
 			// Wait for next download trigger
 			VerifyStarted = false;
 		}
@@ -1322,2189 +1620,5324 @@ namespace iMS
 		}
 	}
 
-	class ImagePlayerEventTrigger :
-		public IEventTrigger
-	{
-	public:
-		ImagePlayerEventTrigger() { updateCount(ImagePlayerEvents::Count); }
-		~ImagePlayerEventTrigger() {};
-	};
-
-	class ImagePlayer::Impl
+	/* IMAGE GROUP DOWNLOAD */
+	class ImageGroupDownload::Impl
 	{
 	public:
-		Impl(std::shared_ptr<IMSSystem>, const Image&, const PlayConfiguration*);
-		Impl(std::shared_ptr<IMSSystem>, const ImageTableEntry&, const PlayConfiguration*, const kHz InternalClock);
-		Impl(std::shared_ptr<IMSSystem>, const ImageTableEntry&, const PlayConfiguration*, const int ExtClockDivide);
+		Impl(std::shared_ptr<IMSSystem>, const ImageGroup&);
 		~Impl();
 
 		std::weak_ptr<IMSSystem> m_ims;
-		//const Image& img;
-		const std::array<std::uint8_t, 16> uuid;
-		const int img_size;
-		const Frequency int_clk;
-		const int ext_div;
-		const PlayConfiguration* cfg;
-		const std::chrono::milliseconds poll_interval = std::chrono::milliseconds(250);
+		const ImageGroup& m_Group;
 		ImageFormat m_fmt;
+		std::unique_ptr<ImageDownloadEventTrigger> m_Event;
+		int m_msbFirst{ 0 };
 
-		std::unique_ptr<ImagePlayerEventTrigger> m_Event;
-		bool ConfigurePlayback(std::shared_ptr<IMSSystem> ims);
-
-		class ResponseReceiver : public IEventHandler
+		// One Image on its way to the Controller
+		struct Staged
 		{
-		public:
-			ResponseReceiver(ImagePlayer::Impl* pl) : m_parent(pl) {};
-			void EventAction(void* sender, const int message, const int param);
-		private:
-			ImagePlayer::Impl* m_parent;
+			std::size_t position;       // in the group
+			const Image* img;
+			boost::container::deque<std::uint8_t> data;
+			std::uint32_t bytes{ 0 };
+			std::uint32_t fmtSpec{ 0 };
+			bool added{ false };        // Image Table entry made
+			ImageIndex handle{ -1 };
+			std::uint32_t address{ 0 };
 		};
-		ResponseReceiver* Receiver;
-
-		bool BackgroundThreadRunning;
-		mutable std::mutex m_bkmutex;
-		std::condition_variable m_bkcond;
-		std::thread BackgroundThread;
-		void BackgroundWorker();
-
-		std::queue<MessageHandle> finishHandle;
-		std::queue<MessageHandle> progressHandle;
-		int latestProgress{ -1 };
-		bool ImagePlaying{ false };
+		static constexpr std::size_t PipelineDepth = 2;
+
+		// Images to format, and Images formatted but not yet transferred, guarded by formatWorker's mutex
+		std::vector<std::size_t> m_pending;
+		std::size_t m_nextFormat{ 0 };
+		bool m_formatting{ false };
+		bool m_formatBusy{ false };     // an Image is being formatted outside the lock
+		std::deque<std::unique_ptr<Staged>> m_ready;
+		std::condition_variable m_readyCond;
+
+		std::atomic<bool> m_busy{ false };
+		std::atomic<bool> m_abort{ false };
+		std::atomic<std::size_t> m_done{ 0 };
+		std::atomic<std::size_t> m_total{ 0 };
+		std::atomic<std::uint64_t> m_bytes{ 0 };
+
+		bool AddEntry(std::shared_ptr<IMSSystem> ims, Staged& st);
+		void DeleteEntry(std::shared_ptr<IMSSystem> ims, const Staged& st);
+
+		bool downloadRequested{ false };
+		LazyWorker downloadWorker;
+		void DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+
+		LazyWorker formatWorker;
+		void FormatWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
 	};
 
-	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const Image& img, const PlayConfiguration* cfg) :
+	ImageGroupDownload::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageGroup& grp) :
 		m_ims(ims),
-		uuid(img.GetUUID()),
-		img_size(img.Size()),
-		int_clk(img.ClockRate()),
-		ext_div(img.ExtClockDivide()),
-		cfg(cfg),
-		m_Event(new ImagePlayerEventTrigger()),
-		Receiver(new ResponseReceiver(this))
+		m_Group(grp),
+		m_fmt(ims),
+		m_Event(new ImageDownloadEventTrigger()),
+		downloadWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			DownloadWorkerLoop(running, cond, mtx);
+		}),
+		formatWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			FormatWorkerLoop(running, cond, mtx);
+		})
 	{
-		BackgroundThreadRunning = true;
-		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+	}
 
-		// Subscribe listener
-		auto conn = ims->Connection();
-		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
-		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
-			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+	ImageGroupDownload::Impl::~Impl()
+	{
+		m_abort.store(true);
+		{
+			// Release a download waiting for an Image
+			std::unique_lock<std::mutex> lck{ formatWorker.mutex() };
+			m_readyCond.notify_all();
+		}
+		downloadWorker.stop();
+		formatWorker.stop();
 	}
 
-	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration* cfg, const kHz InternalClock) :
-		m_ims(ims),
-		uuid(ite.UUID()),
-		img_size(ite.NPts()),
-		int_clk(InternalClock),
-		ext_div(1),
-		cfg(cfg),
-		m_Event(new ImagePlayerEventTrigger()),
-		Receiver(new ResponseReceiver(this))
+	bool ImageGroupDownload::Impl::AddEntry(std::shared_ptr<IMSSystem> ims, Staged& st)
 	{
-		BackgroundThreadRunning = true;
-		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+		// Data format as ImageDownload:
+		// [15:0] = UUID
+		// [19:16] = Image Length(bytes)
+		// [23:20] = Image Length(Points)
+		// [27:24] = Format Specifier
+		// [43:28] = name
+		HostReport iorpt(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
+		ReportFields f = iorpt.Fields();
+		f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::ADD_ENTRY);
+		iorpt.Fields(f);
+
+		std::array<std::uint8_t, 16> uuid = st.img->GetUUID();
+		std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
+		const std::uint32_t ImageSize = st.img->Size();
+		for (std::uint32_t val : { st.bytes, ImageSize, st.fmtSpec }) {
+			for (int i = 0; i < 4; i++) {
+				data.push_back((val >> (i * 8)) & 0xFF);
+			}
+		}
+		std::string name = st.img->Name();
+		name.resize(16, ' ');
+		data.insert(data.end(), name.begin(), name.end());
+		iorpt.Payload<std::vector<std::uint8_t>>(data);
+
+		DeviceReport ioresp = ims->Connection()->SendMsgBlocking(iorpt);
+		if (!ioresp.Done() || ioresp.GeneralError()) return false;
+		st.handle = ioresp.Fields().addr;
+		st.address = ioresp.Payload<std::uint32_t>();
+		st.added = true;
+		return true;
+	}
 
-		// Subscribe listener
-		auto conn = ims->Connection();
-		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
-		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
-			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+	void ImageGroupDownload::Impl::DeleteEntry(std::shared_ptr<IMSSystem> ims, const Staged& st)
+	{
+		HostReport iorpt(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, st.handle);
+		ReportFields f = iorpt.Fields();
+		f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::DEL_ENTRY);
+		f.len = 0;
+		iorpt.Fields(f);
+		DeviceReport ioresp = ims->Connection()->SendMsgBlocking(iorpt);
+		if (!ioresp.Done() || ioresp.GeneralError()) {
+			BOOST_LOG_SEV(lg::get(), sev::warning) << "Image Group Download: unable to remove unused image index " << st.handle;
+		}
 	}
 
-	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration* cfg, const int ExtClockDivide) :
-		m_ims(ims),
-		uuid(ite.UUID()),
-		img_size(ite.NPts()),
-		int_clk(kHz(1.0)),
-		ext_div(ExtClockDivide),
-		cfg(cfg),
-		m_Event(new ImagePlayerEventTrigger()),
-		Receiver(new ResponseReceiver(this))
+	ImageGroupDownload::ImageGroupDownload(std::shared_ptr<IMSSystem> ims, const ImageGroup& grp) : p_Impl(new Impl(ims, grp)) {}
+
+	ImageGroupDownload::~ImageGroupDownload() { delete p_Impl; p_Impl = nullptr; }
+
+	void ImageGroupDownload::SetFormat(const ImageFormat& fmt)
 	{
-		BackgroundThreadRunning = true;
-		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+		p_Impl->m_fmt = fmt;
+	}
 
-		// Subscribe listener
-		auto conn = ims->Connection();
-		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
-		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
-		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
-			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-	}
-
-	ImagePlayer::Impl::~Impl()
+	bool ImageGroupDownload::StartDownload()
 	{
-		// Unblock worker thread
-		BackgroundThreadRunning = false;
-		m_bkcond.notify_one();
+		auto ims = p_Impl->m_ims.lock();
+		if (!ims) return false;
 
-		BackgroundThread.join();
+		// Make sure Controller and Synthesiser are present
+		if (!ims->Ctlr().IsValid()) return false;
+		if (!ims->Synth().IsValid()) return false;
+		if (!ims->Ctlr().GetCap().FastImageTransfer) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Image Group Download requires a Controller with fast image transfer";
+			return false;
+		}
 
-		// Unsubscribe listener
-        with_locked(m_ims, [this](std::shared_ptr<IMSSystem> ims) {  
-            auto conn = ims->Connection();
-            conn->MessageEventUnsubscribe(MessageEvents::SEND_ERROR, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
-            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
-            if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
-                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-        });
+		bool idle = false;
+		if (!p_Impl->m_busy.compare_exchange_strong(idle, true)) {
+			BOOST_LOG_SEV(lg::get(), sev::warning) << "Image Group Download busy - try again later";
+			return false;
+		}
+
+		p_Impl->downloadWorker.start();
+		p_Impl->formatWorker.start();
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->downloadWorker.mutex() };
+			p_Impl->downloadRequested = true;
+		}
+		p_Impl->downloadWorker.notify();
+		return true;
 	}
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const Image& img) :
-			p_Impl(new Impl(ims, img, &(this->cfg))) {};
+	ImageGroupDownload::Progress ImageGroupDownload::GetProgress() const
+	{
+		Progress p;
+		p.ImagesDone = p_Impl->m_done.load();
+		p.ImagesTotal = p_Impl->m_total.load();
+		p.BytesTransferred = p_Impl->m_bytes.load();
+		return p;
+	}
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const Image& img, const PlayConfiguration& cfg) :
-			cfg(cfg), p_Impl(new Impl(ims, img, &(this->cfg))) {};
+	void ImageGroupDownload::ImageGroupDownloadEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+	}
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const kHz InternalClock) :
-			p_Impl(new Impl(ims, ite, &(this->cfg), InternalClock)) {};
+	void ImageGroupDownload::ImageGroupDownloadEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
+	}
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const int ExtClockDivide) :
-			p_Impl(new Impl(ims, ite, &(this->cfg), ExtClockDivide)) {};
+	// Image Group Formatting Thread.  Formats each Image and adds its Image Table entry while the Image before it transfers.
+	void ImageGroupDownload::Impl::FormatWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	{
+		while (true) {
+			std::unique_lock<std::mutex> lck{ mtx };
+			cond.wait(lck, [this, &running]() {
+				return !running || (m_formatting && (m_ready.size() < PipelineDepth));
+			});
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration& cfg, const kHz InternalClock) :
-			cfg(cfg), p_Impl(new Impl(ims, ite, &(this->cfg), InternalClock)) {};
+			// Allow thread to terminate
+			if (!running) break;
+			if (m_abort.load() || (m_nextFormat >= m_pending.size())) {
+				m_formatting = false;
+				m_readyCond.notify_all();
+				continue;
+			}
+			const std::size_t position = m_pending[m_nextFormat++];
+			m_formatBusy = true;
+			lck.unlock();
 
-	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration& cfg, const int ExtClockDivide) :
-			cfg(cfg), p_Impl(new Impl(ims, ite, &(this->cfg), ExtClockDivide)) {};
+			auto ims = m_ims.lock();
+			if (!ims) {
+				lck.lock();
+				m_formatBusy = false;
+				m_formatting = false;
+				m_readyCond.notify_all();
+				continue;
+			}
 
-	ImagePlayer::~ImagePlayer()	{ delete p_Impl; p_Impl = nullptr; };
+			std::unique_ptr<Staged> st(new Staged());
+			st->position = position;
+			st->img = &m_Group[position];
+			const int BytesInImagePoint = FormatImage(*st->img, ims, st->data, m_fmt, m_msbFirst);
+			st->bytes = BytesInImagePoint * st->img->Size();
+			st->fmtSpec = m_fmt.GetFormatSpec();
+
+			// The Controller may refuse a table update during a transfer, in which case the download thread adds the entry
+			// once the transfer has finished
+			AddEntry(ims, *st);
+
+			lck.lock();
+			m_formatBusy = false;
+			m_ready.push_back(std::move(st));
+			if (m_nextFormat >= m_pending.size()) m_formatting = false;
+			m_readyCond.notify_all();
+		}
+	}
 
-	bool ImagePlayer::Impl::ConfigurePlayback(std::shared_ptr<IMSSystem> ims)
+	// Image Group Downloading Thread
+	void ImageGroupDownload::Impl::DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
-        auto conn = ims->Connection();
-        HostReport* iorpt;
-
-        int ckgen_mode = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lck{ mtx };
+				cond.wait(lck, [this, &running]() {
+					return downloadRequested || !running;
+				});
+
+				// Allow thread to terminate
+				if (!running) break;
+				downloadRequested = false;
+			}
 
-        iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_ClockOutput);
-        DeviceReport resp = conn->SendMsgBlocking(*iorpt);
-        if (resp.Done()) {
-            ckgen_mode = resp.Payload<std::uint16_t>() & 0x1;
-        }
-        delete iorpt;
+			auto ims = m_ims.lock();
+			if (!ims) {
+				m_busy.store(false);
+				break;
+			}
+			auto conn = ims->Connection();
 
-        // Set ImgModes CTRLR_REG_ImgModesExt
-        iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgModes);
-        int TFR{ 0 };
-        if (cfg->int_ext == PointClock::EXTERNAL)
-        {
-            TFR |= 4;
-        }
-        switch (cfg->trig)
-        {
-        case ImageTrigger::CONTINUOUS: TFR |= 3; break;
-        case ImageTrigger::EXTERNAL: TFR |= 1; break;
-        case ImageTrigger::HOST: TFR |= 2; break;
-        case ImageTrigger::POST_DELAY: TFR |= 0; break;
-        }
-        if (cfg->rpts == Repeats::FOREVER)
-        {
-            TFR |= 8;
-        }
-        else if (cfg->rpts != Repeats::NONE) {
-            int i = cfg->n_rpts & 0xFF;
-            TFR |= (i << 8);
-        }
-        iorpt->Payload<std::uint16_t>(TFR);
+			// Check for MSB mode once for the whole group
+			m_msbFirst = 0;
+			HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_FPIFormat);
+			DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
+			delete iorpt;
+			if (ioresp.Done() && (ioresp.Payload<std::uint16_t>() & 1)) {
+				// Device supports MSB Mode
+				iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_FPIFormat);
+				iorpt->Payload<std::uint16_t>(ioresp.Payload<std::uint16_t>() << 1);
+				if (NullMessage == conn->SendMsg(*iorpt)) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Failed to set MSB Mode";
+					delete iorpt;
+					m_busy.store(false);
+					m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_ERROR, 0);
+					continue;
+				}
+				delete iorpt;
+				m_msbFirst = 1;
+			}
 
-        if (NullMessage == conn->SendMsg(*iorpt))
-        {
-            delete iorpt;
-            return false;
-        }
-        delete iorpt;
-        if (cfg->rpts == Repeats::PROGRAM) {
-            // extend repeats to 24 bit
-            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgModesExt);
-            iorpt->Payload<std::uint16_t>((cfg->n_rpts >> 8) & 0xFF);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-        }
+			// Leave out Images already on the Controller, and repeats within the group
+			const ImageTable table = ims->Ctlr().ImgTable();
+			std::vector<std::size_t> pending;
+			std::vector<std::array<std::uint8_t, 16>> seen;
+			for (std::size_t i = 0; i < m_Group.size(); i++) {
+				const Image& img = m_Group[i];
+				if (std::find(seen.cbegin(), seen.cend(), img.GetUUID()) != seen.cend()) continue;
+				seen.push_back(img.GetUUID());
+				if (std::none_of(table.cbegin(), table.cend(), [&img](const ImageTableEntry& ite) { return ite.Matches(img); })) {
+					pending.push_back(i);
+				}
+			}
+			m_total.store(seen.size());
+			m_done.store(seen.size() - pending.size());
+			m_bytes.store(0);
+			m_abort.store(false);
+			BOOST_LOG_SEV(lg::get(), sev::info) << "Image Group Download: " << pending.size() << " of " << seen.size() << " Images to download";
 
+			{
+				std::unique_lock<std::mutex> lck{ formatWorker.mutex() };
+				m_pending = pending;
+				m_nextFormat = 0;
+				m_ready.clear();
+				m_formatting = !m_pending.empty();
+			}
+			formatWorker.notify();
 
-        // Set Post-Image Delay, if required
-        if (cfg->trig == ImageTrigger::POST_DELAY)
-        {
-            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgDelay);
-            // Resolution of 1/10 millisecond, max 6.5s
-            iorpt->Payload<std::uint16_t>(cfg->del.count());
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-        }
+			DMASupervisor dmah;
+			conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, &dmah);
 
-        // Set external signal polarity, if required
-        if (!ckgen_mode && ((cfg->trig == ImageTrigger::EXTERNAL) || (cfg->int_ext == PointClock::EXTERNAL) ) )
-        {
-            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ExtPolarity);
+			std::vector<ImageTableEntry> added;
+			int failure = -1;
+			std::size_t failedAt = 0;
+			for (std::size_t n = 0; n < pending.size(); n++) {
+				std::unique_ptr<Staged> st;
+				{
+					std::unique_lock<std::mutex> lck{ formatWorker.mutex() };
+					m_readyCond.wait(lck, [this]() { return !m_ready.empty() || !m_formatting || m_abort.load(); });
+					if (m_ready.empty()) break;
+					st = std::move(m_ready.front());
+					m_ready.pop_front();
+				}
+				formatWorker.notify();
 
-            // bit 0 = clock; bit 1 = trigger
-            // <0> = rising edge; <1> = falling edge
-            std::uint16_t d = 0;
-            d |= (cfg->clk_pol == Polarity::INVERSE) ? 1 : 0;
-            d |= (cfg->trig_pol == Polarity::INVERSE) ? 2 : 0;
-            iorpt->Payload<std::uint16_t>(d);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-        }
+				if (!st->added && !AddEntry(ims, *st)) {
+					failure = ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL;
+					failedAt = st->position;
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Failed to setup Image Download. Memory or Index Table Full?";
+					break;
+				}
+				m_Event->Trigger<int>((void*)this, ImageDownloadEvents::IMAGE_DOWNLOAD_NEW_HANDLE, st->handle);
 
-        // Set Internal Oscillator clock rate or exteral clock divider, as appropriate
-        if (!ckgen_mode) {
-            bool PrescalerDisable = true;
-            if ((int_clk < 5000.0) || !ims->Ctlr().GetCap().FastImageTransfer) {
-                PrescalerDisable = false;
-            }
-            if (ims->Ctlr().GetCap().FastImageTransfer) {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Ctrl);
-                if (PrescalerDisable) {
-                    iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Ctrl_Prescaler_Disable);
-                }
-                else {
-                    iorpt->Payload<std::uint16_t>(0);
-                }
-                if (NullMessage == conn->SendMsg(*iorpt))
-                {
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-            }
-            if (cfg->int_ext == PointClock::INTERNAL)
-            {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_OscFreq);
-                iorpt->Payload<std::uint16_t>(FrequencyRenderer::RenderAsPointRate(ims, int_clk, PrescalerDisable));
+				dmah.Reset();
+				if (conn->MemoryDownload(st->data, st->address, st->handle, st->img->GetUUID())) {
+					dmah.Wait();
+				}
+				const int tfr_size = dmah.GetTransferredSize();
+				if (tfr_size <= 0) {
+					failure = ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT;
+					failedAt = st->position;
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Image Group Download DMA Transfer Failed on Image " << st->position;
+					break;
+				}
 
-                if (NullMessage == conn->SendMsg(*iorpt))
-                {
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-            }
-        }
+				added.emplace_back(st->handle, st->address, st->img->Size(), tfr_size, 0, st->img->GetUUID(), st->img->Name());
+				m_bytes.fetch_add(tfr_size);
+				m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_PROGRESS, (int)++m_done);
+				if (m_abort.load()) break;
+			}
+			conn->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, &dmah);
 
-        if (cfg->int_ext == PointClock::EXTERNAL) {
-            if (ckgen_mode) {
-                BOOST_LOG_SEV(lg::get(), sev::warning) << "External Image Clock requested with Signal Generator On.  Disabling signal generator";
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ClockOutput);
-                iorpt->Payload<uint16_t>(0);
-                MessageHandle h = conn->SendMsg(*iorpt);
-                if (NullMessage == h)
-                {
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-            }
-            int lcl_ext_div = (ext_div < 1) ? 1 : (ext_div > 65535) ? 65535 : ext_div;
-            if (ims->Ctlr().GetCap().FastImageTransfer) {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ExtDiv);
-            }
-            else {
-                // iMS Lite reuses OscFreq field
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_OscFreq);
-            }
-            iorpt->Payload<std::uint16_t>(lcl_ext_div);
+			// Stop formatting, and give back the entries of Images that will not now be transferred
+			std::deque<std::unique_ptr<Staged>> unused;
+			{
+				std::unique_lock<std::mutex> lck{ formatWorker.mutex() };
+				m_nextFormat = m_pending.size();
+				m_readyCond.wait(lck, [this]() { return !m_formatBusy; });
+				m_formatting = false;
+				unused.swap(m_ready);
+			}
+			for (const auto& st : unused) {
+				if (st->added) DeleteEntry(ims, *st);
+			}
 
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-        }
+			// Record the new Images in the Image Table, once for the whole group
+			if (!added.empty()) {
+				const IMSController& c = ims->Ctlr();
+				ImageTable imgtbl = c.ImgTable();
+				for (const auto& ite : added) {
+					auto iter = std::find_if(imgtbl.begin(), imgtbl.end(), [&ite](const ImageTableEntry& e) { return e.Handle() > ite.Handle(); });
+					imgtbl.insert(iter, ite);
+				}
+				ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), imgtbl));
+			}
 
-        // Set ImageFormat (v1.8 - use auto mode only for now)
-        //if (m_fmt.IsAuto()) {
-        //	iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_Img_FormatLo);
-        //	iorpt->Payload<uint32_t>(0x80000fff);
+			m_busy.store(false);
+			if (failure >= 0) {
+				m_Event->Trigger<int>((void*)this, failure, (int)failedAt);
+			}
+			else if (!m_abort.load()) {
+				BOOST_LOG_SEV(lg::get(), sev::info) << "Image Group Download: " << added.size() << " Images, " << m_bytes.load() << " bytes transferred";
+				m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_FINISHED, (int)m_total.load());
+			}
+		}
+	}
 
-        //	if (NullMessage == conn->SendMsg(*iorpt))
-        //	{
-        //		delete iorpt;
-        //		return false;
-        //	}
-        //	delete iorpt;
-        //}
+	/* IMAGE FAN-OUT DOWNLOAD */
+	class ImageFanOutDownload::Impl
+	{
+	public:
+		Impl(const std::vector<std::shared_ptr<IMSSystem>>&, const Image&);
+		~Impl();
 
-        return true;
-	}
+		std::vector<std::weak_ptr<IMSSystem>> m_targets;
+		const Image& m_Image;
+		ImageFormat m_fmt;
+		bool m_fmtSet{ false };
+		std::unique_ptr<ImageDownloadEventTrigger> m_Event;
 
-	bool ImagePlayer::Play(ImageTrigger start_trig)
-	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        { 
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
+		// Everything the formatted bytes of an Image depend on.  Targets with equal keys share one formatted copy.
+		struct FormatKey
+		{
+			std::uint32_t fmtSpec;
+			int msbFirst;
+			int freqBits, amplBits, phaseBits, syncDBits, syncABits;
+			double lowerFrequency, upperFrequency;
 
-            auto conn = ims->Connection();
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+			bool operator ==(const FormatKey& rhs) const
+			{
+				return (fmtSpec == rhs.fmtSpec) && (msbFirst == rhs.msbFirst) && (freqBits == rhs.freqBits) && (amplBits == rhs.amplBits) &&
+					(phaseBits == rhs.phaseBits) && (syncDBits == rhs.syncDBits) && (syncABits == rhs.syncABits) &&
+					(lowerFrequency == rhs.lowerFrequency) && (upperFrequency == rhs.upperFrequency);
+			}
+		};
 
-            // Check to see if we are already playing back or downloading
-            HostReport *iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Ctrl);
-            DeviceReport resp = conn->SendMsgBlocking(*iorpt);
-            if ((resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_IOS_Busy) ||
-                ((cap.SimultaneousPlayback == false) && (resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_DL_Active)) ) {
-                if (resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_IOS_Busy)
-                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Already playing back";
-                else
-                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Simultaneous playback/download not supported";
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
+		// The Image formatted for one key.  Each connection type pads a buffer to its own transfer size, so targets on
+		// different types of connection have their own copy.
+		struct Formatted
+		{
+			FormatKey key;
+			std::string connection;
+			std::shared_ptr<IMSSystem> formatFor;
+			ImageFormat fmt;
+			std::shared_ptr<boost::container::deque<std::uint8_t>> data;
+			std::uint32_t bytes{ 0 };
+		};
 
-            // Readback UUID from hardware to check the Image has been downloaded and is identical to the one we're being asked to play
-            // (only for Lite Controller which has a single Image Memory)
-            if (!cap.FastImageTransfer) {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_UUID);
-                ReportFields f = iorpt->Fields();
-                f.len = static_cast<std::uint16_t>(p_Impl->uuid.size());
-                iorpt->Fields(f);
-                resp = conn->SendMsgBlocking(*iorpt);
-                if (!resp.Done()) {
-                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Couldn't read back UUID";
-                    delete iorpt;
-                    return false;
-                }
-                else {
-                    std::vector<std::uint8_t> v = resp.Payload<std::vector<std::uint8_t>>();
-                    std::array<std::uint8_t, 16> uuid;
-                    v.resize(16);
-                    std::copy(v.begin(), v.end(), uuid.begin());
-                    if (uuid != p_Impl->uuid) {
-                        BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: UUID Mismatch";
-                        delete iorpt;
-                        return false;
-                    }
-                }
-                delete iorpt;
-            }
-            
-            if (!p_Impl->ConfigurePlayback(ims)) return false;
+		struct Target
+		{
+			std::size_t position;       // in the list of targets
+			std::shared_ptr<IMSSystem> ims;
+			std::size_t formatted;
+			ImageIndex handle{ -1 };
+			std::uint32_t address{ 0 };
+			std::unique_ptr<DMASupervisor> dmah;
+		};
 
-            // For large memory capacity controllers, Start DMA Engine and program NumPts
-            if (cap.FastImageTransfer) {
-                std::array<std::uint8_t, 16> uuid = p_Impl->uuid;
-                std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
-                data.push_back(static_cast<std::uint8_t>(cfg.n_rpts & 0xFF));
-                if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().major > 1) {
-                    data.push_back(static_cast<std::uint8_t>((cfg.n_rpts >> 8) & 0xFF));
-                    data.push_back(static_cast<std::uint8_t>((cfg.n_rpts >> 16) & 0xFF));
-                }
-                data.push_back(static_cast<std::uint8_t>(cfg.rpts));
+		mutable std::mutex m_mutex;
+		std::vector<int> m_results;
 
-                iorpt = new HostReport(HostReport::Actions::CTRLR_SYNDMA, HostReport::Dir::WRITE, CTRLR_SYNDMA_Start_DMA);
-                iorpt->Payload<std::vector<std::uint8_t>>(data);
-                resp = conn->SendMsgBlocking(*iorpt);
-                if (!resp.Done() || resp.GeneralError())
-                {
-                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Unable to start DMA";
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
+		std::atomic<bool> m_busy{ false };
+		std::atomic<std::size_t> m_done{ 0 };
+		std::atomic<std::size_t> m_failed{ 0 };
+		std::atomic<std::size_t> m_formats{ 0 };
+		std::atomic<std::uint64_t> m_bytes{ 0 };
 
-                int length = p_Impl->img_size;
-                // Restrict to maximum size of Controller memory;
-                length = std::min(length, ims->Ctlr().GetCap().MaxImageSize);
-                // Program Image Length into NumPts register
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_NumPtsLo);
-                iorpt->Payload<std::uint32_t>(length);
+		static FormatKey Key(std::shared_ptr<IMSSystem> ims, const ImageFormat& fmt, int msbFirst);
+		static int MSBFirst(std::shared_ptr<IMSSystem> ims);
+		void Complete(std::size_t position, int result);
 
-                if (NullMessage == conn->SendMsg(*iorpt))
-                {
-                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Image Length Program Failed";
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-            }
+		bool downloadRequested{ false };
+		LazyWorker downloadWorker;
+		void DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+	};
 
-            // Play Image
-            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
-            if (start_trig == ImageTrigger::EXTERNAL) {
-                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_ERUN);
-            }
-            else {
-                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_RUN);
-            }
+	ImageFanOutDownload::Impl::Impl(const std::vector<std::shared_ptr<IMSSystem>>& targets, const Image& img) :
+		m_targets(targets.cbegin(), targets.cend()),
+		m_Image(img),
+		m_Event(new ImageDownloadEventTrigger()),
+		m_results(targets.size(), -1),
+		downloadWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			DownloadWorkerLoop(running, cond, mtx);
+		})
+	{
+	}
 
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Play Command Failed";
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
+	ImageFanOutDownload::Impl::~Impl()
+	{
+		downloadWorker.stop();
+	}
 
-            {
-                std::unique_lock<std::mutex> lck{ p_Impl->m_bkmutex };
-                p_Impl->ImagePlaying = true;
-                p_Impl->m_bkcond.notify_one();
-                lck.unlock();
-                p_Impl->m_Event->Trigger<int>(this, ImagePlayerEvents::IMAGE_STARTED, 0);
-            }
-            BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Start request sent";
-            return true;
-        }).value_or(false);
+	ImageFanOutDownload::Impl::FormatKey ImageFanOutDownload::Impl::Key(std::shared_ptr<IMSSystem> ims, const ImageFormat& fmt, int msbFirst)
+	{
+		const auto& cap = ims->Synth().GetCap();
+		FormatKey key;
+		key.fmtSpec = fmt.GetFormatSpec();
+		key.msbFirst = msbFirst;
+		key.freqBits = cap.freqBits;
+		key.amplBits = cap.amplBits;
+		key.phaseBits = cap.phaseBits;
+		key.syncDBits = cap.LUTSyncDBits;
+		key.syncABits = cap.LUTSyncABits;
+		key.lowerFrequency = cap.lowerFrequency;
+		key.upperFrequency = cap.upperFrequency;
+		return key;
 	}
 
-	bool ImagePlayer::GetProgress()
+	int ImageFanOutDownload::Impl::MSBFirst(std::shared_ptr<IMSSystem> ims)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        { 
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
+		// As ImageDownload: enable MSB first mode on Controllers that support it
+		auto conn = ims->Connection();
+		HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_FPIFormat);
+		DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
+		delete iorpt;
+		if (!ioresp.Done() || !(ioresp.Payload<std::uint16_t>() & 1)) return 0;
 
-            if (!p_Impl->ImagePlaying) return false;
+		iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_FPIFormat);
+		iorpt->Payload<std::uint16_t>(ioresp.Payload<std::uint16_t>() << 1);
+		const bool sent = (NullMessage != conn->SendMsg(*iorpt));
+		delete iorpt;
+		if (!sent) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Failed to set MSB Mode";
+			return -1;
+		}
+		return 1;
+	}
 
-            auto conn = ims->Connection();
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+	void ImageFanOutDownload::Impl::Complete(std::size_t position, int result)
+	{
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			m_results[position] = result;
+		}
+		if (result != ImageDownloadEvents::DOWNLOAD_FINISHED) m_failed++;
+		m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_PROGRESS, (int)++m_done);
+	}
 
-            HostReport *iorpt;
-            if (cap.FastImageTransfer) {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_ProgressLo);
-                ReportFields f = iorpt->Fields();
-                f.len = 4;
-                iorpt->Fields(f);
-            }
-            else {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Progress);
-            }
+	ImageFanOutDownload::ImageFanOutDownload(const std::vector<std::shared_ptr<IMSSystem>>& targets, const Image& img) :
+		p_Impl(new Impl(targets, img)) {}
 
-            {
-                std::unique_lock<std::mutex> lck{ p_Impl->m_bkmutex };
-                p_Impl->progressHandle.push(conn->SendMsg(*iorpt));
-                delete iorpt;
+	ImageFanOutDownload::~ImageFanOutDownload() { delete p_Impl; p_Impl = nullptr; }
 
-                if (NullMessage == p_Impl->progressHandle.back())
-                {
-                    lck.unlock();
-                    return false;
-                }
-                //std::cout << "Get Progress {" << p_Impl->progressHandle.front() << " " << p_Impl->progressHandle.back() << "} ";
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Progress request sent";
-            }
-            return true;
-        }).value_or(false);            
+	void ImageFanOutDownload::SetFormat(const ImageFormat& fmt)
+	{
+		p_Impl->m_fmt = fmt;
+		p_Impl->m_fmtSet = true;
 	}
-	
-	bool ImagePlayer::Stop(StopStyle s)
+
+	bool ImageFanOutDownload::StartDownload()
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        { 
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
+		if (p_Impl->m_targets.empty()) return false;
 
-            auto conn = ims->Connection();
-            HostReport *iorpt;
-            
-            if (ImagePlayer::StopStyle::IMMEDIATELY == s)
-            {
-                // Force Stop Image
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
-                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_FSTOP);
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Force Stop request sent";
-                if (NullMessage == conn->SendMsg(*iorpt))
-                {
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-                IMSController::Capabilities cap = ims->Ctlr().GetCap();
-                if (cap.FastImageTransfer) {
-                    iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
-                    if (NullMessage == conn->SendMsg(*iorpt))
-                    {
-                        delete iorpt;
-                        return false;
-                    }
-                    delete iorpt;
-                    iorpt = new HostReport(HostReport::Actions::CTRLR_SYNDMA, HostReport::Dir::WRITE, CTRLR_SYNDMA_DMA_Abort);
-                    if (NullMessage == conn->SendMsg(*iorpt))
-                    {
-                        delete iorpt;
-                        return false;
-                    }
-                    delete iorpt;
-                }
-            }
-            else {
-                // Gracefully Stop Image at end of currenr repeat
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
-                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_STOP);
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Graceful Stop request sent";
-                if (NullMessage == conn->SendMsg(*iorpt))
-                {
-                    delete iorpt;
-                    return false;
-                }
-                delete iorpt;
-            }
-            return true;
-        }).value_or(false);  
+		bool idle = false;
+		if (!p_Impl->m_busy.compare_exchange_strong(idle, true)) {
+			BOOST_LOG_SEV(lg::get(), sev::warning) << "Image Fan-Out Download busy - try again later";
+			return false;
+		}
+
+		p_Impl->downloadWorker.start();
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->downloadWorker.mutex() };
+			p_Impl->downloadRequested = true;
+		}
+		p_Impl->downloadWorker.notify();
+		return true;
 	}
 
-	void ImagePlayer::SetPostDelay(const std::chrono::duration<double>& d)
+	ImageFanOutDownload::Progress ImageFanOutDownload::GetProgress() const
 	{
-		cfg.del = std::chrono::duration_cast<ImagePlayer::PlayConfiguration::post_delay>(d);
-		cfg.trig = ImagePlayer::ImageTrigger::POST_DELAY;
+		Progress p;
+		p.TargetsDone = p_Impl->m_done.load();
+		p.TargetsFailed = p_Impl->m_failed.load();
+		p.TargetsTotal = p_Impl->m_targets.size();
+		p.Formats = p_Impl->m_formats.load();
+		p.BytesTransferred = p_Impl->m_bytes.load();
+		return p;
 	}
 
-	void ImagePlayer::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	int ImageFanOutDownload::TargetResult(std::size_t target) const
 	{
-        auto ims = m_parent->m_ims.lock();
-        if (!ims) return;
-        auto conn = ims->Connection();
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		return (target < p_Impl->m_results.size()) ? p_Impl->m_results[target] : -1;
+	}
+
+	void ImageFanOutDownload::ImageFanOutDownloadEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+	}
+
+	void ImageFanOutDownload::ImageFanOutDownloadEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
+	}
+
+	// Image Fan-Out Downloading Thread
+	void ImageFanOutDownload::Impl::DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	{
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lck{ mtx };
+				cond.wait(lck, [this, &running]() {
+					return downloadRequested || !running;
+				});
+
+				// Allow thread to terminate
+				if (!running) break;
+				downloadRequested = false;
+			}
+
+			{
+				std::unique_lock<std::mutex> lck{ m_mutex };
+				std::fill(m_results.begin(), m_results.end(), -1);
+			}
+			m_done.store(0);
+			m_failed.store(0);
+			m_formats.store(0);
+			m_bytes.store(0);
+
+			// Find what each target needs.  A system listed more than once is downloaded to once.
+			std::vector<Target> targets;
+			std::vector<Formatted> formatted;
+			std::vector<std::pair<std::size_t, std::size_t>> repeats;
+			for (std::size_t i = 0; i < m_targets.size(); i++) {
+				auto ims = m_targets[i].lock();
+				if (!ims || !ims->Ctlr().IsValid() || !ims->Synth().IsValid() || !ims->Ctlr().GetCap().FastImageTransfer) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Image Fan-Out Download: target " << i << " is not connected or does not support fast image transfer";
+					Complete(i, ImageDownloadEvents::DOWNLOAD_ERROR);
+					continue;
+				}
+				auto first = std::find_if(targets.cbegin(), targets.cend(), [&ims](const Target& t) { return t.ims == ims; });
+				if (first != targets.cend()) {
+					repeats.emplace_back(i, first->position);
+					continue;
+				}
+				const ImageTable& table = ims->Ctlr().ImgTable();
+				if (std::any_of(table.cbegin(), table.cend(), [this](const ImageTableEntry& ite) { return ite.Matches(m_Image); })) {
+					Complete(i, ImageDownloadEvents::DOWNLOAD_FINISHED);
+					continue;
+				}
+
+				const int msbFirst = MSBFirst(ims);
+				if (msbFirst < 0) {
+					Complete(i, ImageDownloadEvents::DOWNLOAD_ERROR);
+					continue;
+				}
+				const ImageFormat fmt = m_fmtSet ? m_fmt : ImageFormat(ims);
+				const FormatKey key = Key(ims, fmt, msbFirst);
+				const std::string connection = ims->Connection()->Ident();
+
+				Target t;
+				t.position = i;
+				t.ims = ims;
+				auto f = std::find_if(formatted.cbegin(), formatted.cend(), [&](const Formatted& x) { return (x.key == key) && (x.connection == connection); });
+				t.formatted = std::distance(formatted.cbegin(), f);
+				if (f == formatted.cend()) {
+					Formatted x;
+					x.key = key;
+					x.connection = connection;
+					x.formatFor = ims;
+					x.fmt = fmt;
+					formatted.push_back(std::move(x));
+				}
+				targets.push_back(std::move(t));
+			}
+
+			// Format once for each key, on a thread of its own if there are several.  Further connection types with the
+			// same key copy the formatted data.
+			std::vector<std::size_t> unique;
+			for (std::size_t n = 0; n < formatted.size(); n++) {
+				auto same = std::find_if(unique.cbegin(), unique.cend(), [&](std::size_t u) { return formatted[u].key == formatted[n].key; });
+				if (same == unique.cend()) unique.push_back(n);
+			}
+			auto format = [this, &formatted](std::size_t n) {
+				Formatted& x = formatted[n];
+				x.data = std::make_shared<boost::container::deque<std::uint8_t>>();
+				const int BytesInImagePoint = FormatImage(m_Image, x.formatFor, *x.data, x.fmt, x.key.msbFirst);
+				x.bytes = BytesInImagePoint * m_Image.Size();
+			};
+			if (unique.size() > 1) {
+				std::vector<std::thread> workers;
+				for (std::size_t n : unique) workers.emplace_back(format, n);
+				for (auto& w : workers) w.join();
+			}
+			else if (!unique.empty()) {
+				format(unique.front());
+			}
+			m_formats.store(unique.size());
+			for (std::size_t n = 0; n < formatted.size(); n++) {
+				if (formatted[n].data) continue;
+				const Formatted& src = formatted[*std::find_if(unique.cbegin(), unique.cend(), [&](std::size_t u) { return formatted[u].key == formatted[n].key; })];
+				formatted[n].data = std::make_shared<boost::container::deque<std::uint8_t>>(*src.data);
+				formatted[n].bytes = src.bytes;
+			}
+
+			// Add each target's Image Table entry and start its transfer.  The transfers then run together, each on its
+			// own connection, all reading the same buffer.
+			for (auto& t : targets) {
+				const Formatted& x = formatted[t.formatted];
+
+				HostReport iorpt(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
+				ReportFields f = iorpt.Fields();
+				f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::ADD_ENTRY);
+				iorpt.Fields(f);
+
+				// Data format as ImageDownload:
+				// [15:0] = UUID
+				// [19:16] = Image Length(bytes)
+				// [23:20] = Image Length(Points)
+				// [27:24] = Format Specifier
+				// [43:28] = name
+				std::array<std::uint8_t, 16> uuid = m_Image.GetUUID();
+				std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
+				const std::uint32_t ImageSize = m_Image.Size();
+				for (std::uint32_t val : { x.bytes, ImageSize, x.key.fmtSpec }) {
+					for (int i = 0; i < 4; i++) {
+						data.push_back((val >> (i * 8)) & 0xFF);
+					}
+				}
+				std::string name = m_Image.Name();
+				name.resize(16, ' ');
+				data.insert(data.end(), name.begin(), name.end());
+				iorpt.Payload<std::vector<std::uint8_t>>(data);
+
+				auto conn = t.ims->Connection();
+				DeviceReport ioresp = conn->SendMsgBlocking(iorpt);
+				if (!ioresp.Done() || ioresp.GeneralError()) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Image Fan-Out Download: unable to add Image to target " << t.position << ". Memory or Index Table Full?";
+					Complete(t.position, ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL);
+					continue;
+				}
+				t.handle = ioresp.Fields().addr;
+				t.address = ioresp.Payload<std::uint32_t>();
+
+				t.dmah.reset(new DMASupervisor());
+				conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, t.dmah.get());
+				if (!conn->MemoryDownload(*x.data, t.address, t.handle, uuid)) {
+					conn->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, t.dmah.get());
+					t.dmah.reset();
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Image Fan-Out Download: unable to start transfer to target " << t.position;
+					Complete(t.position, ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT);
+				}
+			}
+
+			for (auto& t : targets) {
+				if (!t.dmah) continue;
+				t.dmah->Wait();
+				t.ims->Connection()->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, t.dmah.get());
+				const int tfr_size = t.dmah->GetTransferredSize();
+				t.dmah.reset();
+				if (tfr_size <= 0) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Image Fan-Out Download DMA Transfer Failed on target " << t.position;
+					Complete(t.position, ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT);
+					continue;
+				}
+
+				// Transfer complete.  Add data to index table
+				const IMSController& c = t.ims->Ctlr();
+				ImageTable imgtbl = c.ImgTable();
+				ImageTableEntry ite(t.handle, t.address, m_Image.Size(), tfr_size, 0, m_Image.GetUUID(), m_Image.Name());
+				auto iter = std::find_if(imgtbl.begin(), imgtbl.end(), [&ite](const ImageTableEntry& e) { return e.Handle() > ite.Handle(); });
+				imgtbl.insert(iter, ite);
+				t.ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), imgtbl));
+
+				m_bytes.fetch_add(tfr_size);
+				Complete(t.position, ImageDownloadEvents::DOWNLOAD_FINISHED);
+			}
+
+			for (const auto& r : repeats) {
+				int result;
+				{
+					std::unique_lock<std::mutex> lck{ m_mutex };
+					result = m_results[r.second];
+				}
+				Complete(r.first, result);
+			}
+
+			formatted.clear();
+			targets.clear();
+			BOOST_LOG_SEV(lg::get(), sev::info) << "Image Fan-Out Download: " << m_targets.size() << " targets, " << m_formats.load() << " formats, " <<
+				m_failed.load() << " failed";
+
+			m_busy.store(false);
+			if (m_failed.load() > 0) {
+				m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_ERROR, (int)m_failed.load());
+			}
+			else {
+				m_Event->Trigger<int>((void*)this, ImageDownloadEvents::DOWNLOAD_FINISHED, (int)m_targets.size());
+			}
+		}
+	}
+
+	class ImagePlayerEventTrigger :
+		public IEventTrigger
+	{
+	public:
+		ImagePlayerEventTrigger() { updateCount(ImagePlayerEvents::Count); }
+		~ImagePlayerEventTrigger() {};
+	};
+
+	class ImagePlayer::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem>, const Image&, const PlayConfiguration*);
+		Impl(std::shared_ptr<IMSSystem>, const ImageTableEntry&, const PlayConfiguration*, const kHz InternalClock);
+		Impl(std::shared_ptr<IMSSystem>, const ImageTableEntry&, const PlayConfiguration*, const int ExtClockDivide);
+		~Impl();
+
+		std::weak_ptr<IMSSystem> m_ims;
+		//const Image& img;
+		const std::array<std::uint8_t, 16> uuid;
+		const int img_size;
+		const Frequency int_clk;
+		const int ext_div;
+		const PlayConfiguration* cfg;
+		const std::chrono::milliseconds poll_interval = std::chrono::milliseconds(250);
+		ImageFormat m_fmt;
+
+		std::unique_ptr<ImagePlayerEventTrigger> m_Event;
+		bool ConfigurePlayback(std::shared_ptr<IMSSystem> ims);
+
+		class ResponseReceiver : public IEventHandler
+		{
+		public:
+			ResponseReceiver(ImagePlayer::Impl* pl) : m_parent(pl) {};
+			void EventAction(void* sender, const int message, const int param);
+		private:
+			ImagePlayer::Impl* m_parent;
+		};
+		ResponseReceiver* Receiver;
+
+		bool BackgroundThreadRunning;
+		mutable std::mutex m_bkmutex;
+		std::condition_variable m_bkcond;
+		std::thread BackgroundThread;
+		void BackgroundWorker();
+
+		std::queue<MessageHandle> finishHandle;
+		std::queue<MessageHandle> progressHandle;
+		int latestProgress{ -1 };
+		bool ImagePlaying{ false };
+	};
+
+	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const Image& img, const PlayConfiguration* cfg) :
+		m_ims(ims),
+		uuid(img.GetUUID()),
+		img_size(img.Size()),
+		int_clk(img.ClockRate()),
+		ext_div(img.ExtClockDivide()),
+		cfg(cfg),
+		m_Event(new ImagePlayerEventTrigger()),
+		Receiver(new ResponseReceiver(this))
+	{
+		BackgroundThreadRunning = true;
+		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+
+		// Subscribe listener
+		auto conn = ims->Connection();
+		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
+			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+	}
+
+	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration* cfg, const kHz InternalClock) :
+		m_ims(ims),
+		uuid(ite.UUID()),
+		img_size(ite.NPts()),
+		int_clk(InternalClock),
+		ext_div(1),
+		cfg(cfg),
+		m_Event(new ImagePlayerEventTrigger()),
+		Receiver(new ResponseReceiver(this))
+	{
+		BackgroundThreadRunning = true;
+		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+
+		// Subscribe listener
+		auto conn = ims->Connection();
+		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
+			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+	}
+
+	ImagePlayer::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration* cfg, const int ExtClockDivide) :
+		m_ims(ims),
+		uuid(ite.UUID()),
+		img_size(ite.NPts()),
+		int_clk(kHz(1.0)),
+		ext_div(ExtClockDivide),
+		cfg(cfg),
+		m_Event(new ImagePlayerEventTrigger()),
+		Receiver(new ResponseReceiver(this))
+	{
+		BackgroundThreadRunning = true;
+		BackgroundThread = std::thread(&ImagePlayer::Impl::BackgroundWorker, this);
+
+		// Subscribe listener
+		auto conn = ims->Connection();
+		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
+			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+	}
+
+	ImagePlayer::Impl::~Impl()
+	{
+		// Unblock worker thread
+		BackgroundThreadRunning = false;
+		m_bkcond.notify_one();
+
+		BackgroundThread.join();
+
+		// Unsubscribe listener
+        with_locked(m_ims, [this](std::shared_ptr<IMSSystem> ims) {  
+            auto conn = ims->Connection();
+            conn->MessageEventUnsubscribe(MessageEvents::SEND_ERROR, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+            conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+            if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46)
+                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+        });
+	}
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const Image& img) :
+			p_Impl(new Impl(ims, img, &(this->cfg))) {};
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const Image& img, const PlayConfiguration& cfg) :
+			cfg(cfg), p_Impl(new Impl(ims, img, &(this->cfg))) {};
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const kHz InternalClock) :
+			p_Impl(new Impl(ims, ite, &(this->cfg), InternalClock)) {};
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const int ExtClockDivide) :
+			p_Impl(new Impl(ims, ite, &(this->cfg), ExtClockDivide)) {};
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration& cfg, const kHz InternalClock) :
+			cfg(cfg), p_Impl(new Impl(ims, ite, &(this->cfg), InternalClock)) {};
+
+	ImagePlayer::ImagePlayer(std::shared_ptr<IMSSystem> ims, const ImageTableEntry& ite, const PlayConfiguration& cfg, const int ExtClockDivide) :
+			cfg(cfg), p_Impl(new Impl(ims, ite, &(this->cfg), ExtClockDivide)) {};
+
+	ImagePlayer::~ImagePlayer()	{ delete p_Impl; p_Impl = nullptr; };
+
+	bool ImagePlayer::Impl::ConfigurePlayback(std::shared_ptr<IMSSystem> ims)
+	{
+        auto conn = ims->Connection();
+        HostReport* iorpt;
+
+        int ckgen_mode = 0;
+
+        iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_ClockOutput);
+        DeviceReport resp = conn->SendMsgBlocking(*iorpt);
+        if (resp.Done()) {
+            ckgen_mode = resp.Payload<std::uint16_t>() & 0x1;
+        }
+        delete iorpt;
+
+        // Set ImgModes CTRLR_REG_ImgModesExt
+        iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgModes);
+        int TFR{ 0 };
+        if (cfg->int_ext == PointClock::EXTERNAL)
+        {
+            TFR |= 4;
+        }
+        switch (cfg->trig)
+        {
+        case ImageTrigger::CONTINUOUS: TFR |= 3; break;
+        case ImageTrigger::EXTERNAL: TFR |= 1; break;
+        case ImageTrigger::HOST: TFR |= 2; break;
+        case ImageTrigger::POST_DELAY: TFR |= 0; break;
+        }
+        if (cfg->rpts == Repeats::FOREVER)
+        {
+            TFR |= 8;
+        }
+        else if (cfg->rpts != Repeats::NONE) {
+            int i = cfg->n_rpts & 0xFF;
+            TFR |= (i << 8);
+        }
+        iorpt->Payload<std::uint16_t>(TFR);
+
+        if (NullMessage == conn->SendMsg(*iorpt))
+        {
+            delete iorpt;
+            return false;
+        }
+        delete iorpt;
+        if (cfg->rpts == Repeats::PROGRAM) {
+            // extend repeats to 24 bit
+            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgModesExt);
+            iorpt->Payload<std::uint16_t>((cfg->n_rpts >> 8) & 0xFF);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+        }
+
+
+        // Set Post-Image Delay, if required
+        if (cfg->trig == ImageTrigger::POST_DELAY)
+        {
+            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ImgDelay);
+            // Resolution of 1/10 millisecond, max 6.5s
+            iorpt->Payload<std::uint16_t>(cfg->del.count());
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+        }
+
+        // Set external signal polarity, if required
+        if (!ckgen_mode && ((cfg->trig == ImageTrigger::EXTERNAL) || (cfg->int_ext == PointClock::EXTERNAL) ) )
+        {
+            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ExtPolarity);
+
+            // bit 0 = clock; bit 1 = trigger
+            // <0> = rising edge; <1> = falling edge
+            std::uint16_t d = 0;
+            d |= (cfg->clk_pol == Polarity::INVERSE) ? 1 : 0;
+            d |= (cfg->trig_pol == Polarity::INVERSE) ? 2 : 0;
+            iorpt->Payload<std::uint16_t>(d);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+        }
+
+        // Set Internal Oscillator clock rate or exteral clock divider, as appropriate
+        if (!ckgen_mode) {
+            bool PrescalerDisable = true;
+            if ((int_clk < 5000.0) || !ims->Ctlr().GetCap().FastImageTransfer) {
+                PrescalerDisable = false;
+            }
+            if (ims->Ctlr().GetCap().FastImageTransfer) {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Ctrl);
+                if (PrescalerDisable) {
+                    iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Ctrl_Prescaler_Disable);
+                }
+                else {
+                    iorpt->Payload<std::uint16_t>(0);
+                }
+                if (NullMessage == conn->SendMsg(*iorpt))
+                {
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+            }
+            if (cfg->int_ext == PointClock::INTERNAL)
+            {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_OscFreq);
+                iorpt->Payload<std::uint16_t>(FrequencyRenderer::RenderAsPointRate(ims, int_clk, PrescalerDisable));
+
+                if (NullMessage == conn->SendMsg(*iorpt))
+                {
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+            }
+        }
+
+        if (cfg->int_ext == PointClock::EXTERNAL) {
+            if (ckgen_mode) {
+                BOOST_LOG_SEV(lg::get(), sev::warning) << "External Image Clock requested with Signal Generator On.  Disabling signal generator";
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ClockOutput);
+                iorpt->Payload<uint16_t>(0);
+                MessageHandle h = conn->SendMsg(*iorpt);
+                if (NullMessage == h)
+                {
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+            }
+            int lcl_ext_div = (ext_div < 1) ? 1 : (ext_div > 65535) ? 65535 : ext_div;
+            if (ims->Ctlr().GetCap().FastImageTransfer) {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_ExtDiv);
+            }
+            else {
+                // iMS Lite reuses OscFreq field
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_OscFreq);
+            }
+            iorpt->Payload<std::uint16_t>(lcl_ext_div);
+
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+        }
+
+        // Set ImageFormat (v1.8 - use auto mode only for now)
+        //if (m_fmt.IsAuto()) {
+        //	iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_Img_FormatLo);
+        //	iorpt->Payload<uint32_t>(0x80000fff);
+
+        //	if (NullMessage == conn->SendMsg(*iorpt))
+        //	{
+        //		delete iorpt;
+        //		return false;
+        //	}
+        //	delete iorpt;
+        //}
+
+        return true;
+	}
+
+	bool ImagePlayer::Play(ImageTrigger start_trig)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        { 
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
+
+            auto conn = ims->Connection();
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+
+            // Check to see if we are already playing back or downloading
+            HostReport *iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Ctrl);
+            DeviceReport resp = conn->SendMsgBlocking(*iorpt);
+            if ((resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_IOS_Busy) ||
+                ((cap.SimultaneousPlayback == false) && (resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_DL_Active)) ) {
+                if (resp.Payload<std::uint16_t>() & CTRLR_REG_Img_Ctrl_IOS_Busy)
+                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Already playing back";
+                else
+                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Simultaneous playback/download not supported";
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+
+            // Readback UUID from hardware to check the Image has been downloaded and is identical to the one we're being asked to play
+            // (only for Lite Controller which has a single Image Memory)
+            if (!cap.FastImageTransfer) {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_UUID);
+                ReportFields f = iorpt->Fields();
+                f.len = static_cast<std::uint16_t>(p_Impl->uuid.size());
+                iorpt->Fields(f);
+                resp = conn->SendMsgBlocking(*iorpt);
+                if (!resp.Done()) {
+                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Couldn't read back UUID";
+                    delete iorpt;
+                    return false;
+                }
+                else {
+                    std::vector<std::uint8_t> v = resp.Payload<std::vector<std::uint8_t>>();
+                    std::array<std::uint8_t, 16> uuid;
+                    v.resize(16);
+                    std::copy(v.begin(), v.end(), uuid.begin());
+                    if (uuid != p_Impl->uuid) {
+                        BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: UUID Mismatch";
+                        delete iorpt;
+                        return false;
+                    }
+                }
+                delete iorpt;
+            }
+            
+            if (!p_Impl->ConfigurePlayback(ims)) return false;
+
+            // For large memory capacity controllers, Start DMA Engine and program NumPts
+            if (cap.FastImageTransfer) {
+                std::array<std::uint8_t, 16> uuid = p_Impl->uuid;
+                std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
+                data.push_back(static_cast<std::uint8_t>(cfg.n_rpts & 0xFF));
+                if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().major > 1) {
+                    data.push_back(static_cast<std::uint8_t>((cfg.n_rpts >> 8) & 0xFF));
+                    data.push_back(static_cast<std::uint8_t>((cfg.n_rpts >> 16) & 0xFF));
+                }
+                data.push_back(static_cast<std::uint8_t>(cfg.rpts));
+
+                iorpt = new HostReport(HostReport::Actions::CTRLR_SYNDMA, HostReport::Dir::WRITE, CTRLR_SYNDMA_Start_DMA);
+                iorpt->Payload<std::vector<std::uint8_t>>(data);
+                resp = conn->SendMsgBlocking(*iorpt);
+                if (!resp.Done() || resp.GeneralError())
+                {
+                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Unable to start DMA";
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+
+                int length = p_Impl->img_size;
+                // Restrict to maximum size of Controller memory;
+                length = std::min(length, ims->Ctlr().GetCap().MaxImageSize);
+                // Program Image Length into NumPts register
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_NumPtsLo);
+                iorpt->Payload<std::uint32_t>(length);
+
+                if (NullMessage == conn->SendMsg(*iorpt))
+                {
+                    BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Image Length Program Failed";
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+            }
+
+            // Play Image
+            iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
+            if (start_trig == ImageTrigger::EXTERNAL) {
+                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_ERUN);
+            }
+            else {
+                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_RUN);
+            }
+
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                BOOST_LOG_SEV(lg::get(), sev::error) << "Image Playback Start Failed: Play Command Failed";
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+
+            {
+                std::unique_lock<std::mutex> lck{ p_Impl->m_bkmutex };
+                p_Impl->ImagePlaying = true;
+                p_Impl->m_bkcond.notify_one();
+                lck.unlock();
+                p_Impl->m_Event->Trigger<int>(this, ImagePlayerEvents::IMAGE_STARTED, 0);
+            }
+            BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Start request sent";
+            return true;
+        }).value_or(false);
+	}
+
+	bool ImagePlayer::GetProgress()
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        { 
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+
+            if (!p_Impl->ImagePlaying) return false;
+
+            auto conn = ims->Connection();
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+
+            HostReport *iorpt;
+            if (cap.FastImageTransfer) {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_ProgressLo);
+                ReportFields f = iorpt->Fields();
+                f.len = 4;
+                iorpt->Fields(f);
+            }
+            else {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Progress);
+            }
+
+            {
+                std::unique_lock<std::mutex> lck{ p_Impl->m_bkmutex };
+                p_Impl->progressHandle.push(conn->SendMsg(*iorpt));
+                delete iorpt;
+
+                if (NullMessage == p_Impl->progressHandle.back())
+                {
+                    lck.unlock();
+                    return false;
+                }
+                //std::cout << "Get Progress {" << p_Impl->progressHandle.front() << " " << p_Impl->progressHandle.back() << "} ";
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Progress request sent";
+            }
+            return true;
+        }).value_or(false);            
+	}
+	
+	bool ImagePlayer::Stop(StopStyle s)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        { 
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
+
+            auto conn = ims->Connection();
+            HostReport *iorpt;
+            
+            if (ImagePlayer::StopStyle::IMMEDIATELY == s)
+            {
+                // Force Stop Image
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
+                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_FSTOP);
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Force Stop request sent";
+                if (NullMessage == conn->SendMsg(*iorpt))
+                {
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+                IMSController::Capabilities cap = ims->Ctlr().GetCap();
+                if (cap.FastImageTransfer) {
+                    iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
+                    if (NullMessage == conn->SendMsg(*iorpt))
+                    {
+                        delete iorpt;
+                        return false;
+                    }
+                    delete iorpt;
+                    iorpt = new HostReport(HostReport::Actions::CTRLR_SYNDMA, HostReport::Dir::WRITE, CTRLR_SYNDMA_DMA_Abort);
+                    if (NullMessage == conn->SendMsg(*iorpt))
+                    {
+                        delete iorpt;
+                        return false;
+                    }
+                    delete iorpt;
+                }
+            }
+            else {
+                // Gracefully Stop Image at end of currenr repeat
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::WRITE, CTRLR_REG_Img_Play);
+                iorpt->Payload<std::uint16_t>(CTRLR_REG_Img_Play_STOP);
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Graceful Stop request sent";
+                if (NullMessage == conn->SendMsg(*iorpt))
+                {
+                    delete iorpt;
+                    return false;
+                }
+                delete iorpt;
+            }
+            return true;
+        }).value_or(false);  
+	}
+
+	void ImagePlayer::SetPostDelay(const std::chrono::duration<double>& d)
+	{
+		cfg.del = std::chrono::duration_cast<ImagePlayer::PlayConfiguration::post_delay>(d);
+		cfg.trig = ImagePlayer::ImageTrigger::POST_DELAY;
+	}
+
+	void ImagePlayer::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	{
+        auto ims = m_parent->m_ims.lock();
+        if (!ims) return;
+        auto conn = ims->Connection();
+
+		while (!m_parent->progressHandle.empty() && 
+			((NullMessage == m_parent->progressHandle.front()) || (param > (m_parent->progressHandle.front())))) m_parent->progressHandle.pop();
+		if (ims->Ctlr().Model() == "iMSP" && ims->Ctlr().GetVersion().revision <= 46) {
+			while (!m_parent->finishHandle.empty() &&
+				((NullMessage == m_parent->finishHandle.front()) || (param > (m_parent->finishHandle.front())))) m_parent->finishHandle.pop();
+		}
+		switch (message)
+		{
+		case (MessageEvents::INTERRUPT_RECEIVED): {
+			unsigned int type = (param >> 16);
+	
+			if (type == CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED) {
+				std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
+				m_parent->ImagePlaying = false;
+				m_parent->m_bkcond.notify_one();
+				lck.unlock();
+			}
+
+			break;
+		}
+
+		case (MessageEvents::RESPONSE_RECEIVED) :
+		case (MessageEvents::RESPONSE_ERROR_VALID) : {
+
+			{
+				if ((!m_parent->progressHandle.empty()) && (param == m_parent->progressHandle.front()))
+				{
+					auto object = static_cast<IConnectionManager*>(sender);
+					IOReport resp = object->Response(param);
+
+					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
+					if (ims->Ctlr().GetCap().FastImageTransfer) {
+						m_parent->latestProgress = resp.Payload<std::uint32_t>();
+					}
+					else {
+						m_parent->latestProgress = resp.Payload<std::uint16_t>();
+					}
+					m_parent->progressHandle.pop();
+					m_parent->m_bkcond.notify_one();
+					lck.unlock();  // Wait until thread is not consuming the mutex (might be in timeout loop) before notifying
+					//std::cout << "Recvd " << param << std::endl;
+
+				}
+				if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) break;
+				else if ((!m_parent->finishHandle.empty()) && (param == m_parent->finishHandle.front()))
+				{
+					auto object = static_cast<IConnectionManager*>(sender);
+					IOReport resp = object->Response(param);
+
+					std::uint16_t ctrl = resp.Payload<std::uint16_t>();
+					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
+					m_parent->finishHandle.pop();
+					if (!(ctrl & CTRLR_REG_Img_Ctrl_IOS_Busy)) {
+						m_parent->ImagePlaying = false;
+						m_parent->m_bkcond.notify_one();
+					}
+					lck.unlock();
+				}
+			}
+			break;
+		}
+		case (MessageEvents::TIMED_OUT_ON_SEND) :
+		case (MessageEvents::SEND_ERROR) :
+		case (MessageEvents::RESPONSE_TIMED_OUT) :
+		case (MessageEvents::RESPONSE_ERROR_CRC) :
+		case (MessageEvents::RESPONSE_ERROR_INVALID) : {
+
+			{
+				if ((!m_parent->progressHandle.empty()) && (param == m_parent->progressHandle.front()))
+				{
+					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
+					m_parent->progressHandle.pop();
+					lck.unlock();
+				}
+				if ((!m_parent->finishHandle.empty()) && (param == m_parent->finishHandle.front()))
+				{
+					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
+					m_parent->finishHandle.pop();
+					lck.unlock();
+				}
+				break;
+			}
+		}
+		}
+	}
+
+	// Notify application when something happens
+	void ImagePlayer::ImagePlayerEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+
+        auto ims = p_Impl->m_ims.lock();
+        if (!ims) return;
+        auto conn = ims->Connection();
+
+		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
+			int IntrMask;
+			if (message == ImagePlayerEvents::IMAGE_FINISHED) {
+				IntrMask = (int)(1 << CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED);
+				HostReport *iorpt;
+				iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
+				iorpt->Payload<int>(IntrMask);
+				ReportFields f = iorpt->Fields();
+				f.len = sizeof(IntrMask);
+				iorpt->Fields(f);
+				ims->Connection()->SendMsg(*iorpt);
+				delete iorpt;
+			}
+		}
+	}
+
+	void ImagePlayer::ImagePlayerEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
+
+        auto ims = p_Impl->m_ims.lock();
+        if (!ims) return;
+        auto conn = ims->Connection();
+
+		if (!p_Impl->m_Event->Subscribers(message) && (message == ImagePlayerEvents::IMAGE_FINISHED)) {
+			int IntrMask = (int)~(1 << CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED);
+			HostReport *iorpt;
+			iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
+			iorpt->Payload<int>(IntrMask);
+			ReportFields f = iorpt->Fields();
+			f.len = sizeof(IntrMask);
+			iorpt->Fields(f);
+			ims->Connection()->SendMsg(*iorpt);
+			delete iorpt;
+		}
+	}
+
+	void ImagePlayer::Impl::BackgroundWorker()
+	{
+		bool ImagePlaying_last = false;
+		std::unique_lock<std::mutex> lck{ m_bkmutex };
+		std::chrono::time_point<std::chrono::high_resolution_clock> last_progress_check = std::chrono::high_resolution_clock::now();
+
+        auto ims = m_ims.lock();
+        if (!ims) return;
+        auto conn = ims->Connection();
+
+		while (BackgroundThreadRunning) {
+			//while (std::cv_status::timeout == m_bkcond.wait_for(lck, poll_interval))
+			m_bkcond.wait_for(lck, poll_interval);
+
+			if ((ims->Ctlr().Model() == "iMSP" && ims->Ctlr().GetVersion().revision <= 46) && (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - last_progress_check) > poll_interval))
+			{
+				// Controllers with FW revision greater than 46 use interrupt driven image notifications
+				if (ImagePlaying) {
+
+					HostReport *iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Ctrl);
+
+					finishHandle.push(conn->SendMsg(*iorpt));
+					delete iorpt;
+				}
+
+				/*if (!BackgroundThreadRunning || (latestProgress != -1)) break;
+				if (!ImagePlaying && ImagePlaying_last) break;
+				ImagePlaying_last = ImagePlaying;*/
+
+				last_progress_check = std::chrono::high_resolution_clock::now();
+			}
+			
+			if (!BackgroundThreadRunning) break;
+
+			if (latestProgress != -1) {
+				int progress = latestProgress;
+				lck.unlock();
+				m_Event->Trigger<int>(this, ImagePlayerEvents::POINT_PROGRESS, progress);
+				lck.lock();
+				latestProgress = -1;
+			}
+
+			if (!ImagePlaying && ImagePlaying_last) {
+				lck.unlock();
+				m_Event->Trigger<int>(this, ImagePlayerEvents::IMAGE_FINISHED, 0);
+				lck.lock();
+				BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Finished";
+			}
+			ImagePlaying_last = ImagePlaying;
+		}
+	}
+
+	/* IMAGE TABLE READER */
+	ImageTableReader::ImageTableReader(std::shared_ptr<IMSSystem> ims) : m_ims(ims)
+	{}
+
+	ImageTableReader::~ImageTableReader()
+	{}
+
+	ImageTable ImageTableReader::Readback()
+	{
+		std::unique_ptr<ImageTable> imgt(new ImageTable());
+		std::array<std::uint8_t, 16> uuid;
+
+        return with_locked_value(m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTable
+        {  
+            // Read back ImageTable from iMS Controller
+            if (!ims->Ctlr().IsValid()) return ImageTable();
+
+            auto conn = ims->Connection();
+
+            // Get number of entries in table
+            std::size_t tbl_size;
+            HostReport *iorpt;
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+            if (!cap.FastImageTransfer) {
+                // Only ever 1 entry in a Controller Lite
+                tbl_size = 1;
+
+                // Read Image Length
+                int img_len = 0;
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_NumPts);
+                DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+                delete iorpt;
+                if (Resp.Done()) {
+                    img_len = Resp.Payload<std::uint16_t>();
+                }
+                else return ImageTable();
+
+                // Read Image UUID
+                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_UUID);
+                ReportFields f = iorpt->Fields();
+                f.len = static_cast<std::uint16_t>(uuid.size());
+                iorpt->Fields(f);
+                Resp = conn->SendMsgBlocking(*iorpt);
+                if (!Resp.Done()) {
+                    delete iorpt;
+                    return ImageTable();
+                }
+                else {
+                    std::vector<std::uint8_t> v = Resp.Payload<std::vector<std::uint8_t>>();
+                    //std::array<std::uint8_t, 16> uuid;
+                    v.resize(16);
+                    std::copy(v.begin(), v.end(), uuid.begin());
+                    ImageTableEntry ite(0, 0, img_len, img_len * 20, 0, uuid, std::string("solo_img"));
+                    imgt->push_back(ite);
+                }
+                delete iorpt;
+            }
+            else {
+                iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::READ, 0);
+                ReportFields f = iorpt->Fields();
+                f.context = 4; // Get Image Table Size
+                f.len = 2;
+                iorpt->Fields(f);
+                DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+                delete iorpt;
+                if (Resp.Done()) {
+                    tbl_size = Resp.Payload<std::uint16_t>();
+                }
+                else return ImageTable();
+
+                for (ImageIndex idx = 0; idx < (int)tbl_size; idx++) {
+                    iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::READ, static_cast<std::uint16_t>(idx));
+                    f = iorpt->Fields();
+                    f.context = static_cast < std::uint8_t>(HostReport::ImageIndexOperations::GET_ENTRY); 
+                    f.len = 49;
+                    iorpt->Fields(f);
+                    Resp = conn->SendMsgBlocking(*iorpt);
+                    delete iorpt;
+                    if (Resp.Done() && !Resp.GeneralError()) {
+                        ImageTableEntry ite(idx, Resp.Payload<std::vector<std::uint8_t>>());
+                        imgt->push_back(ite);
+                    }
+                }
+            }
+            // Return by value
+            return (*imgt);
+
+        }).value_or(ImageTable());
+
+	}
+
+	/* IMAGE TABLE VIEWER */
+	class ImageTableViewer::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem> ims) : m_ims(ims) {}
+
+		std::weak_ptr<IMSSystem> m_ims;
+	};
+
+	ImageTableViewer::ImageTableViewer(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+
+	ImageTableViewer::~ImageTableViewer() { delete p_Impl; p_Impl = nullptr; }
+
+	const int ImageTableViewer::Entries() const
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> int
+        { 
+    		return (int)ims->Ctlr().ImgTable().size();
+        }).value_or(0);
+	}
+
+	const ImageTableEntry ImageTableViewer::operator[](const std::size_t idx) const
+	{
+        std::size_t entries = (std::size_t)this->Entries();
+
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableEntry
+        {         
+            ImageTable t = ims->Ctlr().ImgTable();
+            if (idx < entries) {
+                return *(std::next(t.begin(), idx));
+            }
+            else {
+                return ImageTableEntry();
+            }
+        }).value_or(ImageTableEntry());
+	}
+
+	ImageTableViewer::const_iterator ImageTableViewer::begin() 
+    {
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableViewer::const_iterator
+        {         
+            return ims->Ctlr().ImgTable().begin(); 
+        }).value();  // This can throw a bad_optional_access if m_ims is invalid
+    }
+
+	ImageTableViewer::const_iterator ImageTableViewer::end() { 
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableViewer::const_iterator
+        {   
+            return ims->Ctlr().ImgTable().end(); 
+        }).value();
+    }
+
+	bool ImageTableViewer::Erase(const std::size_t idx)
+	{
+        auto ims = p_Impl->m_ims.lock();
+        if (!ims) return false;
+        auto conn = ims->Connection();
+
+		// Read back ImageTable from iMS Controller
+		if (!ims->Ctlr().IsValid()) return false;
+
+		HostReport* iorpt;
+		IMSController::Capabilities cap = ims->Ctlr().GetCap();
+
+		// Can't delete images in single image controllers. Just download a replacement image.
+		if (!cap.FastImageTransfer) return false;
+
+		if (idx < (std::size_t)this->Entries()) {
+			ImageTable t = ims->Ctlr().ImgTable();
+			ImageTableEntry ite = *(std::next(t.begin(), idx));
+
+			iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
+			ReportFields f = iorpt->Fields();
+			f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::CHECK_UUID);
+			f.len = 16;
+			iorpt->Fields(f);
+
+			std::array<std::uint8_t, 16> uuid = ite.UUID();
+			std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
+			iorpt->Payload<std::vector<std::uint8_t>>(data);
+
+			DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
+			if (!ioresp.Done() || ioresp.GeneralError()) {
+				// Most likely image UUID doesn't exist on Controller.  How did we get out of sync?
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Erase of image index " << idx << " [" << ite.Name() << "] requested but no matching UUID found on Controller.";
+
+				delete iorpt;
+				return false;
+			}
+
+			uint16_t img_idx = ioresp.Payload<uint16_t>();
+			delete iorpt;
+
+			iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, img_idx);
+			f = iorpt->Fields();
+			f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::DEL_ENTRY);
+			f.len = 0;
+			iorpt->Fields(f);
+
+			ioresp = conn->SendMsgBlocking(*iorpt);
+			if (!ioresp.Done() || ioresp.GeneralError()) {
+				// Erase failed. As image must exist (we checked for this above) a DMA operation must be in progress
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Erase of image index " << idx << " [" << ite.Name() << "] failed. Image Upload / Download in progress.";
+
+				delete iorpt;
+				return false;
+			}
+			delete iorpt;
+
+			// Remove from Image Table
+			t.erase(std::next(t.begin(), idx));
+			const IMSController& c = ims->Ctlr();
+			ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), t));
+
+			return true;
+		}
+		BOOST_LOG_SEV(lg::get(), sev::warning) << "Erase of image index " << idx << " failed. Index not found in Image Table";
+		return false;
+	}
+
+	bool ImageTableViewer::Erase(ImageTableEntry ite)
+	{
+		for (int i = 0; i < this->Entries(); i++)
+		{
+			if ((*this)[i].UUID() == ite.UUID())
+				return this->Erase(i);
+		}
+		return false;
+	}
+
+	bool ImageTableViewer::Erase(ImageTableViewer::const_iterator it)
+	{
+		return this->Erase(std::distance(this->begin(), it));
+	}
+
+	bool ImageTableViewer::Clear()
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {  
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+
+            HostReport* iorpt;
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+
+            // Can't delete images in single image controllers. Just download a replacement image.
+            if (!cap.FastImageTransfer) return false;
+
+            // Try an erase all command
+            iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::ERASE_ALL);
+            f.len = 0;
+            iorpt->Fields(f);
+
+            DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
+            delete iorpt;
+            if (!ioresp.Done() || ioresp.GeneralError()) {
+                // Try clearing images individually
+                int images_total = this->Entries();
+                for (int i = 0; i < images_total; i++) {
+                    if (!this->Erase((*this)[0])) {
+                        BOOST_LOG_SEV(lg::get(), sev::error) << "Unable to Clear Image Table";
+                        return false;
+                    }
+                }
+            }
+            // All done OK
+            BOOST_LOG_SEV(lg::get(), sev::info) << "Image Table Cleared";
+
+            // Reset local image table
+            const IMSController& c = ims->Ctlr();
+            ImageTable empty_table;
+            ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), empty_table));
+
+            return true;
+        }).value_or(false);
+	}
+
+	std::ostream& operator <<(std::ostream& stream, const ImageTableViewer& itv) {
+
+		for (int i = 0; i < itv.Entries(); i++) {
+			stream << "Image[" << i << "] id:" << itv[i].Handle() <<
+				" Addr: 0x" << std::setw(8) << std::setfill('0') << std::hex << itv[i].Address() <<
+				" Points: " << std::dec << itv[i].NPts() <<
+				" ByteLength: " << itv[i].Size() <<
+				" Format Code: " << std::hex << itv[i].Format() <<
+				" UUID: ";
+			int j;
+			stream << std::hex;
+			for (j = 0; j < 4; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
+			stream << "-";
+			for (j = 4; j < 6; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
+			stream << "-";
+			for (j = 6; j < 8; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
+			stream << "-";
+			for (j = 8; j < 10; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
+			stream << "-";
+			for (j = 10; j < 16; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
+			stream << " Name: " << itv[i].Name();
+			stream << std::dec << std::endl;
+		}
+		return stream;
+	}
+
+
+	/* IMAGE MEMORY MAP */
+	class ImageMemoryMap::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem> ims, std::uint32_t base, std::uint64_t size, std::uint32_t alignment) :
+			m_ims(ims), m_base(base), m_end(static_cast<std::uint64_t>(base) + size), m_align(alignment ? alignment : 1) {}
+
+		// A half open range of addresses [start, end)
+		struct Span
+		{
+			std::uint64_t start;
+			std::uint64_t end;
+		};
+		// The part of one Image Table entry that lies within Image memory
+		struct Slot
+		{
+			Span span;
+			std::size_t entry;
+		};
+
+		std::weak_ptr<IMSSystem> m_ims;
+		std::uint64_t m_base;
+		std::uint64_t m_end;
+		const std::uint32_t m_align;
+		std::vector<ImageTableEntry> m_entries;
+		std::vector<Slot> m_slots;            // sorted by address
+		mutable int m_msbFirst{ -1 };         // Controller Image format mode, read on first use
+
+		void Build();
+		int MSBFirst(std::shared_ptr<IMSSystem> ims) const;
+		std::uint64_t AlignUp(std::uint64_t addr) const { return ((addr + m_align - 1) / m_align) * m_align; }
+		std::vector<Span> Spans() const;
+		// Finds the lowest aligned address at which 'bytes' fit between the sorted spans in 'used'
+		bool FirstFit(const std::vector<Span>& used, std::uint64_t bytes, std::uint64_t& addr) const;
+		static void Insert(std::vector<Span>& used, const Span& span);
+	};
+
+	int ImageMemoryMap::Impl::MSBFirst(std::shared_ptr<IMSSystem> ims) const
+	{
+		if (m_msbFirst < 0) {
+			// As ImageDownload: bit 0 of the format register indicates MSB first mode is supported and will be used
+			HostReport *iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_FPIFormat);
+			DeviceReport ioresp = ims->Connection()->SendMsgBlocking(*iorpt);
+			delete iorpt;
+			m_msbFirst = (ioresp.Done() && (ioresp.Payload<std::uint16_t>() & 1)) ? 1 : 0;
+		}
+		return m_msbFirst;
+	}
+
+	void ImageMemoryMap::Impl::Build()
+	{
+		m_entries.clear();
+		m_slots.clear();
+
+		auto ims = m_ims.lock();
+		if (!ims || !ims->Ctlr().IsValid() || !ims->Ctlr().GetCap().FastImageTransfer) return;
+
+		const ImageTable& tbl = ims->Ctlr().ImgTable();
+		m_entries.assign(tbl.cbegin(), tbl.cend());
+		for (std::size_t i = 0; i < m_entries.size(); i++) {
+			const std::uint64_t start = std::max<std::uint64_t>(m_entries[i].Address(), m_base);
+			const std::uint64_t end = std::min<std::uint64_t>(static_cast<std::uint64_t>(m_entries[i].Address()) + std::max(m_entries[i].Size(), 0), m_end);
+			if (start < end) m_slots.push_back(Slot{ Span{ start, end }, i });
+		}
+		std::sort(m_slots.begin(), m_slots.end(), [](const Slot& a, const Slot& b) { return a.span.start < b.span.start; });
+	}
+
+	std::vector<ImageMemoryMap::Impl::Span> ImageMemoryMap::Impl::Spans() const
+	{
+		std::vector<Span> used;
+		used.reserve(m_slots.size() + 1);
+		for (const auto& slot : m_slots) used.push_back(slot.span);
+		return used;
+	}
+
+	bool ImageMemoryMap::Impl::FirstFit(const std::vector<Span>& used, std::uint64_t bytes, std::uint64_t& addr) const
+	{
+		std::uint64_t candidate = AlignUp(m_base);
+		for (const auto& span : used) {
+			if (candidate + bytes <= span.start) break;
+			candidate = std::max(candidate, AlignUp(span.end));
+		}
+		if (candidate + bytes > m_end) return false;
+		addr = candidate;
+		return true;
+	}
+
+	void ImageMemoryMap::Impl::Insert(std::vector<Span>& used, const Span& span)
+	{
+		auto it = std::upper_bound(used.begin(), used.end(), span, [](const Span& a, const Span& b) { return a.start < b.start; });
+		used.insert(it, span);
+	}
+
+	ImageMemoryMap::ImageMemoryMap(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims, 0, std::uint64_t(1) << 32, DefaultAlignment))
+	{
+		p_Impl->Build();
+	}
+
+	ImageMemoryMap::ImageMemoryMap(std::shared_ptr<IMSSystem> ims, std::uint32_t base, std::uint64_t size, std::uint32_t alignment) :
+		p_Impl(new Impl(ims, base, size, alignment))
+	{
+		p_Impl->Build();
+	}
+
+	ImageMemoryMap::~ImageMemoryMap() { delete p_Impl; p_Impl = nullptr; }
+
+	void ImageMemoryMap::Refresh()
+	{
+		p_Impl->Build();
+	}
+
+	std::uint64_t ImageMemoryMap::Capacity() const
+	{
+		return p_Impl->m_end - p_Impl->m_base;
+	}
+
+	std::uint64_t ImageMemoryMap::UsedBytes() const
+	{
+		// Entries should never overlap, but count any shared bytes once
+		std::uint64_t used = 0, covered = p_Impl->m_base;
+		for (const auto& slot : p_Impl->m_slots) {
+			const std::uint64_t start = std::max(slot.span.start, covered);
+			if (slot.span.end > start) used += slot.span.end - start;
+			covered = std::max(covered, slot.span.end);
+		}
+		return used;
+	}
+
+	std::uint64_t ImageMemoryMap::FreeBytes() const
+	{
+		return Capacity() - UsedBytes();
+	}
+
+	std::vector<ImageMemoryMap::Region> ImageMemoryMap::FreeRegions() const
+	{
+		std::vector<Region> free;
+		std::uint64_t start = p_Impl->m_base;
+		auto add = [&](std::uint64_t end) {
+			if (end > start) free.push_back(Region{ static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(end - start) });
+		};
+		for (const auto& slot : p_Impl->m_slots) {
+			add(slot.span.start);
+			start = std::max(start, slot.span.end);
+		}
+		add(p_Impl->m_end);
+		return free;
+	}
+
+	std::vector<ImageMemoryMap::Region> ImageMemoryMap::UsedRegions() const
+	{
+		std::vector<Region> used;
+		for (const auto& slot : p_Impl->m_slots) {
+			used.push_back(Region{ static_cast<std::uint32_t>(slot.span.start), static_cast<std::uint32_t>(slot.span.end - slot.span.start) });
+		}
+		return used;
+	}
+
+	std::uint32_t ImageMemoryMap::LargestFree() const
+	{
+		std::uint64_t largest = 0;
+		for (const auto& r : FreeRegions()) {
+			const std::uint64_t start = p_Impl->AlignUp(r.Address);
+			const std::uint64_t end = static_cast<std::uint64_t>(r.Address) + r.Size;
+			if (end > start) largest = std::max(largest, end - start);
+		}
+		return static_cast<std::uint32_t>(std::min<std::uint64_t>(largest, UINT32_MAX));
+	}
+
+	double ImageMemoryMap::Fragmentation() const
+	{
+		const std::uint64_t free = FreeBytes();
+		if (!free) return 0.0;
+		return 1.0 - static_cast<double>(LargestFree()) / static_cast<double>(free);
+	}
+
+	bool ImageMemoryMap::Fits(std::uint64_t bytes) const
+	{
+		std::uint64_t addr;
+		return p_Impl->FirstFit(p_Impl->Spans(), bytes, addr);
+	}
+
+	std::uint64_t ImageMemoryMap::ImageBytes(const Image& img, const ImageFormat& fmt) const
+	{
+		return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> std::uint64_t
+		{
+			if (!img.Size()) return 0;
+
+			// Every point is formatted to the same length
+			Image pt;
+			pt.AddPoint(*img.cbegin());
+			boost::container::deque<std::uint8_t> data;
+			const int bytesPerPoint = FormatImage(pt, ims, data, fmt, p_Impl->MSBFirst(ims));
+
+			// The download is padded to the transfer granularity of the connection
+			const std::uint64_t bytes = static_cast<std::uint64_t>(bytesPerPoint) * img.Size();
+			const std::uint64_t unit = static_cast<std::uint64_t>(std::max(ims->Connection()->MemoryTransferGranularity(), 1));
+			return ((bytes + unit - 1) / unit) * unit;
+		}).value_or(0);
+	}
+
+	bool ImageMemoryMap::Fits(const Image& img, const ImageFormat& fmt) const
+	{
+		for (const auto& ite : p_Impl->m_entries) {
+			if (ite.Matches(img)) return true;
+		}
+		return Fits(ImageBytes(img, fmt));
+	}
+
+	bool ImageMemoryMap::Fits(const Image& img) const
+	{
+		return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+		{
+			return Fits(img, ImageFormat(ims));
+		}).value_or(false);
+	}
+
+	ImageMemoryMap::CompactionPlan ImageMemoryMap::PlanCompaction(std::uint64_t bytes) const
+	{
+		BOOST_LOG_SEV(lg::get(), sev::trace) << "ImageMemoryMap::PlanCompaction(" << bytes << ")";
+
+		CompactionPlan plan;
+		const auto& slots = p_Impl->m_slots;
+		const std::vector<Impl::Span> used = p_Impl->Spans();
+
+		std::uint64_t addr;
+		if (p_Impl->FirstFit(used, bytes, addr)) {
+			plan.Feasible = true;
+			plan.Address = static_cast<std::uint32_t>(addr);
+			return plan;
+		}
+		if (bytes > FreeBytes()) return plan;
+
+		// Try removing each run of adjacent Images [i, j] that leaves a large enough gap behind.  Runs are extended only while
+		// they cost less than the best plan so far, since a longer run frees more space but always costs more to download again.
+		std::uint64_t best = UINT64_MAX;
+		std::vector<std::size_t> order;
+		for (std::size_t i = 0; i < slots.size(); i++) {
+			const std::uint64_t gap_start = (i == 0) ? p_Impl->m_base : slots[i - 1].span.end;
+			std::uint64_t cost = 0;
+			for (std::size_t j = i; j < slots.size(); j++) {
+				cost += slots[j].span.end - slots[j].span.start;
+				if (cost >= best) break;
+
+				const std::uint64_t gap_end = (j + 1 == slots.size()) ? p_Impl->m_end : slots[j + 1].span.start;
+				if (gap_end < p_Impl->AlignUp(gap_start) + bytes) continue;
+
+				// Replay the plan: erase the run, download the new Image, then download the run again, largest first
+				std::vector<Impl::Span> trial(used.begin(), used.begin() + i);
+				trial.insert(trial.end(), used.begin() + j + 1, used.end());
+				std::uint64_t new_addr;
+				if (!p_Impl->FirstFit(trial, bytes, new_addr)) continue;
+				Impl::Insert(trial, Impl::Span{ new_addr, new_addr + bytes });
+
+				order.clear();
+				for (std::size_t k = i; k <= j; k++) order.push_back(k);
+				std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+					return (slots[a].span.end - slots[a].span.start) > (slots[b].span.end - slots[b].span.start);
+				});
+
+				bool placed = true;
+				for (std::size_t k : order) {
+					const std::uint64_t len = slots[k].span.end - slots[k].span.start;
+					if (!p_Impl->FirstFit(trial, len, addr)) {
+						placed = false;
+						break;
+					}
+					Impl::Insert(trial, Impl::Span{ addr, addr + len });
+				}
+				if (!placed) continue;
+
+				best = cost;
+				plan.Feasible = true;
+				plan.RelocateBytes = cost;
+				plan.Address = static_cast<std::uint32_t>(new_addr);
+				plan.Relocate.clear();
+				for (std::size_t k : order) plan.Relocate.push_back(p_Impl->m_entries[slots[k].entry]);
+			}
+		}
+		return plan;
+	}
+
+	/* SEQUENCE COMPACTOR */
+	class SequenceCompactor::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem> ims) : m_ims(ims)
+		{
+			// v1 records hold the repeat count in one byte, v2 records in three
+			m_maxRpts = (ims->Ctlr().GetVersion().major >= 2) ? 0xFFFFFF : UINT8_MAX;
+			m_recSize = SequenceRecordFormatter(ims).RecordSize();
+		}
+
+		std::uint64_t BufferSize(std::size_t entries) const { return SequenceHeaderSize(entries) + entries * m_recSize; }
+
+		// True if 'a' and 'b' are ImageSequenceEntry's that differ only in their repeats
+		static bool Mergeable(const SequenceEntry* a, const SequenceEntry* b);
+
+		std::shared_ptr<IMSSystem> m_ims;
+		int m_maxRpts;
+		std::size_t m_recSize;
+		bool m_fold{ true };
+		Report m_report;
+	};
+
+	bool SequenceCompactor::Impl::Mergeable(const SequenceEntry* a, const SequenceEntry* b)
+	{
+		const ImageSequenceEntry* ia = dynamic_cast<const ImageSequenceEntry*>(a);
+		const ImageSequenceEntry* ib = dynamic_cast<const ImageSequenceEntry*>(b);
+		if ((ia == nullptr) || (ib == nullptr)) return false;
+		if ((ia->NumRpts() < 0) || (ib->NumRpts() < 0)) return false;
+		if (ia == ib) return true;
+
+		for (RFChannel ch = RFChannel::min; ; ch++) {
+			if (ia->GetFrequencyOffset(ch) != ib->GetFrequencyOffset(ch)) return false;
+			if (ch == RFChannel::max) break;
+		}
+		return ((ia->UUID() == ib->UUID()) &&
+			(ia->ExtDiv() == ib->ExtDiv()) &&
+			(ia->IntOsc() == ib->IntOsc()) &&
+			(ia->PostImgDelay() == ib->PostImgDelay()) &&
+			(ia->SyncOutDelay() == ib->SyncOutDelay()));
+	}
+
+	SequenceCompactor::SequenceCompactor(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+
+	SequenceCompactor::~SequenceCompactor() { delete p_Impl; p_Impl = nullptr; }
+
+	void SequenceCompactor::FoldRepeats(bool enable)
+	{
+		p_Impl->m_fold = enable;
+	}
+
+	const SequenceCompactor::Report& SequenceCompactor::LastReport() const
+	{
+		return p_Impl->m_report;
+	}
+
+	ImageSequence SequenceCompactor::Compact(const ImageSequence& seq)
+	{
+		Report& report = p_Impl->m_report;
+		report = Report();
+
+		std::vector<std::shared_ptr<SequenceEntry>> entries(seq.cbegin(), seq.cend());
+		std::size_t n = entries.size();
+		report.EntriesBefore = n;
+		report.BytesBefore = p_Impl->BufferSize(n);
+
+		// The part of the sequence that plays again when it reaches the end, if any
+		std::size_t loop = n;
+		if (seq.TermAction() == SequenceTermAction::REPEAT) loop = 0;
+		else if ((seq.TermAction() == SequenceTermAction::REPEAT_FROM) && (seq.TermValue() >= 0) && ((std::size_t)seq.TermValue() < n)) {
+			loop = seq.TermValue();
+		}
+
+		// If that part is several copies of a shorter pattern, one copy plays the same
+		if (p_Impl->m_fold && (n - loop > 1)) {
+			const std::size_t len = n - loop;
+			for (std::size_t period = 1; period <= len / 2; period++) {
+				if (len % period) continue;
+				std::size_t i = loop + period;
+				while ((i < n) && ((entries[i] == entries[i - period]) || (*entries[i] == *entries[i - period]))) i++;
+				if (i == n) {
+					report.FoldedEntries = len - period;
+					n = loop + period;
+					break;
+				}
+			}
+		}
+
+		ImageSequence out;
+		if (seq.TermInsertBefore() != nullptr) out.OnTermination(seq.TermAction(), seq.TermInsertBefore());
+		else out.OnTermination(seq.TermAction(), seq.TermValue());
+
+		// Merge each run of identical Images into one entry, never across the start of the repeating part
+		std::size_t loop_out = 0;
+		std::size_t first = 0;
+		while (first < n) {
+			std::size_t last = first + 1;
+			int rpts = entries[first]->NumRpts();
+			while ((last < n) && (last != loop) &&
+				Impl::Mergeable(entries[first].get(), entries[last].get()) &&
+				((std::int64_t)rpts + entries[last]->NumRpts() + 1 <= p_Impl->m_maxRpts)) {
+				rpts += entries[last]->NumRpts() + 1;
+				last++;
+			}
+
+			if (first == loop) loop_out = out.size();
+			report.FirstEntry.push_back(first);
+			if (last - first > 1) {
+				const ImageSequenceEntry& ise = dynamic_cast<const ImageSequenceEntry&>(*entries[first]);
+				out.push_back(std::make_shared<ImageSequenceEntry>(ise, ImageRepeats::PROGRAM, rpts));
+				report.MergedRuns++;
+			}
+			else {
+				out.push_back(entries[first]);
+			}
+			first = last;
+		}
+		if ((seq.TermAction() == SequenceTermAction::REPEAT_FROM) && (loop < n)) {
+			out.OnTermination(SequenceTermAction::REPEAT_FROM, (int)loop_out);
+		}
+
+		report.EntriesAfter = out.size();
+		report.BytesAfter = p_Impl->BufferSize(out.size());
+
+		BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence compacted from " << report.EntriesBefore << " to " << report.EntriesAfter << " entries ("
+			<< report.BytesBefore << " to " << report.BytesAfter << " bytes)";
+		return out;
+	}
+
+
+	/* SEQUENCE IMAGE REGISTRY */
+	// Returns the UUIDs of the Images an ImageSequence or CompactSequence plays, each once.  Tone buffer entries
+	// don't occupy Image memory.
+	static std::vector<std::array<std::uint8_t, 16>> SequenceImageUUIDs(const ImageSequence& seq)
+	{
+		std::vector<std::array<std::uint8_t, 16>> images;
+		for (auto it = seq.cbegin(); it != seq.cend(); ++it) {
+			if (std::dynamic_pointer_cast<ImageSequenceEntry>(*it) == nullptr) continue;
+			if (std::find(images.cbegin(), images.cend(), (*it)->UUID()) == images.cend()) images.push_back((*it)->UUID());
+		}
+		return images;
+	}
+
+	static std::vector<std::array<std::uint8_t, 16>> SequenceImageUUIDs(const CompactSequence& seq)
+	{
+		std::vector<std::array<std::uint8_t, 16>> images;
+		for (std::size_t i = 0; i < seq.EntryCount(); i++) {
+			const auto& entry = seq.Entry(i);
+			if (std::dynamic_pointer_cast<ImageSequenceEntry>(entry) == nullptr) continue;
+			if (std::find(images.cbegin(), images.cend(), entry->UUID()) == images.cend()) images.push_back(entry->UUID());
+		}
+		return images;
+	}
+
+	// The Controller's sequence queue only reports the UUID of each sequence, so the Images each sequence plays are
+	// recorded here as it is downloaded, for ImageCache to keep resident while the sequence is queued.  Like the
+	// shadow registries, entries recorded before a system was last connected or disconnected are discarded.
+	class SequenceImageRegistry
+	{
+	public:
+		using UUID = std::array<std::uint8_t, 16>;
+
+		static SequenceImageRegistry& Instance()
+		{
+			static SequenceImageRegistry reg;
+			return reg;
+		}
+
+		void Record(std::shared_ptr<IMSSystem> ims, const UUID& seq, std::vector<UUID> images)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_systems.end()) {
+				it = m_systems.emplace(ims.get(), Entry{ ims, ims->ConnectionEpoch(), {} }).first;
+			}
+			it->second.sequences[seq] = Sequence{ std::move(images), ++m_stamp };
+		}
+
+		bool Get(std::shared_ptr<IMSSystem> ims, const UUID& seq, std::vector<UUID>& images)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_systems.end()) return false;
+			auto s = it->second.sequences.find(seq);
+			if (s == it->second.sequences.end()) return false;
+			images = s->second.images;
+			return true;
+		}
+
+		// Returns a stamp to pass to Retain(), taken before the queue is read
+		std::uint64_t Stamp()
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			return m_stamp;
+		}
+
+		// Forgets the sequences that have left the queue.  Those recorded after 'stamp' may not have been in the
+		// queue when it was read, so are kept.
+		void Retain(std::shared_ptr<IMSSystem> ims, const std::vector<UUID>& queue, std::uint64_t stamp)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_systems.end()) return;
+			auto& seqs = it->second.sequences;
+			for (auto s = seqs.begin(); s != seqs.end(); ) {
+				if ((s->second.stamp <= stamp) && (std::find(queue.cbegin(), queue.cend(), s->first) == queue.cend())) s = seqs.erase(s);
+				else ++s;
+			}
+		}
+
+	private:
+		struct Sequence
+		{
+			std::vector<UUID> images;
+			std::uint64_t stamp;
+		};
+		struct Entry
+		{
+			std::weak_ptr<IMSSystem> owner;
+			std::uint32_t epoch;
+			std::map<UUID, Sequence> sequences;
+		};
+		using SystemMap = std::map<const IMSSystem*, Entry>;
+
+		// Finds the entry for a system, discarding any left by a destroyed system at the same address
+		// or recorded before the system was last connected or disconnected
+		SystemMap::iterator Find(std::shared_ptr<IMSSystem> ims)
+		{
+			auto it = m_systems.find(ims.get());
+			if ((it != m_systems.end()) && ((it->second.owner.lock() != ims) || (it->second.epoch != ims->ConnectionEpoch()))) {
+				m_systems.erase(it);
+				return m_systems.end();
+			}
+			return it;
+		}
+
+		std::mutex m_mutex;
+		SystemMap m_systems;
+		std::uint64_t m_stamp{ 0 };
+	};
+
+	/* SEQUENCE DOWNLOADER */
+	class SequenceDownloadEventTrigger :
+		public IEventTrigger
+	{
+	public:
+		SequenceDownloadEventTrigger() { updateCount(DownloadEvents::Count); }
+		~SequenceDownloadEventTrigger() {};
+	};
+
+	class SequenceDownload::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem>, const ImageSequence*, const CompactSequence*);
+		~Impl();
+
+        LazyWorker downloadWorker;
+
+		std::weak_ptr<IMSSystem> m_ims;
+
+		// The sequence to download is one or the other
+		const ImageSequence* m_Seq;
+		const CompactSequence* m_Compact;
+		std::size_t SeqSize() const { return m_Compact ? m_Compact->size() : m_Seq->size(); }
+		std::array<std::uint8_t, 16> SeqUUID() const { return m_Compact ? m_Compact->GetUUID() : m_Seq->GetUUID(); }
+		SequenceTermAction SeqTermAction() const { return m_Compact ? m_Compact->TermAction() : m_Seq->TermAction(); }
+		int SeqTermValue() const { return m_Compact ? m_Compact->TermValue() : m_Seq->TermValue(); }
+		const ImageSequence* SeqTermInsertBefore() const { return m_Compact ? m_Compact->TermInsertBefore() : m_Seq->TermInsertBefore(); }
+		std::vector<std::array<std::uint8_t, 16>> SeqImages() const { return m_Compact ? SequenceImageUUIDs(*m_Compact) : SequenceImageUUIDs(*m_Seq); }
+
+		const std::unique_ptr<boost::container::deque<std::uint8_t>> m_seqdata;
+		std::unique_ptr<SequenceDownloadEventTrigger> m_Event;
+
+		// m_seqdata is kept as a formatted shadow of the sequence last downloaded, with the entry each record was
+		// formatted from and the position of the record in the buffer, so that an edited sequence need only have
+		// its new entries formatted
+		std::vector<std::shared_ptr<SequenceEntry>> m_shadowEntries;
+		std::vector<std::size_t> m_shadowOffsets;
+		bool m_shadowValid{ false };
+		int FormatShadow(std::shared_ptr<IMSSystem> ims, bool incremental);
+
+		class ResponseReceiver : public IEventHandler
+		{
+		public:
+			ResponseReceiver(SequenceDownload::Impl* pl) : m_parent(pl) { Init(); };
+			void EventAction(void* sender, const int message, const int param);
+			void Init() { done.reset(); error.store(false); success_code = 0; error_code = 0; }
+			bool IsBusy() const { return !done.is_set(); }
+			void Wait() const { done.wait(); }
+			bool HasError() const { return error.load(); }
+			int SuccessCode() const { return success_code; }
+			int ErrorCode() const { return error_code; }
+		private:
+			SequenceDownload::Impl* m_parent;
+			CompletionSignal done;
+			std::atomic_bool error;
+			int error_code;
+			int success_code;
+		};
+		ResponseReceiver* Receiver;
+
+		DMASupervisor* dmah;
+
+        bool downloadRequested{ false };
+        bool incrementalRequested{ false };
+        void DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+ 
+		// Capability flags
+		bool fast_seq_dl_supported{ false };
+		bool large_seq_supported{ false };
+	};
+
+	SequenceDownload::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageSequence* seq, const CompactSequence* compact) :
+		m_ims(ims), m_Seq(seq), m_Compact(compact),
+		m_seqdata(new boost::container::deque<std::uint8_t>()),
+		Receiver(new ResponseReceiver(this)),
+		m_Event(new SequenceDownloadEventTrigger()),
+		dmah(new DMASupervisor()),
+        downloadWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+            DownloadWorkerLoop(running, cond, mtx);
+        })
+	{
+		fast_seq_dl_supported = false;
+		large_seq_supported = false;
+
+		// Subscribe listener
+		auto conn = ims->Connection();
+		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
+			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+			int IntrMask = (int)((1 << CTRLR_INTERRUPT_SEQDL_ERROR) | (1 << CTRLR_INTERRUPT_SEQDL_COMPLETE) | (1 << CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED));
+
+			HostReport* iorpt;
+			iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
+			iorpt->Payload<int>(IntrMask);
+			ReportFields f = iorpt->Fields();
+			f.len = sizeof(IntrMask);
+			iorpt->Fields(f);
+			conn->SendMsg(*iorpt);
+			delete iorpt;
+		}
+
+		conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
+	}
+
+	SequenceDownload::Impl::~Impl() 
+	{
+        with_locked(m_ims, [&](std::shared_ptr<IMSSystem> ims) {         
+            // Unsubscribe listener
+            auto conn = ims->Connection();
+            if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
+                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+                int IntrMask = ~(int)((1 << CTRLR_INTERRUPT_SEQDL_ERROR) | (1 << CTRLR_INTERRUPT_SEQDL_COMPLETE) | (1 << CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED));
+
+                HostReport* iorpt;
+                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
+                iorpt->Payload<int>(IntrMask);
+                ReportFields f = iorpt->Fields();
+                f.len = sizeof(IntrMask);
+                iorpt->Fields(f);
+                ims->Connection()->SendMsg(*iorpt);
+                delete iorpt;
+            }
+
+            conn->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
+        });
+
+		delete dmah;
+		delete Receiver;
+	}
+
+	SequenceDownload::SequenceDownload(std::shared_ptr<IMSSystem> ims, const ImageSequence& seq) : p_Impl(new Impl(ims, &seq, nullptr)) {}
+
+	SequenceDownload::SequenceDownload(std::shared_ptr<IMSSystem> ims, const CompactSequence& seq) : p_Impl(new Impl(ims, nullptr, &seq)) {}
+
+	SequenceDownload::~SequenceDownload() { delete p_Impl; p_Impl = nullptr; }
+
+	int SequenceDownload::Impl::FormatShadow(std::shared_ptr<IMSSystem> ims, bool incremental)
+	{
+		if (m_Compact != nullptr) {
+			// Always formatted in full, which costs little more than a copy of each record played
+			m_shadowValid = false;
+			m_shadowEntries.clear();
+			m_shadowOffsets.clear();
+			return FormatSequenceBuffer(*m_Compact, ims, *m_seqdata, &m_shadowOffsets);
+		}
+
+		std::vector<std::shared_ptr<SequenceEntry>> entries(m_Seq->cbegin(), m_Seq->cend());
+		const std::size_t n_old = m_shadowEntries.size();
+		const std::size_t n_new = entries.size();
+
+		// Start again if the header changes length
+		if (!incremental || !m_shadowValid || ((n_old <= UINT16_MAX) != (n_new <= UINT16_MAX))) {
+			m_shadowValid = false;
+			m_shadowEntries.clear();
+			m_shadowOffsets.clear();
+			if (!FormatSequenceBuffer(*m_Seq, ims, *m_seqdata, &m_shadowOffsets)) return 0;
+			m_shadowEntries.swap(entries);
+			m_shadowValid = true;
+			return (int)m_seqdata->size();
+		}
+
+		// Entries are matched by identity.  Only those between the first and last differences are formatted.
+		std::size_t head = 0;
+		while ((head < n_old) && (head < n_new) && (m_shadowEntries[head] == entries[head])) head++;
+		std::size_t tail = 0;
+		while ((tail < n_old - head) && (tail < n_new - head) && (m_shadowEntries[n_old - 1 - tail] == entries[n_new - 1 - tail])) tail++;
+
+		const SequenceRecordFormatter fmt(ims);
+		std::vector<const SequenceEntry*> changed;
+		for (std::size_t i = head; i < n_new - tail; i++) changed.push_back(entries[i].get());
+		std::vector<std::uint8_t> records(changed.size() * fmt.RecordSize());
+		if (!FormatSequenceRecords(changed, 0, changed.size(), fmt, records.begin())) {
+			m_shadowValid = false;
+			return 0;
+		}
+
+		// Splice the new records in place of those of the entries removed
+		const std::size_t first = (head < n_old) ? m_shadowOffsets[head] : m_seqdata->size();
+		const std::size_t last = (tail > 0) ? m_shadowOffsets[n_old - tail] : m_seqdata->size();
+		auto pos = m_seqdata->erase(m_seqdata->begin() + first, m_seqdata->begin() + last);
+		m_seqdata->insert(pos, records.begin(), records.end());
+
+		std::vector<std::size_t> newOffsets;
+		newOffsets.reserve(n_new);
+		newOffsets.insert(newOffsets.end(), m_shadowOffsets.begin(), m_shadowOffsets.begin() + head);
+		for (std::size_t i = 0; i < changed.size(); i++) newOffsets.push_back(first + i * fmt.RecordSize());
+		for (std::size_t i = n_old - tail; i < n_old; i++) newOffsets.push_back(m_shadowOffsets[i] + records.size() - (last - first));
+		m_shadowOffsets.swap(newOffsets);
+		m_shadowEntries.swap(entries);
+
+		// New entry count
+		boost::container::deque<std::uint8_t> hdr;
+		FormatSequenceHeader(n_new, hdr);
+		std::copy(hdr.begin(), hdr.end(), m_seqdata->begin());
+
+		return (int)m_seqdata->size();
+	}
+
+	bool SequenceDownload::Download(bool asynchronous)
+	{
+		return Transfer(asynchronous, false);
+	}
+
+	bool SequenceDownload::Redownload(bool asynchronous)
+	{
+		return Transfer(asynchronous, true);
+	}
+
+	bool SequenceDownload::Transfer(bool asynchronous, bool incremental)
+	{
+        auto ims = p_Impl->m_ims.lock();
+        if (!ims) return false;
+        auto conn = ims->Connection();
+
+		// Make sure Controller is present
+		if (!ims->Ctlr().IsValid()) return false;
+		int entries = (int)p_Impl->SeqSize();
+
+		HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
+		ReportFields f = iorpt->Fields();
+		f.context = 0;
+		f.len = 3;
+		iorpt->Fields(f);
+		DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+		delete iorpt;
+
+		if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 2) {}
+		else {
+			if (Resp.Fields().len > 2) {
+				if (Resp.Payload<std::vector<std::uint8_t>>().at(2) != 0) {
+					p_Impl->fast_seq_dl_supported = true;
+				}
+			}
+			if (Resp.Fields().len > 3) {
+				if (Resp.Payload<std::vector<std::uint8_t>>().at(3) != 0) {
+					p_Impl->large_seq_supported = true;
+				}
+			}
+		}
+
+		if (p_Impl->fast_seq_dl_supported && asynchronous) {
+            p_Impl->downloadWorker.start();
+
+            int retries=10;
+            while (retries)
+            {
+                std::unique_lock<std::mutex> lck{ p_Impl->downloadWorker.mutex(), std::try_to_lock };
+
+                if (!lck.owns_lock()) {
+                    if (!--retries) {
+    					BOOST_LOG_SEV(lg::get(), sev::warning) << "Sequence Download busy - try again later";
+                        return false;
+                    }
+                    // Mutex lock failed, Downloader must be busy, try again later
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+                p_Impl->downloadRequested = true;
+                p_Impl->incrementalRequested = incremental;
+                lck.unlock();
+
+                break;
+            }
+
+			p_Impl->downloadWorker.notify();
+			return true;
+		}
+
+		/* Create a new sequence */
+		/* Payload
+		* [15:0] = Sequence UUID
+		* [17:16] = number of entries in sequence
+		*/
+		iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+		f = iorpt->Fields();
+		f.context = 0;
+		iorpt->Fields(f);
+		std::array<std::uint8_t, 16> uuid = p_Impl->SeqUUID();
+		std::vector<std::uint8_t> v(uuid.begin(), uuid.begin() + 16);
+		v.push_back(entries & 0xff);
+		v.push_back(entries >> 8);
+		iorpt->Payload<std::vector<std::uint8_t>>(v);
+		Resp = conn->SendMsgBlocking(*iorpt);
+		if (!Resp.Done() || Resp.GeneralError()) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence creation failed.  Insufficient device memory for sequence entries";
+			p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
+			delete iorpt;
+			return false;
+		}
+		delete iorpt;
+
+		// Entries are sent one at a time from the formatted shadow
+		std::unique_lock<std::mutex> shadowlck{ p_Impl->downloadWorker.mutex() };
+		if (p_Impl->FormatShadow(ims, incremental) == 0) {
+			return false;
+		}
+
+		int entry = 0;
+		for (std::size_t off : p_Impl->m_shadowOffsets) {
+			iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, entry);
+			f = iorpt->Fields();
+
+			// Record: type, length, entry payload
+			auto rec = p_Impl->m_seqdata->cbegin() + off;
+			f.context = rec[0];
+			v.assign(rec + 2, rec + 2 + rec[1]);
+			iorpt->Fields(f);
+
+			iorpt->Payload<std::vector<std::uint8_t>>(v);
+			Resp = conn->SendMsgBlocking(*iorpt);
+			if (!Resp.Done() || Resp.GeneralError()) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence creation failed.  Error on sequence entry " << entry;
+				p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, entry);
+				delete iorpt;
+				return false;
+			}
+			entry++;
+			delete iorpt;
+		}
+
+		/* Commit Sequence */
+		/* Payload:
+		* [0] = termination type
+		* [4:1] = termination value
+		* [20:5] = termination tag (for Insert mode)
+		*/
+		iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+		f = iorpt->Fields();
+		f.context = 2;
+		iorpt->Fields(f);
+		v.clear();
+		v.push_back(static_cast<std::uint8_t>(p_Impl->SeqTermAction()));
+		std::uint32_t term_val = p_Impl->SeqTermValue();
+		v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
+		v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
+		v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
+		v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
+
+		if (p_Impl->SeqTermInsertBefore() != nullptr) {
+			const std::array<uint8_t, 16> term_tag = p_Impl->SeqTermInsertBefore()->GetUUID();
+			v.insert(v.end(), term_tag.begin(), term_tag.begin() + 16);
+		}
+
+		iorpt->Payload<std::vector<std::uint8_t>>(v);
+		Resp = conn->SendMsgBlocking(*iorpt);
+		if (!Resp.Done() || Resp.GeneralError()) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence commit failed.";
+			p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, 0);
+			delete iorpt;
+			return false;
+		}
+		delete iorpt;
+		SequenceImageRegistry::Instance().Record(ims, p_Impl->SeqUUID(), p_Impl->SeqImages());
+
+		// A caller that asked for an asynchronous download waits for an event whichever path was taken
+		if (asynchronous) {
+			p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FINISHED, 0);
+		}
+		return true;
+	}
+
+
+	void SequenceDownload::SequenceDownloadEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+	}
+
+	void SequenceDownload::SequenceDownloadEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
+	}
+
+	// Sequence Downloading Thread
+	void SequenceDownload::Impl::DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	{
+		HostReport* iorpt;
+
+		while (true) {
+			std::unique_lock<std::mutex> lck{ mtx };
+			cond.wait(lck, [this, &running]() {
+                return downloadRequested || !running;
+            });
+
+			// Allow thread to terminate 
+			if (!running) break;
+            downloadRequested = false;
+
+            auto ims = m_ims.lock();
+            if (!ims) break;
+            auto conn = ims->Connection();
+
+			// Create Byte Vector
+			std::uint32_t BytesInSequenceBuffer = FormatShadow(ims, incrementalRequested);
+			if (BytesInSequenceBuffer == 0) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "FormatSequenceBuffer: Unable to create sequence buffer";
+				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
+				continue;
+			}
+
+			/* Attempt to Create a new sequence */
+			/* Payload
+			* [15:0] = Sequence UUID
+			* [17:16] = number of entries in sequence
+			* [18] = Use fast fownload
+			* [22:19] = Download size (bytes)
+			* 
+			* OR: (for large sequence supporting firmware)
+			* 
+			* [15:0] = Sequence UUID
+			* [17:16] = set to zero
+			* [18] = Use fast fownload = 1
+			* [22:19] = Download size (bytes)
+			* [26:23] = number of entries in sequence
+			*
+			*/
+			int entries = (int)SeqSize();
+			iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+			ReportFields f = iorpt->Fields();
+			f.context = 0;
+			iorpt->Fields(f);
+			std::array<std::uint8_t, 16> uuid = SeqUUID();
+			std::vector<std::uint8_t> v(uuid.begin(), uuid.begin() + 16);
+			if (entries <= (int)UINT16_MAX) {
+			v.push_back(entries & 0xff);
+			v.push_back(entries >> 8);
+			}
+			else {
+				v.push_back(0);
+				v.push_back(0);
+			}
+			v.push_back(1);
+			v.push_back(BytesInSequenceBuffer & 0xff);
+			v.push_back((BytesInSequenceBuffer >> 8) & 0xff);
+			v.push_back((BytesInSequenceBuffer >> 16) & 0xff);
+			v.push_back((BytesInSequenceBuffer >> 24) & 0xff);
+			if (entries > (int)UINT16_MAX) {
+				v.push_back(entries & 0xff);
+				v.push_back((entries >> 8) & 0xff);
+				v.push_back((entries >> 16) & 0xff);
+				v.push_back((entries >> 24) & 0xff);
+			}
+			iorpt->Payload<std::vector<std::uint8_t>>(v);
+			DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+			if (!Resp.Done() || Resp.GeneralError()) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download (DownloadWorker): Sequence creation failed.  Insufficient device memory for sequence entries";
+				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
+				delete iorpt;
+				continue;
+			}
+			delete iorpt;
+
+			if (Resp.Fields().len < 4) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download (DownloadWorker): Sequence creation failed.  iMS failed to provide download memory address";
+				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
+				continue;
+			}
+				
+			std::uint32_t SeqMemoryAddress = Resp.Payload < std::uint32_t >();
+			std::uint32_t SeqMemoryLength = 0x1000000;
 
-		while (!m_parent->progressHandle.empty() && 
-			((NullMessage == m_parent->progressHandle.front()) || (param > (m_parent->progressHandle.front())))) m_parent->progressHandle.pop();
-		if (ims->Ctlr().Model() == "iMSP" && ims->Ctlr().GetVersion().revision <= 46) {
-			while (!m_parent->finishHandle.empty() &&
-				((NullMessage == m_parent->finishHandle.front()) || (param > (m_parent->finishHandle.front())))) m_parent->finishHandle.pop();
-		}
-		switch (message)
-		{
-		case (MessageEvents::INTERRUPT_RECEIVED): {
-			unsigned int type = (param >> 16);
-	
-			if (type == CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED) {
-				std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
-				m_parent->ImagePlaying = false;
-				m_parent->m_bkcond.notify_one();
-				lck.unlock();
+			if (Resp.Fields().len >= 8) {
+				SeqMemoryLength = Resp.Payload < std::vector <std::uint32_t> >().at(1);
 			}
+			BOOST_LOG_SEV(lg::get(), sev::trace) << "Download Buffer " << SeqMemoryLength << " bytes @ 0x" << std::hex << SeqMemoryAddress << std::dec;
 
-			break;
-		}
+			// Start memory download
+			int tfr_size = 0;
+			bool failed = false;
+			boost::container::deque<std::uint8_t>::iterator bufs = m_seqdata->begin();
+			boost::container::deque<std::uint8_t>::iterator bufe = m_seqdata->end();
 
-		case (MessageEvents::RESPONSE_RECEIVED) :
-		case (MessageEvents::RESPONSE_ERROR_VALID) : {
+			//boost::container::deque<std::uint8_t> copy_buf;
 
-			{
-				if ((!m_parent->progressHandle.empty()) && (param == m_parent->progressHandle.front()))
-				{
-					auto object = static_cast<IConnectionManager*>(sender);
-					IOReport resp = object->Response(param);
+			do {
+				dmah->Reset();
+				Receiver->Init();
 
-					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
-					if (ims->Ctlr().GetCap().FastImageTransfer) {
-						m_parent->latestProgress = resp.Payload<std::uint32_t>();
+				if (m_seqdata->size() > SeqMemoryLength) {
+					if ((m_seqdata->size() - tfr_size) <= SeqMemoryLength)
+					{
+						bufe = m_seqdata->end();
 					}
-					else {
-						m_parent->latestProgress = resp.Payload<std::uint16_t>();
+					else
+					{
+						bufe = bufs + SeqMemoryLength;
 					}
-					m_parent->progressHandle.pop();
-					m_parent->m_bkcond.notify_one();
-					lck.unlock();  // Wait until thread is not consuming the mutex (might be in timeout loop) before notifying
-					//std::cout << "Recvd " << param << std::endl;
-
 				}
-				if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) break;
-				else if ((!m_parent->finishHandle.empty()) && (param == m_parent->finishHandle.front()))
-				{
-					auto object = static_cast<IConnectionManager*>(sender);
-					IOReport resp = object->Response(param);
+				boost::container::deque<std::uint8_t> copy_buf(boost::make_move_iterator(bufs), boost::make_move_iterator(bufe));
+				if (!conn->MemoryDownload(copy_buf, SeqMemoryAddress, 0, uuid)) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Unable to start sequence memory download";
+					m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, -1);
+					failed = true;
+					break;
+				}
+				uuid[0]++;
 
-					std::uint16_t ctrl = resp.Payload<std::uint16_t>();
-					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
-					m_parent->finishHandle.pop();
-					if (!(ctrl & CTRLR_REG_Img_Ctrl_IOS_Busy)) {
-						m_parent->ImagePlaying = false;
-						m_parent->m_bkcond.notify_one();
-					}
-					lck.unlock();
+				dmah->Wait();
+
+				tfr_size += dmah->GetTransferredSize();
+				BOOST_LOG_SEV(lg::get(), sev::info) << "Memory Download complete. Transferred " << tfr_size << " bytes.";
+
+				Receiver->Wait();
+
+				if (Receiver->HasError()) {
+					BOOST_LOG_SEV(lg::get(), sev::error) << "Error in sequence download";
+					m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, Receiver->ErrorCode());
+					failed = true;
+					break;
 				}
+
+				bufs += dmah->GetTransferredSize();
+			} while (tfr_size < m_seqdata->size());
+
+			if (failed) {
+				// DOWNLOAD_ERROR has been raised.  A sequence only partly transferred is not committed.
 			}
-			break;
-		}
-		case (MessageEvents::TIMED_OUT_ON_SEND) :
-		case (MessageEvents::SEND_ERROR) :
-		case (MessageEvents::RESPONSE_TIMED_OUT) :
-		case (MessageEvents::RESPONSE_ERROR_CRC) :
-		case (MessageEvents::RESPONSE_ERROR_INVALID) : {
+			else if (tfr_size > 0) {
+				BOOST_LOG_SEV(lg::get(), sev::trace) << "Seq Download Commit";
+				// Transfer complete.  Commit sequence
+				/* Commit Sequence */
+				/* Payload:
+				* [0] = termination type
+				* [4:1] = termination value
+				* [20:5] = termination tag (for Insert mode)
+				*/
+				iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+				f = iorpt->Fields();
+				f.context = 2;
+				iorpt->Fields(f);
+				v.clear();
+				v.push_back(static_cast<std::uint8_t>(SeqTermAction()));
+				std::uint32_t term_val = SeqTermValue();
+				v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
+				v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
+				v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
+				v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
 
-			{
-				if ((!m_parent->progressHandle.empty()) && (param == m_parent->progressHandle.front()))
-				{
-					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
-					m_parent->progressHandle.pop();
-					lck.unlock();
-				}
-				if ((!m_parent->finishHandle.empty()) && (param == m_parent->finishHandle.front()))
-				{
-					std::unique_lock<std::mutex> lck{ m_parent->m_bkmutex };
-					m_parent->finishHandle.pop();
-					lck.unlock();
+				if (SeqTermInsertBefore() != nullptr) {
+					const std::array<uint8_t, 16> term_tag = SeqTermInsertBefore()->GetUUID();
+					v.insert(v.end(), term_tag.begin(), term_tag.begin() + 16);
 				}
-				break;
+
+				iorpt->Payload<std::vector<std::uint8_t>>(v);
+				conn->SendMsg(*iorpt);
+				delete iorpt;
+				SequenceImageRegistry::Instance().Record(ims, SeqUUID(), SeqImages());
+
+				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FINISHED, tfr_size);
 			}
-		}
+			else {
+//				std::cout << "Seq Download FAIL" << std::endl;
+				// Problem with DMA Transfer
+				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, tfr_size);
+			}
+
+			// Release lock, wait for next download trigger
+			lck.unlock();
 		}
 	}
 
-	// Notify application when something happens
-	void ImagePlayer::ImagePlayerEventSubscribe(const int message, IEventHandler* handler)
+	void SequenceDownload::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
 	{
-		p_Impl->m_Event->Subscribe(message, handler);
-
-        auto ims = p_Impl->m_ims.lock();
-        if (!ims) return;
-        auto conn = ims->Connection();
-
-		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
-			int IntrMask;
-			if (message == ImagePlayerEvents::IMAGE_FINISHED) {
-				IntrMask = (int)(1 << CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED);
-				HostReport *iorpt;
-				iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
-				iorpt->Payload<int>(IntrMask);
-				ReportFields f = iorpt->Fields();
-				f.len = sizeof(IntrMask);
-				iorpt->Fields(f);
-				ims->Connection()->SendMsg(*iorpt);
-				delete iorpt;
+		switch (message)
+		{
+		case (MessageEvents::INTERRUPT_RECEIVED):
+			unsigned int type = (param >> 16);
+			int value = (param & 0xffff);
+			switch (type) {
+			case (CTRLR_INTERRUPT_SEQDL_ERROR): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download ERROR Event Trigger";
+//				std::cout << "Seq Download Error" << std::endl;
+				error.store(true); error_code = value; done.set();
+			}
+			break;
+			case (CTRLR_INTERRUPT_SEQDL_COMPLETE): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download Complete Event Trigger";
+//				std::cout << "Seq Download Complete" << std::endl;
+				error.store(false); success_code = value; done.set();
+			}
+			break;
+			case (CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download Buffer Processed Event Trigger";
+//				std::cout << "Seq Download Complete" << std::endl;
+				error.store(false); done.set();
+			}
+			break;
 			}
+			break;
 		}
 	}
 
-	void ImagePlayer::ImagePlayerEventUnsubscribe(const int message, const IEventHandler* handler)
+
+	/* SEQUENCE MANAGER */
+	class SequenceEventTrigger :
+		public IEventTrigger
 	{
-		p_Impl->m_Event->Unsubscribe(message, handler);
+	public:
+		SequenceEventTrigger() { updateCount(SequenceEvents::Count); }
+		~SequenceEventTrigger() {};
+	};
 
-        auto ims = p_Impl->m_ims.lock();
-        if (!ims) return;
-        auto conn = ims->Connection();
 
-		if (!p_Impl->m_Event->Subscribers(message) && (message == ImagePlayerEvents::IMAGE_FINISHED)) {
-			int IntrMask = (int)~(1 << CTRLR_INTERRUPT_SINGLE_IMAGE_FINISHED);
-			HostReport *iorpt;
-			iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
-			iorpt->Payload<int>(IntrMask);
-			ReportFields f = iorpt->Fields();
-			f.len = sizeof(IntrMask);
-			iorpt->Fields(f);
-			ims->Connection()->SendMsg(*iorpt);
-			delete iorpt;
+	class SequenceManager::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem>);
+		~Impl();
+
+		std::unique_ptr<SequenceEventTrigger> m_Event;
+		class ResponseReceiver : public IEventHandler
+		{
+		public:
+			ResponseReceiver(SequenceManager::Impl* pl) : m_parent(pl) {};
+			void EventAction(void* sender, const int message, const int param);
+			//void EventAction(void* sender, const int message, const int param, const int param2);
+			void EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
+		private:
+			SequenceManager::Impl* m_parent;
+		};
+		ResponseReceiver* Receiver;
+
+		std::weak_ptr<IMSSystem> m_ims;
+	};
+
+	SequenceManager::Impl::Impl(std::shared_ptr<IMSSystem> ims) :
+		m_Event(new SequenceEventTrigger()),
+		Receiver(new ResponseReceiver(this)),
+		m_ims(ims)
+	{
+		// Subscribe listener
+		auto conn = ims->Connection();
+		if (ims->Ctlr().GetVersion().revision > 46) {
+			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
 		}
+
 	}
 
-	void ImagePlayer::Impl::BackgroundWorker()
+	SequenceManager::Impl::~Impl() 
 	{
-		bool ImagePlaying_last = false;
-		std::unique_lock<std::mutex> lck{ m_bkmutex };
-		std::chrono::time_point<std::chrono::high_resolution_clock> last_progress_check = std::chrono::high_resolution_clock::now();
+        with_locked(m_ims, [&](std::shared_ptr<IMSSystem> ims) {               
+            // Unsubscribe listener
+            auto conn = ims->Connection();
+            if (ims->Ctlr().GetVersion().revision > 46)
+                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
+        });
 
-        auto ims = m_ims.lock();
-        if (!ims) return;
+		delete Receiver;
+	}
+
+	SequenceManager::SequenceManager(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+
+	SequenceManager::~SequenceManager() { delete p_Impl; p_Impl = nullptr; }
+
+	bool SequenceManager::StartSequenceQueue(const SequenceManager::SeqConfiguration& cfg, ImageTrigger start_trig)
+	{
+        auto ims = p_Impl->m_ims.lock();
+        if (!ims) return false;
         auto conn = ims->Connection();
 
-		while (BackgroundThreadRunning) {
-			//while (std::cv_status::timeout == m_bkcond.wait_for(lck, poll_interval))
-			m_bkcond.wait_for(lck, poll_interval);
+		// Make sure Controller & Synthesiser are present
+		if (!ims->Ctlr().IsValid()) return false;
+		if (!ims->Synth().IsValid()) return false;
 
-			if ((ims->Ctlr().Model() == "iMSP" && ims->Ctlr().GetVersion().revision <= 46) && (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - last_progress_check) > poll_interval))
-			{
-				// Controllers with FW revision greater than 46 use interrupt driven image notifications
-				if (ImagePlaying) {
+		// Sequences require interrupts, which are only available on Controller firmware versions > 46
+		if (ims->Ctlr().GetVersion().revision <= 46) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Playback failed: Require Controller F/W revision > 46. Yours = " << 
+				ims->Ctlr().GetVersion().revision;
+			return false;
+		}
 
-					HostReport *iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_Img_Ctrl);
+		IMSController::Capabilities cap = ims->Ctlr().GetCap();
 
-					finishHandle.push(conn->SendMsg(*iorpt));
-					delete iorpt;
-				}
+		if (!cap.FastImageTransfer) return false;
 
-				/*if (!BackgroundThreadRunning || (latestProgress != -1)) break;
-				if (!ImagePlaying && ImagePlaying_last) break;
-				ImagePlaying_last = ImagePlaying;*/
+		// Set ImageFormat (v1.8 - use auto mode only for now)
+		{
+			HostReport* iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_Img_FormatLo);
+			iorpt->Payload<uint32_t>(0x80000fff);
 
-				last_progress_check = std::chrono::high_resolution_clock::now();
+			if (NullMessage == conn->SendMsg(*iorpt))
+			{
+				delete iorpt;
+				return false;
 			}
-			
-			if (!BackgroundThreadRunning) break;
+			delete iorpt;
+		}
 
-			if (latestProgress != -1) {
-				int progress = latestProgress;
-				lck.unlock();
-				m_Event->Trigger<int>(this, ImagePlayerEvents::POINT_PROGRESS, progress);
-				lck.lock();
-				latestProgress = -1;
+		{
+			HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Start);
+			std::vector<std::uint8_t> v;
+
+			// Set ImgModes
+			std::uint8_t TFR{ 0 };
+			if (cfg.int_ext == PointClock::EXTERNAL)
+			{
+				TFR |= 4;
 			}
+			switch (cfg.trig)
+			{
+			case ImageTrigger::CONTINUOUS: TFR |= 3; break;
+			case ImageTrigger::EXTERNAL: TFR |= 1; break;
+			case ImageTrigger::HOST: TFR |= 2; break;
+			case ImageTrigger::POST_DELAY: TFR |= 0; break;
+			}
+			v.push_back(TFR);
 
-			if (!ImagePlaying && ImagePlaying_last) {
-				lck.unlock();
-				m_Event->Trigger<int>(this, ImagePlayerEvents::IMAGE_FINISHED, 0);
-				lck.lock();
-				BOOST_LOG_SEV(lg::get(), sev::info) << "Image Playback Finished";
+			std::uint8_t Pol = 0;
+			Pol |= (cfg.clk_pol == Polarity::INVERSE) ? 1 : 0;
+			Pol |= (cfg.trig_pol == Polarity::INVERSE) ? 2 : 0;
+			v.push_back(Pol);
+
+			std::uint8_t Play = 0;
+			switch (start_trig)
+			{
+			case ImageTrigger::EXTERNAL: Play |= 2; break;
+			case ImageTrigger::HOST: Play |= 4; break;
+			case ImageTrigger::CONTINUOUS: Play |= 1; break;
+			default: Play |= 1; break;
 			}
-			ImagePlaying_last = ImagePlaying;
+			v.push_back(Play);
+
+			iorpt->Payload < std::vector<std::uint8_t>>(v);
+			conn->SendMsg(*iorpt);
+			delete iorpt;
 		}
-	}
 
-	/* IMAGE TABLE READER */
-	ImageTableReader::ImageTableReader(std::shared_ptr<IMSSystem> ims) : m_ims(ims)
-	{}
+		BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Queue started";
 
-	ImageTableReader::~ImageTableReader()
-	{}
+		return true;
+	}
 
-	ImageTable ImageTableReader::Readback()
+	void SequenceManager::SendHostTrigger()
 	{
-		std::unique_ptr<ImageTable> imgt(new ImageTable());
-		std::array<std::uint8_t, 16> uuid;
+        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {  
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return;
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_USR_Trig);
+            ims->Connection()->SendMsg(*iorpt);
+            delete iorpt;
+        });
+	}   
 
-        return with_locked_value(m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTable
-        {  
-            // Read back ImageTable from iMS Controller
-            if (!ims->Ctlr().IsValid()) return ImageTable();
+	bool SequenceManager::Stop(ImagePlayer::StopStyle style)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
+
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+            if (!cap.FastImageTransfer) {
+                return false;
+            }
 
             auto conn = ims->Connection();
+            HostReport* iorpt;
+
+            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
+            if (ImagePlayer::StopStyle::IMMEDIATELY == style)
+            {
+                // Force Stop Image
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Force Stop request sent";
+                iorpt->Payload<std::uint8_t>(0);
+            }
+            else {
+                // Gracefully Stop Image at end of currenr repeat
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Graceful Stop request sent";
+                iorpt->Payload<std::uint8_t>(1);
+            }
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false); 
+	}
+
+	bool SequenceManager::StopAtEndOfSequence()
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {        
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
 
-            // Get number of entries in table
-            std::size_t tbl_size;
-            HostReport *iorpt;
             IMSController::Capabilities cap = ims->Ctlr().GetCap();
             if (!cap.FastImageTransfer) {
-                // Only ever 1 entry in a Controller Lite
-                tbl_size = 1;
+                return false;
+            }
 
-                // Read Image Length
-                int img_len = 0;
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_NumPts);
-                DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-                delete iorpt;
-                if (Resp.Done()) {
-                    img_len = Resp.Payload<std::uint16_t>();
-                }
-                else return ImageTable();
+            auto conn = ims->Connection();
+            HostReport* iorpt;
 
-                // Read Image UUID
-                iorpt = new HostReport(HostReport::Actions::CTRLR_REG, HostReport::Dir::READ, CTRLR_REG_UUID);
-                ReportFields f = iorpt->Fields();
-                f.len = static_cast<std::uint16_t>(uuid.size());
-                iorpt->Fields(f);
-                Resp = conn->SendMsgBlocking(*iorpt);
-                if (!Resp.Done()) {
-                    delete iorpt;
-                    return ImageTable();
-                }
-                else {
-                    std::vector<std::uint8_t> v = Resp.Payload<std::vector<std::uint8_t>>();
-                    //std::array<std::uint8_t, 16> uuid;
-                    v.resize(16);
-                    std::copy(v.begin(), v.end(), uuid.begin());
-                    ImageTableEntry ite(0, 0, img_len, img_len * 20, 0, uuid, std::string("solo_img"));
-                    imgt->push_back(ite);
-                }
+            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
+
+            BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Programmed Stop (end of sequence) request sent";
+            iorpt->Payload<std::uint8_t>(2);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
                 delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false);        
+	}
+
+	bool SequenceManager::Pause(ImagePlayer::StopStyle style)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {           
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
+
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+            if (!cap.FastImageTransfer) {
+                return false;
+            }
+
+            auto conn = ims->Connection();
+            HostReport* iorpt;
+
+            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Pause);
+            if (ImagePlayer::StopStyle::IMMEDIATELY == style)
+            {
+                // Force Stop Image
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Immediate Pause request sent";
+                iorpt->Payload<std::uint8_t>(0);
             }
             else {
-                iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::READ, 0);
-                ReportFields f = iorpt->Fields();
-                f.context = 4; // Get Image Table Size
-                f.len = 2;
-                iorpt->Fields(f);
-                DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+                // Gracefully Stop Image at end of currenr repeat
+                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Pause after Entry request sent";
+                iorpt->Payload<std::uint8_t>(1);
+            }
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
                 delete iorpt;
-                if (Resp.Done()) {
-                    tbl_size = Resp.Payload<std::uint16_t>();
-                }
-                else return ImageTable();
-
-                for (ImageIndex idx = 0; idx < (int)tbl_size; idx++) {
-                    iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::READ, static_cast<std::uint16_t>(idx));
-                    f = iorpt->Fields();
-                    f.context = static_cast < std::uint8_t>(HostReport::ImageIndexOperations::GET_ENTRY); 
-                    f.len = 49;
-                    iorpt->Fields(f);
-                    Resp = conn->SendMsgBlocking(*iorpt);
-                    delete iorpt;
-                    if (Resp.Done() && !Resp.GeneralError()) {
-                        ImageTableEntry ite(idx, Resp.Payload<std::vector<std::uint8_t>>());
-                        imgt->push_back(ite);
-                    }
-                }
+                return false;
             }
-            // Return by value
-            return (*imgt);
-
-        }).value_or(ImageTable());
-
+            delete iorpt;
+            return true;
+        }).value_or(false);          
 	}
 
-	/* IMAGE TABLE VIEWER */
-	class ImageTableViewer::Impl
+	bool SequenceManager::Resume()
 	{
-	public:
-		Impl(std::shared_ptr<IMSSystem> ims) : m_ims(ims) {}
-
-		std::weak_ptr<IMSSystem> m_ims;
-	};
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {         
+            // Make sure Controller & Synthesiser are present
+            if (!ims->Ctlr().IsValid()) return false;
+            if (!ims->Synth().IsValid()) return false;
 
-	ImageTableViewer::ImageTableViewer(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+            IMSController::Capabilities cap = ims->Ctlr().GetCap();
+            if (!cap.FastImageTransfer) {
+                return false;
+            }
 
-	ImageTableViewer::~ImageTableViewer() { delete p_Impl; p_Impl = nullptr; }
+            auto conn = ims->Connection();
+            HostReport* iorpt;
 
-	const int ImageTableViewer::Entries() const
-	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> int
-        { 
-    		return (int)ims->Ctlr().ImgTable().size();
-        }).value_or(0);
+            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Restart);
+            BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Resume request sent";
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false);   
 	}
 
-	const ImageTableEntry ImageTableViewer::operator[](const std::size_t idx) const
+	std::uint16_t SequenceManager::QueueCount()
 	{
-        std::size_t entries = (std::size_t)this->Entries();
-
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableEntry
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> std::uint16_t
         {         
-            ImageTable t = ims->Ctlr().ImgTable();
-            if (idx < entries) {
-                return *(std::next(t.begin(), idx));
-            }
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return -1;
+            auto conn = ims->Connection();
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 0;
+            f.len = 2;
+            iorpt->Fields(f);
+            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+            delete iorpt;
+
+            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 2) return 0;
             else {
-                return ImageTableEntry();
+                return Resp.Payload<std::uint16_t>();
             }
-        }).value_or(ImageTableEntry());
+        }).value_or(0);         
 	}
 
-	ImageTableViewer::const_iterator ImageTableViewer::begin() 
-    {
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableViewer::const_iterator
-        {         
-            return ims->Ctlr().ImgTable().begin(); 
-        }).value();  // This can throw a bad_optional_access if m_ims is invalid
-    }
-
-	ImageTableViewer::const_iterator ImageTableViewer::end() { 
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> ImageTableViewer::const_iterator
-        {   
-            return ims->Ctlr().ImgTable().end(); 
-        }).value();
-    }
-
-	bool ImageTableViewer::Erase(const std::size_t idx)
+	bool SequenceManager::GetSequenceUUID(int index, std::array<std::uint8_t, 16>& uuid)
 	{
-        auto ims = p_Impl->m_ims.lock();
-        if (!ims) return false;
-        auto conn = ims->Connection();
-
-		// Read back ImageTable from iMS Controller
-		if (!ims->Ctlr().IsValid()) return false;
-
-		HostReport* iorpt;
-		IMSController::Capabilities cap = ims->Ctlr().GetCap();
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {        
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, index);
+            ReportFields f = iorpt->Fields();
+            f.context = 1;
+            f.len = 16;
+            iorpt->Fields(f);
+            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+            delete iorpt;
 
-		// Can't delete images in single image controllers. Just download a replacement image.
-		if (!cap.FastImageTransfer) return false;
+            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 16) return false;
+            else {
+                std::vector<std::uint8_t> v = Resp.Payload<std::vector<std::uint8_t>>();
+                v.resize(16);
+                std::copy(v.cbegin(), v.cend(), uuid.begin());
+            }
+            return true;
+        }).value_or(false);          
+	}
 
-		if (idx < (std::size_t)this->Entries()) {
-			ImageTable t = ims->Ctlr().ImgTable();
-			ImageTableEntry ite = *(std::next(t.begin(), idx));
+	bool SequenceManager::QueueClear()
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {          
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 5;
+            f.len = 0;
+            iorpt->Fields(f);
+            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+            delete iorpt;
 
-			iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
-			ReportFields f = iorpt->Fields();
-			f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::CHECK_UUID);
-			f.len = 16;
-			iorpt->Fields(f);
+            if (!Resp.Done() || Resp.GeneralError()) return false;
+            return true;
+        }).value_or(false); 
+	}
 
-			std::array<std::uint8_t, 16> uuid = ite.UUID();
-			std::vector<std::uint8_t> data(uuid.begin(), uuid.begin() + 16);
-			iorpt->Payload<std::vector<std::uint8_t>>(data);
+	bool SequenceManager::RemoveSequence(const std::array<std::uint8_t, 16>& uuid)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {         
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 4;
+            f.len = 16;
+            iorpt->Fields(f);
+            std::vector<std::uint8_t> v;
+            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
 
-			DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
-			if (!ioresp.Done() || ioresp.GeneralError()) {
-				// Most likely image UUID doesn't exist on Controller.  How did we get out of sync?
-				BOOST_LOG_SEV(lg::get(), sev::error) << "Erase of image index " << idx << " [" << ite.Name() << "] requested but no matching UUID found on Controller.";
+            iorpt->Payload<std::vector<std::uint8_t>>(v);
+            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
+            delete iorpt;
 
-				delete iorpt;
-				return false;
-			}
+            if (!Resp.Done() || Resp.GeneralError()) return false;
+            return true;
+        }).value_or(false); 
+	}
 
-			uint16_t img_idx = ioresp.Payload<uint16_t>();
-			delete iorpt;
+	bool SequenceManager::RemoveSequence(const ImageSequence& seq)
+	{
+		std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
+		return this->RemoveSequence(seq_uuid);
+	}
 
-			iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, img_idx);
-			f = iorpt->Fields();
-			f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::DEL_ENTRY);
-			f.len = 0;
-			iorpt->Fields(f);
+	bool SequenceManager::UpdateTermination(const std::array<std::uint8_t, 16>& uuid, SequenceTermAction term, int term_val)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {          
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 3;
+            f.len = 21;
+            iorpt->Fields(f);
+            std::vector<std::uint8_t> v;
+            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
+            v.push_back(static_cast<std::uint8_t>(term));
+            v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
+            v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
+            v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
+            v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
 
-			ioresp = conn->SendMsgBlocking(*iorpt);
-			if (!ioresp.Done() || ioresp.GeneralError()) {
-				// Erase failed. As image must exist (we checked for this above) a DMA operation must be in progress
-				BOOST_LOG_SEV(lg::get(), sev::error) << "Erase of image index " << idx << " [" << ite.Name() << "] failed. Image Upload / Download in progress.";
+            iorpt->Payload<std::vector<std::uint8_t>>(v);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false); 
+	}
 
-				delete iorpt;
-				return false;
-			}
-			delete iorpt;
+	bool SequenceManager::UpdateTermination(const std::array<std::uint8_t, 16>& uuid, SequenceTermAction term, const std::array<std::uint8_t, 16>& term_uuid)
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {          
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 3;
+            f.len = 37;
+            iorpt->Fields(f);
+            std::vector<std::uint8_t> v;
+            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
+            v.push_back(static_cast<std::uint8_t>(term));
+            v.insert(v.end(), { 0, 0, 0, 0 });
+            v.insert(v.end(), term_uuid.begin(), term_uuid.begin() + 16);
 
-			// Remove from Image Table
-			t.erase(std::next(t.begin(), idx));
-			const IMSController& c = ims->Ctlr();
-			ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), t));
+            iorpt->Payload<std::vector<std::uint8_t>>(v);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false);         
+	}
 
-			return true;
-		}
-		BOOST_LOG_SEV(lg::get(), sev::warning) << "Erase of image index " << idx << " failed. Index not found in Image Table";
-		return false;
+	bool SequenceManager::UpdateTermination(ImageSequence& seq, SequenceTermAction term, int term_val)
+	{
+		std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
+		seq.OnTermination(term, term_val);
+		return this->UpdateTermination(seq_uuid, term, term_val);
 	}
 
-	bool ImageTableViewer::Erase(ImageTableEntry ite)
+	bool SequenceManager::UpdateTermination(ImageSequence& seq, SequenceTermAction term, const ImageSequence* term_seq)
 	{
-		for (int i = 0; i < this->Entries(); i++)
-		{
-			if ((*this)[i].UUID() == ite.UUID())
-				return this->Erase(i);
+		if (term_seq != nullptr) {
+			std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
+			std::array<std::uint8_t, 16> term_seq_uuid = term_seq->GetUUID();
+			seq.OnTermination(term, term_seq);
+			return this->UpdateTermination(seq_uuid, term, term_seq_uuid);
 		}
-		return false;
+		else return false;
 	}
 
-	bool ImageTableViewer::Erase(ImageTableViewer::const_iterator it)
+	bool SequenceManager::MoveSequence(const ImageSequence& dest, const ImageSequence& src)
 	{
-		return this->Erase(std::distance(this->begin(), it));
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {         
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 9;
+            f.len = 32;
+            iorpt->Fields(f);
+            std::vector<std::uint8_t> v;
+            auto s = src.GetUUID();
+            auto d = dest.GetUUID();
+            v.assign(d.cbegin(), d.cbegin() + 16);
+            v.insert(v.end(), s.cbegin(), s.cbegin() + 16);
+            iorpt->Payload<std::vector<std::uint8_t>>(v);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false);        
 	}
 
-	bool ImageTableViewer::Clear()
+	bool SequenceManager::MoveSequenceToEnd(const ImageSequence& src)
 	{
         return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {  
+        {          
+            // Make sure Controller is present
             if (!ims->Ctlr().IsValid()) return false;
             auto conn = ims->Connection();
-
-            HostReport* iorpt;
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
-
-            // Can't delete images in single image controllers. Just download a replacement image.
-            if (!cap.FastImageTransfer) return false;
-
-            // Try an erase all command
-            iorpt = new HostReport(HostReport::Actions::CTRLR_IMGIDX, HostReport::Dir::WRITE, 0);
+            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
             ReportFields f = iorpt->Fields();
-            f.context = static_cast<std::uint8_t>(HostReport::ImageIndexOperations::ERASE_ALL);
-            f.len = 0;
+            f.context = 10;
+            f.len = 16;
             iorpt->Fields(f);
+            std::vector<std::uint8_t> v;
+            auto s = src.GetUUID();
+            v.assign(s.cbegin(), s.cbegin() + 16);
+            iorpt->Payload<std::vector<std::uint8_t>>(v);
+            if (NullMessage == conn->SendMsg(*iorpt))
+            {
+                delete iorpt;
+                return false;
+            }
+            delete iorpt;
+            return true;
+        }).value_or(false);           
+	}
 
-            DeviceReport ioresp = conn->SendMsgBlocking(*iorpt);
+	bool SequenceManager::GetCurrentPosition()
+	{
+        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {          
+            // Make sure Controller is present
+            if (!ims->Ctlr().IsValid()) return false;
+            auto conn = ims->Connection();
+            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
+            ReportFields f = iorpt->Fields();
+            f.context = 8;
+            f.len = 21;
+            iorpt->Fields(f);
+            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
             delete iorpt;
-            if (!ioresp.Done() || ioresp.GeneralError()) {
-                // Try clearing images individually
-                int images_total = this->Entries();
-                for (int i = 0; i < images_total; i++) {
-                    if (!this->Erase((*this)[0])) {
-                        BOOST_LOG_SEV(lg::get(), sev::error) << "Unable to Clear Image Table";
-                        return false;
-                    }
+
+            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 21) return false;
+            else {
+                int value = 0;
+                auto d = Resp.Payload<std::vector<uint8_t>>();
+                value |= ((int)d[1]);
+                value |= ((int)d[2] << 8);
+                value |= ((int)d[3] << 16);
+                value |= ((int)d[4] << 24);
+
+                std::vector<uint8_t> uuid(d.begin() + 5, d.begin() + 21);
+                p_Impl->m_Event->Trigger<int, std::vector<std::uint8_t>>((void*)p_Impl, SequenceEvents::SEQUENCE_POSITION, value, uuid);
+
+                return true;
+            }
+        }).value_or(false);           
+	}
+
+	// Notify application when something happens
+	void SequenceManager::SequenceEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {             
+            if (ims->Ctlr().GetVersion().revision >= 38) {
+                int IntrMask;
+                switch (message) {
+                case SequenceEvents::SEQUENCE_START: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_START); break;
+                case SequenceEvents::SEQUENCE_FINISHED: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_FINISHED); break;
+                case SequenceEvents::SEQUENCE_ERROR: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_ERROR); break;
+                case SequenceEvents::SEQUENCE_TONE: IntrMask = (int)(1 << CTRLR_INTERRUPT_TONE_START); break;
+                default: IntrMask = 0;
                 }
+                HostReport *iorpt;
+                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
+                iorpt->Payload<int>(IntrMask);
+                ReportFields f = iorpt->Fields();
+                f.len = sizeof(IntrMask);
+                iorpt->Fields(f);
+                ims->Connection()->SendMsg(*iorpt);
+                delete iorpt;
             }
-            // All done OK
-            BOOST_LOG_SEV(lg::get(), sev::info) << "Image Table Cleared";
+        });
+	}
 
-            // Reset local image table
-            const IMSController& c = ims->Ctlr();
-            ImageTable empty_table;
-            ims->Ctlr(IMSController(c.Model(), c.Description(), c.GetCap(), c.GetVersion(), empty_table));
+	void SequenceManager::SequenceEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
+        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {   
+            int IntrMask;
+            if (!p_Impl->m_Event->Subscribers(message)) {
+                switch (message) {
+                case SequenceEvents::SEQUENCE_START: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_START); break;
+                case SequenceEvents::SEQUENCE_FINISHED: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_FINISHED); break;
+                case SequenceEvents::SEQUENCE_ERROR: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_ERROR); break;
+                case SequenceEvents::SEQUENCE_TONE: IntrMask = (int)~(1 << CTRLR_INTERRUPT_TONE_START); break;
+                default: IntrMask = 0;
+                }
+                HostReport *iorpt;
+                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
+                iorpt->Payload<int>(IntrMask);
+                ReportFields f = iorpt->Fields();
+                f.len = sizeof(IntrMask);
+                iorpt->Fields(f);
+                ims->Connection()->SendMsg(*iorpt);
+                delete iorpt;
+            }
+        });        
+	}
 
-            return true;
-        }).value_or(false);
+	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	{
+		switch (message)
+		{
+		case (MessageEvents::INTERRUPT_RECEIVED) :
+			unsigned int type = (param >> 16);
+			int value = (param & 0xffff);
+			switch (type) {
+			case (CTRLR_INTERRUPT_SEQUENCE_FINISHED): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Finished Event Trigger";
+				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_FINISHED, value); break;
+			}
+			case (CTRLR_INTERRUPT_SEQUENCE_ERROR): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Error Event Trigger";
+				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_ERROR, value); break;
+			}
+			case (CTRLR_INTERRUPT_TONE_START): {
+				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Tone Entry Event Trigger";
+				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_TONE, value); break;
+				}
+			}
+		}
 	}
 
-	std::ostream& operator <<(std::ostream& stream, const ImageTableViewer& itv) {
+/*	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param, const int param2)
+	{
+		switch (message)
+		{
+		case (MessageEvents::INTERRUPT_RECEIVED) :
+			unsigned int type = (param >> 16);
+			int value = (param & 0xffff);
+			switch (type) {
+			case (CTRLR_INTERRUPT_SEQUENCE_IMAGE_REPEAT) : m_parent->m_Event->Trigger<int, int>((void *)m_parent, SequenceEvents::SEQUENCE_IMAGE_REPEAT, value, param2); break;
+			}
+		}
+	}*/
 
-		for (int i = 0; i < itv.Entries(); i++) {
-			stream << "Image[" << i << "] id:" << itv[i].Handle() <<
-				" Addr: 0x" << std::setw(8) << std::setfill('0') << std::hex << itv[i].Address() <<
-				" Points: " << std::dec << itv[i].NPts() <<
-				" ByteLength: " << itv[i].Size() <<
-				" Format Code: " << std::hex << itv[i].Format() <<
-				" UUID: ";
-			int j;
-			stream << std::hex;
-			for (j = 0; j < 4; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
-			stream << "-";
-			for (j = 4; j < 6; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
-			stream << "-";
-			for (j = 6; j < 8; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
-			stream << "-";
-			for (j = 8; j < 10; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
-			stream << "-";
-			for (j = 10; j < 16; j++) stream << std::setfill('0') << std::setw(2) << (int)itv[i].UUID()[j];
-			stream << " Name: " << itv[i].Name();
-			stream << std::dec << std::endl;
+	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data)
+	{
+		switch (message)
+		{
+		case (MessageEvents::INTERRUPT_RECEIVED) :
+			unsigned int type = (param >> 16);
+			int value = (param & 0xffff);
+			switch (type) {
+			case (CTRLR_INTERRUPT_SEQUENCE_START): {
+					BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Start Event Trigger";
+					m_parent->m_Event->Trigger<int, std::vector<std::uint8_t>>((void*)m_parent, SequenceEvents::SEQUENCE_START, value, data); break;
+				}
+			}
 		}
-		return stream;
 	}
 
 
-	/* SEQUENCE DOWNLOADER */
-	class SequenceDownloadEventTrigger :
-		public IEventTrigger
+	/* SEQUENCE POSITION TRACKER */
+	class SequencePositionTracker::Impl
 	{
 	public:
-		SequenceDownloadEventTrigger() { updateCount(DownloadEvents::Count); }
-		~SequenceDownloadEventTrigger() {};
-	};
+		using UUID = std::array<std::uint8_t, 16>;
+		using clock = std::chrono::steady_clock;
 
-	class SequenceDownload::Impl
-	{
-	public:
-		Impl(std::shared_ptr<IMSSystem>, const ImageSequence&);
+		Impl(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr, std::size_t capacity);
 		~Impl();
 
-        LazyWorker downloadWorker;
+		// Playing time of one entry of a tracked sequence.  'play' is zero if it can't be predicted.
+		struct EntryTiming
+		{
+			double play{ 0.0 };
+			std::uint32_t plays{ 1 };
+			std::uint32_t npts{ 0 };
+			double rate{ 0.0 };
+			bool tone{ false };
+		};
 
-		std::weak_ptr<IMSSystem> m_ims;
-		const ImageSequence& m_Seq;
+		struct Tracked
+		{
+			std::vector<EntryTiming> entries;
+			// Start time of each entry from the start of the sequence, counting unpredictable entries as taking no time, then the total
+			std::vector<double> start;
+			// Index of the first unpredictable entry at or after each entry, or the number of entries if there is none
+			std::vector<std::size_t> nextUntimed;
+			// Entry that playback returns to at the end, or the number of entries if it doesn't
+			std::size_t loop;
+		};
 
-		const std::unique_ptr<boost::container::deque<std::uint8_t>> m_seqdata;
-		std::unique_ptr<SequenceDownloadEventTrigger> m_Event;
+		// The last position known for certain, from which estimates are made
+		struct Anchor
+		{
+			bool valid{ false };
+			bool playing{ false };
+			UUID uuid{};
+			std::size_t entry{ 0 };
+			double offset{ 0.0 };
+			clock::time_point time;
+			bool toneStarted{ false };
+		};
 
-		class ResponseReceiver : public IEventHandler
+		class Listener : public IEventHandler
 		{
 		public:
-			ResponseReceiver(SequenceDownload::Impl* pl) : m_parent(pl) { Init(); };
+			Listener(SequencePositionTracker::Impl* pl) : m_parent(pl) {};
 			void EventAction(void* sender, const int message, const int param);
-			void Init() { busy.store(true); error.store(false); success_code = 0; error_code = 0; }
-			bool IsBusy() const { return busy.load(); }
-			bool HasError() const { return error.load(); }
-			int SuccessCode() const { return success_code; }
-			int ErrorCode() const { return error_code; }
+			void EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
 		private:
-			SequenceDownload::Impl* m_parent;
-			std::atomic_bool busy;
-			std::atomic_bool error;
-			int error_code;
-			int success_code;
+			SequencePositionTracker::Impl* m_parent;
 		};
-		ResponseReceiver* Receiver;
-
-		DMASupervisor* dmah;
+		Listener* Receiver;
 
-        bool downloadRequested{ false };
-        void DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
- 
-		// Capability flags
-		bool fast_seq_dl_supported{ false };
-		bool large_seq_supported{ false };
+		std::weak_ptr<IMSSystem> m_ims;
+		SequenceManager* m_mgr;
+
+		mutable std::mutex m_mutex;
+		std::map<UUID, Tracked> m_tracked;
+		Anchor m_anchor;
+
+		// Called with m_mutex held
+		static void Locate(const Tracked& s, std::size_t k, double offset, std::size_t& entry, double& within);
+		void Advance(clock::time_point t, std::size_t& entry, double& within) const;
+		Position EstimateAt(clock::time_point t) const;
+		void Publish(Source src, const Position& p);
+
+		void OnStart(const UUID& uuid, clock::time_point t);
+		void OnStop(Source src, clock::time_point t);
+		void OnTone(clock::time_point t);
+		void OnPosition(std::size_t entry, const UUID& uuid, clock::time_point t);
+
+		// Lock-free ring of published Samples.  Each slot holds a sequence number, odd while it is being written and
+		// 2 * (index + 1) once Sample 'index' is complete, so that readers can tell whether the Sample they copied was intact.
+		struct Slot
+		{
+			std::atomic<std::uint64_t> seq{ 0 };
+			std::array<std::atomic<std::uint64_t>, 5> words;
+		};
+		std::unique_ptr<Slot[]> m_ring;
+		std::size_t m_capacity;
+		std::atomic<std::uint64_t> m_head{ 0 };
+
+		// Position reads are sent from the worker thread, which records when
+		std::atomic<clock::rep> m_readSent{ 0 };
+		std::atomic<std::thread::id> m_readThread;
+
+		// Guarded by the worker mutex
+		std::chrono::milliseconds m_resync{ 1000 };
+		std::chrono::milliseconds m_publish{ 0 };
+		clock::time_point m_nextRead;
+		clock::time_point m_nextPublish;
+		std::atomic<bool> m_playing{ false };
+
+		LazyWorker worker;
+		void WorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+		void Rearm(clock::time_point t);
 	};
 
-	SequenceDownload::Impl::Impl(std::shared_ptr<IMSSystem> ims, const ImageSequence& seq) :
-		m_ims(ims), m_Seq(seq),
-		m_seqdata(new boost::container::deque<std::uint8_t>()),
-		Receiver(new ResponseReceiver(this)),
-		m_Event(new SequenceDownloadEventTrigger()),
-		dmah(new DMASupervisor()),
-        downloadWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
-            DownloadWorkerLoop(running, cond, mtx);
-        })
+	SequencePositionTracker::Impl::Impl(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr, std::size_t capacity) :
+		Receiver(new Listener(this)),
+		m_ims(ims),
+		m_mgr(&mgr),
+		m_capacity(1),
+		worker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			WorkerLoop(running, cond, mtx);
+		})
 	{
-		fast_seq_dl_supported = false;
-		large_seq_supported = false;
+		while (m_capacity < capacity) m_capacity <<= 1;
+		m_ring.reset(new Slot[m_capacity]);
+	}
 
-		// Subscribe listener
-		auto conn = ims->Connection();
-		if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
-			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-			int IntrMask = (int)((1 << CTRLR_INTERRUPT_SEQDL_ERROR) | (1 << CTRLR_INTERRUPT_SEQDL_COMPLETE) | (1 << CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED));
+	SequencePositionTracker::Impl::~Impl()
+	{
+		worker.stop();
+		delete Receiver;
+	}
 
-			HostReport* iorpt;
-			iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
-			iorpt->Payload<int>(IntrMask);
-			ReportFields f = iorpt->Fields();
-			f.len = sizeof(IntrMask);
-			iorpt->Fields(f);
-			conn->SendMsg(*iorpt);
-			delete iorpt;
+	void SequencePositionTracker::Impl::Locate(const Tracked& s, std::size_t k, double offset, std::size_t& entry, double& within)
+	{
+		const std::size_t n = s.entries.size();
+		const std::size_t u = s.nextUntimed[k];
+		double pos = s.start[k] + offset;
+		within = 0.0;
+
+		if (u == k) {
+			// Waiting on an entry whose length isn't known
+			entry = k;
+			return;
 		}
-
-		conn->MessageEventSubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
+		if ((u < n) && (pos >= s.start[u])) {
+			entry = u;
+			return;
+		}
+		if (pos >= s.start[n]) {
+			if (s.loop >= n) {
+				// Played to the end, and held there until the next sequence starts
+				entry = n - 1;
+				within = s.start[n] - s.start[n - 1];
+				return;
+			}
+			if (s.nextUntimed[s.loop] < n) {
+				entry = s.nextUntimed[s.loop];
+				return;
+			}
+			const double span = s.start[n] - s.start[s.loop];
+			pos = s.start[s.loop] + std::fmod(pos - s.start[n], span);
+		}
+		entry = std::upper_bound(s.start.cbegin(), s.start.cbegin() + n, pos) - s.start.cbegin() - 1;
+		within = pos - s.start[entry];
 	}
 
-	SequenceDownload::Impl::~Impl() 
+	void SequencePositionTracker::Impl::Advance(clock::time_point t, std::size_t& entry, double& within) const
 	{
-        with_locked(m_ims, [&](std::shared_ptr<IMSSystem> ims) {         
-            // Unsubscribe listener
-            auto conn = ims->Connection();
-            if (ims->Ctlr().Model() != "iMSP" || ims->Ctlr().GetVersion().revision > 46) {
-                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-                int IntrMask = ~(int)((1 << CTRLR_INTERRUPT_SEQDL_ERROR) | (1 << CTRLR_INTERRUPT_SEQDL_COMPLETE) | (1 << CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED));
-
-                HostReport* iorpt;
-                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
-                iorpt->Payload<int>(IntrMask);
-                ReportFields f = iorpt->Fields();
-                f.len = sizeof(IntrMask);
-                iorpt->Fields(f);
-                ims->Connection()->SendMsg(*iorpt);
-                delete iorpt;
-            }
-
-            conn->MessageEventUnsubscribe(MessageEvents::MEMORY_TRANSFER_COMPLETE, dmah);
-        });
-
-		delete dmah;
-		delete Receiver;
+		entry = m_anchor.entry;
+		within = m_anchor.offset;
+		auto it = m_tracked.find(m_anchor.uuid);
+		if ((it == m_tracked.end()) || (m_anchor.entry >= it->second.entries.size())) return;
+
+		double elapsed = 0.0;
+		if (m_anchor.playing && (t > m_anchor.time)) elapsed = std::chrono::duration<double>(t - m_anchor.time).count();
+		Locate(it->second, m_anchor.entry, m_anchor.offset + elapsed, entry, within);
 	}
 
-	SequenceDownload::SequenceDownload(std::shared_ptr<IMSSystem> ims, const ImageSequence& seq) : p_Impl(new Impl(ims, seq)) {}
+	SequencePositionTracker::Position SequencePositionTracker::Impl::EstimateAt(clock::time_point t) const
+	{
+		Position p;
+		p.Time = t;
+		if (!m_anchor.valid) return p;
+
+		p.Valid = true;
+		p.Playing = m_anchor.playing;
+		p.UUID = m_anchor.uuid;
+
+		std::size_t entry;
+		double within;
+		Advance(t, entry, within);
+		p.Entry = static_cast<std::uint32_t>(entry);
+
+		auto it = m_tracked.find(m_anchor.uuid);
+		if ((it == m_tracked.end()) || (entry >= it->second.entries.size())) return p;
+		const EntryTiming& e = it->second.entries[entry];
+		if (e.play <= 0.0) return p;
+
+		p.Interpolated = true;
+		p.Repeat = std::min(e.plays - 1, static_cast<std::uint32_t>(within / e.play));
+		const double in_play = within - p.Repeat * e.play;
+		// During a post image delay the last point is still being output
+		p.Point = std::min(e.npts - 1, static_cast<std::uint32_t>(in_play * e.rate));
+		return p;
+	}
 
-	SequenceDownload::~SequenceDownload() { delete p_Impl; p_Impl = nullptr; }
+	void SequencePositionTracker::Impl::Publish(Source src, const Position& p)
+	{
+		const std::uint64_t idx = m_head.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = m_ring[idx & (m_capacity - 1)];
+
+		std::uint64_t id[2] = { 0, 0 };
+		for (int i = 0; i < 16; i++) id[i / 8] |= (std::uint64_t)p.UUID[i] << (8 * (i % 8));
+		const std::uint64_t flags = (p.Valid ? 1 : 0) | (p.Playing ? 2 : 0) | (p.Interpolated ? 4 : 0) | ((std::uint64_t)src << 8);
+
+		slot.seq.store(2 * idx + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.words[0].store(static_cast<std::uint64_t>(p.Time.time_since_epoch().count()), std::memory_order_relaxed);
+		slot.words[1].store(id[0], std::memory_order_relaxed);
+		slot.words[2].store(id[1], std::memory_order_relaxed);
+		slot.words[3].store(p.Entry | ((std::uint64_t)p.Repeat << 32), std::memory_order_relaxed);
+		slot.words[4].store(p.Point | (flags << 32), std::memory_order_relaxed);
+		slot.seq.store(2 * idx + 2, std::memory_order_release);
+	}
 
-	bool SequenceDownload::Download(bool asynchronous)
+	void SequencePositionTracker::Impl::OnStart(const UUID& uuid, clock::time_point t)
 	{
-        auto ims = p_Impl->m_ims.lock();
-        if (!ims) return false;
-        auto conn = ims->Connection();
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			m_anchor = Anchor();
+			m_anchor.valid = true;
+			m_anchor.playing = true;
+			m_anchor.uuid = uuid;
+			m_anchor.time = t;
+			Publish(Source::SEQUENCE_START, EstimateAt(t));
+		}
+		m_playing.store(true);
+		Rearm(t);
+	}
 
-		// Make sure Controller is present
-		if (!ims->Ctlr().IsValid()) return false;
-		int entries = (int)p_Impl->m_Seq.size();
+	void SequencePositionTracker::Impl::OnStop(Source src, clock::time_point t)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		if (m_anchor.valid) {
+			Advance(t, m_anchor.entry, m_anchor.offset);
+			m_anchor.time = t;
+		}
+		m_anchor.playing = false;
+		m_playing.store(false);
+		Publish(src, EstimateAt(t));
+	}
 
-		HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
-		ReportFields f = iorpt->Fields();
-		f.context = 0;
-		f.len = 3;
-		iorpt->Fields(f);
-		DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-		delete iorpt;
+	void SequencePositionTracker::Impl::OnTone(clock::time_point t)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		auto it = m_tracked.find(m_anchor.uuid);
+		if (m_anchor.valid && (it != m_tracked.end())) {
+			// The next tone entry from where playback is estimated to be, not counting one that has already started
+			const std::vector<EntryTiming>& e = it->second.entries;
+			std::size_t entry;
+			double within;
+			Advance(t, entry, within);
+			if (m_anchor.toneStarted && (entry == m_anchor.entry)) entry++;
+
+			std::size_t i = entry;
+			while ((i < e.size()) && !e[i].tone) i++;
+			if ((i == e.size()) && (it->second.loop < e.size())) {
+				for (i = it->second.loop; (i < entry) && !e[i].tone; i++);
+				if (i == entry) i = e.size();
+			}
+			if (i < e.size()) {
+				m_anchor.entry = i;
+				m_anchor.offset = 0.0;
+				m_anchor.time = t;
+				m_anchor.toneStarted = true;
+			}
+		}
+		Publish(Source::TONE_START, EstimateAt(t));
+	}
 
-		if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 2) {}
+	void SequencePositionTracker::Impl::OnPosition(std::size_t entry, const UUID& uuid, clock::time_point t)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		auto it = m_tracked.find(uuid);
+		if (!m_anchor.valid || (uuid != m_anchor.uuid) || (it == m_tracked.end()) || (entry >= it->second.entries.size())) {
+			m_anchor.valid = true;
+			m_anchor.uuid = uuid;
+			m_anchor.entry = entry;
+			m_anchor.offset = 0.0;
+			m_anchor.toneStarted = false;
+		}
 		else {
-			if (Resp.Fields().len > 2) {
-				if (Resp.Payload<std::vector<std::uint8_t>>().at(2) != 0) {
-					p_Impl->fast_seq_dl_supported = true;
-				}
+			// Keep the estimate if it agrees with the Controller, otherwise start again from the reported entry
+			std::size_t est;
+			double within;
+			Advance(t, est, within);
+			if (est == entry) {
+				m_anchor.offset = within;
 			}
-			if (Resp.Fields().len > 3) {
-				if (Resp.Payload<std::vector<std::uint8_t>>().at(3) != 0) {
-					p_Impl->large_seq_supported = true;
-				}
+			else {
+				m_anchor.offset = 0.0;
+				m_anchor.toneStarted = false;
 			}
+			m_anchor.entry = entry;
 		}
+		m_anchor.time = t;
+		Publish(Source::POSITION_READ, EstimateAt(t));
+	}
 
-		if (p_Impl->fast_seq_dl_supported && asynchronous) {
-            p_Impl->downloadWorker.start();
-
-            int retries=10;
-            while (retries)
-            {
-                std::unique_lock<std::mutex> lck{ p_Impl->downloadWorker.mutex(), std::try_to_lock };
-
-                if (!lck.owns_lock()) {
-                    if (!--retries) {
-    					BOOST_LOG_SEV(lg::get(), sev::warning) << "Sequence Download busy - try again later";
-                        return false;
-                    }
-                    // Mutex lock failed, Downloader must be busy, try again later
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    continue;
-                }
-                p_Impl->downloadRequested = true;
-                lck.unlock();
+	void SequencePositionTracker::Impl::Listener::EventAction(void* sender, const int message, const int param)
+	{
+		const clock::time_point t = clock::now();
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_FINISHED) : m_parent->OnStop(Source::SEQUENCE_FINISHED, t); break;
+		case (SequenceEvents::SEQUENCE_ERROR) : m_parent->OnStop(Source::SEQUENCE_ERROR, t); break;
+		case (SequenceEvents::SEQUENCE_TONE) : m_parent->OnTone(t); break;
+		}
+	}
 
-                break;
-            }
+	void SequencePositionTracker::Impl::Listener::EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data)
+	{
+		clock::time_point t = clock::now();
+		if (data.size() < 16) return;
+		UUID uuid;
+		std::copy(data.cbegin(), data.cbegin() + 16, uuid.begin());
 
-			p_Impl->downloadWorker.notify();
-			return true;
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_START) : m_parent->OnStart(uuid, t); break;
+		case (SequenceEvents::SEQUENCE_POSITION) : {
+			// A read sent by the worker was answered somewhere between being sent and now
+			const clock::rep sent = m_parent->m_readSent.load();
+			if (sent && (m_parent->m_readThread.load() == std::this_thread::get_id())) {
+				t = clock::time_point(clock::duration(sent)) + (t - clock::time_point(clock::duration(sent))) / 2;
+			}
+			m_parent->OnPosition((std::size_t)(unsigned int)param, uuid, t);
+			break;
 		}
+		}
+	}
 
-		/* Create a new sequence */
-		/* Payload
-		* [15:0] = Sequence UUID
-		* [17:16] = number of entries in sequence
-		*/
-		iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-		f = iorpt->Fields();
-		f.context = 0;
-		iorpt->Fields(f);
-		std::array<std::uint8_t, 16> uuid = p_Impl->m_Seq.GetUUID();
-		std::vector<std::uint8_t> v(uuid.begin(), uuid.begin() + 16);
-		v.push_back(entries & 0xff);
-		v.push_back(entries >> 8);
-		iorpt->Payload<std::vector<std::uint8_t>>(v);
-		Resp = conn->SendMsgBlocking(*iorpt);
-		if (!Resp.Done() || Resp.GeneralError()) {
-			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence creation failed.  Insufficient device memory for sequence entries";
-			p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
-			delete iorpt;
-			return false;
+	void SequencePositionTracker::Impl::Rearm(clock::time_point t)
+	{
+		{
+			std::unique_lock<std::mutex> lck{ worker.mutex() };
+			m_nextRead = t + m_resync;
+			m_nextPublish = t + m_publish;
 		}
-		delete iorpt;
+		worker.notify();
+	}
 
-		int entry = 0;
-		for (ImageSequence::const_iterator it = p_Impl->m_Seq.cbegin(); it != p_Impl->m_Seq.cend(); ++it) {
-			iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, entry);
-			f = iorpt->Fields();
+	void SequencePositionTracker::Impl::WorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	{
+		while (true) {
+			bool read = false;
+			bool publish = false;
+			{
+				std::unique_lock<std::mutex> lck{ mtx };
+				if (!running) return;
+				const bool resyncing = m_resync.count() > 0;
+				const bool publishing = m_publish.count() > 0;
+				if (!m_playing.load() || (!resyncing && !publishing)) {
+					cond.wait(lck);
+					continue;
+				}
 
-			const std::shared_ptr<SequenceEntry> seq_entry = *it;
-			f.context = FormatSequenceEntry(*it, ims, v);
-			if (f.context == 0) {
-				delete iorpt;
-				return false;
+				const clock::time_point now = clock::now();
+				clock::time_point due = clock::time_point::max();
+				if (resyncing) due = std::min(due, m_nextRead);
+				if (publishing) due = std::min(due, m_nextPublish);
+				if (now < due) {
+					cond.wait_until(lck, due);
+					continue;
+				}
+				if (resyncing && (now >= m_nextRead)) {
+					read = true;
+					m_nextRead = now + m_resync;
+				}
+				if (publishing && (now >= m_nextPublish)) {
+					publish = true;
+					m_nextPublish = now + m_publish;
+				}
 			}
-			iorpt->Fields(f);
 
-			iorpt->Payload<std::vector<std::uint8_t>>(v);
-			Resp = conn->SendMsgBlocking(*iorpt);
-			if (!Resp.Done() || Resp.GeneralError()) {
-				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence creation failed.  Error on sequence entry " << entry;
-				p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, entry);
-				delete iorpt;
-				return false;
+			if (read) {
+				m_readThread.store(std::this_thread::get_id());
+				m_readSent.store(clock::now().time_since_epoch().count());
+				m_mgr->GetCurrentPosition();
+				m_readSent.store(0);
+			}
+			if (publish) {
+				std::unique_lock<std::mutex> lck{ m_mutex };
+				if (m_anchor.playing) Publish(Source::ESTIMATE, EstimateAt(clock::now()));
 			}
-			entry++;
-			delete iorpt;
 		}
+	}
 
-		/* Commit Sequence */
-		/* Payload:
-		* [0] = termination type
-		* [4:1] = termination value
-		* [20:5] = termination tag (for Insert mode)
-		*/
-		iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-		f = iorpt->Fields();
-		f.context = 2;
-		iorpt->Fields(f);
-		v.clear();
-		v.push_back(static_cast<std::uint8_t>(p_Impl->m_Seq.TermAction()));
-		std::uint32_t term_val = p_Impl->m_Seq.TermValue();
-		v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
-		v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
-		v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
-		v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
+	SequencePositionTracker::SequencePositionTracker(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr, std::size_t capacity) :
+		p_Impl(new Impl(ims, mgr, capacity))
+	{
+		p_Impl->worker.start();
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Receiver);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Receiver);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_ERROR, p_Impl->Receiver);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_TONE, p_Impl->Receiver);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_POSITION, p_Impl->Receiver);
+	}
 
-		if (p_Impl->m_Seq.TermInsertBefore() != nullptr) {
-			const std::array<uint8_t, 16> term_tag = p_Impl->m_Seq.TermInsertBefore()->GetUUID();
-			v.insert(v.end(), term_tag.begin(), term_tag.begin() + 16);
+	SequencePositionTracker::~SequencePositionTracker()
+	{
+		p_Impl->worker.stop();
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Receiver);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Receiver);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_ERROR, p_Impl->Receiver);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_TONE, p_Impl->Receiver);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_POSITION, p_Impl->Receiver);
+		delete p_Impl;
+		p_Impl = nullptr;
+	}
+
+	void SequencePositionTracker::Track(const ImageSequence& seq, const SequenceManager::SeqConfiguration& cfg)
+	{
+		// Number of points in each Image in the Image Table
+		std::map<Impl::UUID, int> npts;
+		with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {
+			const ImageTable& table = ims->Ctlr().ImgTable();
+			for (auto it = table.cbegin(); it != table.cend(); ++it) npts[it->UUID()] = it->NPts();
+		});
+
+		// Only Images clocked internally and not waiting on a trigger play for a predictable time
+		const bool timed = (cfg.int_ext == SequenceManager::PointClock::INTERNAL) &&
+			((cfg.trig == SequenceManager::ImageTrigger::CONTINUOUS) || (cfg.trig == SequenceManager::ImageTrigger::POST_DELAY));
+
+		Impl::Tracked s;
+		s.entries.reserve(seq.size());
+		for (auto it = seq.cbegin(); it != seq.cend(); ++it) {
+			Impl::EntryTiming e;
+			e.plays = static_cast<std::uint32_t>(std::max(0, (*it)->NumRpts())) + 1;
+			e.tone = (dynamic_cast<const ToneSequenceEntry*>(it->get()) != nullptr);
+
+			const ImageSequenceEntry* img = dynamic_cast<const ImageSequenceEntry*>(it->get());
+			auto n = npts.find((*it)->UUID());
+			if (timed && (img != nullptr) && (n != npts.end()) && (n->second > 0) && ((double)img->IntOsc() > 0.0)) {
+				e.npts = static_cast<std::uint32_t>(n->second);
+				e.rate = img->IntOsc();
+				e.play = e.npts / e.rate;
+				if (cfg.trig == SequenceManager::ImageTrigger::POST_DELAY) e.play += img->PostImgDelay().count();
+			}
+			s.entries.push_back(e);
 		}
 
-		iorpt->Payload<std::vector<std::uint8_t>>(v);
-		Resp = conn->SendMsgBlocking(*iorpt);
-		if (!Resp.Done() || Resp.GeneralError()) {
-			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download: Sequence commit failed.";
-			p_Impl->m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, 0);
-			delete iorpt;
-			return false;
+		const std::size_t count = s.entries.size();
+		s.start.resize(count + 1, 0.0);
+		for (std::size_t i = 0; i < count; i++) s.start[i + 1] = s.start[i] + s.entries[i].play * s.entries[i].plays;
+		s.nextUntimed.resize(count + 1, count);
+		for (std::size_t i = count; i-- > 0; ) s.nextUntimed[i] = (s.entries[i].play > 0.0) ? s.nextUntimed[i + 1] : i;
+
+		s.loop = count;
+		if (seq.TermAction() == SequenceTermAction::REPEAT) s.loop = 0;
+		else if ((seq.TermAction() == SequenceTermAction::REPEAT_FROM) && (seq.TermValue() >= 0) && ((std::size_t)seq.TermValue() < count)) {
+			s.loop = seq.TermValue();
+		}
+
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		if (count) p_Impl->m_tracked[seq.GetUUID()] = std::move(s);
+	}
+
+	void SequencePositionTracker::Untrack(const ImageSequence& seq)
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		p_Impl->m_tracked.erase(seq.GetUUID());
+	}
+
+	void SequencePositionTracker::ResyncInterval(std::chrono::milliseconds interval)
+	{
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->worker.mutex() };
+			p_Impl->m_resync = interval;
+			p_Impl->m_nextRead = std::chrono::steady_clock::now() + interval;
+		}
+		p_Impl->worker.notify();
+	}
+
+	void SequencePositionTracker::PublishInterval(std::chrono::milliseconds interval)
+	{
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->worker.mutex() };
+			p_Impl->m_publish = interval;
+			p_Impl->m_nextPublish = std::chrono::steady_clock::now() + interval;
 		}
-		delete iorpt;
+		p_Impl->worker.notify();
+	}
 
-		return true;
+	SequencePositionTracker::Position SequencePositionTracker::Estimate() const
+	{
+		return Estimate(std::chrono::steady_clock::now());
 	}
 
+	SequencePositionTracker::Position SequencePositionTracker::Estimate(std::chrono::steady_clock::time_point t) const
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		return p_Impl->EstimateAt(t);
+	}
 
-	void SequenceDownload::SequenceDownloadEventSubscribe(const int message, IEventHandler* handler)
+	std::uint64_t SequencePositionTracker::Published() const
 	{
-		p_Impl->m_Event->Subscribe(message, handler);
+		return p_Impl->m_head.load(std::memory_order_acquire);
 	}
 
-	void SequenceDownload::SequenceDownloadEventUnsubscribe(const int message, const IEventHandler* handler)
+	bool SequencePositionTracker::ReadSample(std::uint64_t& cursor, Sample& s) const
 	{
-		p_Impl->m_Event->Unsubscribe(message, handler);
+		const std::uint64_t capacity = p_Impl->m_capacity;
+		while (true) {
+			const std::uint64_t head = p_Impl->m_head.load(std::memory_order_acquire);
+			if (cursor >= head) return false;
+			if (head - cursor > capacity) cursor = head - capacity;
+
+			const Impl::Slot& slot = p_Impl->m_ring[cursor & (capacity - 1)];
+			const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+			if (seq < 2 * cursor + 2) {
+				// Still being written
+				return false;
+			}
+			if (seq == 2 * cursor + 2) {
+				std::uint64_t w[5];
+				for (int i = 0; i < 5; i++) w[i] = slot.words[i].load(std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.seq.load(std::memory_order_relaxed) == seq) {
+					s.Time = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(static_cast<std::chrono::steady_clock::rep>(w[0])));
+					for (int i = 0; i < 16; i++) s.UUID[i] = static_cast<std::uint8_t>(w[1 + i / 8] >> (8 * (i % 8)));
+					s.Entry = static_cast<std::uint32_t>(w[3]);
+					s.Repeat = static_cast<std::uint32_t>(w[3] >> 32);
+					s.Point = static_cast<std::uint32_t>(w[4]);
+					const std::uint32_t flags = static_cast<std::uint32_t>(w[4] >> 32);
+					s.Valid = (flags & 1) != 0;
+					s.Playing = (flags & 2) != 0;
+					s.Interpolated = (flags & 4) != 0;
+					s.Src = static_cast<Source>((flags >> 8) & 0xff);
+					cursor++;
+					return true;
+				}
+			}
+			// Overwritten while the reader was behind: move on to the oldest Sample still in the ring
+			cursor++;
+		}
 	}
 
-	// Sequence Downloading Thread
-	void SequenceDownload::Impl::DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	/* IMAGE CACHE */
+	class ImageCacheEventTrigger :
+		public IEventTrigger
 	{
-		HostReport* iorpt;
+	public:
+		ImageCacheEventTrigger() { updateCount(ImageCacheEvents::Count); }
+		~ImageCacheEventTrigger() {};
+	};
 
-		while (true) {
-			std::unique_lock<std::mutex> lck{ mtx };
-			cond.wait(lck, [this, &running]() {
-                return downloadRequested || !running;
-            });
+	class ImageCache::Impl
+	{
+	public:
+		using UUID = std::array<std::uint8_t, 16>;
 
-			// Allow thread to terminate 
-			if (!running) break;
-            downloadRequested = false;
+		Impl(std::shared_ptr<IMSSystem> ims, ImageMemoryMap* map);
+		~Impl();
 
-            auto ims = m_ims.lock();
-            if (!ims) break;
-            auto conn = ims->Connection();
+		std::weak_ptr<IMSSystem> m_ims;
+		std::unique_ptr<ImageCacheEventTrigger> m_Event;
 
-			// Create Byte Vector
-			std::uint32_t BytesInSequenceBuffer = FormatSequenceBuffer(m_Seq, ims, *m_seqdata);
-			if (BytesInSequenceBuffer == 0) {
-				BOOST_LOG_SEV(lg::get(), sev::error) << "FormatSequenceBuffer: Unable to create sequence buffer";
-				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
-				continue;
-			}
+		// Waits for the outcome of one ImageDownload
+		class DownloadWaiter : public IEventHandler
+		{
+		public:
+			void EventAction(void* sender, const int message, const int param);
+			// Returns false if the download has not finished within the timeout
+			bool Wait(std::chrono::milliseconds timeout) const { return done.wait_for(timeout); }
+			bool Finished() const { return done.is_set(); }
+			int Result() const { return result.load(); }
+		private:
+			CompletionSignal done;
+			std::atomic<int> result{ ImageDownloadEvents::DOWNLOAD_ERROR };
+		};
+		static constexpr std::chrono::seconds DownloadTimeout{ 30 };
 
-			/* Attempt to Create a new sequence */
-			/* Payload
-			* [15:0] = Sequence UUID
-			* [17:16] = number of entries in sequence
-			* [18] = Use fast fownload
-			* [22:19] = Download size (bytes)
-			* 
-			* OR: (for large sequence supporting firmware)
-			* 
-			* [15:0] = Sequence UUID
-			* [17:16] = set to zero
-			* [18] = Use fast fownload = 1
-			* [22:19] = Download size (bytes)
-			* [26:23] = number of entries in sequence
-			*
-			*/
-			int entries = (int)m_Seq.size();
-			iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-			ReportFields f = iorpt->Fields();
-			f.context = 0;
-			iorpt->Fields(f);
-			std::array<std::uint8_t, 16> uuid = m_Seq.GetUUID();
-			std::vector<std::uint8_t> v(uuid.begin(), uuid.begin() + 16);
-			if (entries <= (int)UINT16_MAX) {
-			v.push_back(entries & 0xff);
-			v.push_back(entries >> 8);
-			}
-			else {
-				v.push_back(0);
-				v.push_back(0);
+		// A download that timed out is kept until it finishes, as its worker thread can't be stopped.  The waiter
+		// is declared first so that it outlives the ImageDownload that signals it.
+		struct AbandonedDownload
+		{
+			std::unique_ptr<DownloadWaiter> waiter;
+			std::unique_ptr<ImageDownload> dl;
+		};
+
+		// Follows sequence playback on an attached SequenceManager
+		class SequenceListener : public IEventHandler
+		{
+		public:
+			SequenceListener(ImageCache::Impl* pl) : m_parent(pl) {};
+			void EventAction(void* sender, const int message, const int param);
+			void EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
+		private:
+			ImageCache::Impl* m_parent;
+		};
+		SequenceListener* Listener;
+
+		// Cache contents, usage and pins, guarded by m_mutex
+		struct PinnedSequence
+		{
+			std::vector<UUID> images;
+			bool queued{ false };       // seen in the Controller's sequence queue
+		};
+		mutable std::mutex m_mutex;
+		std::map<UUID, const Image*> m_images;
+		std::set<UUID> m_loaded;            // downloaded by the cache and not since evicted
+		std::map<UUID, std::uint64_t> m_lastUse;
+		std::uint64_t m_clock{ 0 };
+		std::map<UUID, int> m_pins;
+		std::map<UUID, PinnedSequence> m_sequences;
+
+		// Serialises every download and erase, and guards the members below
+		std::mutex m_dlMutex;
+		std::unique_ptr<ImageMemoryMap> m_map;
+		ImageFormat m_fmt;
+		bool m_fmtSet{ false };
+		SequenceManager* m_mgr{ nullptr };
+		std::unique_ptr<SequenceManager> m_queue;     // reads back the Controller's sequence queue
+		std::vector<AbandonedDownload> m_abandoned;
+
+		// Images waiting to be prefetched, guarded by the prefetch worker's mutex
+		std::deque<UUID> m_prefetch;
+		bool m_resync{ false };
+
+		static std::vector<UUID> SequenceImages(const ImageSequence& seq);
+		void Touch(const UUID& uuid);
+		void Pin(const ImageSequence& seq);
+		void Trigger(int message, int param, const UUID& uuid);
+
+		// Called with m_dlMutex held
+		bool Load(const UUID& uuid);
+		int Download(std::shared_ptr<IMSSystem> ims, const Image& img);
+		bool ReadQueue(std::shared_ptr<IMSSystem> ims, std::vector<UUID>& queue);
+		bool QueuedImages(std::shared_ptr<IMSSystem> ims, std::set<UUID>& images);
+		bool EvictOne(std::shared_ptr<IMSSystem> ims, const UUID& keep, const std::set<UUID>& queued);
+		void Resync();
+
+		LazyWorker prefetchWorker;
+		void PrefetchWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+	};
+
+	ImageCache::Impl::Impl(std::shared_ptr<IMSSystem> ims, ImageMemoryMap* map) :
+		m_ims(ims),
+		m_Event(new ImageCacheEventTrigger()),
+		Listener(new SequenceListener(this)),
+		m_map(map),
+		m_queue(new SequenceManager(ims)),
+		prefetchWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			PrefetchWorkerLoop(running, cond, mtx);
+		})
+	{
+	}
+
+	ImageCache::Impl::~Impl()
+	{
+		{
+			std::unique_lock<std::mutex> lck{ prefetchWorker.mutex() };
+			m_prefetch.clear();
+		}
+		prefetchWorker.stop();
+		delete Listener;
+	}
+
+	void ImageCache::Impl::DownloadWaiter::EventAction(void* sender, const int message, const int param)
+	{
+		switch (message)
+		{
+		case (ImageDownloadEvents::DOWNLOAD_FINISHED) :
+		case (ImageDownloadEvents::DOWNLOAD_ERROR) :
+		case (ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL) :
+		case (ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT) : result.store(message); done.set(); break;
+		}
+	}
+
+	void ImageCache::Impl::SequenceListener::EventAction(void* sender, const int message, const int param)
+	{
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_FINISHED) : {
+			{
+				std::unique_lock<std::mutex> lck{ m_parent->prefetchWorker.mutex() };
+				m_parent->m_resync = true;
 			}
-			v.push_back(1);
-			v.push_back(BytesInSequenceBuffer & 0xff);
-			v.push_back((BytesInSequenceBuffer >> 8) & 0xff);
-			v.push_back((BytesInSequenceBuffer >> 16) & 0xff);
-			v.push_back((BytesInSequenceBuffer >> 24) & 0xff);
-			if (entries > (int)UINT16_MAX) {
-				v.push_back(entries & 0xff);
-				v.push_back((entries >> 8) & 0xff);
-				v.push_back((entries >> 16) & 0xff);
-				v.push_back((entries >> 24) & 0xff);
+			m_parent->prefetchWorker.notify();
+			break;
+		}
+		}
+	}
+
+	void ImageCache::Impl::SequenceListener::EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data)
+	{
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_START) : {
+			if (data.size() >= 16) {
+				UUID uuid;
+				std::copy(data.cbegin(), data.cbegin() + 16, uuid.begin());
+				std::unique_lock<std::mutex> lck{ m_parent->m_mutex };
+				auto it = m_parent->m_sequences.find(uuid);
+				if (it != m_parent->m_sequences.end()) {
+					it->second.queued = true;
+					for (const auto& img : it->second.images) m_parent->m_lastUse[img] = ++m_parent->m_clock;
+				}
 			}
-			iorpt->Payload<std::vector<std::uint8_t>>(v);
-			DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-			if (!Resp.Done() || Resp.GeneralError()) {
-				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download (DownloadWorker): Sequence creation failed.  Insufficient device memory for sequence entries";
-				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
-				delete iorpt;
-				continue;
+			// The sequence before this one may have left the queue
+			{
+				std::unique_lock<std::mutex> lck{ m_parent->prefetchWorker.mutex() };
+				m_parent->m_resync = true;
 			}
-			delete iorpt;
+			m_parent->prefetchWorker.notify();
+			break;
+		}
+		}
+	}
 
-			if (Resp.Fields().len < 4) {
-				BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Download (DownloadWorker): Sequence creation failed.  iMS failed to provide download memory address";
-				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, 0);
-				continue;
-			}
-				
-			std::uint32_t SeqMemoryAddress = Resp.Payload < std::uint32_t >();
-			std::uint32_t SeqMemoryLength = 0x1000000;
+	std::vector<ImageCache::Impl::UUID> ImageCache::Impl::SequenceImages(const ImageSequence& seq)
+	{
+		return SequenceImageUUIDs(seq);
+	}
 
-			if (Resp.Fields().len >= 8) {
-				SeqMemoryLength = Resp.Payload < std::vector <std::uint32_t> >().at(1);
-			}
-			BOOST_LOG_SEV(lg::get(), sev::trace) << "Download Buffer " << SeqMemoryLength << " bytes @ 0x" << std::hex << SeqMemoryAddress << std::dec;
+	void ImageCache::Impl::Touch(const UUID& uuid)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		m_lastUse[uuid] = ++m_clock;
+	}
 
-			// Start memory download
-			int tfr_size = 0;
-			boost::container::deque<std::uint8_t>::iterator bufs = m_seqdata->begin();
-			boost::container::deque<std::uint8_t>::iterator bufe = m_seqdata->end();
+	void ImageCache::Impl::Pin(const ImageSequence& seq)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		auto res = m_sequences.emplace(seq.GetUUID(), PinnedSequence());
+		if (!res.second) return;
+		res.first->second.images = SequenceImages(seq);
+		for (const auto& img : res.first->second.images) m_pins[img]++;
+	}
 
-			//boost::container::deque<std::uint8_t> copy_buf;
+	void ImageCache::Impl::Trigger(int message, int param, const UUID& uuid)
+	{
+		m_Event->Trigger<int, std::vector<std::uint8_t>>((void*)this, message, param, std::vector<std::uint8_t>(uuid.cbegin(), uuid.cend()));
+	}
 
-			do {
-				dmah->Reset();
-				Receiver->Init();
+	int ImageCache::Impl::Download(std::shared_ptr<IMSSystem> ims, const Image& img)
+	{
+		m_abandoned.erase(std::remove_if(m_abandoned.begin(), m_abandoned.end(),
+			[](const AbandonedDownload& a) { return a.waiter->Finished(); }), m_abandoned.end());
+
+		std::unique_ptr<DownloadWaiter> waiter(new DownloadWaiter());
+		std::unique_ptr<ImageDownload> dl(new ImageDownload(ims, img));
+		if (m_fmtSet) dl->SetFormat(m_fmt);
+
+		dl->ImageDownloadEventSubscribe(ImageDownloadEvents::DOWNLOAD_FINISHED, waiter.get());
+		dl->ImageDownloadEventSubscribe(ImageDownloadEvents::DOWNLOAD_ERROR, waiter.get());
+		dl->ImageDownloadEventSubscribe(ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL, waiter.get());
+		dl->ImageDownloadEventSubscribe(ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, waiter.get());
+
+		int result = ImageDownloadEvents::DOWNLOAD_ERROR;
+		if (dl->StartDownload()) {
+			if (!waiter->Wait(DownloadTimeout)) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Image Cache: download of [" << img.Name() << "] timed out";
+				m_abandoned.push_back(AbandonedDownload{ std::move(waiter), std::move(dl) });
+				return ImageDownloadEvents::DOWNLOAD_ERROR;
+			}
+			result = waiter->Result();
+		}
 
-				if (m_seqdata->size() > SeqMemoryLength) {
-					if ((m_seqdata->size() - tfr_size) <= SeqMemoryLength)
-					{
-						bufe = m_seqdata->end();
-					}
-					else
-					{
-						bufe = bufs + SeqMemoryLength;
-					}
-				}
-				boost::container::deque<std::uint8_t> copy_buf(boost::make_move_iterator(bufs), boost::make_move_iterator(bufe));
-				conn->MemoryDownload(copy_buf, SeqMemoryAddress, 0, uuid);
-				uuid[0]++;
+		dl->ImageDownloadEventUnsubscribe(ImageDownloadEvents::DOWNLOAD_FINISHED, waiter.get());
+		dl->ImageDownloadEventUnsubscribe(ImageDownloadEvents::DOWNLOAD_ERROR, waiter.get());
+		dl->ImageDownloadEventUnsubscribe(ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL, waiter.get());
+		dl->ImageDownloadEventUnsubscribe(ImageDownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, waiter.get());
+		return result;
+	}
 
-				while (dmah->Busy()) {
-					std::this_thread::sleep_for(std::chrono::milliseconds(5));
-				}
+	bool ImageCache::Impl::ReadQueue(std::shared_ptr<IMSSystem> ims, std::vector<UUID>& queue)
+	{
+		const std::uint64_t stamp = SequenceImageRegistry::Instance().Stamp();
+		const std::uint16_t n = m_queue->QueueCount();
+		for (int i = 0; i < n; i++) {
+			UUID uuid;
+			if (!m_queue->GetSequenceUUID(i, uuid)) return false;
+			queue.push_back(uuid);
+		}
+		SequenceImageRegistry::Instance().Retain(ims, queue, stamp);
+		return true;
+	}
 
-				tfr_size += dmah->GetTransferredSize();
-				BOOST_LOG_SEV(lg::get(), sev::info) << "Memory Download complete. Transferred " << tfr_size << " bytes.";
+	bool ImageCache::Impl::QueuedImages(std::shared_ptr<IMSSystem> ims, std::set<UUID>& images)
+	{
+		// Every sequence in the queue keeps its Images resident, whether or not it was pinned through the cache
+		std::vector<UUID> queue;
+		if (!ReadQueue(ims, queue)) return false;
+
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		for (const auto& seq : queue) {
+			std::vector<UUID> seqImages;
+			auto it = m_sequences.find(seq);
+			if (it != m_sequences.end()) seqImages = it->second.images;
+			else if (!SequenceImageRegistry::Instance().Get(ims, seq, seqImages)) {
+				BOOST_LOG_SEV(lg::get(), sev::warning) << "Image Cache: Images of a queued sequence not downloaded by this application are not protected from eviction";
+				continue;
+			}
+			images.insert(seqImages.cbegin(), seqImages.cend());
+		}
+		return true;
+	}
 
-				while (Receiver->IsBusy()) {
-	//				std::cout << "Busy" << std::endl;
-					std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	bool ImageCache::Impl::EvictOne(std::shared_ptr<IMSSystem> ims, const UUID& keep, const std::set<UUID>& queued)
+	{
+		// Choose the least recently used Image that isn't pinned or queued.  Only Images added to or downloaded by the
+		// cache are candidates; of those, Images never used through the cache count as oldest.
+		ImageTableEntry victim;
+		bool found = false;
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			std::uint64_t oldest = UINT64_MAX;
+			for (const auto& ite : ims->Ctlr().ImgTable()) {
+				if ((ite.UUID() == keep) || (m_pins.find(ite.UUID()) != m_pins.end()) || (queued.find(ite.UUID()) != queued.end())) continue;
+				if ((m_images.find(ite.UUID()) == m_images.end()) && (m_loaded.find(ite.UUID()) == m_loaded.end())) continue;
+				auto it = m_lastUse.find(ite.UUID());
+				const std::uint64_t used = (it == m_lastUse.end()) ? 0 : it->second;
+				if (used < oldest) {
+					oldest = used;
+					victim = ite;
+					found = true;
 				}
+			}
+		}
+		if (!found) return false;
 
-				if (Receiver->HasError()) {
-					BOOST_LOG_SEV(lg::get(), sev::error) << "Error in sequence download";
-					m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_ERROR, Receiver->ErrorCode());
-						break;
-				}
+		ImageTableViewer itv(ims);
+		if (!itv.Erase(victim)) return false;
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			m_lastUse.erase(victim.UUID());
+			m_loaded.erase(victim.UUID());
+		}
+		BOOST_LOG_SEV(lg::get(), sev::debug) << "Image Cache evicted [" << victim.Name() << "] " << victim.Size() << " bytes";
+		Trigger(ImageCacheEvents::IMAGE_EVICTED, victim.Size(), victim.UUID());
+		return true;
+	}
 
-				bufs += dmah->GetTransferredSize();
-			} while (tfr_size < m_seqdata->size());
+	bool ImageCache::Impl::Load(const UUID& uuid)
+	{
+		auto ims = m_ims.lock();
+		if (!ims || !ims->Ctlr().IsValid()) return false;
 
-			if (tfr_size > 0) {
-				BOOST_LOG_SEV(lg::get(), sev::trace) << "Seq Download Commit";
-				// Transfer complete.  Commit sequence
-				/* Commit Sequence */
-				/* Payload:
-				* [0] = termination type
-				* [4:1] = termination value
-				* [20:5] = termination tag (for Insert mode)
-				*/
-				iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-				f = iorpt->Fields();
-				f.context = 2;
-				iorpt->Fields(f);
-				v.clear();
-				v.push_back(static_cast<std::uint8_t>(m_Seq.TermAction()));
-				std::uint32_t term_val = m_Seq.TermValue();
-				v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
-				v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
-				v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
-				v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
+		const Image* img = nullptr;
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = m_images.find(uuid);
+			if (it != m_images.end()) img = it->second;
+		}
+		if (img == nullptr) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Image Cache: image required that has not been added to the cache";
+			Trigger(ImageCacheEvents::IMAGE_LOAD_FAILED, 0, uuid);
+			return false;
+		}
 
-				if (m_Seq.TermInsertBefore() != nullptr) {
-					const std::array<uint8_t, 16> term_tag = m_Seq.TermInsertBefore()->GetUUID();
-					v.insert(v.end(), term_tag.begin(), term_tag.begin() + 16);
+		if (ims->Ctlr().GetCap().FastImageTransfer) {
+			for (const auto& ite : ims->Ctlr().ImgTable()) {
+				if (ite.Matches(*img)) {
+					Touch(uuid);
+					return true;
 				}
+			}
+		}
 
-				iorpt->Payload<std::vector<std::uint8_t>>(v);
-				conn->SendMsg(*iorpt);
-				delete iorpt;
+		// The queue is read back the first time an Image has to be evicted.  Nothing is evicted if it can't be read.
+		std::set<UUID> queued;
+		bool queueRead = false;
+		auto evict = [&]() -> bool {
+			if (!queueRead && !(queueRead = QueuedImages(ims, queued))) return false;
+			return EvictOne(ims, uuid, queued);
+		};
 
-				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FINISHED, tfr_size);
-			}
-			else {
-//				std::cout << "Seq Download FAIL" << std::endl;
-				// Problem with DMA Transfer
-				m_Event->Trigger<int>((void*)this, DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, tfr_size);
+		if (ims->Ctlr().GetCap().FastImageTransfer) {
+			// Make as much room as the memory map predicts is needed
+			const std::uint64_t bytes = m_map->ImageBytes(*img, m_fmtSet ? m_fmt : ImageFormat(ims));
+			m_map->Refresh();
+			while (!m_map->Fits(bytes)) {
+				if (!evict()) break;
+				m_map->Refresh();
 			}
+		}
 
-			// Release lock, wait for next download trigger
-			lck.unlock();
+		// The Controller has the final word, so keep evicting for as long as it reports that memory is full
+		int result;
+		while ((result = Download(ims, *img)) == ImageDownloadEvents::DOWNLOAD_FAIL_MEMORY_FULL) {
+			if (!ims->Ctlr().GetCap().FastImageTransfer || !evict()) break;
+		}
+		m_map->Refresh();
+
+		if (result != ImageDownloadEvents::DOWNLOAD_FINISHED) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Image Cache: unable to load [" << img->Name() << "]";
+			Trigger(ImageCacheEvents::IMAGE_LOAD_FAILED, 0, uuid);
+			return false;
+		}
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			m_loaded.insert(uuid);
+		}
+		Touch(uuid);
+
+		int bytes = 0;
+		for (const auto& ite : ims->Ctlr().ImgTable()) {
+			if (ite.UUID() == uuid) bytes = ite.Size();
 		}
+		Trigger(ImageCacheEvents::IMAGE_LOADED, bytes, uuid);
+		return true;
 	}
 
-	void SequenceDownload::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	void ImageCache::Impl::Resync()
 	{
-		switch (message)
-		{
-		case (MessageEvents::INTERRUPT_RECEIVED):
-			unsigned int type = (param >> 16);
-			int value = (param & 0xffff);
-			switch (type) {
-			case (CTRLR_INTERRUPT_SEQDL_ERROR): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download ERROR Event Trigger";
-//				std::cout << "Seq Download Error" << std::endl;
-				error.store(true); busy.store(false); error_code = value;
-			}
-			break;
-			case (CTRLR_INTERRUPT_SEQDL_COMPLETE): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download Complete Event Trigger";
-//				std::cout << "Seq Download Complete" << std::endl;
-				error.store(false); busy.store(false); success_code = value;
-			}
-			break;
-			case (CTRLR_INTERRUPT_SEQDL_BUFFER_PROCESSED): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Download Buffer Processed Event Trigger";
-//				std::cout << "Seq Download Complete" << std::endl;
-				error.store(false); busy.store(false);
+		if (m_mgr == nullptr) return;
+		auto ims = m_ims.lock();
+		if (!ims) return;
+
+		std::vector<UUID> queue;
+		if (!ReadQueue(ims, queue)) return;
+
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		for (auto it = m_sequences.begin(); it != m_sequences.end(); ) {
+			if (std::find(queue.cbegin(), queue.cend(), it->first) != queue.cend()) {
+				it->second.queued = true;
+				++it;
 			}
-			break;
+			else if (it->second.queued) {
+				// Played and discarded
+				for (const auto& img : it->second.images) {
+					auto pin = m_pins.find(img);
+					if ((pin != m_pins.end()) && (--pin->second <= 0)) m_pins.erase(pin);
+				}
+				it = m_sequences.erase(it);
 			}
-			break;
+			else ++it;
 		}
 	}
 
-
-	/* SEQUENCE MANAGER */
-	class SequenceEventTrigger :
-		public IEventTrigger
+	// Image Prefetch Thread
+	void ImageCache::Impl::PrefetchWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
-	public:
-		SequenceEventTrigger() { updateCount(SequenceEvents::Count); }
-		~SequenceEventTrigger() {};
-	};
+		while (true) {
+			std::unique_lock<std::mutex> lck{ mtx };
+			cond.wait(lck, [this, &running]() {
+				return !m_prefetch.empty() || m_resync || !running;
+			});
 
+			// Allow thread to terminate
+			if (!running) break;
 
-	class SequenceManager::Impl
-	{
-	public:
-		Impl(std::shared_ptr<IMSSystem>);
-		~Impl();
+			if (m_resync) {
+				m_resync = false;
+				lck.unlock();
+				std::unique_lock<std::mutex> dllck{ m_dlMutex };
+				Resync();
+				continue;
+			}
 
-		std::unique_ptr<SequenceEventTrigger> m_Event;
-		class ResponseReceiver : public IEventHandler
-		{
-		public:
-			ResponseReceiver(SequenceManager::Impl* pl) : m_parent(pl) {};
-			void EventAction(void* sender, const int message, const int param);
-			//void EventAction(void* sender, const int message, const int param, const int param2);
-			void EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
-		private:
-			SequenceManager::Impl* m_parent;
-		};
-		ResponseReceiver* Receiver;
+			const UUID next = m_prefetch.front();
+			m_prefetch.pop_front();
+			lck.unlock();
+			{
+				std::unique_lock<std::mutex> dllck{ m_dlMutex };
+				Load(next);
+			}
 
-		std::weak_ptr<IMSSystem> m_ims;
-	};
+			lck.lock();
+			const bool idle = m_prefetch.empty();
+			lck.unlock();
+			if (idle) m_Event->Trigger<int>((void*)this, ImageCacheEvents::PREFETCH_IDLE, 0);
+		}
+	}
 
-	SequenceManager::Impl::Impl(std::shared_ptr<IMSSystem> ims) :
-		m_Event(new SequenceEventTrigger()),
-		Receiver(new ResponseReceiver(this)),
-		m_ims(ims)
+	ImageCache::ImageCache(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims, new ImageMemoryMap(ims))) {}
+
+	ImageCache::ImageCache(std::shared_ptr<IMSSystem> ims, std::uint32_t base, std::uint64_t size) :
+		p_Impl(new Impl(ims, new ImageMemoryMap(ims, base, size))) {}
+
+	ImageCache::~ImageCache()
 	{
-		// Subscribe listener
-		auto conn = ims->Connection();
-		if (ims->Ctlr().GetVersion().revision > 46) {
-			conn->MessageEventSubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-		}
+		Detach();
+		delete p_Impl;
+		p_Impl = nullptr;
+	}
 
+	void ImageCache::SetFormat(const ImageFormat& fmt)
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+		p_Impl->m_fmt = fmt;
+		p_Impl->m_fmtSet = true;
 	}
 
-	SequenceManager::Impl::~Impl() 
+	void ImageCache::Add(const Image& img)
 	{
-        with_locked(m_ims, [&](std::shared_ptr<IMSSystem> ims) {               
-            // Unsubscribe listener
-            auto conn = ims->Connection();
-            if (ims->Ctlr().GetVersion().revision > 46)
-                conn->MessageEventUnsubscribe(MessageEvents::INTERRUPT_RECEIVED, Receiver);
-        });
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		p_Impl->m_images[img.GetUUID()] = &img;
+	}
 
-		delete Receiver;
+	void ImageCache::Add(const ImageGroup& grp)
+	{
+		for (auto it = grp.cbegin(); it != grp.cend(); ++it) Add(*it);
 	}
 
-	SequenceManager::SequenceManager(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+	void ImageCache::Remove(const Image& img)
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		p_Impl->m_images.erase(img.GetUUID());
+	}
 
-	SequenceManager::~SequenceManager() { delete p_Impl; p_Impl = nullptr; }
+	bool ImageCache::IsResident(const Image& img) const
+	{
+		return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+		{
+			for (const auto& ite : ims->Ctlr().ImgTable()) {
+				if (ite.Matches(img)) return true;
+			}
+			return false;
+		}).value_or(false);
+	}
 
-	bool SequenceManager::StartSequenceQueue(const SequenceManager::SeqConfiguration& cfg, ImageTrigger start_trig)
+	bool ImageCache::Require(const Image& img)
 	{
-        auto ims = p_Impl->m_ims.lock();
-        if (!ims) return false;
-        auto conn = ims->Connection();
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			p_Impl->m_images.emplace(img.GetUUID(), &img);
+		}
+		std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+		return p_Impl->Load(img.GetUUID());
+	}
 
-		// Make sure Controller & Synthesiser are present
-		if (!ims->Ctlr().IsValid()) return false;
-		if (!ims->Synth().IsValid()) return false;
+	bool ImageCache::Require(const ImageSequence& seq)
+	{
+		p_Impl->Pin(seq);
 
-		// Sequences require interrupts, which are only available on Controller firmware versions > 46
-		if (ims->Ctlr().GetVersion().revision <= 46) {
-			BOOST_LOG_SEV(lg::get(), sev::error) << "Sequence Playback failed: Require Controller F/W revision > 46. Yours = " << 
-				ims->Ctlr().GetVersion().revision;
-			return false;
+		bool ok = true;
+		std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+		for (const auto& uuid : Impl::SequenceImages(seq)) {
+			ok &= p_Impl->Load(uuid);
 		}
+		return ok;
+	}
 
-		IMSController::Capabilities cap = ims->Ctlr().GetCap();
+	void ImageCache::Prefetch(const ImageSequence& seq)
+	{
+		p_Impl->Pin(seq);
 
-		if (!cap.FastImageTransfer) return false;
+		const std::vector<Impl::UUID> images = Impl::SequenceImages(seq);
+		if (images.empty()) return;
 
-		// Set ImageFormat (v1.8 - use auto mode only for now)
+		p_Impl->prefetchWorker.start();
 		{
-			HostReport* iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_Img_FormatLo);
-			iorpt->Payload<uint32_t>(0x80000fff);
-
-			if (NullMessage == conn->SendMsg(*iorpt))
-			{
-				delete iorpt;
-				return false;
-			}
-			delete iorpt;
+			std::unique_lock<std::mutex> lck{ p_Impl->prefetchWorker.mutex() };
+			p_Impl->m_prefetch.insert(p_Impl->m_prefetch.end(), images.cbegin(), images.cend());
 		}
+		p_Impl->prefetchWorker.notify();
+	}
 
+	bool ImageCache::MakeRoom(std::uint64_t bytes)
+	{
+		return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
 		{
-			HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Start);
-			std::vector<std::uint8_t> v;
-
-			// Set ImgModes
-			std::uint8_t TFR{ 0 };
-			if (cfg.int_ext == PointClock::EXTERNAL)
-			{
-				TFR |= 4;
-			}
-			switch (cfg.trig)
-			{
-			case ImageTrigger::CONTINUOUS: TFR |= 3; break;
-			case ImageTrigger::EXTERNAL: TFR |= 1; break;
-			case ImageTrigger::HOST: TFR |= 2; break;
-			case ImageTrigger::POST_DELAY: TFR |= 0; break;
-			}
-			v.push_back(TFR);
+			std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+			std::set<Impl::UUID> queued;
+			p_Impl->m_map->Refresh();
+			if (p_Impl->m_map->Fits(bytes)) return true;
+			if (!p_Impl->QueuedImages(ims, queued)) return false;
+			do {
+				if (!p_Impl->EvictOne(ims, Impl::UUID(), queued)) return false;
+				p_Impl->m_map->Refresh();
+			} while (!p_Impl->m_map->Fits(bytes));
+			return true;
+		}).value_or(false);
+	}
 
-			std::uint8_t Pol = 0;
-			Pol |= (cfg.clk_pol == Polarity::INVERSE) ? 1 : 0;
-			Pol |= (cfg.trig_pol == Polarity::INVERSE) ? 2 : 0;
-			v.push_back(Pol);
+	void ImageCache::Touch(const Image& img)
+	{
+		p_Impl->Touch(img.GetUUID());
+	}
 
-			std::uint8_t Play = 0;
-			switch (start_trig)
-			{
-			case ImageTrigger::EXTERNAL: Play |= 2; break;
-			case ImageTrigger::HOST: Play |= 4; break;
-			case ImageTrigger::CONTINUOUS: Play |= 1; break;
-			default: Play |= 1; break;
-			}
-			v.push_back(Play);
+	void ImageCache::Touch(const std::array<std::uint8_t, 16>& uuid)
+	{
+		p_Impl->Touch(uuid);
+	}
 
-			iorpt->Payload < std::vector<std::uint8_t>>(v);
-			conn->SendMsg(*iorpt);
-			delete iorpt;
-		}
+	void ImageCache::Pin(const Image& img)
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		p_Impl->m_pins[img.GetUUID()]++;
+	}
 
-		BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Queue started";
+	void ImageCache::Unpin(const Image& img)
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		auto it = p_Impl->m_pins.find(img.GetUUID());
+		if ((it != p_Impl->m_pins.end()) && (--it->second <= 0)) p_Impl->m_pins.erase(it);
+	}
 
-		return true;
+	void ImageCache::Pin(const ImageSequence& seq)
+	{
+		p_Impl->Pin(seq);
 	}
 
-	void SequenceManager::SendHostTrigger()
+	void ImageCache::Unpin(const ImageSequence& seq)
 	{
-        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {  
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return;
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_USR_Trig);
-            ims->Connection()->SendMsg(*iorpt);
-            delete iorpt;
-        });
-	}   
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		auto it = p_Impl->m_sequences.find(seq.GetUUID());
+		if (it == p_Impl->m_sequences.end()) return;
+		for (const auto& img : it->second.images) {
+			auto pin = p_Impl->m_pins.find(img);
+			if ((pin != p_Impl->m_pins.end()) && (--pin->second <= 0)) p_Impl->m_pins.erase(pin);
+		}
+		p_Impl->m_sequences.erase(it);
+	}
 
-	bool SequenceManager::Stop(ImagePlayer::StopStyle style)
+	void ImageCache::Attach(SequenceManager& mgr)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
+		Detach();
 
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
-            if (!cap.FastImageTransfer) {
-                return false;
-            }
+		p_Impl->prefetchWorker.start();
+		std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+		p_Impl->m_mgr = &mgr;
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Listener);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Listener);
+	}
 
-            auto conn = ims->Connection();
-            HostReport* iorpt;
+	void ImageCache::Detach()
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_dlMutex };
+		if (p_Impl->m_mgr == nullptr) return;
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Listener);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Listener);
+		p_Impl->m_mgr = nullptr;
+	}
 
-            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
-            if (ImagePlayer::StopStyle::IMMEDIATELY == style)
-            {
-                // Force Stop Image
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Force Stop request sent";
-                iorpt->Payload<std::uint8_t>(0);
-            }
-            else {
-                // Gracefully Stop Image at end of currenr repeat
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Graceful Stop request sent";
-                iorpt->Payload<std::uint8_t>(1);
-            }
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false); 
+	void ImageCache::ImageCacheEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
 	}
 
-	bool SequenceManager::StopAtEndOfSequence()
+	void ImageCache::ImageCacheEventUnsubscribe(const int message, const IEventHandler* handler)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {        
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
+		p_Impl->m_Event->Unsubscribe(message, handler);
+	}
+
+	/* PLAYLIST SCHEDULER */
+	class PlaylistEventTrigger :
+		public IEventTrigger
+	{
+	public:
+		PlaylistEventTrigger() { updateCount(PlaylistEvents::Count); }
+		~PlaylistEventTrigger() {};
+	};
+
+	class PlaylistScheduler::Impl
+	{
+	public:
+		using UUID = std::array<std::uint8_t, 16>;
+		using clock = std::chrono::steady_clock;
+
+		Impl(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr);
+		~Impl();
+
+		std::weak_ptr<IMSSystem> m_ims;
+		SequenceManager* m_mgr;
+		std::unique_ptr<PlaylistEventTrigger> m_Event;
+		ImageCache m_cache;
+
+		// Waits for the outcome of one SequenceDownload
+		class DownloadWaiter : public IEventHandler
+		{
+		public:
+			void EventAction(void* sender, const int message, const int param);
+			void Wait() const { done.wait(); }
+			int Result() const { return result.load(); }
+		private:
+			CompletionSignal done;
+			std::atomic<int> result{ DownloadEvents::DOWNLOAD_ERROR };
+		};
 
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
-            if (!cap.FastImageTransfer) {
-                return false;
-            }
+		// Follows playback of the queued steps
+		class SequenceListener : public IEventHandler
+		{
+		public:
+			SequenceListener(PlaylistScheduler::Impl* pl) : m_parent(pl) {};
+			void EventAction(void* sender, const int message, const int param);
+			void EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data);
+		private:
+			PlaylistScheduler::Impl* m_parent;
+		};
+		SequenceListener* Listener;
 
-            auto conn = ims->Connection();
-            HostReport* iorpt;
+		// One step's sequence in the Controller's queue.  The front slot is the one playing, or about to play.
+		struct Slot
+		{
+			std::size_t step;
+			std::unique_ptr<ImageSequence> seq;
+			bool started{ false };
+			std::uint32_t passes{ 0 };
+			clock::time_point startTime;
+			bool ending{ false };       // termination changed to DISCARD
+			unsigned int handovers{ 0 };  // failed attempts to change the termination
+		};
 
-            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Stop);
+		// Attempts to end a step before giving up with HANDOVER_FAILED
+		static constexpr unsigned int HandoverAttempts = 3;
+		static constexpr std::chrono::milliseconds HandoverRetryInterval{ 5 };
+
+		// Playlist and playback state, guarded by m_mutex
+		mutable std::mutex m_mutex;
+		std::vector<Step> m_steps;
+		bool m_loop{ false };
+		std::size_t m_lookahead{ 1 };
+		std::deque<Slot> m_slots;
+		std::size_t m_nextStage{ 0 };   // counts on through every loop of the playlist
+		bool m_running{ false };
+		bool m_failed{ false };
+		bool m_advance{ false };
+		std::uint32_t m_gen{ 0 };       // changed on every Start and Stop, so stale downloads are discarded
+		int m_current{ -1 };
+
+		static std::unique_ptr<ImageSequence> StepSequence(const Step& step);
+		bool Stage(const ImageSequence& seq);
+		void Discard(const ImageSequence& seq, bool queued);
+		bool Exhausted() const;
+		bool Due(const Slot& slot, clock::time_point now) const;
+		void Trigger(int message, std::size_t step) { m_Event->Trigger<int>((void*)this, message, (int)step); }
+		void Halt(ImagePlayer::StopStyle style);
+
+		// Downloads the steps after the one playing
+		bool m_stage{ false };
+		LazyWorker stagingWorker;
+		void StagingWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+
+		// Ends each step when it is due.  Kept apart from the downloads so a step is never held up by a slow one.
+		bool m_evaluate{ false };
+		bool m_finished{ false };
+		LazyWorker controlWorker;
+		void ControlWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+
+		static void Kick(LazyWorker& worker, bool& flag);
+	};
 
-            BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Programmed Stop (end of sequence) request sent";
-            iorpt->Payload<std::uint8_t>(2);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);        
+	PlaylistScheduler::Impl::Impl(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr) :
+		m_ims(ims),
+		m_mgr(&mgr),
+		m_Event(new PlaylistEventTrigger()),
+		m_cache(ims),
+		Listener(new SequenceListener(this)),
+		stagingWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			StagingWorkerLoop(running, cond, mtx);
+		}),
+		controlWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			ControlWorkerLoop(running, cond, mtx);
+		})
+	{
 	}
 
-	bool SequenceManager::Pause(ImagePlayer::StopStyle style)
+	PlaylistScheduler::Impl::~Impl()
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {           
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
-
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
-            if (!cap.FastImageTransfer) {
-                return false;
-            }
-
-            auto conn = ims->Connection();
-            HostReport* iorpt;
+		stagingWorker.stop();
+		controlWorker.stop();
+		delete Listener;
+	}
 
-            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Pause);
-            if (ImagePlayer::StopStyle::IMMEDIATELY == style)
-            {
-                // Force Stop Image
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Immediate Pause request sent";
-                iorpt->Payload<std::uint8_t>(0);
-            }
-            else {
-                // Gracefully Stop Image at end of currenr repeat
-                BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Pause after Entry request sent";
-                iorpt->Payload<std::uint8_t>(1);
-            }
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);          
+	void PlaylistScheduler::Impl::Kick(LazyWorker& worker, bool& flag)
+	{
+		{
+			std::unique_lock<std::mutex> lck{ worker.mutex() };
+			flag = true;
+		}
+		worker.notify();
 	}
 
-	bool SequenceManager::Resume()
+	void PlaylistScheduler::Impl::DownloadWaiter::EventAction(void* sender, const int message, const int param)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {         
-            // Make sure Controller & Synthesiser are present
-            if (!ims->Ctlr().IsValid()) return false;
-            if (!ims->Synth().IsValid()) return false;
+		switch (message)
+		{
+		case (DownloadEvents::DOWNLOAD_FINISHED) :
+		case (DownloadEvents::DOWNLOAD_ERROR) :
+		case (DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT) : result.store(message); done.set(); break;
+		}
+	}
 
-            IMSController::Capabilities cap = ims->Ctlr().GetCap();
-            if (!cap.FastImageTransfer) {
-                return false;
-            }
+	void PlaylistScheduler::Impl::SequenceListener::EventAction(void* sender, const int message, const int param)
+	{
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_FINISHED) :
+		case (SequenceEvents::SEQUENCE_ERROR) : {
+			{
+				std::unique_lock<std::mutex> lck{ m_parent->m_mutex };
+				if (!m_parent->m_running) break;
+			}
+			Kick(m_parent->controlWorker, m_parent->m_finished);
+			break;
+		}
+		}
+	}
 
-            auto conn = ims->Connection();
-            HostReport* iorpt;
+	void PlaylistScheduler::Impl::SequenceListener::EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data)
+	{
+		switch (message)
+		{
+		case (SequenceEvents::SEQUENCE_START) : {
+			if (data.size() < 16) break;
+			UUID uuid;
+			std::copy(data.cbegin(), data.cbegin() + 16, uuid.begin());
+
+			std::vector<std::unique_ptr<ImageSequence>> retired;
+			std::vector<std::size_t> finished;
+			int started = -1;
+			{
+				std::unique_lock<std::mutex> lck{ m_parent->m_mutex };
+				if (!m_parent->m_running) break;
+				auto it = std::find_if(m_parent->m_slots.begin(), m_parent->m_slots.end(),
+					[&uuid](const Slot& s) { return s.seq->GetUUID() == uuid; });
+				if (it == m_parent->m_slots.end()) break;
+
+				// Every step ahead of this one has left the queue
+				while (m_parent->m_slots.begin() != it) {
+					Slot& done = m_parent->m_slots.front();
+					if (done.started) finished.push_back(done.step);
+					retired.push_back(std::move(done.seq));
+					m_parent->m_slots.pop_front();
+					it = m_parent->m_slots.begin();
+				}
+				if (it->started) {
+					it->passes++;
+				}
+				else {
+					it->started = true;
+					it->passes = 1;
+					it->startTime = clock::now();
+					m_parent->m_advance = false;
+					m_parent->m_current = (int)it->step;
+					started = (int)it->step;
+				}
+			}
 
-            iorpt = new HostReport(HostReport::Actions::CTRLR_SEQPLAY, HostReport::Dir::WRITE, CTRLR_SEQPLAY_Seq_Restart);
-            BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Resume request sent";
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);   
+			for (const auto& seq : retired) m_parent->m_cache.Unpin(*seq);
+			for (std::size_t step : finished) m_parent->Trigger(PlaylistEvents::STEP_FINISHED, step);
+			if (started >= 0) {
+				BOOST_LOG_SEV(lg::get(), sev::info) << "Playlist: step " << started << " started";
+				m_parent->Trigger(PlaylistEvents::STEP_STARTED, started);
+			}
+			Kick(m_parent->controlWorker, m_parent->m_evaluate);
+			if (!retired.empty()) Kick(m_parent->stagingWorker, m_parent->m_stage);
+			break;
+		}
+		}
 	}
 
-	std::uint16_t SequenceManager::QueueCount()
+	std::unique_ptr<ImageSequence> PlaylistScheduler::Impl::StepSequence(const Step& step)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> std::uint16_t
-        {         
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return -1;
-            auto conn = ims->Connection();
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 0;
-            f.len = 2;
-            iorpt->Fields(f);
-            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-            delete iorpt;
-
-            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 2) return 0;
-            else {
-                return Resp.Payload<std::uint16_t>();
-            }
-        }).value_or(0);         
+		// A fresh sequence, so each step queued has its own UUID even if the same group is played twice
+		const ImageSequence& src = step.Group->Sequence();
+		std::unique_ptr<ImageSequence> seq;
+		if (src.TermAction() == SequenceTermAction::REPEAT_FROM) {
+			seq.reset(new ImageSequence(SequenceTermAction::REPEAT_FROM, src.TermValue()));
+		}
+		else {
+			seq.reset(new ImageSequence(SequenceTermAction::REPEAT));
+		}
+		for (auto it = src.cbegin(); it != src.cend(); ++it) seq->push_back(*it);
+		return seq;
 	}
 
-	bool SequenceManager::GetSequenceUUID(int index, std::array<std::uint8_t, 16>& uuid)
+	bool PlaylistScheduler::Impl::Stage(const ImageSequence& seq)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {        
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, index);
-            ReportFields f = iorpt->Fields();
-            f.context = 1;
-            f.len = 16;
-            iorpt->Fields(f);
-            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-            delete iorpt;
+		if (!m_cache.Require(seq)) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Playlist: unable to make Images resident for sequence " << UUIDToStr(seq.GetUUID());
+			m_cache.Unpin(seq);
+			return false;
+		}
 
-            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 16) return false;
-            else {
-                std::vector<std::uint8_t> v = Resp.Payload<std::vector<std::uint8_t>>();
-                v.resize(16);
-                std::copy(v.cbegin(), v.cend(), uuid.begin());
-            }
-            return true;
-        }).value_or(false);          
+		const bool ok = with_locked_value(m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+		{
+			SequenceDownload dl(ims, seq);
+			DownloadWaiter waiter;
+			dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+			dl.SequenceDownloadEventSubscribe(DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, &waiter);
+
+			int result = DownloadEvents::DOWNLOAD_ERROR;
+			if (dl.StartDownload()) {
+				waiter.Wait();
+				result = waiter.Result();
+			}
+
+			dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FINISHED, &waiter);
+			dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_ERROR, &waiter);
+			dl.SequenceDownloadEventUnsubscribe(DownloadEvents::DOWNLOAD_FAIL_TRANSFER_ABORT, &waiter);
+			return (result == DownloadEvents::DOWNLOAD_FINISHED);
+		}).value_or(false);
+
+		if (!ok) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Playlist: download failed for sequence " << UUIDToStr(seq.GetUUID());
+			m_cache.Unpin(seq);
+		}
+		return ok;
 	}
 
-	bool SequenceManager::QueueClear()
+	void PlaylistScheduler::Impl::Discard(const ImageSequence& seq, bool queued)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {          
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 5;
-            f.len = 0;
-            iorpt->Fields(f);
-            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-            delete iorpt;
+		if (queued) m_mgr->RemoveSequence(seq.GetUUID());
+		m_cache.Unpin(seq);
+	}
 
-            if (!Resp.Done() || Resp.GeneralError()) return false;
-            return true;
-        }).value_or(false); 
+	// Called with m_mutex held
+	bool PlaylistScheduler::Impl::Exhausted() const
+	{
+		return !m_loop && (m_nextStage >= m_steps.size());
 	}
 
-	bool SequenceManager::RemoveSequence(const std::array<std::uint8_t, 16>& uuid)
+	// Called with m_mutex held
+	bool PlaylistScheduler::Impl::Due(const Slot& slot, clock::time_point now) const
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {         
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 4;
-            f.len = 16;
-            iorpt->Fields(f);
-            std::vector<std::uint8_t> v;
-            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
+		if (!slot.started || slot.ending) return false;
 
-            iorpt->Payload<std::vector<std::uint8_t>>(v);
-            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-            delete iorpt;
+		// Never end a step before the next is in the queue
+		if ((m_slots.size() < 2) && !Exhausted()) return false;
+		if (m_advance) return true;
 
-            if (!Resp.Done() || Resp.GeneralError()) return false;
-            return true;
-        }).value_or(false); 
+		const Step& step = m_steps[slot.step];
+		if (step.Passes == 0) return false;
+		if (slot.passes < step.Passes) return false;
+		return (now >= slot.startTime + step.MinDuration);
 	}
 
-	bool SequenceManager::RemoveSequence(const ImageSequence& seq)
+	// Playlist Staging Thread
+	void PlaylistScheduler::Impl::StagingWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
-		std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
-		return this->RemoveSequence(seq_uuid);
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lck{ mtx };
+				cond.wait(lck, [this, &running]() {
+					return m_stage || !running;
+				});
+
+				// Allow thread to terminate
+				if (!running) break;
+				m_stage = false;
+			}
+
+			// Keep Lookahead steps queued behind the one playing
+			while (true) {
+				std::unique_ptr<ImageSequence> seq;
+				std::size_t step;
+				std::uint32_t gen;
+				{
+					std::unique_lock<std::mutex> lck{ m_mutex };
+					// Start() stages the first step itself
+					if (!m_running || m_failed || m_slots.empty() || Exhausted()) break;
+					if (m_slots.size() > m_lookahead) break;
+					step = m_nextStage % m_steps.size();
+					gen = m_gen;
+					seq = StepSequence(m_steps[step]);
+				}
+
+				const bool ok = Stage(*seq);
+
+				{
+					std::unique_lock<std::mutex> lck{ m_mutex };
+					if (!m_running || (gen != m_gen)) {
+						// Stopped while downloading
+						lck.unlock();
+						if (ok) Discard(*seq, true);
+						break;
+					}
+					if (ok) {
+						Slot slot;
+						slot.step = step;
+						slot.seq = std::move(seq);
+						m_slots.push_back(std::move(slot));
+						m_nextStage++;
+					}
+					else {
+						m_failed = true;
+					}
+				}
+
+				if (ok) {
+					BOOST_LOG_SEV(lg::get(), sev::debug) << "Playlist: step " << step << " staged";
+					Trigger(PlaylistEvents::STEP_STAGED, step);
+					Kick(controlWorker, m_evaluate);
+				}
+				else {
+					Trigger(PlaylistEvents::STAGING_FAILED, step);
+					break;
+				}
+			}
+		}
 	}
 
-	bool SequenceManager::UpdateTermination(const std::array<std::uint8_t, 16>& uuid, SequenceTermAction term, int term_val)
+	// Playlist Control Thread
+	void PlaylistScheduler::Impl::ControlWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {          
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport * iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 3;
-            f.len = 21;
-            iorpt->Fields(f);
-            std::vector<std::uint8_t> v;
-            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
-            v.push_back(static_cast<std::uint8_t>(term));
-            v.push_back(static_cast<std::uint8_t>(term_val & 0xff));
-            v.push_back(static_cast<std::uint8_t>((term_val >> 8) & 0xff));
-            v.push_back(static_cast<std::uint8_t>((term_val >> 16) & 0xff));
-            v.push_back(static_cast<std::uint8_t>((term_val >> 24) & 0xff));
+		clock::time_point due = clock::time_point::max();
+		while (true) {
+			bool finished = false;
+			{
+				std::unique_lock<std::mutex> lck{ mtx };
+				auto ready = [this, &running]() { return m_evaluate || m_finished || !running; };
+				if (due == clock::time_point::max()) cond.wait(lck, ready);
+				else cond.wait_until(lck, due, ready);
+
+				// Allow thread to terminate
+				if (!running) break;
+				m_evaluate = false;
+				finished = m_finished;
+				m_finished = false;
+			}
+
+			if (finished) {
+				// The queue has stopped.  Anything still staged will never play.
+				std::deque<Slot> slots;
+				int last = -1;
+				{
+					std::unique_lock<std::mutex> lck{ m_mutex };
+					if (!m_running) continue;
+					m_running = false;
+					m_gen++;
+					m_current = -1;
+					slots.swap(m_slots);
+				}
+				for (auto& slot : slots) {
+					Discard(*slot.seq, !slot.started);
+					if (slot.started) {
+						Trigger(PlaylistEvents::STEP_FINISHED, slot.step);
+						last = (int)slot.step;
+					}
+				}
+				BOOST_LOG_SEV(lg::get(), sev::info) << "Playlist: finished";
+				Trigger(PlaylistEvents::PLAYLIST_FINISHED, (last < 0) ? 0 : last);
+				due = clock::time_point::max();
+				continue;
+			}
 
-            iorpt->Payload<std::vector<std::uint8_t>>(v);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false); 
+			UUID end;
+			bool ending = false;
+			due = clock::time_point::max();
+			{
+				std::unique_lock<std::mutex> lck{ m_mutex };
+				if (!m_running || m_slots.empty()) continue;
+				Slot& current = m_slots.front();
+				const clock::time_point now = clock::now();
+				if (Due(current, now)) {
+					current.ending = true;
+					ending = true;
+					end = current.seq->GetUUID();
+				}
+				else if (current.started && !current.ending) {
+					// Come back when the minimum duration is up
+					const clock::time_point until = current.startTime + m_steps[current.step].MinDuration;
+					if (until > now) due = until;
+				}
+			}
+
+			if (ending && !m_mgr->UpdateTermination(end, SequenceTermAction::DISCARD, 0)) {
+				BOOST_LOG_SEV(lg::get(), sev::error) << "Playlist: unable to end sequence " << UUIDToStr(end);
+
+				// The step is still set to repeat.  Try again shortly, or give up and stop.
+				bool retry = false;
+				std::size_t step = 0;
+				{
+					std::unique_lock<std::mutex> lck{ m_mutex };
+					if (!m_running || m_slots.empty() || (m_slots.front().seq->GetUUID() != end)) continue;
+					Slot& current = m_slots.front();
+					current.ending = false;
+					step = current.step;
+					retry = (++current.handovers < HandoverAttempts);
+				}
+				if (retry) {
+					due = clock::now() + HandoverRetryInterval;
+				}
+				else {
+					Trigger(PlaylistEvents::HANDOVER_FAILED, step);
+					Halt(ImagePlayer::StopStyle::IMMEDIATELY);
+				}
+			}
+		}
 	}
 
-	bool SequenceManager::UpdateTermination(const std::array<std::uint8_t, 16>& uuid, SequenceTermAction term, const std::array<std::uint8_t, 16>& term_uuid)
+	PlaylistScheduler::PlaylistScheduler(std::shared_ptr<IMSSystem> ims, SequenceManager& mgr) : p_Impl(new Impl(ims, mgr))
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {          
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 3;
-            f.len = 37;
-            iorpt->Fields(f);
-            std::vector<std::uint8_t> v;
-            v.assign(uuid.cbegin(), uuid.cbegin() + 16);
-            v.push_back(static_cast<std::uint8_t>(term));
-            v.insert(v.end(), { 0, 0, 0, 0 });
-            v.insert(v.end(), term_uuid.begin(), term_uuid.begin() + 16);
-
-            iorpt->Payload<std::vector<std::uint8_t>>(v);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);         
+		p_Impl->m_cache.Attach(mgr);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Listener);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Listener);
+		mgr.SequenceEventSubscribe(SequenceEvents::SEQUENCE_ERROR, p_Impl->Listener);
 	}
 
-	bool SequenceManager::UpdateTermination(ImageSequence& seq, SequenceTermAction term, int term_val)
+	PlaylistScheduler::~PlaylistScheduler()
 	{
-		std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
-		seq.OnTermination(term, term_val);
-		return this->UpdateTermination(seq_uuid, term, term_val);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_START, p_Impl->Listener);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_FINISHED, p_Impl->Listener);
+		p_Impl->m_mgr->SequenceEventUnsubscribe(SequenceEvents::SEQUENCE_ERROR, p_Impl->Listener);
+		delete p_Impl;
+		p_Impl = nullptr;
 	}
 
-	bool SequenceManager::UpdateTermination(ImageSequence& seq, SequenceTermAction term, const ImageSequence* term_seq)
+	void PlaylistScheduler::Add(const Step& step)
 	{
-		if (term_seq != nullptr) {
-			std::array<std::uint8_t, 16> seq_uuid = seq.GetUUID();
-			std::array<std::uint8_t, 16> term_seq_uuid = term_seq->GetUUID();
-			seq.OnTermination(term, term_seq);
-			return this->UpdateTermination(seq_uuid, term, term_seq_uuid);
+		p_Impl->m_cache.Add(*step.Group);
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			p_Impl->m_steps.push_back(step);
 		}
-		else return false;
+		Impl::Kick(p_Impl->stagingWorker, p_Impl->m_stage);
 	}
 
-	bool SequenceManager::MoveSequence(const ImageSequence& dest, const ImageSequence& src)
+	void PlaylistScheduler::Clear()
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {         
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 9;
-            f.len = 32;
-            iorpt->Fields(f);
-            std::vector<std::uint8_t> v;
-            auto s = src.GetUUID();
-            auto d = dest.GetUUID();
-            v.assign(d.cbegin(), d.cbegin() + 16);
-            v.insert(v.end(), s.cbegin(), s.cbegin() + 16);
-            iorpt->Payload<std::vector<std::uint8_t>>(v);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);        
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		if (p_Impl->m_running) return;
+		p_Impl->m_steps.clear();
 	}
 
-	bool SequenceManager::MoveSequenceToEnd(const ImageSequence& src)
+	std::size_t PlaylistScheduler::Size() const
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {          
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::WRITE, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 10;
-            f.len = 16;
-            iorpt->Fields(f);
-            std::vector<std::uint8_t> v;
-            auto s = src.GetUUID();
-            v.assign(s.cbegin(), s.cbegin() + 16);
-            iorpt->Payload<std::vector<std::uint8_t>>(v);
-            if (NullMessage == conn->SendMsg(*iorpt))
-            {
-                delete iorpt;
-                return false;
-            }
-            delete iorpt;
-            return true;
-        }).value_or(false);           
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		return p_Impl->m_steps.size();
 	}
 
-	bool SequenceManager::GetCurrentPosition()
+	void PlaylistScheduler::Loop(bool loop)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {          
-            // Make sure Controller is present
-            if (!ims->Ctlr().IsValid()) return false;
-            auto conn = ims->Connection();
-            HostReport* iorpt = new HostReport(HostReport::Actions::CTRLR_SEQQUEUE, HostReport::Dir::READ, 0);
-            ReportFields f = iorpt->Fields();
-            f.context = 8;
-            f.len = 21;
-            iorpt->Fields(f);
-            DeviceReport Resp = conn->SendMsgBlocking(*iorpt);
-            delete iorpt;
-
-            if (!Resp.Done() || Resp.GeneralError() || Resp.Fields().len < 21) return false;
-            else {
-                int value = 0;
-                auto d = Resp.Payload<std::vector<uint8_t>>();
-                value |= ((int)d[1]);
-                value |= ((int)d[2] << 8);
-                value |= ((int)d[3] << 16);
-                value |= ((int)d[4] << 24);
-
-                std::vector<uint8_t> uuid(d.begin() + 5, d.begin() + 21);
-                p_Impl->m_Event->Trigger<int, std::vector<std::uint8_t>>((void*)p_Impl, SequenceEvents::SEQUENCE_POSITION, value, uuid);
-
-                return true;
-            }
-        }).value_or(false);           
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			p_Impl->m_loop = loop;
+		}
+		Impl::Kick(p_Impl->stagingWorker, p_Impl->m_stage);
+		Impl::Kick(p_Impl->controlWorker, p_Impl->m_evaluate);
 	}
 
-	// Notify application when something happens
-	void SequenceManager::SequenceEventSubscribe(const int message, IEventHandler* handler)
+	void PlaylistScheduler::Lookahead(std::size_t steps)
 	{
-		p_Impl->m_Event->Subscribe(message, handler);
-        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {             
-            if (ims->Ctlr().GetVersion().revision >= 38) {
-                int IntrMask;
-                switch (message) {
-                case SequenceEvents::SEQUENCE_START: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_START); break;
-                case SequenceEvents::SEQUENCE_FINISHED: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_FINISHED); break;
-                case SequenceEvents::SEQUENCE_ERROR: IntrMask = (int)(1 << CTRLR_INTERRUPT_SEQUENCE_ERROR); break;
-                case SequenceEvents::SEQUENCE_TONE: IntrMask = (int)(1 << CTRLR_INTERRUPT_TONE_START); break;
-                default: IntrMask = 0;
-                }
-                HostReport *iorpt;
-                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 1);
-                iorpt->Payload<int>(IntrMask);
-                ReportFields f = iorpt->Fields();
-                f.len = sizeof(IntrMask);
-                iorpt->Fields(f);
-                ims->Connection()->SendMsg(*iorpt);
-                delete iorpt;
-            }
-        });
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			p_Impl->m_lookahead = std::max<std::size_t>(steps, 1);
+		}
+		Impl::Kick(p_Impl->stagingWorker, p_Impl->m_stage);
 	}
 
-	void SequenceManager::SequenceEventUnsubscribe(const int message, const IEventHandler* handler)
+	ImageCache& PlaylistScheduler::Cache()
 	{
-		p_Impl->m_Event->Unsubscribe(message, handler);
-        with_locked(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) {   
-            int IntrMask;
-            if (!p_Impl->m_Event->Subscribers(message)) {
-                switch (message) {
-                case SequenceEvents::SEQUENCE_START: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_START); break;
-                case SequenceEvents::SEQUENCE_FINISHED: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_FINISHED); break;
-                case SequenceEvents::SEQUENCE_ERROR: IntrMask = (int)~(1 << CTRLR_INTERRUPT_SEQUENCE_ERROR); break;
-                case SequenceEvents::SEQUENCE_TONE: IntrMask = (int)~(1 << CTRLR_INTERRUPT_TONE_START); break;
-                default: IntrMask = 0;
-                }
-                HostReport *iorpt;
-                iorpt = new HostReport(HostReport::Actions::CTRLR_INTREN, HostReport::Dir::WRITE, 0);
-                iorpt->Payload<int>(IntrMask);
-                ReportFields f = iorpt->Fields();
-                f.len = sizeof(IntrMask);
-                iorpt->Fields(f);
-                ims->Connection()->SendMsg(*iorpt);
-                delete iorpt;
-            }
-        });        
+		return p_Impl->m_cache;
 	}
 
-	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	bool PlaylistScheduler::Start(const SequenceManager::SeqConfiguration& cfg, SequenceManager::ImageTrigger start_trig)
 	{
-		switch (message)
+		std::unique_ptr<ImageSequence> seq;
+		std::uint32_t gen;
 		{
-		case (MessageEvents::INTERRUPT_RECEIVED) :
-			unsigned int type = (param >> 16);
-			int value = (param & 0xffff);
-			switch (type) {
-			case (CTRLR_INTERRUPT_SEQUENCE_FINISHED): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Finished Event Trigger";
-				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_FINISHED, value); break;
-			}
-			case (CTRLR_INTERRUPT_SEQUENCE_ERROR): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Error Event Trigger";
-				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_ERROR, value); break;
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			if (p_Impl->m_running || p_Impl->m_steps.empty()) return false;
+			p_Impl->m_running = true;
+			p_Impl->m_failed = false;
+			p_Impl->m_advance = false;
+			p_Impl->m_current = -1;
+			p_Impl->m_nextStage = 1;
+			gen = ++p_Impl->m_gen;
+			seq = Impl::StepSequence(p_Impl->m_steps.front());
+		}
+
+		// The first step must be in the queue before it can be started
+		if (!p_Impl->Stage(*seq)) {
+			{
+				std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+				p_Impl->m_running = false;
 			}
-			case (CTRLR_INTERRUPT_TONE_START): {
-				BOOST_LOG_SEV(lg::get(), sev::debug) << "Sequence Tone Entry Event Trigger";
-				m_parent->m_Event->Trigger<int>((void*)m_parent, SequenceEvents::SEQUENCE_TONE, value); break;
-				}
+			p_Impl->Trigger(PlaylistEvents::STAGING_FAILED, 0);
+			return false;
+		}
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			if (gen != p_Impl->m_gen) {
+				lck.unlock();
+				p_Impl->Discard(*seq, true);
+				return false;
 			}
+			Impl::Slot slot;
+			slot.step = 0;
+			slot.seq = std::move(seq);
+			p_Impl->m_slots.push_back(std::move(slot));
+		}
+		p_Impl->Trigger(PlaylistEvents::STEP_STAGED, 0);
+
+		p_Impl->stagingWorker.start();
+		p_Impl->controlWorker.start();
+		if (!p_Impl->m_mgr->StartSequenceQueue(cfg, start_trig)) {
+			BOOST_LOG_SEV(lg::get(), sev::error) << "Playlist: unable to start the sequence queue";
+			Stop(ImagePlayer::StopStyle::IMMEDIATELY);
+			return false;
 		}
+		Impl::Kick(p_Impl->stagingWorker, p_Impl->m_stage);
+		return true;
 	}
 
-/*	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param, const int param2)
+	void PlaylistScheduler::Advance()
 	{
-		switch (message)
 		{
-		case (MessageEvents::INTERRUPT_RECEIVED) :
-			unsigned int type = (param >> 16);
-			int value = (param & 0xffff);
-			switch (type) {
-			case (CTRLR_INTERRUPT_SEQUENCE_IMAGE_REPEAT) : m_parent->m_Event->Trigger<int, int>((void *)m_parent, SequenceEvents::SEQUENCE_IMAGE_REPEAT, value, param2); break;
-			}
+			std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+			if (!p_Impl->m_running) return;
+			p_Impl->m_advance = true;
 		}
-	}*/
+		Impl::Kick(p_Impl->controlWorker, p_Impl->m_evaluate);
+	}
 
-	void SequenceManager::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param, const std::vector<std::uint8_t> data)
+	void PlaylistScheduler::Impl::Halt(ImagePlayer::StopStyle style)
 	{
-		switch (message)
+		std::deque<Slot> slots;
 		{
-		case (MessageEvents::INTERRUPT_RECEIVED) :
-			unsigned int type = (param >> 16);
-			int value = (param & 0xffff);
-			switch (type) {
-			case (CTRLR_INTERRUPT_SEQUENCE_START): {
-					BOOST_LOG_SEV(lg::get(), sev::info) << "Sequence Start Event Trigger";
-					m_parent->m_Event->Trigger<int, std::vector<std::uint8_t>>((void*)m_parent, SequenceEvents::SEQUENCE_START, value, data); break;
-				}
-			}
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			if (!m_running) return;
+			m_running = false;
+			m_gen++;
+			m_current = -1;
+			slots.swap(m_slots);
 		}
+
+		m_mgr->Stop(style);
+		for (auto& slot : slots) Discard(*slot.seq, true);
+	}
+
+	void PlaylistScheduler::Stop(ImagePlayer::StopStyle style)
+	{
+		p_Impl->Halt(style);
+	}
+
+	bool PlaylistScheduler::Running() const
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		return p_Impl->m_running;
+	}
+
+	int PlaylistScheduler::Current() const
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_mutex };
+		return p_Impl->m_current;
+	}
+
+	void PlaylistScheduler::PlaylistEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event->Subscribe(message, handler);
+	}
+
+	void PlaylistScheduler::PlaylistEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event->Unsubscribe(message, handler);
 	}
 }
@@ -62,6 +62,13 @@ namespace iMS
 		"PROCESSED_INTERRUPT"
 	};
 
+	namespace {
+		bool IsFinal(Message::Status s)
+		{
+			return (s != Message::Status::UNSENT && s != Message::Status::SENT && s != Message::Status::RX_PARTIAL && s != Message::Status::INTERRUPT);
+		}
+	}
+
 	// Initialise ID Counter
 	MessageHandle Message::mIDCount = 1;
 	
@@ -91,6 +98,25 @@ namespace iMS
         }
 	}
 
+	bool Message::setStatusIf(const Message::Status expected, const Message::Status s)
+	{
+        bool c;
+        {
+            std::unique_lock lock(m_mutex);
+            if (m_status != expected) return false;
+            c = IsFinal(m_status);
+            if ((m_status == Status::UNSENT) && (s > Status::UNSENT)) {
+                m_tm_sent = std::chrono::high_resolution_clock::now();
+            }
+            m_status = s;
+        }
+        if (!c && this->isComplete()) {
+            this->markRecdTime();
+            m_cv.notify_all();
+        }
+        return true;
+	}
+
 	Message::Status Message::getStatus() const
 	{
         std::shared_lock lock(m_mutex);
@@ -98,8 +124,7 @@ namespace iMS
 	}
 
     bool Message::isComplete() const {
-        auto s = this->getStatus();
-        return (s != Status::UNSENT && s != Status::SENT && s != Status::RX_PARTIAL && s != Status::INTERRUPT);
+        return IsFinal(this->getStatus());
     }
 
     // Wait until status changes to RX_OK or timeout
@@ -25,6 +25,7 @@
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <cstdio>
 
 #include "PrivateUtil.h"
 #include "readonlymemvfs.h"
@@ -36,6 +37,10 @@
 extern "C" {
 #include "imshw.h"
 }
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 // Include symbol for the current memory address of the executing module (DLL or EXE)
@@ -295,5 +300,96 @@ namespace iMS {
     std::mutex& LazyWorker::mutex() {
         return workMutex;
     }    
+
+    void CompletionSignal::set() {
+        {
+            std::lock_guard<std::mutex> lck(mtx);
+            done = true;
+        }
+        cond.notify_all();
+    }
+
+    void CompletionSignal::reset() {
+        std::lock_guard<std::mutex> lck(mtx);
+        done = false;
+    }
+
+    bool CompletionSignal::is_set() const {
+        std::lock_guard<std::mutex> lck(mtx);
+        return done;
+    }
+
+    void CompletionSignal::wait() const {
+        std::unique_lock<std::mutex> lck(mtx);
+        cond.wait(lck, [this] { return done; });
+    }
+
+    bool CompletionSignal::wait_for(std::chrono::milliseconds timeout) const {
+        std::unique_lock<std::mutex> lck(mtx);
+        return cond.wait_for(lck, timeout, [this] { return done; });
+    }
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& fileName) {
+        // FILE_SHARE_DELETE lets the file be replaced (see RenameReplacing) while it is mapped
+        HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || (size.QuadPart == 0)) {
+            CloseHandle(file);
+            return;
+        }
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) {
+            CloseHandle(file);
+            return;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == NULL) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return;
+        }
+        m_file = file;
+        m_mapping = mapping;
+        m_data = static_cast<const char*>(view);
+        m_size = static_cast<std::size_t>(size.QuadPart);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file) CloseHandle(m_file);
+    }
+
+    bool RenameReplacing(const std::string& replacement, const std::string& fileName) {
+        return (MoveFileExA(replacement.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
+    }
+#else
+    MappedFile::MappedFile(const std::string& fileName) {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                m_data = static_cast<const char*>(view);
+                m_size = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        // The mapping holds its own reference to the file
+        close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    bool RenameReplacing(const std::string& replacement, const std::string& fileName) {
+        return (std::rename(replacement.c_str(), fileName.c_str()) == 0);
+    }
+#endif
  
 }
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------
+/ Title      : Receive Handoff CPP
+/ Project    : Isomet Modular Synthesiser System
+/------------------------------------------------------------------------------
+/ File       : $URL: http://nutmeg/svn/sw/trunk/09-Isomet/iMS_SDK/API/ConnectionManager/src/RxHandoff.cpp $
+/ Author     : $Author: dave $
+/ Company    : Isomet (UK) Ltd
+/ Created    : 2026-10-18
+/ Last update: $Date: 2026-10-18 10:00:00 +0100 (Sun, 18 Oct 2026) $
+/ Platform   :
+/ Standard   : C++17
+/ Revision   : $Rev: 602 $
+/------------------------------------------------------------------------------
+/ Description:
+/------------------------------------------------------------------------------
+/ Copyright (c) 2026 Isomet (UK) Ltd. All Rights Reserved.
+/------------------------------------------------------------------------------
+/ Revisions  :
+/ Date        Version  Author  Description
+/ 2026-10-18  1.0      dc      Created
+/
+/----------------------------------------------------------------------------*/
+
+#include "RxHandoff.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace iMS {
+
+	RxWakeup::RxWakeup()
+		: m_spinCount(std::thread::hardware_concurrency() > 1 ? 1000 : 0)
+	{
+	}
+
+	RxWakeup::~RxWakeup()
+	{
+	}
+
+#if defined(__linux__)
+
+	void RxWakeup::Signal()
+	{
+		m_seq.fetch_add(1, std::memory_order_seq_cst);
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_seq), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+	}
+
+	void RxWakeup::Sleep(Clock::time_point deadline, std::uint32_t seq)
+	{
+		auto remaining = deadline - Clock::now();
+		if (remaining <= Clock::duration::zero()) return;
+
+		struct timespec ts;
+		auto secs = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+		ts.tv_sec = static_cast<time_t>(secs.count());
+		ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - secs).count());
+
+		// Returns immediately if the sequence number has already moved on
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_seq), FUTEX_WAIT_PRIVATE, seq, &ts, nullptr, 0);
+	}
+
+#else
+
+	void RxWakeup::Signal()
+	{
+		{
+			std::lock_guard<std::mutex> lck{ m_mutex };
+			m_seq.fetch_add(1, std::memory_order_seq_cst);
+		}
+		m_cond.notify_one();
+	}
+
+	void RxWakeup::Sleep(Clock::time_point deadline, std::uint32_t seq)
+	{
+		std::unique_lock<std::mutex> lck{ m_mutex };
+		m_cond.wait_until(lck, deadline, [&] { return m_seq.load() != seq; });
+	}
+
+#endif
+
+}
@@ -24,6 +24,8 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <deque>
+#include <map>
 //#include <iostream>
 
 #include "IMSTypeDefs_p.h"
@@ -46,6 +48,81 @@ namespace iMS
 		~SignalPathEventTrigger() {};
 	};
 
+	// Last value written to SYNTH_REG_UseLocal on each system.  Lets ToneIndexStream change the LTB index
+	// without first reading the register back to preserve its control source and compensation bits.
+	class UseLocalShadow
+	{
+	public:
+		static UseLocalShadow& Instance()
+		{
+			static UseLocalShadow shadow;
+			return shadow;
+		}
+
+		bool Get(std::shared_ptr<IMSSystem> ims, std::uint16_t& value)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) return false;
+			value = it->second.value;
+			return true;
+		}
+
+		// Returns the shadow, reading the register from the Synthesiser if it is not yet known
+		bool Fetch(std::shared_ptr<IMSSystem> ims, std::uint16_t& value)
+		{
+			if (Get(ims, value)) return true;
+
+			HostReport *iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::READ, SYNTH_REG_UseLocal);
+			DeviceReport Resp = ims->Connection()->SendMsgBlocking(*iorpt);
+			delete iorpt;
+			if (!Resp.Done()) return false;
+
+			value = Resp.Payload<std::uint16_t>();
+			Set(ims, value);
+			return true;
+		}
+
+		void Set(std::shared_ptr<IMSSystem> ims, std::uint16_t value)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) {
+				it = m_shadow.emplace(ims.get(), Entry{ ims, 0 }).first;
+			}
+			it->second.value = value;
+		}
+
+		void Invalidate(std::shared_ptr<IMSSystem> ims)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it != m_shadow.end()) m_shadow.erase(it);
+		}
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<IMSSystem> owner;
+			std::uint16_t value;
+		};
+		using ShadowMap = std::map<const IMSSystem*, Entry>;
+
+		// Finds the entry for a system, discarding any left by a destroyed system at the same address
+		ShadowMap::iterator Find(std::shared_ptr<IMSSystem> ims)
+		{
+			auto it = m_shadow.find(ims.get());
+			if ((it != m_shadow.end()) && (it->second.owner.lock() != ims)) {
+				m_shadow.erase(it);
+				return m_shadow.end();
+			}
+			return it;
+		}
+
+		std::mutex m_mutex;
+		ShadowMap m_shadow;
+	};
+
 	class SignalPath::Impl
 	{
 	public:
@@ -1831,9 +1908,11 @@ namespace iMS
             if (NullMessage == conn->SendMsg(*iorpt))
             {
                 delete iorpt;
+                UseLocalShadow::Instance().Invalidate(ims);
                 return false;
             }
             delete iorpt;
+            UseLocalShadow::Instance().Set(ims, data);
             return true;
         }).value_or(false); 
 	}
@@ -1871,9 +1950,11 @@ namespace iMS
             if (NullMessage == conn->SendMsg(*iorpt))
             {
                 delete iorpt;
+                UseLocalShadow::Instance().Invalidate(ims);
                 return false;
             }
             delete iorpt;
+            UseLocalShadow::Instance().Set(ims, data);
             return true;
         }).value_or(false); 
 	}
@@ -1907,9 +1988,11 @@ namespace iMS
             if (NullMessage == conn->SendMsg(*iorpt))
             {
                 delete iorpt;
+                UseLocalShadow::Instance().Invalidate(ims);
                 return false;
             }
             delete iorpt;
+            UseLocalShadow::Instance().Set(ims, data);
             return true;
         }).value_or(false); 
 	}
@@ -1943,9 +2026,11 @@ namespace iMS
             if (NullMessage == conn->SendMsg(*iorpt))
             {
                 delete iorpt;
+                UseLocalShadow::Instance().Invalidate(ims);
                 return false;
             }
             delete iorpt;
+            UseLocalShadow::Instance().Set(ims, data);
             return true;
         }).value_or(false); 
 	}
@@ -2408,4 +2493,302 @@ namespace iMS
         }
 	}
 
+	class ToneIndexStreamEventTrigger :
+		public IEventTrigger
+	{
+	public:
+		ToneIndexStreamEventTrigger() { updateCount(ToneIndexStreamEvents::Count); }
+		~ToneIndexStreamEventTrigger() {};
+	};
+
+	class ToneIndexStream::Impl
+	{
+	public:
+		Impl(std::shared_ptr<IMSSystem>);
+		~Impl();
+
+		std::weak_ptr<IMSSystem> m_ims;
+		ToneIndexStreamEventTrigger m_Event;
+
+		class ResponseReceiver : public IEventHandler
+		{
+		public:
+			ResponseReceiver(ToneIndexStream::Impl* ts) : m_parent(ts) {};
+			void EventAction(void* sender, const int message, const int param);
+		private:
+			ToneIndexStream::Impl* m_parent;
+		};
+		ResponseReceiver* Receiver;
+
+		struct Update
+		{
+			Clock::time_point at;
+			std::uint16_t index;
+		};
+
+		bool Enqueue(const std::vector<Update>& updates);
+
+		// Indices waiting to be sent, guarded by the send worker's mutex
+		std::deque<Update> m_queue;
+		std::atomic<std::size_t> m_queued{ 0 };
+
+		// Index updates sent but not yet acknowledged, by message handle
+		std::map<MessageHandle, std::uint16_t> m_outstanding;
+		mutable std::mutex m_outMutex;
+		std::condition_variable m_outCond;      // signals when there is room for more messages
+		const std::size_t m_watermark = 32;     // messages in flight before sending pauses
+		bool m_closing{ false };
+		bool m_sending{ false };                // an update has been taken from the queue but not yet recorded
+
+		void Completed(MessageHandle handle, bool ok);
+		// Called by the send worker when it has finished with an update that is not awaiting acknowledgement
+		void Settled();
+
+		LazyWorker sendWorker;
+		void SendWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx);
+	};
+
+	ToneIndexStream::Impl::Impl(std::shared_ptr<IMSSystem> ims) :
+		m_ims(ims), Receiver(new ResponseReceiver(this)),
+		sendWorker([this](std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx) {
+			SendWorkerLoop(running, cond, mtx);
+		})
+	{
+		auto conn = ims->Connection();
+		conn->MessageEventSubscribe(MessageEvents::SEND_ERROR, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+		conn->MessageEventSubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+	}
+
+	ToneIndexStream::Impl::~Impl()
+	{
+		// Release the send worker if it is waiting for acknowledgements, then stop it
+		{
+			std::unique_lock<std::mutex> lck{ m_outMutex };
+			m_closing = true;
+		}
+		m_outCond.notify_all();
+		sendWorker.stop();
+
+		with_locked(m_ims, [this](std::shared_ptr<IMSSystem> ims) {
+			auto conn = ims->Connection();
+			conn->MessageEventUnsubscribe(MessageEvents::SEND_ERROR, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::TIMED_OUT_ON_SEND, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_RECEIVED, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_VALID, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_TIMED_OUT, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_CRC, Receiver);
+			conn->MessageEventUnsubscribe(MessageEvents::RESPONSE_ERROR_INVALID, Receiver);
+		});
+
+		delete Receiver;
+	}
+
+	void ToneIndexStream::Impl::ResponseReceiver::EventAction(void* sender, const int message, const int param)
+	{
+		switch (message)
+		{
+		case (MessageEvents::RESPONSE_RECEIVED) :
+		case (MessageEvents::RESPONSE_ERROR_VALID) : m_parent->Completed(param, true); break;
+		case (MessageEvents::TIMED_OUT_ON_SEND) :
+		case (MessageEvents::SEND_ERROR) :
+		case (MessageEvents::RESPONSE_TIMED_OUT) :
+		case (MessageEvents::RESPONSE_ERROR_CRC) :
+		case (MessageEvents::RESPONSE_ERROR_INVALID) : m_parent->Completed(param, false); break;
+		}
+	}
+
+	void ToneIndexStream::Impl::Completed(MessageHandle handle, bool ok)
+	{
+		std::uint16_t index;
+		bool idle;
+		{
+			std::unique_lock<std::mutex> lck{ m_outMutex };
+			auto it = m_outstanding.find(handle);
+			if (it == m_outstanding.end()) return;
+			index = it->second;
+			m_outstanding.erase(it);
+			idle = m_outstanding.empty() && (m_queued == 0) && !m_sending;
+		}
+		m_outCond.notify_one();
+
+		if (!ok) {
+			// The register may not hold what was last written, so read it back before the next update
+			with_locked(m_ims, [](std::shared_ptr<IMSSystem> ims) { UseLocalShadow::Instance().Invalidate(ims); });
+			m_Event.Trigger<int>((void *)this, ToneIndexStreamEvents::WRITE_ERROR, index);
+		}
+		if (idle) m_Event.Trigger<int>((void *)this, ToneIndexStreamEvents::STREAM_IDLE, 0);
+	}
+
+	void ToneIndexStream::Impl::Settled()
+	{
+		bool idle;
+		{
+			std::unique_lock<std::mutex> lck{ m_outMutex };
+			m_sending = false;
+			idle = m_outstanding.empty() && (m_queued == 0);
+		}
+		if (idle) m_Event.Trigger<int>((void *)this, ToneIndexStreamEvents::STREAM_IDLE, 0);
+	}
+
+	bool ToneIndexStream::Impl::Enqueue(const std::vector<Update>& updates)
+	{
+		return with_locked_value(m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+		{
+			if (!ims->Synth().IsValid()) return false;
+
+			// Establish the shadow here rather than on the send worker, so the caller learns of a failure
+			std::uint16_t data;
+			if (!UseLocalShadow::Instance().Fetch(ims, data)) return false;
+
+			sendWorker.start();
+			{
+				std::unique_lock<std::mutex> lck{ sendWorker.mutex() };
+				m_queue.insert(m_queue.end(), updates.begin(), updates.end());
+				m_queued = m_queue.size();
+			}
+			sendWorker.notify();
+			return true;
+		}).value_or(false);
+	}
+
+	// Index Update Sending Thread
+	void ToneIndexStream::Impl::SendWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
+	{
+		while (true) {
+			std::unique_lock<std::mutex> lck{ mtx };
+			cond.wait(lck, [this, &running]() {
+				return !m_queue.empty() || !running;
+			});
+
+			// Allow thread to terminate
+			if (!running) break;
+
+			// Sleep until the next update is due.  Pushing or clearing wakes the thread to look again.
+			const Update next = m_queue.front();
+			if (next.at > Clock::now()) {
+				cond.wait_until(lck, next.at);
+				continue;
+			}
+			m_queue.pop_front();
+			{
+				std::unique_lock<std::mutex> outlck{ m_outMutex };
+				m_sending = true;
+				m_queued = m_queue.size();
+			}
+			lck.unlock();
+
+			auto ims = m_ims.lock();
+			if (!ims) break;
+
+			std::uint16_t data;
+			if (!UseLocalShadow::Instance().Fetch(ims, data)) {
+				m_Event.Trigger<int>((void *)this, ToneIndexStreamEvents::WRITE_ERROR, next.index);
+				Settled();
+				continue;
+			}
+			const std::uint16_t update = static_cast<std::uint16_t>((data & ~0xFF) | next.index);
+			// Register already holds this index
+			if (update == data) {
+				Settled();
+				continue;
+			}
+
+			HostReport *iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_UseLocal);
+			iorpt->Payload<std::uint16_t>(update);
+			MessageHandle h;
+			{
+				// THROTTLE: wait until there is room for another message, then send and record it under the same
+				// lock so the acknowledgement can't arrive before the handle is known
+				std::unique_lock<std::mutex> outlck{ m_outMutex };
+				m_outCond.wait(outlck, [&]() {
+					return m_closing || !running || (m_outstanding.size() < m_watermark);
+				});
+				if (m_closing || !running) {
+					delete iorpt;
+					break;
+				}
+				h = ims->Connection()->SendMsg(*iorpt);
+				if (NullMessage != h) {
+					m_outstanding[h] = next.index;
+					m_sending = false;
+					// Before the acknowledgement can be processed, so a failure always invalidates it
+					UseLocalShadow::Instance().Set(ims, update);
+				}
+			}
+			delete iorpt;
+
+			if (NullMessage == h) {
+				UseLocalShadow::Instance().Invalidate(ims);
+				m_Event.Trigger<int>((void *)this, ToneIndexStreamEvents::WRITE_ERROR, next.index);
+				Settled();
+				continue;
+			}
+		}
+	}
+
+	ToneIndexStream::ToneIndexStream(std::shared_ptr<IMSSystem> ims) : p_Impl(new Impl(ims)) {}
+
+	ToneIndexStream::~ToneIndexStream() { delete p_Impl; p_Impl = nullptr; }
+
+	bool ToneIndexStream::Push(unsigned int index)
+	{
+		return Push(index, Clock::time_point());
+	}
+
+	bool ToneIndexStream::Push(unsigned int index, Clock::time_point at)
+	{
+		const std::uint16_t index_lim = static_cast<std::uint16_t>(std::min<unsigned int>(index, 255u));
+		return p_Impl->Enqueue({ Impl::Update{ at, index_lim } });
+	}
+
+	bool ToneIndexStream::Push(const std::vector<unsigned int>& indices, std::chrono::microseconds period, Clock::time_point start)
+	{
+		BOOST_LOG_SEV(lg::get(), sev::trace) << "ToneIndexStream::Push(" << indices.size() << " indices, " << period.count() << "us)";
+		if (start == Clock::time_point()) start = Clock::now();
+
+		std::vector<Impl::Update> updates;
+		updates.reserve(indices.size());
+		for (std::size_t i = 0; i < indices.size(); i++) {
+			const std::uint16_t index_lim = static_cast<std::uint16_t>(std::min<unsigned int>(indices[i], 255u));
+			updates.push_back(Impl::Update{ start + period * static_cast<long>(i), index_lim });
+		}
+		return p_Impl->Enqueue(updates);
+	}
+
+	void ToneIndexStream::Clear()
+	{
+		{
+			std::unique_lock<std::mutex> lck{ p_Impl->sendWorker.mutex() };
+			p_Impl->m_queue.clear();
+			p_Impl->m_queued = 0;
+		}
+		p_Impl->sendWorker.notify();
+	}
+
+	std::size_t ToneIndexStream::Queued() const
+	{
+		return p_Impl->m_queued;
+	}
+
+	std::size_t ToneIndexStream::Outstanding() const
+	{
+		std::unique_lock<std::mutex> lck{ p_Impl->m_outMutex };
+		return p_Impl->m_outstanding.size();
+	}
+
+	void ToneIndexStream::ToneIndexStreamEventSubscribe(const int message, IEventHandler* handler)
+	{
+		p_Impl->m_Event.Subscribe(message, handler);
+	}
+
+	void ToneIndexStream::ToneIndexStreamEventUnsubscribe(const int message, const IEventHandler* handler)
+	{
+		p_Impl->m_Event.Unsubscribe(message, handler);
+	}
+
 }
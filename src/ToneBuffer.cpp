@@ -36,7 +36,9 @@
 #include <condition_variable>
 #include <thread>
 #include <list>
+#include <map>
 #include <iostream>
+#include <tuple>
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -151,6 +153,72 @@ namespace iMS {
 		return p_Impl->m_name;
 	}
 
+	// Record of the Local Tone Buffer contents last downloaded successfully to each iMS System, one entry
+	// per LTB index in the format sent to the Synthesiser.  An empty entry is one whose contents are not
+	// known.  The record is only kept for the current connection.  Used for incremental downloads.
+	class LTBShadowRegistry
+	{
+	public:
+		using Entries = std::array<std::vector<std::uint8_t>, std::tuple_size<ToneBuffer::TBArray>::value>;
+
+		static LTBShadowRegistry& Instance()
+		{
+			static LTBShadowRegistry reg;
+			return reg;
+		}
+
+		bool Get(std::shared_ptr<IMSSystem> ims, Entries& entries)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) return false;
+			entries = it->second.entries;
+			return true;
+		}
+
+		void Set(std::shared_ptr<IMSSystem> ims, const std::map<int, std::vector<std::uint8_t>>& changed)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) {
+				it = m_shadow.emplace(ims.get(), Entry{ ims, ims->ConnectionEpoch(), {} }).first;
+			}
+			for (const auto& e : changed) it->second.entries[e.first] = e.second;
+		}
+
+		void Invalidate(std::shared_ptr<IMSSystem> ims, const std::map<int, std::vector<std::uint8_t>>& changed)
+		{
+			std::unique_lock<std::mutex> lck{ m_mutex };
+			auto it = Find(ims);
+			if (it == m_shadow.end()) return;
+			for (const auto& e : changed) it->second.entries[e.first].clear();
+		}
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<IMSSystem> owner;
+			std::uint32_t epoch;
+			Entries entries;
+		};
+		using ShadowMap = std::map<const IMSSystem*, Entry>;
+
+		// Finds the entry for a system, discarding any left by a destroyed system at the same address
+		// or recorded before the system was last connected or disconnected
+		ShadowMap::iterator Find(std::shared_ptr<IMSSystem> ims)
+		{
+			auto it = m_shadow.find(ims.get());
+			if ((it != m_shadow.end()) && ((it->second.owner.lock() != ims) || (it->second.epoch != ims->ConnectionEpoch()))) {
+				m_shadow.erase(it);
+				return m_shadow.end();
+			}
+			return it;
+		}
+
+		std::mutex m_mutex;
+		ShadowMap m_shadow;
+	};
+
 	class ToneBufferDownload::Impl
 	{
 	public:
@@ -163,6 +231,14 @@ namespace iMS {
 		ToneBufferEventTrigger m_Event;
 
 		void AddPointToVector(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>&, const TBEntry&, bool toEEPROM);
+		// Everything written to the Synthesiser to program one LTB entry: the ProgSyncDig register block,
+		// followed by the ProgFreq0L register if the frequency is wider than 16 bits
+		void FormatEntry(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>&, const TBEntry&);
+		bool StartDownload(ToneBuffer::const_iterator first, ToneBuffer::const_iterator last, bool incremental);
+		void DownloadFinished();
+		// Waits for room in dl_list, then sends the report and records its handle.  The handle is added
+		// under the same lock as the send, so a fast response can never arrive before it is listed.
+		bool SendThrottled(const std::shared_ptr<IConnectionManager>& conn, HostReport* iorpt, std::atomic<bool>& running);
 
 		class ResponseReceiver : public IEventHandler
 		{
@@ -177,6 +253,11 @@ namespace iMS {
 		ToneBuffer::const_iterator first;
 		ToneBuffer::const_iterator last;
 		int offset;
+		bool m_incremental{ false };
+
+		// Entries sent by the current download, recorded in the LTB shadow once it completes
+		std::map<int, std::vector<std::uint8_t>> m_pending;
+		bool m_failed{ false };
 
 		std::list <MessageHandle> dl_list;
 		MessageHandle dl_final;
@@ -297,23 +378,30 @@ namespace iMS {
 
 	bool ToneBufferDownload::StartDownload(ToneBuffer::const_iterator first, ToneBuffer::const_iterator last)
 	{
-        return with_locked_value(p_Impl->m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
-        {         
-            BOOST_LOG_SEV(lg::get(), sev::trace) << "ToneBufferDownload::StartDownload(ToneBuffer::const_iterator first, ToneBuffer::const_iterator last)";
-            p_Impl->first = first;
-            p_Impl->last = last;
-            p_Impl->offset = static_cast<int>(std::distance(p_Impl->m_tb.cbegin(), first));
+        BOOST_LOG_SEV(lg::get(), sev::trace) << "ToneBufferDownload::StartDownload(ToneBuffer::const_iterator first, ToneBuffer::const_iterator last)";
+		return p_Impl->StartDownload(first, last, false);
+	}
 
+	bool ToneBufferDownload::StartIncrementalDownload()
+	{
+        BOOST_LOG_SEV(lg::get(), sev::trace) << "ToneBufferDownload::StartIncrementalDownload()";
+		return p_Impl->StartDownload(p_Impl->m_tb.cbegin(), p_Impl->m_tb.cend(), true);
+	}
+
+	bool ToneBufferDownload::Impl::StartDownload(ToneBuffer::const_iterator first, ToneBuffer::const_iterator last, bool incremental)
+	{
+        return with_locked_value(m_ims, [&](std::shared_ptr<IMSSystem> ims) -> bool
+        {         
             // Make sure Synthesiser is present
             if (!ims->Synth().IsValid()) return false;
 
-            p_Impl->rxWorker.start();
-            p_Impl->downloadWorker.start();
+            rxWorker.start();
+            downloadWorker.start();
 
             int retries=10;
             while (retries)
             {
-                std::unique_lock<std::mutex> lck{ p_Impl->downloadWorker.mutex(), std::try_to_lock };
+                std::unique_lock<std::mutex> lck{ downloadWorker.mutex(), std::try_to_lock };
 
                 if (!lck.owns_lock()) {
                     if (!--retries) return false;
@@ -322,7 +410,7 @@ namespace iMS {
                     continue;
                 }
 
-                std::unique_lock<std::mutex> rxlck{ p_Impl->rxWorker.mutex(), std::try_to_lock };
+                std::unique_lock<std::mutex> rxlck{ rxWorker.mutex(), std::try_to_lock };
 
                 if (!rxlck.owns_lock()) {
                     if (!--retries) return false;
@@ -331,14 +419,19 @@ namespace iMS {
                     continue;
                 }
 
-                p_Impl->dl_list.clear();
-                p_Impl->downloadRequested = true;
+                this->first = first;
+                this->last = last;
+                this->offset = static_cast<int>(std::distance(m_tb.cbegin(), first));
+                m_incremental = incremental;
+
+                dl_list.clear();
+                downloadRequested = true;
                 lck.unlock();
 
                 break;
             }
             
-            p_Impl->downloadWorker.notify();
+            downloadWorker.notify();
             return true;   
         }).value_or(false); 
 	}
@@ -385,6 +478,41 @@ namespace iMS {
 		} while (chan++ < RFChannel::max);
 	}
 
+	void ToneBufferDownload::Impl::FormatEntry(std::shared_ptr<IMSSystem> ims, std::vector<std::uint8_t>& entry_data, const TBEntry& tbe)
+	{
+		AddPointToVector(ims, entry_data, tbe, false);
+
+		const int freqBits = ims->Synth().GetCap().freqBits;
+		if (freqBits > 16)
+		{
+			unsigned int freq = FrequencyRenderer::RenderAsImagePoint(ims, tbe.GetFAP(RFChannel::min).freq);
+			entry_data.push_back(static_cast<std::uint8_t>((freq >> (freqBits - 32)) & 0xFF));
+			entry_data.push_back(static_cast<std::uint8_t>((freq >> (freqBits - 24)) & 0xFF));
+		}
+	}
+
+	void ToneBufferDownload::Impl::DownloadFinished()
+	{
+		if (auto ims = m_ims.lock()) {
+			if (m_failed) LTBShadowRegistry::Instance().Invalidate(ims, m_pending);
+			else LTBShadowRegistry::Instance().Set(ims, m_pending);
+		}
+		m_Event.Trigger<int>((void *)this, ToneBufferEvents::DOWNLOAD_FINISHED, 0);
+	}
+
+	bool ToneBufferDownload::Impl::SendThrottled(const std::shared_ptr<IConnectionManager>& conn, HostReport* iorpt, std::atomic<bool>& running)
+	{
+		std::unique_lock<std::mutex> dllck{ dl_list_mutex };
+		dl_list_cv.wait(dllck, [&]() {
+			return (!running) || (dl_list.size() < dl_list_watermark);
+		});
+		if (!running) return false;
+
+		MessageHandle h = conn->SendMsg(*iorpt);
+		dl_list.push_back(h);
+		return true;
+	}
+
 	// ToneBuffer Downloading Thread
 	void ToneBufferDownload::Impl::DownloadWorkerLoop(std::atomic<bool>& running, std::condition_variable& cond, std::mutex& mtx)
 	{
@@ -406,79 +534,75 @@ namespace iMS {
 			HostReport *iorpt;
 			int index = offset;
 			int length = static_cast<int>(std::distance(first, last));
-			int buf_bytes = 1024;
+			const std::size_t freq0l_bytes = (ims->Synth().GetCap().freqBits > 16) ? 2 : 0;
 
 			dl_final = NullMessage;
 
+			// Incremental downloads skip any entry whose contents match the last successful download
+			LTBShadowRegistry::Entries shadow;
+			const bool skip_unchanged = m_incremental && LTBShadowRegistry::Instance().Get(ims, shadow);
+			{
+				std::unique_lock<std::mutex> dllck{ dl_list_mutex };
+				m_pending.clear();
+				m_failed = false;
+			}
+
+			std::vector<std::uint8_t> entry_data;
 			std::vector<std::uint8_t> ltb_data;
 			ToneBuffer::const_iterator it = first;
-			MessageHandle h2;
-
-			while (((index - offset) < length) && (it < last) && running)
+			for (; ((index - offset) < length) && (it < last) && running; ++it, ++index)
 			{
-				// Add one TBEntry to vector: build packet data
-				AddPointToVector(ims, ltb_data, (*it), false);
+				// Build packet data for one TBEntry
+				entry_data.clear();
+				FormatEntry(ims, entry_data, (*it));
+				if (skip_unchanged && (shadow[index] == entry_data)) continue;
 
-                if (buf_bytes <= 0)
-                {
-                    buf_bytes = 1024;
-                }
-                buf_bytes -= static_cast<int>(ltb_data.size());                
+				{
+					std::unique_lock<std::mutex> dllck{ dl_list_mutex };
+					m_pending[index] = entry_data;
+				}
 
+				const std::size_t sync_dig_bytes = entry_data.size() - freq0l_bytes;
+				ltb_data.assign(entry_data.begin(), entry_data.begin() + sync_dig_bytes);
 				iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_ProgSyncDig);
 				iorpt->Payload<std::vector<std::uint8_t>>(ltb_data);
-				MessageHandle h = conn->SendMsg(*iorpt);
+				bool sent = SendThrottled(conn, iorpt, running);
 				delete iorpt;
+				if (!sent) break;
 
-                // THROTTLE: wait until dl_list has room (atomically)
-                {
-                    std::unique_lock<std::mutex> dllck{ dl_list_mutex };
-                    dl_list_cv.wait(dllck, [&]() {
-                        return (!running) || (dl_list.size() < dl_list_watermark);
-                    });
-                    if (!running) {
-                        // optionally clean up or break out to terminate quickly
-                        dllck.unlock();
-                        break;
-                    }
-                    dl_list.push_back(h);
-                    // dllck.unlock(); // unlocks at scope exit
-                }
-
-				ltb_data.clear();
-
-				if (ims->Synth().GetCap().freqBits > 16)
+				if (freq0l_bytes)
 				{
-					unsigned int freq = FrequencyRenderer::RenderAsImagePoint(ims, it->GetFAP(RFChannel::min).freq);
-					ltb_data.push_back(static_cast<std::uint8_t>((freq >> (ims->Synth().GetCap().freqBits - 32)) & 0xFF));
-					ltb_data.push_back(static_cast<std::uint8_t>((freq >> (ims->Synth().GetCap().freqBits - 24)) & 0xFF));
+					ltb_data.assign(entry_data.begin() + sync_dig_bytes, entry_data.end());
 					iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_ProgFreq0L);
 					iorpt->Payload<std::vector<std::uint8_t>>(ltb_data);
-					conn->SendMsg(*iorpt);
+					sent = SendThrottled(conn, iorpt, running);
 					delete iorpt;
+					if (!sent) break;
 				}
 
-				ltb_data.clear();
-
 				// Send message to program entry into an LTB index
 				iorpt = new HostReport(HostReport::Actions::SYNTH_REG, HostReport::Dir::WRITE, SYNTH_REG_ProgLocal);
-				iorpt->Payload<std::uint16_t>(static_cast<std::uint16_t>(index++));
-				h2 = conn->SendMsg(*iorpt);
+				iorpt->Payload<std::uint16_t>(static_cast<std::uint16_t>(index));
+				sent = SendThrottled(conn, iorpt, running);
 				delete iorpt;
-
-				++it;
-
-				// Add message handles to download list so we can check the responses
-				{
-				    std::unique_lock<std::mutex> dllck{ dl_list_mutex };
-        			if ((it == last) || ((index - offset) >= length)) dl_final = h2;
-        			dl_list.push_back(h2);
-                }
+				if (!sent) break;
 
 				// Not a great hack: adding a gap ensures packets aren't coalesced (even with TCP_NODELAY enabled)
 				//std::this_thread::sleep_for(std::chrono::milliseconds(5));
 			}
 
+			{
+				// The download is finished when the last message sent is acknowledged
+				std::unique_lock<std::mutex> dllck{ dl_list_mutex };
+				if (!dl_list.empty()) dl_final = dl_list.back();
+				else {
+					// Nothing was sent because the LTB is already up to date, or every response has
+					// arrived before the final message could be identified.  A failed download also
+					// finishes here, which discards the record of the entries that were sent.
+					DownloadFinished();
+				}
+			}
+
 			// Release lock, wait for next download trigger
 			lck.unlock();
 		}
@@ -489,7 +613,9 @@ namespace iMS {
 	{
 		while (true) {
     		std::unique_lock<std::mutex> lck{ mtx };
-            cond.wait(lck);
+            cond.wait(lck, [this, &running]() {
+                return !rxok_list.empty() || !rxerr_list.empty() || !running;
+            });
 
             // Allow thread to terminate 
 			if (!running) break;
@@ -518,7 +644,7 @@ namespace iMS {
                         // Download Finished?
                         if (handle == dl_final)
                         {
-                            m_Event.Trigger<int>((void *)this, ToneBufferEvents::DOWNLOAD_FINISHED, 0);
+                            DownloadFinished();
                         }
 
                         // Notify producer that there is room for more messages
@@ -547,10 +673,13 @@ namespace iMS {
                             continue;
                         }
 
+                        // The LTB contents on the Synthesiser are no longer known
+                        m_failed = true;
+
                         // Download Finished?
                         if (handle == dl_final)
                         {
-                            m_Event.Trigger<int>((void *)this, ToneBufferEvents::DOWNLOAD_FINISHED, 0);
+                            DownloadFinished();
                         }
 
                         // Remove from list
@@ -60,6 +60,16 @@ int TFTPClient::sendPacket(TFTP_Packet* packet) {
 
 bool TFTPClient::getFile(const char* filename, boost::container::deque<std::uint8_t>& dest) {
 
+	dest.clear();
+	return getFile(filename, [&dest](const std::uint8_t* data, std::size_t len) {
+		dest.insert(dest.end(), data, data + len);
+		return true;
+	});
+
+}
+
+bool TFTPClient::getFile(const char* filename, const std::function<bool(const std::uint8_t*, std::size_t)>& sink) {
+
 	TFTP_Packet packet_rrq, packet_ack;
 	char buffer[TFTP_PACKET_DATA_SIZE];
 
@@ -70,8 +80,6 @@ bool TFTPClient::getFile(const char* filename, boost::container::deque<std::uint
 	int last_packet_no = 1;
 	int wait_status;
 	int timeout_count = 0;
-	boost::container::deque<std::uint8_t>::iterator arrptr = dest.begin();
-	dest.clear();
 
 	while (true) {
 
@@ -111,7 +119,14 @@ bool TFTPClient::getFile(const char* filename, boost::container::deque<std::uint
 
 			int len;
 			if ((len = received_packet.copyData(4, buffer, TFTP_PACKET_DATA_SIZE)) > -1) {
-				if (len) dest.insert(dest.end(), buffer, &buffer[len]);
+				if (len && !sink(reinterpret_cast<const std::uint8_t*>(buffer), static_cast<std::size_t>(len))) {
+					//- The receiver has seen enough.  Tell the server to stop sending.
+					TFTP_Packet packet_error;
+					char message[] = "Transfer abandoned";
+					packet_error.createError(0, message);
+					sendPacket(&packet_error);
+					return false;
+				}
 				//- A data packet of less than 512 bytes signals termination of a transfer.
 
 				if (received_packet.getSize() - 4 < TFTP_PACKET_DATA_SIZE) {